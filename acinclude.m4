@@ -6,6 +6,11 @@ dnl Function to detect if libnk2 dependencies are available
 AC_DEFUN([AX_LIBNK2_CHECK_LOCAL],
   [dnl Check for internationalization functions in libnk2/libnk2_i18n.c
   AC_CHECK_FUNCS([bindtextdomain])
+
+  dnl Headers and functions included in libnk2/libnk2_statistics.c
+  AC_CHECK_HEADERS([time.h])
+
+  AC_CHECK_FUNCS([clock_gettime])
 ])
 
 dnl Function to detect if nk2tools dependencies are available
@@ -21,6 +26,11 @@ AC_DEFUN([AX_NK2TOOLS_CHECK_LOCAL],
      [1])
   ])
 
+  dnl Headers and functions used in nk2tools/alias_handle.c and pynk2/pynk2_file.c
+  AC_CHECK_HEADERS([fcntl.h sys/mman.h])
+
+  AC_CHECK_FUNCS([mmap munmap])
+
   dnl Headers included in nk2tools/log_handle.c
   AC_CHECK_HEADERS([stdarg.h varargs.h])
 
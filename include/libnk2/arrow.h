@@ -0,0 +1,96 @@
+/*
+ * Arrow C data interface definitions for libnk2
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBNK2_ARROW_H )
+#define _LIBNK2_ARROW_H
+
+#include <libnk2/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The Arrow C data interface structures
+ * These are defined by the Arrow C data interface specification and
+ * are ABI stable, they are copied here so that libnk2 does not depend on Arrow
+ */
+#if !defined( ARROW_C_DATA_INTERFACE )
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED	1
+#define ARROW_FLAG_NULLABLE		2
+#define ARROW_FLAG_MAP_KEYS_SORTED	4
+
+struct ArrowSchema
+{
+	const char *format;
+	const char *name;
+	const char *metadata;
+	int64_t flags;
+	int64_t n_children;
+	struct ArrowSchema **children;
+	struct ArrowSchema *dictionary;
+
+	void (*release)( struct ArrowSchema * );
+
+	void *private_data;
+};
+
+struct ArrowArray
+{
+	int64_t length;
+	int64_t null_count;
+	int64_t offset;
+	int64_t n_buffers;
+	int64_t n_children;
+	const void **buffers;
+	struct ArrowArray **children;
+	struct ArrowArray *dictionary;
+
+	void (*release)( struct ArrowArray * );
+
+	void *private_data;
+};
+
+#endif /* !defined( ARROW_C_DATA_INTERFACE ) */
+
+/* The columns of the exported record batch
+ */
+enum LIBNK2_ARROW_COLUMNS
+{
+	LIBNK2_ARROW_COLUMN_ITEM_INDEX		= 0,
+	LIBNK2_ARROW_COLUMN_ENTRY_TYPE		= 1,
+	LIBNK2_ARROW_COLUMN_VALUE_TYPE		= 2,
+	LIBNK2_ARROW_COLUMN_INTEGER		= 3,
+	LIBNK2_ARROW_COLUMN_FLOATING_POINT	= 4,
+	LIBNK2_ARROW_COLUMN_TIMESTAMP		= 5,
+	LIBNK2_ARROW_COLUMN_STRING		= 6,
+	LIBNK2_ARROW_COLUMN_DATA		= 7
+};
+
+#define LIBNK2_ARROW_NUMBER_OF_COLUMNS		8
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* !defined( _LIBNK2_ARROW_H ) */
+
@@ -239,6 +239,8 @@ enum LIBNK2_ENTRY_TYPES
 
 	LIBNK2_ENTRY_TYPE_MESSAGE_TRUST_SENDER					= 0x0e79,
 
+	LIBNK2_ENTRY_TYPE_ENTRY_IDENTIFIER					= 0x0fff,
+
 	LIBNK2_ENTRY_TYPE_MESSAGE_BODY_PLAIN_TEXT				= 0x1000,
 
 	LIBNK2_ENTRY_TYPE_MESSAGE_BODY_COMPRESSED_RTF				= 0x1009,
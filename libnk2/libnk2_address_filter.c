@@ -0,0 +1,1247 @@
+/*
+ * Address filter functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libnk2_address_filter.h"
+#include "libnk2_alias_index.h"
+#include "libnk2_alias_index_writer.h"
+#include "libnk2_file.h"
+#include "libnk2_index.h"
+#include "libnk2_item.h"
+#include "libnk2_libcdata.h"
+#include "libnk2_libcerror.h"
+#include "libnk2_mapi.h"
+#include "libnk2_mapi_value.h"
+#include "libnk2_record_entry.h"
+
+#include "nk2_address_filter.h"
+
+const uint8_t nk2_address_filter_signature[ 8 ] = { 'N', 'K', '2', 'B', 'L', 'O', 'O', 'M' };
+
+/* Creates an address filter
+ * Make sure the value address_filter is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_address_filter_initialize(
+     libnk2_address_filter_t **address_filter,
+     libcerror_error_t **error )
+{
+	libnk2_internal_address_filter_t *internal_address_filter = NULL;
+	static char *function                                     = "libnk2_address_filter_initialize";
+
+	if( address_filter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid address filter.",
+		 function );
+
+		return( -1 );
+	}
+	if( *address_filter != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid address filter value already set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_address_filter = memory_allocate_structure(
+	                           libnk2_internal_address_filter_t );
+
+	if( internal_address_filter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create address filter.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     internal_address_filter,
+	     0,
+	     sizeof( libnk2_internal_address_filter_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear address filter.",
+		 function );
+
+		memory_free(
+		 internal_address_filter );
+
+		return( -1 );
+	}
+	*address_filter = (libnk2_address_filter_t *) internal_address_filter;
+
+	return( 1 );
+}
+
+/* Frees an address filter
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_address_filter_free(
+     libnk2_address_filter_t **address_filter,
+     libcerror_error_t **error )
+{
+	libnk2_internal_address_filter_t *internal_address_filter = NULL;
+	static char *function                                     = "libnk2_address_filter_free";
+
+	if( address_filter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid address filter.",
+		 function );
+
+		return( -1 );
+	}
+	if( *address_filter != NULL )
+	{
+		internal_address_filter = (libnk2_internal_address_filter_t *) *address_filter;
+		*address_filter         = NULL;
+
+		if( internal_address_filter->bitmap != NULL )
+		{
+			memory_free(
+			 internal_address_filter->bitmap );
+		}
+		memory_free(
+		 internal_address_filter );
+	}
+	return( 1 );
+}
+
+/* Calculates the hash of the data
+ * This uses the 64-bit FNV-1a hash
+ * Returns the hash
+ */
+uint64_t libnk2_address_filter_calculate_hash(
+          const uint8_t *data,
+          size_t data_size )
+{
+	size_t data_offset = 0;
+	uint64_t hash      = 0xcbf29ce484222325ULL;
+
+	if( data == NULL )
+	{
+		return( 0 );
+	}
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset++ )
+	{
+		hash ^= data[ data_offset ];
+		hash *= 0x00000100000001b3ULL;
+	}
+	return( hash );
+}
+
+/* Sets the bits of a hash in the bitmap
+ */
+void libnk2_address_filter_set_hash(
+      libnk2_internal_address_filter_t *internal_address_filter,
+      uint64_t hash )
+{
+	uint64_t bit_index           = 0;
+	uint64_t first_hash          = 0;
+	uint64_t second_hash         = 0;
+	uint32_t hash_function_index = 0;
+
+	if( ( internal_address_filter == NULL )
+	 || ( internal_address_filter->bitmap == NULL )
+	 || ( internal_address_filter->number_of_bits == 0 ) )
+	{
+		return;
+	}
+	first_hash  = hash & 0xffffffffUL;
+	second_hash = ( hash >> 32 ) | 1;
+
+	for( hash_function_index = 0;
+	     hash_function_index < internal_address_filter->number_of_hash_functions;
+	     hash_function_index++ )
+	{
+		bit_index = ( first_hash + ( hash_function_index * second_hash ) ) % internal_address_filter->number_of_bits;
+
+		internal_address_filter->bitmap[ bit_index / 8 ] |= (uint8_t) ( 1 << ( bit_index % 8 ) );
+	}
+}
+
+/* Tests the bits of a hash in the bitmap
+ * Returns 1 if all bits are set or 0 if not
+ */
+int libnk2_address_filter_test_hash(
+     libnk2_internal_address_filter_t *internal_address_filter,
+     uint64_t hash )
+{
+	uint64_t bit_index           = 0;
+	uint64_t first_hash          = 0;
+	uint64_t second_hash         = 0;
+	uint32_t hash_function_index = 0;
+
+	if( ( internal_address_filter == NULL )
+	 || ( internal_address_filter->bitmap == NULL )
+	 || ( internal_address_filter->number_of_bits == 0 ) )
+	{
+		return( 0 );
+	}
+	first_hash  = hash & 0xffffffffUL;
+	second_hash = ( hash >> 32 ) | 1;
+
+	for( hash_function_index = 0;
+	     hash_function_index < internal_address_filter->number_of_hash_functions;
+	     hash_function_index++ )
+	{
+		bit_index = ( first_hash + ( hash_function_index * second_hash ) ) % internal_address_filter->number_of_bits;
+
+		if( ( internal_address_filter->bitmap[ bit_index / 8 ] & (uint8_t) ( 1 << ( bit_index % 8 ) ) ) == 0 )
+		{
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
+
+/* Builds the address filter from the email addresses of the items of an open file
+ * The email addresses are normalized the same way as in the alias index
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_address_filter_build_from_file(
+     libnk2_address_filter_t *address_filter,
+     libnk2_file_t *file,
+     libcerror_error_t **error )
+{
+	libnk2_internal_address_filter_t *internal_address_filter = NULL;
+	libnk2_internal_file_t *internal_file                     = NULL;
+	libnk2_internal_item_t *internal_item                     = NULL;
+	libnk2_internal_record_entry_t *internal_record_entry     = NULL;
+	uint8_t *bitmap                                           = NULL;
+	uint8_t *hashes                                           = NULL;
+	uint8_t *utf8_string                                      = NULL;
+	static char *function                                     = "libnk2_address_filter_build_from_file";
+	size_t hashes_allocated_size                              = 0;
+	size_t utf8_string_allocated_size                         = 0;
+	size_t utf8_string_length                                 = 0;
+	size_t utf8_string_size                                   = 0;
+	uint64_t hash                                             = 0;
+	uint64_t modification_time                                = 0;
+	uint32_t address_index                                    = 0;
+	uint32_t number_of_addresses                              = 0;
+	uint32_t number_of_bits                                   = 0;
+	int entry_index                                           = 0;
+	int item_index                                            = 0;
+	int number_of_entries                                     = 0;
+	int number_of_items                                       = 0;
+	int result                                                = 0;
+
+	if( address_filter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid address filter.",
+		 function );
+
+		return( -1 );
+	}
+	internal_address_filter = (libnk2_internal_address_filter_t *) address_filter;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libnk2_internal_file_t *) file;
+
+	if( internal_file->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libnk2_file_get_modification_time(
+	     file,
+	     &modification_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve modification time.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_file->items_array,
+	     &number_of_items,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of items.",
+		 function );
+
+		goto on_error;
+	}
+	/* The hashes are collected first since the size of the bitmap
+	 * depends on the number of addresses
+	 */
+	for( item_index = 0;
+	     item_index < number_of_items;
+	     item_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_file->items_array,
+		     item_index,
+		     (intptr_t **) &internal_item,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve item: %d.",
+			 function,
+			 item_index );
+
+			goto on_error;
+		}
+		if( internal_item == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing item: %d.",
+			 function,
+			 item_index );
+
+			goto on_error;
+		}
+		if( libcdata_array_get_number_of_entries(
+		     internal_item->entries_array,
+		     &number_of_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of entries of item: %d.",
+			 function,
+			 item_index );
+
+			goto on_error;
+		}
+		for( entry_index = 0;
+		     entry_index < number_of_entries;
+		     entry_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     internal_item->entries_array,
+			     entry_index,
+			     (intptr_t **) &internal_record_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve record entry: %d of item: %d.",
+				 function,
+				 entry_index,
+				 item_index );
+
+				goto on_error;
+			}
+			if( internal_record_entry->entry_type != LIBNK2_ENTRY_TYPE_EMAIL_ADDRESS )
+			{
+				continue;
+			}
+			result = libnk2_index_get_key_string_size(
+			          internal_record_entry,
+			          &utf8_string_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve key string size of record entry: %d of item: %d.",
+				 function,
+				 entry_index,
+				 item_index );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				continue;
+			}
+			if( libnk2_alias_index_writer_resize_buffer(
+			     &utf8_string,
+			     &utf8_string_allocated_size,
+			     utf8_string_size + 1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+				 "%s: unable to resize UTF-8 string.",
+				 function );
+
+				goto on_error;
+			}
+			if( libnk2_mapi_value_get_data_as_utf8_string(
+			     internal_record_entry->value_type,
+			     internal_record_entry->value_data,
+			     internal_record_entry->value_data_size,
+			     internal_record_entry->ascii_codepage,
+			     utf8_string,
+			     utf8_string_size + 1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve UTF-8 string of record entry: %d of item: %d.",
+				 function,
+				 entry_index,
+				 item_index );
+
+				goto on_error;
+			}
+			utf8_string_length = utf8_string_size;
+
+			if( libnk2_alias_index_normalize_utf8_string(
+			     utf8_string,
+			     &utf8_string_length,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to normalize UTF-8 string of record entry: %d of item: %d.",
+				 function,
+				 entry_index,
+				 item_index );
+
+				goto on_error;
+			}
+			if( utf8_string_length == 0 )
+			{
+				continue;
+			}
+			if( number_of_addresses >= ( ( UINT32_MAX - 63 ) / LIBNK2_ADDRESS_FILTER_BITS_PER_ADDRESS ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid number of addresses value exceeds maximum.",
+				 function );
+
+				goto on_error;
+			}
+			if( libnk2_alias_index_writer_resize_buffer(
+			     &hashes,
+			     &hashes_allocated_size,
+			     sizeof( uint64_t ) * ( (size_t) number_of_addresses + 1 ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+				 "%s: unable to resize hashes.",
+				 function );
+
+				goto on_error;
+			}
+			( (uint64_t *) hashes )[ number_of_addresses ] = libnk2_address_filter_calculate_hash(
+			                                                  utf8_string,
+			                                                  utf8_string_length );
+
+			number_of_addresses++;
+		}
+	}
+	/* The number of bits is rounded up to a multiple of 64
+	 */
+	number_of_bits = ( ( number_of_addresses * LIBNK2_ADDRESS_FILTER_BITS_PER_ADDRESS ) + 63 ) & ~( (uint32_t) 63 );
+
+	if( number_of_bits == 0 )
+	{
+		number_of_bits = 64;
+	}
+	bitmap = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * ( number_of_bits / 8 ) );
+
+	if( bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create bitmap.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     bitmap,
+	     0,
+	     sizeof( uint8_t ) * ( number_of_bits / 8 ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear bitmap.",
+		 function );
+
+		goto on_error;
+	}
+	if( internal_address_filter->bitmap != NULL )
+	{
+		memory_free(
+		 internal_address_filter->bitmap );
+	}
+	internal_address_filter->bitmap                   = bitmap;
+	internal_address_filter->number_of_bits           = number_of_bits;
+	internal_address_filter->number_of_hash_functions = LIBNK2_ADDRESS_FILTER_NUMBER_OF_HASH_FUNCTIONS;
+	internal_address_filter->number_of_addresses      = number_of_addresses;
+	internal_address_filter->number_of_items          = (uint32_t) number_of_items;
+	internal_address_filter->modification_time        = modification_time;
+
+	bitmap = NULL;
+
+	for( address_index = 0;
+	     address_index < number_of_addresses;
+	     address_index++ )
+	{
+		hash = ( (uint64_t *) hashes )[ address_index ];
+
+		libnk2_address_filter_set_hash(
+		 internal_address_filter,
+		 hash );
+	}
+	if( hashes != NULL )
+	{
+		memory_free(
+		 hashes );
+	}
+	if( utf8_string != NULL )
+	{
+		memory_free(
+		 utf8_string );
+	}
+	return( 1 );
+
+on_error:
+	if( bitmap != NULL )
+	{
+		memory_free(
+		 bitmap );
+	}
+	if( hashes != NULL )
+	{
+		memory_free(
+		 hashes );
+	}
+	if( utf8_string != NULL )
+	{
+		memory_free(
+		 utf8_string );
+	}
+	return( -1 );
+}
+
+/* Retrieves the size of the serialized address filter
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_address_filter_get_data_size(
+     libnk2_address_filter_t *address_filter,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	libnk2_internal_address_filter_t *internal_address_filter = NULL;
+	static char *function                                     = "libnk2_address_filter_get_data_size";
+
+	if( address_filter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid address filter.",
+		 function );
+
+		return( -1 );
+	}
+	internal_address_filter = (libnk2_internal_address_filter_t *) address_filter;
+
+	if( internal_address_filter->bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid address filter - missing bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	*data_size = sizeof( nk2_address_filter_header_t ) + ( internal_address_filter->number_of_bits / 8 );
+
+	return( 1 );
+}
+
+/* Writes the address filter to a buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_address_filter_write_data(
+     libnk2_address_filter_t *address_filter,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	nk2_address_filter_header_t *header                       = NULL;
+	libnk2_internal_address_filter_t *internal_address_filter = NULL;
+	static char *function                                     = "libnk2_address_filter_write_data";
+	size_t required_data_size                                 = 0;
+
+	if( libnk2_address_filter_get_data_size(
+	     address_filter,
+	     &required_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data size.",
+		 function );
+
+		return( -1 );
+	}
+	internal_address_filter = (libnk2_internal_address_filter_t *) address_filter;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < required_data_size )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	header = (nk2_address_filter_header_t *) data;
+
+	if( memory_set(
+	     data,
+	     0,
+	     sizeof( nk2_address_filter_header_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear header.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     header->signature,
+	     nk2_address_filter_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 header->format_version,
+	 LIBNK2_ADDRESS_FILTER_FORMAT_VERSION );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 header->number_of_hash_functions,
+	 internal_address_filter->number_of_hash_functions );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 header->number_of_bits,
+	 internal_address_filter->number_of_bits );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 header->number_of_addresses,
+	 internal_address_filter->number_of_addresses );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 header->modification_time,
+	 internal_address_filter->modification_time );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 header->number_of_items,
+	 internal_address_filter->number_of_items );
+
+	if( memory_copy(
+	     &( data[ sizeof( nk2_address_filter_header_t ) ] ),
+	     internal_address_filter->bitmap,
+	     internal_address_filter->number_of_bits / 8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the address filter from a buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_address_filter_read_data(
+     libnk2_address_filter_t *address_filter,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	nk2_address_filter_header_t *header                       = NULL;
+	libnk2_internal_address_filter_t *internal_address_filter = NULL;
+	uint8_t *bitmap                                           = NULL;
+	static char *function                                     = "libnk2_address_filter_read_data";
+	uint64_t modification_time                                = 0;
+	uint32_t format_version                                   = 0;
+	uint32_t number_of_addresses                              = 0;
+	uint32_t number_of_bits                                   = 0;
+	uint32_t number_of_hash_functions                         = 0;
+	uint32_t number_of_items                                  = 0;
+
+	if( address_filter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid address filter.",
+		 function );
+
+		return( -1 );
+	}
+	internal_address_filter = (libnk2_internal_address_filter_t *) address_filter;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < sizeof( nk2_address_filter_header_t ) )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	header = (nk2_address_filter_header_t *) data;
+
+	if( memory_compare(
+	     header->signature,
+	     nk2_address_filter_signature,
+	     8 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 header->format_version,
+	 format_version );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 header->number_of_hash_functions,
+	 number_of_hash_functions );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 header->number_of_bits,
+	 number_of_bits );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 header->number_of_addresses,
+	 number_of_addresses );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 header->modification_time,
+	 modification_time );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 header->number_of_items,
+	 number_of_items );
+
+	if( format_version != LIBNK2_ADDRESS_FILTER_FORMAT_VERSION )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported format version: %" PRIu32 ".",
+		 function,
+		 format_version );
+
+		return( -1 );
+	}
+	if( ( number_of_hash_functions == 0 )
+	 || ( number_of_hash_functions > LIBNK2_ADDRESS_FILTER_MAXIMUM_NUMBER_OF_HASH_FUNCTIONS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of hash functions value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_bits == 0 )
+	 || ( ( number_of_bits % 64 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported number of bits: %" PRIu32 ".",
+		 function,
+		 number_of_bits );
+
+		return( -1 );
+	}
+	/* A truncated bitmap would result in false negatives hence the size must match
+	 */
+	if( ( data_size - sizeof( nk2_address_filter_header_t ) ) != (size_t) ( number_of_bits / 8 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of bits value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	bitmap = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * ( number_of_bits / 8 ) );
+
+	if( bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     bitmap,
+	     &( data[ sizeof( nk2_address_filter_header_t ) ] ),
+	     number_of_bits / 8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy bitmap.",
+		 function );
+
+		memory_free(
+		 bitmap );
+
+		return( -1 );
+	}
+	if( internal_address_filter->bitmap != NULL )
+	{
+		memory_free(
+		 internal_address_filter->bitmap );
+	}
+	internal_address_filter->bitmap                   = bitmap;
+	internal_address_filter->number_of_bits           = number_of_bits;
+	internal_address_filter->number_of_hash_functions = number_of_hash_functions;
+	internal_address_filter->number_of_addresses      = number_of_addresses;
+	internal_address_filter->number_of_items          = number_of_items;
+	internal_address_filter->modification_time        = modification_time;
+
+	return( 1 );
+}
+
+/* Retrieves the modification time of the file the address filter was built from
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_address_filter_get_modification_time(
+     libnk2_address_filter_t *address_filter,
+     uint64_t *filetime,
+     libcerror_error_t **error )
+{
+	libnk2_internal_address_filter_t *internal_address_filter = NULL;
+	static char *function                                     = "libnk2_address_filter_get_modification_time";
+
+	if( address_filter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid address filter.",
+		 function );
+
+		return( -1 );
+	}
+	internal_address_filter = (libnk2_internal_address_filter_t *) address_filter;
+
+	if( filetime == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filetime.",
+		 function );
+
+		return( -1 );
+	}
+	*filetime = internal_address_filter->modification_time;
+
+	return( 1 );
+}
+
+/* Retrieves the number of items of the file the address filter was built from
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_address_filter_get_number_of_items(
+     libnk2_address_filter_t *address_filter,
+     uint32_t *number_of_items,
+     libcerror_error_t **error )
+{
+	libnk2_internal_address_filter_t *internal_address_filter = NULL;
+	static char *function                                     = "libnk2_address_filter_get_number_of_items";
+
+	if( address_filter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid address filter.",
+		 function );
+
+		return( -1 );
+	}
+	internal_address_filter = (libnk2_internal_address_filter_t *) address_filter;
+
+	if( number_of_items == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of items.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_items = internal_address_filter->number_of_items;
+
+	return( 1 );
+}
+
+/* Retrieves the number of addresses in the address filter
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_address_filter_get_number_of_addresses(
+     libnk2_address_filter_t *address_filter,
+     uint32_t *number_of_addresses,
+     libcerror_error_t **error )
+{
+	libnk2_internal_address_filter_t *internal_address_filter = NULL;
+	static char *function                                     = "libnk2_address_filter_get_number_of_addresses";
+
+	if( address_filter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid address filter.",
+		 function );
+
+		return( -1 );
+	}
+	internal_address_filter = (libnk2_internal_address_filter_t *) address_filter;
+
+	if( number_of_addresses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of addresses.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_addresses = internal_address_filter->number_of_addresses;
+
+	return( 1 );
+}
+
+/* Determines if the address filter contains a specific UTF-8 formatted address
+ * The address is matched case insensitive and without leading and trailing white space
+ * Returns 1 if the address is possibly contained, 0 if the address is not contained or -1 on error
+ */
+int libnk2_address_filter_contains_utf8_address(
+     libnk2_address_filter_t *address_filter,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcerror_error_t **error )
+{
+	uint8_t key_data[ 256 ];
+
+	libnk2_internal_address_filter_t *internal_address_filter = NULL;
+	uint8_t *allocated_key                                    = NULL;
+	uint8_t *key                                              = NULL;
+	static char *function                                     = "libnk2_address_filter_contains_utf8_address";
+	size_t key_length                                         = 0;
+	uint64_t hash                                             = 0;
+
+	if( address_filter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid address filter.",
+		 function );
+
+		return( -1 );
+	}
+	internal_address_filter = (libnk2_internal_address_filter_t *) address_filter;
+
+	if( internal_address_filter->bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid address filter - missing bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-8 string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_length == 0 )
+	{
+		return( 0 );
+	}
+	if( utf8_string_length <= 256 )
+	{
+		key = key_data;
+	}
+	else
+	{
+		allocated_key = (uint8_t *) memory_allocate(
+		                             sizeof( uint8_t ) * utf8_string_length );
+
+		if( allocated_key == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create key.",
+			 function );
+
+			return( -1 );
+		}
+		key = allocated_key;
+	}
+	if( memory_copy(
+	     key,
+	     utf8_string,
+	     utf8_string_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy key.",
+		 function );
+
+		goto on_error;
+	}
+	key_length = utf8_string_length;
+
+	if( libnk2_alias_index_normalize_utf8_string(
+	     key,
+	     &key_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to normalize key.",
+		 function );
+
+		goto on_error;
+	}
+	hash = libnk2_address_filter_calculate_hash(
+	        key,
+	        key_length );
+
+	if( allocated_key != NULL )
+	{
+		memory_free(
+		 allocated_key );
+	}
+	if( key_length == 0 )
+	{
+		return( 0 );
+	}
+	return( libnk2_address_filter_test_hash(
+	         internal_address_filter,
+	         hash ) );
+
+on_error:
+	if( allocated_key != NULL )
+	{
+		memory_free(
+		 allocated_key );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,162 @@
+/*
+ * Address filter functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBNK2_ADDRESS_FILTER_H )
+#define _LIBNK2_ADDRESS_FILTER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libnk2_extern.h"
+#include "libnk2_libcerror.h"
+#include "libnk2_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The version of the address filter format
+ */
+#define LIBNK2_ADDRESS_FILTER_FORMAT_VERSION		1
+
+/* The number of bits per address, which together with the number of hash functions
+ * results in a false positive rate of less than 1 percent
+ */
+#define LIBNK2_ADDRESS_FILTER_BITS_PER_ADDRESS		10
+
+/* The number of hash functions
+ */
+#define LIBNK2_ADDRESS_FILTER_NUMBER_OF_HASH_FUNCTIONS	7
+
+/* The maximum number of hash functions supported when reading an address filter
+ */
+#define LIBNK2_ADDRESS_FILTER_MAXIMUM_NUMBER_OF_HASH_FUNCTIONS	32
+
+extern const uint8_t nk2_address_filter_signature[ 8 ];
+
+typedef struct libnk2_internal_address_filter libnk2_internal_address_filter_t;
+
+struct libnk2_internal_address_filter
+{
+	/* The bitmap
+	 */
+	uint8_t *bitmap;
+
+	/* The number of bits
+	 */
+	uint32_t number_of_bits;
+
+	/* The number of hash functions
+	 */
+	uint32_t number_of_hash_functions;
+
+	/* The number of addresses
+	 */
+	uint32_t number_of_addresses;
+
+	/* The number of items of the file
+	 */
+	uint32_t number_of_items;
+
+	/* The modification time of the file
+	 */
+	uint64_t modification_time;
+};
+
+LIBNK2_EXTERN \
+int libnk2_address_filter_initialize(
+     libnk2_address_filter_t **address_filter,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_address_filter_free(
+     libnk2_address_filter_t **address_filter,
+     libcerror_error_t **error );
+
+uint64_t libnk2_address_filter_calculate_hash(
+          const uint8_t *data,
+          size_t data_size );
+
+void libnk2_address_filter_set_hash(
+      libnk2_internal_address_filter_t *internal_address_filter,
+      uint64_t hash );
+
+int libnk2_address_filter_test_hash(
+     libnk2_internal_address_filter_t *internal_address_filter,
+     uint64_t hash );
+
+LIBNK2_EXTERN \
+int libnk2_address_filter_build_from_file(
+     libnk2_address_filter_t *address_filter,
+     libnk2_file_t *file,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_address_filter_get_data_size(
+     libnk2_address_filter_t *address_filter,
+     size_t *data_size,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_address_filter_write_data(
+     libnk2_address_filter_t *address_filter,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_address_filter_read_data(
+     libnk2_address_filter_t *address_filter,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_address_filter_get_modification_time(
+     libnk2_address_filter_t *address_filter,
+     uint64_t *filetime,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_address_filter_get_number_of_items(
+     libnk2_address_filter_t *address_filter,
+     uint32_t *number_of_items,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_address_filter_get_number_of_addresses(
+     libnk2_address_filter_t *address_filter,
+     uint32_t *number_of_addresses,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_address_filter_contains_utf8_address(
+     libnk2_address_filter_t *address_filter,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBNK2_ADDRESS_FILTER_H ) */
+
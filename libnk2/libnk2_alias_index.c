@@ -0,0 +1,1399 @@
+/*
+ * Alias index functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libnk2_alias_index.h"
+#include "libnk2_index.h"
+#include "libnk2_libcerror.h"
+
+#include "nk2_alias_index.h"
+
+const uint8_t nk2_alias_index_signature[ 8 ] = { 'N', 'K', '2', 'A', 'L', 'I', 'A', 'S' };
+
+/* Creates an alias index
+ * Make sure the value alias_index is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_alias_index_initialize(
+     libnk2_alias_index_t **alias_index,
+     libcerror_error_t **error )
+{
+	libnk2_internal_alias_index_t *internal_alias_index = NULL;
+	static char *function                               = "libnk2_alias_index_initialize";
+
+	if( alias_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid alias index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *alias_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid alias index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_alias_index = memory_allocate_structure(
+	                        libnk2_internal_alias_index_t );
+
+	if( internal_alias_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create alias index.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     internal_alias_index,
+	     0,
+	     sizeof( libnk2_internal_alias_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear alias index.",
+		 function );
+
+		memory_free(
+		 internal_alias_index );
+
+		return( -1 );
+	}
+	*alias_index = (libnk2_alias_index_t *) internal_alias_index;
+
+	return( 1 );
+}
+
+/* Frees an alias index
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_alias_index_free(
+     libnk2_alias_index_t **alias_index,
+     libcerror_error_t **error )
+{
+	libnk2_internal_alias_index_t *internal_alias_index = NULL;
+	static char *function                               = "libnk2_alias_index_free";
+
+	if( alias_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid alias index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *alias_index != NULL )
+	{
+		internal_alias_index = (libnk2_internal_alias_index_t *) *alias_index;
+		*alias_index         = NULL;
+
+		if( internal_alias_index->segments != NULL )
+		{
+			memory_free(
+			 internal_alias_index->segments );
+		}
+		memory_free(
+		 internal_alias_index );
+	}
+	return( 1 );
+}
+
+/* Normalizes an UTF-8 formatted address in place
+ * Leading and trailing white space is removed and the address is case folded
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_alias_index_normalize_utf8_string(
+     uint8_t *utf8_string,
+     size_t *utf8_string_length,
+     libcerror_error_t **error )
+{
+	static char *function = "libnk2_alias_index_normalize_utf8_string";
+	size_t string_end     = 0;
+	size_t string_index   = 0;
+	size_t string_start   = 0;
+
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_length == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string length.",
+		 function );
+
+		return( -1 );
+	}
+	string_end = *utf8_string_length;
+
+	while( ( string_end > 0 )
+	    && ( ( utf8_string[ string_end - 1 ] == (uint8_t) ' ' )
+	     ||  ( utf8_string[ string_end - 1 ] == (uint8_t) '\t' ) ) )
+	{
+		string_end--;
+	}
+	while( ( string_start < string_end )
+	    && ( ( utf8_string[ string_start ] == (uint8_t) ' ' )
+	     ||  ( utf8_string[ string_start ] == (uint8_t) '\t' ) ) )
+	{
+		string_start++;
+	}
+	/* The source and destination overlap hence the string is moved byte by byte
+	 */
+	if( string_start > 0 )
+	{
+		for( string_index = string_start;
+		     string_index < string_end;
+		     string_index++ )
+		{
+			utf8_string[ string_index - string_start ] = utf8_string[ string_index ];
+		}
+	}
+	*utf8_string_length = string_end - string_start;
+
+	libnk2_index_case_fold_utf8_string(
+	 utf8_string,
+	 *utf8_string_length );
+
+	return( 1 );
+}
+
+/* Compares the data of two keys
+ * Returns a negative value if the first key sorts before the second key, 0 if equal or a positive value otherwise
+ */
+int libnk2_alias_index_key_data_compare(
+     const uint8_t *first_key_data,
+     size_t first_key_data_size,
+     const uint8_t *second_key_data,
+     size_t second_key_data_size )
+{
+	size_t compare_size = 0;
+	int result          = 0;
+
+	compare_size = first_key_data_size;
+
+	if( compare_size > second_key_data_size )
+	{
+		compare_size = second_key_data_size;
+	}
+	if( compare_size > 0 )
+	{
+		result = memory_compare(
+		          first_key_data,
+		          second_key_data,
+		          compare_size );
+	}
+	if( result != 0 )
+	{
+		return( result );
+	}
+	if( first_key_data_size < second_key_data_size )
+	{
+		return( -1 );
+	}
+	else if( first_key_data_size > second_key_data_size )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Reads the segment footer at the end of the data
+ * The data must start at the start of the alias index
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_alias_index_read_segment_footer(
+     libnk2_alias_index_segment_t *segment,
+     const uint8_t *data,
+     size_t data_size,
+     size_t *segment_size,
+     libcerror_error_t **error )
+{
+	const nk2_alias_index_segment_footer_t *segment_footer = NULL;
+	const uint8_t *segment_data                            = NULL;
+	static char *function                                  = "libnk2_alias_index_read_segment_footer";
+	uint64_t calculated_segment_size                       = 0;
+	uint64_t safe_segment_size                             = 0;
+	uint32_t format_version                                = 0;
+	size_t segment_data_offset                             = 0;
+
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < sizeof( nk2_alias_index_segment_footer_t ) )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment size.",
+		 function );
+
+		return( -1 );
+	}
+	segment_footer = (const nk2_alias_index_segment_footer_t *) &( data[ data_size - sizeof( nk2_alias_index_segment_footer_t ) ] );
+
+	if( memory_compare(
+	     segment_footer->signature,
+	     nk2_alias_index_signature,
+	     8 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported segment footer signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 segment_footer->format_version,
+	 format_version );
+
+	if( format_version != LIBNK2_ALIAS_INDEX_FORMAT_VERSION )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported format version: %" PRIu32 ".",
+		 function,
+		 format_version );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 segment_footer->first_file_identifier,
+	 segment->first_file_identifier );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 segment_footer->number_of_files,
+	 segment->number_of_files );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 segment_footer->number_of_keys,
+	 segment->number_of_keys );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 segment_footer->number_of_postings,
+	 segment->number_of_postings );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 segment_footer->file_names_data_size,
+	 segment->file_names_data_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 segment_footer->keys_data_size,
+	 segment->keys_data_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 segment_footer->segment_size,
+	 safe_segment_size );
+
+	/* The size of every part is less than 2^36 hence the sum cannot overflow
+	 */
+	calculated_segment_size = ( (uint64_t) segment->number_of_files * sizeof( nk2_alias_index_file_entry_t ) )
+	                        + ( ( (uint64_t) segment->file_names_data_size + 7 ) & ~( (uint64_t) 7 ) )
+	                        + ( (uint64_t) segment->number_of_keys * sizeof( nk2_alias_index_key_entry_t ) )
+	                        + ( ( (uint64_t) segment->keys_data_size + 7 ) & ~( (uint64_t) 7 ) )
+	                        + ( (uint64_t) segment->number_of_postings * sizeof( nk2_alias_index_posting_t ) )
+	                        + sizeof( nk2_alias_index_segment_footer_t );
+
+	if( ( safe_segment_size != calculated_segment_size )
+	 || ( safe_segment_size > (uint64_t) data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	segment_data = &( data[ data_size - (size_t) safe_segment_size ] );
+
+	segment->file_entries = segment_data;
+	segment_data_offset   = (size_t) segment->number_of_files * sizeof( nk2_alias_index_file_entry_t );
+
+	segment->file_names_data = &( segment_data[ segment_data_offset ] );
+	segment_data_offset     += ( (size_t) segment->file_names_data_size + 7 ) & ~( (size_t) 7 );
+
+	segment->key_entries = &( segment_data[ segment_data_offset ] );
+	segment_data_offset += (size_t) segment->number_of_keys * sizeof( nk2_alias_index_key_entry_t );
+
+	segment->keys_data   = &( segment_data[ segment_data_offset ] );
+	segment_data_offset += ( (size_t) segment->keys_data_size + 7 ) & ~( (size_t) 7 );
+
+	segment->postings = &( segment_data[ segment_data_offset ] );
+
+	*segment_size = (size_t) safe_segment_size;
+
+	return( 1 );
+}
+
+/* Opens an alias index stored in a buffer
+ * Only the segment footers are read, the tables are accessed in place
+ * hence the data is not copied and must remain valid until the alias index is closed
+ * This allows the data to be a memory mapped file
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_alias_index_open_data(
+     libnk2_alias_index_t *alias_index,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libnk2_alias_index_segment_t segment;
+
+	libnk2_alias_index_segment_t *segments              = NULL;
+	libnk2_internal_alias_index_t *internal_alias_index = NULL;
+	static char *function                               = "libnk2_alias_index_open_data";
+	size_t remaining_data_size                          = 0;
+	size_t segment_size                                 = 0;
+	uint32_t next_file_identifier                       = 0;
+	int number_of_segments                              = 0;
+	int segment_index                                   = 0;
+
+	if( alias_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid alias index.",
+		 function );
+
+		return( -1 );
+	}
+	internal_alias_index = (libnk2_internal_alias_index_t *) alias_index;
+
+	if( internal_alias_index->data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid alias index - data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < sizeof( nk2_alias_index_segment_footer_t ) )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The segments are chained from the end of the data, the first pass
+	 * determines the number of segments and the second pass stores them
+	 */
+	remaining_data_size = data_size;
+
+	while( remaining_data_size > 0 )
+	{
+		if( number_of_segments == INT_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of segments value exceeds maximum.",
+			 function );
+
+			goto on_error;
+		}
+		if( libnk2_alias_index_read_segment_footer(
+		     &segment,
+		     data,
+		     remaining_data_size,
+		     &segment_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read segment footer at offset: %" PRIzd ".",
+			 function,
+			 remaining_data_size - sizeof( nk2_alias_index_segment_footer_t ) );
+
+			goto on_error;
+		}
+		remaining_data_size -= segment_size;
+
+		number_of_segments++;
+	}
+	if( (size_t) number_of_segments > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libnk2_alias_index_segment_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of segments value exceeds maximum allocation size.",
+		 function );
+
+		goto on_error;
+	}
+	segments = (libnk2_alias_index_segment_t *) memory_allocate(
+	                                             sizeof( libnk2_alias_index_segment_t ) * number_of_segments );
+
+	if( segments == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segments.",
+		 function );
+
+		goto on_error;
+	}
+	remaining_data_size = data_size;
+
+	for( segment_index = number_of_segments - 1;
+	     segment_index >= 0;
+	     segment_index-- )
+	{
+		if( libnk2_alias_index_read_segment_footer(
+		     &( segments[ segment_index ] ),
+		     data,
+		     remaining_data_size,
+		     &segment_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read segment footer: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		remaining_data_size -= segment_size;
+	}
+	/* The file identifiers of the segments must be contiguous
+	 */
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		if( ( segments[ segment_index ].first_file_identifier != next_file_identifier )
+		 || ( segments[ segment_index ].number_of_files > ( UINT32_MAX - next_file_identifier ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid segment: %d - first file identifier value out of bounds.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		next_file_identifier += segments[ segment_index ].number_of_files;
+	}
+	internal_alias_index->data               = data;
+	internal_alias_index->data_size          = data_size;
+	internal_alias_index->segments           = segments;
+	internal_alias_index->number_of_segments = number_of_segments;
+	internal_alias_index->number_of_files    = next_file_identifier;
+
+	return( 1 );
+
+on_error:
+	if( segments != NULL )
+	{
+		memory_free(
+		 segments );
+	}
+	return( -1 );
+}
+
+/* Closes an alias index
+ * Returns 0 if successful or -1 on error
+ */
+int libnk2_alias_index_close(
+     libnk2_alias_index_t *alias_index,
+     libcerror_error_t **error )
+{
+	libnk2_internal_alias_index_t *internal_alias_index = NULL;
+	static char *function                               = "libnk2_alias_index_close";
+
+	if( alias_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid alias index.",
+		 function );
+
+		return( -1 );
+	}
+	internal_alias_index = (libnk2_internal_alias_index_t *) alias_index;
+
+	if( internal_alias_index->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid alias index - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_alias_index->segments != NULL )
+	{
+		memory_free(
+		 internal_alias_index->segments );
+	}
+	internal_alias_index->data               = NULL;
+	internal_alias_index->data_size          = 0;
+	internal_alias_index->segments           = NULL;
+	internal_alias_index->number_of_segments = 0;
+	internal_alias_index->number_of_files    = 0;
+
+	return( 0 );
+}
+
+/* Retrieves the number of segments
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_alias_index_get_number_of_segments(
+     libnk2_alias_index_t *alias_index,
+     int *number_of_segments,
+     libcerror_error_t **error )
+{
+	libnk2_internal_alias_index_t *internal_alias_index = NULL;
+	static char *function                               = "libnk2_alias_index_get_number_of_segments";
+
+	if( alias_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid alias index.",
+		 function );
+
+		return( -1 );
+	}
+	internal_alias_index = (libnk2_internal_alias_index_t *) alias_index;
+
+	if( number_of_segments == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of segments.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_segments = internal_alias_index->number_of_segments;
+
+	return( 1 );
+}
+
+/* Retrieves the number of files
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_alias_index_get_number_of_files(
+     libnk2_alias_index_t *alias_index,
+     uint32_t *number_of_files,
+     libcerror_error_t **error )
+{
+	libnk2_internal_alias_index_t *internal_alias_index = NULL;
+	static char *function                               = "libnk2_alias_index_get_number_of_files";
+
+	if( alias_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid alias index.",
+		 function );
+
+		return( -1 );
+	}
+	internal_alias_index = (libnk2_internal_alias_index_t *) alias_index;
+
+	if( number_of_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of files.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_files = internal_alias_index->number_of_files;
+
+	return( 1 );
+}
+
+/* Retrieves the segment and the file entry of a specific file identifier
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_alias_index_get_file_entry(
+     libnk2_internal_alias_index_t *internal_alias_index,
+     uint32_t file_identifier,
+     libnk2_alias_index_segment_t **segment,
+     const uint8_t **file_entry,
+     libcerror_error_t **error )
+{
+	libnk2_alias_index_segment_t *safe_segment = NULL;
+	static char *function                      = "libnk2_alias_index_get_file_entry";
+	int first_segment_index                    = 0;
+	int last_segment_index                     = 0;
+	int segment_index                          = 0;
+
+	if( internal_alias_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid alias index.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_identifier >= internal_alias_index->number_of_files )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file identifier value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	/* Find the last segment with a first file identifier less than or equal to the file identifier
+	 */
+	last_segment_index = internal_alias_index->number_of_segments - 1;
+
+	while( first_segment_index < last_segment_index )
+	{
+		segment_index = first_segment_index + ( ( last_segment_index - first_segment_index + 1 ) / 2 );
+
+		if( internal_alias_index->segments[ segment_index ].first_file_identifier <= file_identifier )
+		{
+			first_segment_index = segment_index;
+		}
+		else
+		{
+			last_segment_index = segment_index - 1;
+		}
+	}
+	safe_segment = &( internal_alias_index->segments[ first_segment_index ] );
+
+	*segment    = safe_segment;
+	*file_entry = &( safe_segment->file_entries[ ( file_identifier - safe_segment->first_file_identifier ) * sizeof( nk2_alias_index_file_entry_t ) ] );
+
+	return( 1 );
+}
+
+/* Retrieves the modification date and time of a specific file
+ * The returned time is a 64-bit version of a filetime value
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_alias_index_get_file_modification_time(
+     libnk2_alias_index_t *alias_index,
+     uint32_t file_identifier,
+     uint64_t *filetime,
+     libcerror_error_t **error )
+{
+	libnk2_alias_index_segment_t *segment = NULL;
+	const uint8_t *file_entry             = NULL;
+	static char *function                 = "libnk2_alias_index_get_file_modification_time";
+
+	if( filetime == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filetime.",
+		 function );
+
+		return( -1 );
+	}
+	if( libnk2_alias_index_get_file_entry(
+	     (libnk2_internal_alias_index_t *) alias_index,
+	     file_identifier,
+	     &segment,
+	     &file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file entry: %" PRIu32 ".",
+		 function,
+		 file_identifier );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (nk2_alias_index_file_entry_t *) file_entry )->modification_time,
+	 *filetime );
+
+	return( 1 );
+}
+
+/* Retrieves the size of the UTF-8 encoded name of a specific file
+ * The returned size includes the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_alias_index_get_utf8_file_name_size(
+     libnk2_alias_index_t *alias_index,
+     uint32_t file_identifier,
+     size_t *utf8_string_size,
+     libcerror_error_t **error )
+{
+	libnk2_alias_index_segment_t *segment = NULL;
+	const uint8_t *file_entry             = NULL;
+	static char *function                 = "libnk2_alias_index_get_utf8_file_name_size";
+	uint32_t name_offset                  = 0;
+	uint32_t name_size                    = 0;
+
+	if( utf8_string_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libnk2_alias_index_get_file_entry(
+	     (libnk2_internal_alias_index_t *) alias_index,
+	     file_identifier,
+	     &segment,
+	     &file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file entry: %" PRIu32 ".",
+		 function,
+		 file_identifier );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (nk2_alias_index_file_entry_t *) file_entry )->name_offset,
+	 name_offset );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (nk2_alias_index_file_entry_t *) file_entry )->name_size,
+	 name_size );
+
+	if( ( name_offset > segment->file_names_data_size )
+	 || ( name_size > ( segment->file_names_data_size - name_offset ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file entry: %" PRIu32 " - name value out of bounds.",
+		 function,
+		 file_identifier );
+
+		return( -1 );
+	}
+	*utf8_string_size = (size_t) name_size + 1;
+
+	return( 1 );
+}
+
+/* Retrieves the UTF-8 encoded name of a specific file
+ * The size should include the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_alias_index_get_utf8_file_name(
+     libnk2_alias_index_t *alias_index,
+     uint32_t file_identifier,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
+     libcerror_error_t **error )
+{
+	libnk2_alias_index_segment_t *segment = NULL;
+	const uint8_t *file_entry             = NULL;
+	static char *function                 = "libnk2_alias_index_get_utf8_file_name";
+	size_t name_size                      = 0;
+	uint32_t name_offset                  = 0;
+
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( libnk2_alias_index_get_utf8_file_name_size(
+	     alias_index,
+	     file_identifier,
+	     &name_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 file name size: %" PRIu32 ".",
+		 function,
+		 file_identifier );
+
+		return( -1 );
+	}
+	if( utf8_string_size < name_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: UTF-8 string size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	/* The file entry was validated by libnk2_alias_index_get_utf8_file_name_size
+	 */
+	if( libnk2_alias_index_get_file_entry(
+	     (libnk2_internal_alias_index_t *) alias_index,
+	     file_identifier,
+	     &segment,
+	     &file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file entry: %" PRIu32 ".",
+		 function,
+		 file_identifier );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (nk2_alias_index_file_entry_t *) file_entry )->name_offset,
+	 name_offset );
+
+	name_size -= 1;
+
+	if( name_size > 0 )
+	{
+		if( memory_copy(
+		     utf8_string,
+		     &( segment->file_names_data[ name_offset ] ),
+		     name_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy UTF-8 file name.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	utf8_string[ name_size ] = 0;
+
+	return( 1 );
+}
+
+/* Searches the alias index for the items that contain a specific UTF-8 formatted address
+ * The address is normalized before it is matched
+ * The postings are stored in ascending file identifier and item index order
+ * and are limited to maximum_number_of_postings
+ * Returns 1 if successful, 0 if no matching items were found or -1 on error
+ */
+int libnk2_alias_index_search_utf8_address(
+     libnk2_alias_index_t *alias_index,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     uint32_t *file_identifiers,
+     uint32_t *item_indexes,
+     int maximum_number_of_postings,
+     int *number_of_postings,
+     libcerror_error_t **error )
+{
+	uint8_t key_data[ 256 ];
+
+	libnk2_alias_index_segment_t *segment               = NULL;
+	libnk2_internal_alias_index_t *internal_alias_index = NULL;
+	const nk2_alias_index_key_entry_t *key_entry        = NULL;
+	const nk2_alias_index_posting_t *posting            = NULL;
+	uint8_t *key                                        = NULL;
+	uint8_t *allocated_key                              = NULL;
+	static char *function                               = "libnk2_alias_index_search_utf8_address";
+	size_t key_length                                   = 0;
+	uint32_t file_index                                 = 0;
+	uint32_t first_key_index                            = 0;
+	uint32_t first_posting_index                        = 0;
+	uint32_t key_index                                  = 0;
+	uint32_t key_offset                                 = 0;
+	uint32_t key_size                                   = 0;
+	uint32_t last_key_index                             = 0;
+	uint32_t number_of_key_postings                     = 0;
+	uint32_t posting_index                              = 0;
+	int result                                          = 0;
+	int safe_number_of_postings                         = 0;
+	int segment_index                                   = 0;
+
+	if( alias_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid alias index.",
+		 function );
+
+		return( -1 );
+	}
+	internal_alias_index = (libnk2_internal_alias_index_t *) alias_index;
+
+	if( internal_alias_index->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid alias index - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_length > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-8 string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_identifiers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file identifiers.",
+		 function );
+
+		return( -1 );
+	}
+	if( item_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item indexes.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_postings < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of postings value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_postings == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of postings.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_postings = 0;
+
+	if( utf8_string_length == 0 )
+	{
+		return( 0 );
+	}
+	if( utf8_string_length <= 256 )
+	{
+		key = key_data;
+	}
+	else
+	{
+		allocated_key = (uint8_t *) memory_allocate(
+		                             sizeof( uint8_t ) * utf8_string_length );
+
+		if( allocated_key == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create key.",
+			 function );
+
+			return( -1 );
+		}
+		key = allocated_key;
+	}
+	if( memory_copy(
+	     key,
+	     utf8_string,
+	     utf8_string_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy key.",
+		 function );
+
+		goto on_error;
+	}
+	key_length = utf8_string_length;
+
+	if( libnk2_alias_index_normalize_utf8_string(
+	     key,
+	     &key_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to normalize key.",
+		 function );
+
+		goto on_error;
+	}
+	for( segment_index = 0;
+	     segment_index < internal_alias_index->number_of_segments;
+	     segment_index++ )
+	{
+		segment = &( internal_alias_index->segments[ segment_index ] );
+
+		first_key_index = 0;
+		last_key_index  = segment->number_of_keys;
+
+		/* Find the first key that is greater than or equal to the normalized address
+		 */
+		while( first_key_index < last_key_index )
+		{
+			key_index = first_key_index + ( ( last_key_index - first_key_index ) / 2 );
+			key_entry = (const nk2_alias_index_key_entry_t *) &( segment->key_entries[ key_index * sizeof( nk2_alias_index_key_entry_t ) ] );
+
+			byte_stream_copy_to_uint32_little_endian(
+			 key_entry->key_offset,
+			 key_offset );
+
+			byte_stream_copy_to_uint32_little_endian(
+			 key_entry->key_size,
+			 key_size );
+
+			if( ( key_offset > segment->keys_data_size )
+			 || ( key_size > ( segment->keys_data_size - key_offset ) ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid segment: %d key entry: %" PRIu32 " - key value out of bounds.",
+				 function,
+				 segment_index,
+				 key_index );
+
+				goto on_error;
+			}
+			if( libnk2_alias_index_key_data_compare(
+			     &( segment->keys_data[ key_offset ] ),
+			     (size_t) key_size,
+			     key,
+			     key_length ) < 0 )
+			{
+				first_key_index = key_index + 1;
+			}
+			else
+			{
+				last_key_index = key_index;
+			}
+		}
+		if( first_key_index >= segment->number_of_keys )
+		{
+			continue;
+		}
+		key_entry = (const nk2_alias_index_key_entry_t *) &( segment->key_entries[ first_key_index * sizeof( nk2_alias_index_key_entry_t ) ] );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 key_entry->key_offset,
+		 key_offset );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 key_entry->key_size,
+		 key_size );
+
+		if( ( key_offset > segment->keys_data_size )
+		 || ( key_size > ( segment->keys_data_size - key_offset ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid segment: %d key entry: %" PRIu32 " - key value out of bounds.",
+			 function,
+			 segment_index,
+			 first_key_index );
+
+			goto on_error;
+		}
+		if( libnk2_alias_index_key_data_compare(
+		     &( segment->keys_data[ key_offset ] ),
+		     (size_t) key_size,
+		     key,
+		     key_length ) != 0 )
+		{
+			continue;
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 key_entry->first_posting_index,
+		 first_posting_index );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 key_entry->number_of_postings,
+		 number_of_key_postings );
+
+		if( ( first_posting_index > segment->number_of_postings )
+		 || ( number_of_key_postings > ( segment->number_of_postings - first_posting_index ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid segment: %d key entry: %" PRIu32 " - postings value out of bounds.",
+			 function,
+			 segment_index,
+			 first_key_index );
+
+			goto on_error;
+		}
+		result = 1;
+
+		for( posting_index = first_posting_index;
+		     posting_index < ( first_posting_index + number_of_key_postings );
+		     posting_index++ )
+		{
+			if( safe_number_of_postings >= maximum_number_of_postings )
+			{
+				break;
+			}
+			posting = (const nk2_alias_index_posting_t *) &( segment->postings[ posting_index * sizeof( nk2_alias_index_posting_t ) ] );
+
+			byte_stream_copy_to_uint32_little_endian(
+			 posting->file_index,
+			 file_index );
+
+			if( file_index >= segment->number_of_files )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid segment: %d posting: %" PRIu32 " - file index value out of bounds.",
+				 function,
+				 segment_index,
+				 posting_index );
+
+				goto on_error;
+			}
+			file_identifiers[ safe_number_of_postings ] = segment->first_file_identifier + file_index;
+
+			byte_stream_copy_to_uint32_little_endian(
+			 posting->item_index,
+			 item_indexes[ safe_number_of_postings ] );
+
+			safe_number_of_postings++;
+		}
+	}
+	if( allocated_key != NULL )
+	{
+		memory_free(
+		 allocated_key );
+	}
+	*number_of_postings = safe_number_of_postings;
+
+	return( result );
+
+on_error:
+	if( allocated_key != NULL )
+	{
+		memory_free(
+		 allocated_key );
+	}
+	return( -1 );
+}
+
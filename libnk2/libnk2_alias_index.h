@@ -0,0 +1,213 @@
+/*
+ * Alias index functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBNK2_ALIAS_INDEX_H )
+#define _LIBNK2_ALIAS_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libnk2_extern.h"
+#include "libnk2_libcerror.h"
+#include "libnk2_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The version of the alias index format
+ */
+#define LIBNK2_ALIAS_INDEX_FORMAT_VERSION		1
+
+extern const uint8_t nk2_alias_index_signature[ 8 ];
+
+typedef struct libnk2_alias_index_segment libnk2_alias_index_segment_t;
+
+struct libnk2_alias_index_segment
+{
+	/* The file entries
+	 */
+	const uint8_t *file_entries;
+
+	/* The file names data
+	 */
+	const uint8_t *file_names_data;
+
+	/* The key entries
+	 */
+	const uint8_t *key_entries;
+
+	/* The keys data
+	 */
+	const uint8_t *keys_data;
+
+	/* The postings
+	 */
+	const uint8_t *postings;
+
+	/* The first file identifier
+	 */
+	uint32_t first_file_identifier;
+
+	/* The number of files
+	 */
+	uint32_t number_of_files;
+
+	/* The number of keys
+	 */
+	uint32_t number_of_keys;
+
+	/* The number of postings
+	 */
+	uint32_t number_of_postings;
+
+	/* The file names data size
+	 */
+	uint32_t file_names_data_size;
+
+	/* The keys data size
+	 */
+	uint32_t keys_data_size;
+};
+
+typedef struct libnk2_internal_alias_index libnk2_internal_alias_index_t;
+
+struct libnk2_internal_alias_index
+{
+	/* The data, which is not owned by the alias index
+	 */
+	const uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The segments, stored in the order they were appended
+	 */
+	libnk2_alias_index_segment_t *segments;
+
+	/* The number of segments
+	 */
+	int number_of_segments;
+
+	/* The number of files
+	 */
+	uint32_t number_of_files;
+};
+
+LIBNK2_EXTERN \
+int libnk2_alias_index_initialize(
+     libnk2_alias_index_t **alias_index,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_alias_index_free(
+     libnk2_alias_index_t **alias_index,
+     libcerror_error_t **error );
+
+int libnk2_alias_index_normalize_utf8_string(
+     uint8_t *utf8_string,
+     size_t *utf8_string_length,
+     libcerror_error_t **error );
+
+int libnk2_alias_index_key_data_compare(
+     const uint8_t *first_key_data,
+     size_t first_key_data_size,
+     const uint8_t *second_key_data,
+     size_t second_key_data_size );
+
+int libnk2_alias_index_read_segment_footer(
+     libnk2_alias_index_segment_t *segment,
+     const uint8_t *data,
+     size_t data_size,
+     size_t *segment_size,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_alias_index_open_data(
+     libnk2_alias_index_t *alias_index,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_alias_index_close(
+     libnk2_alias_index_t *alias_index,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_alias_index_get_number_of_segments(
+     libnk2_alias_index_t *alias_index,
+     int *number_of_segments,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_alias_index_get_number_of_files(
+     libnk2_alias_index_t *alias_index,
+     uint32_t *number_of_files,
+     libcerror_error_t **error );
+
+int libnk2_alias_index_get_file_entry(
+     libnk2_internal_alias_index_t *internal_alias_index,
+     uint32_t file_identifier,
+     libnk2_alias_index_segment_t **segment,
+     const uint8_t **file_entry,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_alias_index_get_file_modification_time(
+     libnk2_alias_index_t *alias_index,
+     uint32_t file_identifier,
+     uint64_t *filetime,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_alias_index_get_utf8_file_name_size(
+     libnk2_alias_index_t *alias_index,
+     uint32_t file_identifier,
+     size_t *utf8_string_size,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_alias_index_get_utf8_file_name(
+     libnk2_alias_index_t *alias_index,
+     uint32_t file_identifier,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_alias_index_search_utf8_address(
+     libnk2_alias_index_t *alias_index,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     uint32_t *file_identifiers,
+     uint32_t *item_indexes,
+     int maximum_number_of_postings,
+     int *number_of_postings,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBNK2_ALIAS_INDEX_H ) */
+
@@ -0,0 +1,1224 @@
+/*
+ * Alias index writer functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "libnk2_alias_index.h"
+#include "libnk2_alias_index_writer.h"
+#include "libnk2_file.h"
+#include "libnk2_index.h"
+#include "libnk2_item.h"
+#include "libnk2_libcdata.h"
+#include "libnk2_libcerror.h"
+#include "libnk2_mapi.h"
+#include "libnk2_mapi_value.h"
+#include "libnk2_record_entry.h"
+
+#include "nk2_alias_index.h"
+
+/* Creates an alias index writer
+ * Make sure the value alias_index_writer is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_alias_index_writer_initialize(
+     libnk2_alias_index_writer_t **alias_index_writer,
+     libcerror_error_t **error )
+{
+	libnk2_internal_alias_index_writer_t *internal_alias_index_writer = NULL;
+	static char *function                                             = "libnk2_alias_index_writer_initialize";
+
+	if( alias_index_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid alias index writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *alias_index_writer != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid alias index writer value already set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_alias_index_writer = memory_allocate_structure(
+	                               libnk2_internal_alias_index_writer_t );
+
+	if( internal_alias_index_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create alias index writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     internal_alias_index_writer,
+	     0,
+	     sizeof( libnk2_internal_alias_index_writer_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear alias index writer.",
+		 function );
+
+		memory_free(
+		 internal_alias_index_writer );
+
+		return( -1 );
+	}
+	*alias_index_writer = (libnk2_alias_index_writer_t *) internal_alias_index_writer;
+
+	return( 1 );
+}
+
+/* Frees an alias index writer
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_alias_index_writer_free(
+     libnk2_alias_index_writer_t **alias_index_writer,
+     libcerror_error_t **error )
+{
+	libnk2_internal_alias_index_writer_t *internal_alias_index_writer = NULL;
+	static char *function                                             = "libnk2_alias_index_writer_free";
+
+	if( alias_index_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid alias index writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *alias_index_writer != NULL )
+	{
+		internal_alias_index_writer = (libnk2_internal_alias_index_writer_t *) *alias_index_writer;
+		*alias_index_writer         = NULL;
+
+		if( internal_alias_index_writer->keys_data != NULL )
+		{
+			memory_free(
+			 internal_alias_index_writer->keys_data );
+		}
+		if( internal_alias_index_writer->postings != NULL )
+		{
+			memory_free(
+			 internal_alias_index_writer->postings );
+		}
+		if( internal_alias_index_writer->file_names_data != NULL )
+		{
+			memory_free(
+			 internal_alias_index_writer->file_names_data );
+		}
+		if( internal_alias_index_writer->files != NULL )
+		{
+			memory_free(
+			 internal_alias_index_writer->files );
+		}
+		memory_free(
+		 internal_alias_index_writer );
+	}
+	return( 1 );
+}
+
+/* Clears an alias index writer
+ * The files and postings are removed but the allocated buffers are retained for reuse
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_alias_index_writer_clear(
+     libnk2_alias_index_writer_t *alias_index_writer,
+     libcerror_error_t **error )
+{
+	libnk2_internal_alias_index_writer_t *internal_alias_index_writer = NULL;
+	static char *function                                             = "libnk2_alias_index_writer_clear";
+
+	if( alias_index_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid alias index writer.",
+		 function );
+
+		return( -1 );
+	}
+	internal_alias_index_writer = (libnk2_internal_alias_index_writer_t *) alias_index_writer;
+
+	internal_alias_index_writer->number_of_files             = 0;
+	internal_alias_index_writer->file_names_data_size        = 0;
+	internal_alias_index_writer->number_of_postings          = 0;
+	internal_alias_index_writer->keys_data_size              = 0;
+	internal_alias_index_writer->postings_sorted             = 0;
+	internal_alias_index_writer->number_of_distinct_keys     = 0;
+	internal_alias_index_writer->distinct_keys_data_size     = 0;
+	internal_alias_index_writer->number_of_distinct_postings = 0;
+
+	return( 1 );
+}
+
+/* Resizes a buffer to at least a required size
+ * The buffer is grown exponentially to reduce the number of reallocations
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_alias_index_writer_resize_buffer(
+     uint8_t **buffer,
+     size_t *allocated_size,
+     size_t required_size,
+     libcerror_error_t **error )
+{
+	uint8_t *reallocated_buffer = NULL;
+	static char *function       = "libnk2_alias_index_writer_resize_buffer";
+	size_t new_allocated_size   = 0;
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocated_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocated size.",
+		 function );
+
+		return( -1 );
+	}
+	if( required_size <= *allocated_size )
+	{
+		return( 1 );
+	}
+	if( required_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid required size value exceeds maximum allocation size.",
+		 function );
+
+		return( -1 );
+	}
+	new_allocated_size = 4096;
+
+	if( *allocated_size > new_allocated_size )
+	{
+		new_allocated_size = *allocated_size;
+	}
+	while( new_allocated_size < required_size )
+	{
+		if( new_allocated_size > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / 2 ) )
+		{
+			new_allocated_size = required_size;
+
+			break;
+		}
+		new_allocated_size *= 2;
+	}
+	reallocated_buffer = (uint8_t *) memory_reallocate(
+	                                  *buffer,
+	                                  sizeof( uint8_t ) * new_allocated_size );
+
+	if( reallocated_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize buffer.",
+		 function );
+
+		return( -1 );
+	}
+	*buffer         = reallocated_buffer;
+	*allocated_size = new_allocated_size;
+
+	return( 1 );
+}
+
+/* Adds the email addresses of the items of a file
+ * The file must be open, the file is assigned the next file index of the segment
+ * The file name is stored as-is and can be used to identify the file in search results
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_alias_index_writer_add_file(
+     libnk2_alias_index_writer_t *alias_index_writer,
+     libnk2_file_t *file,
+     const uint8_t *utf8_file_name,
+     size_t utf8_file_name_length,
+     libcerror_error_t **error )
+{
+	libnk2_alias_index_writer_file_t *writer_file                     = NULL;
+	libnk2_alias_index_writer_posting_t *posting                      = NULL;
+	libnk2_internal_alias_index_writer_t *internal_alias_index_writer = NULL;
+	libnk2_internal_file_t *internal_file                             = NULL;
+	libnk2_internal_item_t *internal_item                             = NULL;
+	libnk2_internal_record_entry_t *internal_record_entry             = NULL;
+	uint8_t *buffer                                                   = NULL;
+	static char *function                                             = "libnk2_alias_index_writer_add_file";
+	size_t file_names_data_size                                       = 0;
+	size_t key_length                                                 = 0;
+	size_t keys_data_size                                             = 0;
+	size_t utf8_string_size                                           = 0;
+	uint64_t modification_time                                        = 0;
+	uint32_t number_of_postings                                       = 0;
+	int entry_index                                                   = 0;
+	int item_index                                                    = 0;
+	int number_of_entries                                             = 0;
+	int number_of_items                                               = 0;
+	int result                                                        = 0;
+
+	if( alias_index_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid alias index writer.",
+		 function );
+
+		return( -1 );
+	}
+	internal_alias_index_writer = (libnk2_internal_alias_index_writer_t *) alias_index_writer;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libnk2_internal_file_t *) file;
+
+	if( internal_file->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( utf8_file_name == NULL )
+	 && ( utf8_file_name_length > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 file name.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_alias_index_writer->number_of_files == UINT32_MAX )
+	 || ( utf8_file_name_length > (size_t) ( UINT32_MAX - internal_alias_index_writer->file_names_data_size ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid alias index writer - number of files or file names data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libnk2_file_get_modification_time(
+	     file,
+	     &modification_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve modification time.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_file->items_array,
+	     &number_of_items,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of items.",
+		 function );
+
+		return( -1 );
+	}
+	/* The sizes are restored on error so that a partially added file is removed
+	 */
+	file_names_data_size = internal_alias_index_writer->file_names_data_size;
+	keys_data_size       = internal_alias_index_writer->keys_data_size;
+	number_of_postings   = internal_alias_index_writer->number_of_postings;
+
+	buffer = (uint8_t *) internal_alias_index_writer->files;
+
+	result = libnk2_alias_index_writer_resize_buffer(
+	          &buffer,
+	          &( internal_alias_index_writer->files_allocated_size ),
+	          sizeof( libnk2_alias_index_writer_file_t ) * ( (size_t) internal_alias_index_writer->number_of_files + 1 ),
+	          error );
+
+	internal_alias_index_writer->files = (libnk2_alias_index_writer_file_t *) buffer;
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize files.",
+		 function );
+
+		goto on_error;
+	}
+	if( libnk2_alias_index_writer_resize_buffer(
+	     &( internal_alias_index_writer->file_names_data ),
+	     &( internal_alias_index_writer->file_names_data_allocated_size ),
+	     file_names_data_size + utf8_file_name_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize file names data.",
+		 function );
+
+		goto on_error;
+	}
+	if( utf8_file_name_length > 0 )
+	{
+		if( memory_copy(
+		     &( internal_alias_index_writer->file_names_data[ file_names_data_size ] ),
+		     utf8_file_name,
+		     utf8_file_name_length ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy file name.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( item_index = 0;
+	     item_index < number_of_items;
+	     item_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_file->items_array,
+		     item_index,
+		     (intptr_t **) &internal_item,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve item: %d.",
+			 function,
+			 item_index );
+
+			goto on_error;
+		}
+		if( internal_item == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing item: %d.",
+			 function,
+			 item_index );
+
+			goto on_error;
+		}
+		if( libcdata_array_get_number_of_entries(
+		     internal_item->entries_array,
+		     &number_of_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of entries of item: %d.",
+			 function,
+			 item_index );
+
+			goto on_error;
+		}
+		for( entry_index = 0;
+		     entry_index < number_of_entries;
+		     entry_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     internal_item->entries_array,
+			     entry_index,
+			     (intptr_t **) &internal_record_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve record entry: %d of item: %d.",
+				 function,
+				 entry_index,
+				 item_index );
+
+				goto on_error;
+			}
+			if( internal_record_entry->entry_type != LIBNK2_ENTRY_TYPE_EMAIL_ADDRESS )
+			{
+				continue;
+			}
+			result = libnk2_index_get_key_string_size(
+			          internal_record_entry,
+			          &utf8_string_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve key string size of record entry: %d of item: %d.",
+				 function,
+				 entry_index,
+				 item_index );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				continue;
+			}
+			if( ( internal_alias_index_writer->number_of_postings == UINT32_MAX )
+			 || ( utf8_string_size > (size_t) ( UINT32_MAX - internal_alias_index_writer->keys_data_size ) ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid alias index writer - number of postings or keys data size value exceeds maximum.",
+				 function );
+
+				goto on_error;
+			}
+			/* The end of string character is written by libnk2_mapi_value_get_data_as_utf8_string
+			 * but is not part of the key
+			 */
+			if( libnk2_alias_index_writer_resize_buffer(
+			     &( internal_alias_index_writer->keys_data ),
+			     &( internal_alias_index_writer->keys_data_allocated_size ),
+			     internal_alias_index_writer->keys_data_size + utf8_string_size + 1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+				 "%s: unable to resize keys data.",
+				 function );
+
+				goto on_error;
+			}
+			if( libnk2_mapi_value_get_data_as_utf8_string(
+			     internal_record_entry->value_type,
+			     internal_record_entry->value_data,
+			     internal_record_entry->value_data_size,
+			     internal_record_entry->ascii_codepage,
+			     &( internal_alias_index_writer->keys_data[ internal_alias_index_writer->keys_data_size ] ),
+			     utf8_string_size + 1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve UTF-8 string of record entry: %d of item: %d.",
+				 function,
+				 entry_index,
+				 item_index );
+
+				goto on_error;
+			}
+			key_length = utf8_string_size;
+
+			if( libnk2_alias_index_normalize_utf8_string(
+			     &( internal_alias_index_writer->keys_data[ internal_alias_index_writer->keys_data_size ] ),
+			     &key_length,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to normalize UTF-8 string of record entry: %d of item: %d.",
+				 function,
+				 entry_index,
+				 item_index );
+
+				goto on_error;
+			}
+			if( key_length == 0 )
+			{
+				continue;
+			}
+			buffer = (uint8_t *) internal_alias_index_writer->postings;
+
+			result = libnk2_alias_index_writer_resize_buffer(
+			          &buffer,
+			          &( internal_alias_index_writer->postings_allocated_size ),
+			          sizeof( libnk2_alias_index_writer_posting_t ) * ( (size_t) internal_alias_index_writer->number_of_postings + 1 ),
+			          error );
+
+			internal_alias_index_writer->postings = (libnk2_alias_index_writer_posting_t *) buffer;
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+				 "%s: unable to resize postings.",
+				 function );
+
+				goto on_error;
+			}
+			posting = &( internal_alias_index_writer->postings[ internal_alias_index_writer->number_of_postings ] );
+
+			posting->key_data   = NULL;
+			posting->key_offset = (uint32_t) internal_alias_index_writer->keys_data_size;
+			posting->key_size   = (uint32_t) key_length;
+			posting->file_index = internal_alias_index_writer->number_of_files;
+			posting->item_index = (uint32_t) item_index;
+
+			internal_alias_index_writer->keys_data_size     += key_length;
+			internal_alias_index_writer->number_of_postings += 1;
+		}
+	}
+	writer_file = &( internal_alias_index_writer->files[ internal_alias_index_writer->number_of_files ] );
+
+	writer_file->modification_time = modification_time;
+	writer_file->name_offset       = (uint32_t) file_names_data_size;
+	writer_file->name_size         = (uint32_t) utf8_file_name_length;
+
+	internal_alias_index_writer->file_names_data_size += utf8_file_name_length;
+	internal_alias_index_writer->number_of_files      += 1;
+	internal_alias_index_writer->postings_sorted       = 0;
+
+	return( 1 );
+
+on_error:
+	internal_alias_index_writer->file_names_data_size = file_names_data_size;
+	internal_alias_index_writer->keys_data_size       = keys_data_size;
+	internal_alias_index_writer->number_of_postings   = number_of_postings;
+
+	return( -1 );
+}
+
+/* Retrieves the number of files
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_alias_index_writer_get_number_of_files(
+     libnk2_alias_index_writer_t *alias_index_writer,
+     uint32_t *number_of_files,
+     libcerror_error_t **error )
+{
+	libnk2_internal_alias_index_writer_t *internal_alias_index_writer = NULL;
+	static char *function                                             = "libnk2_alias_index_writer_get_number_of_files";
+
+	if( alias_index_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid alias index writer.",
+		 function );
+
+		return( -1 );
+	}
+	internal_alias_index_writer = (libnk2_internal_alias_index_writer_t *) alias_index_writer;
+
+	if( number_of_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of files.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_files = internal_alias_index_writer->number_of_files;
+
+	return( 1 );
+}
+
+/* Compares two postings
+ * This function is used as the comparison function of qsort
+ * Returns a negative value if the first posting sorts before the second posting, 0 if equal or a positive value otherwise
+ */
+int libnk2_alias_index_writer_posting_compare(
+     const void *first_posting,
+     const void *second_posting )
+{
+	const libnk2_alias_index_writer_posting_t *first_writer_posting  = (const libnk2_alias_index_writer_posting_t *) first_posting;
+	const libnk2_alias_index_writer_posting_t *second_writer_posting = (const libnk2_alias_index_writer_posting_t *) second_posting;
+	int result                                                       = 0;
+
+	result = libnk2_alias_index_key_data_compare(
+	          first_writer_posting->key_data,
+	          (size_t) first_writer_posting->key_size,
+	          second_writer_posting->key_data,
+	          (size_t) second_writer_posting->key_size );
+
+	if( result != 0 )
+	{
+		return( result );
+	}
+	if( first_writer_posting->file_index < second_writer_posting->file_index )
+	{
+		return( -1 );
+	}
+	else if( first_writer_posting->file_index > second_writer_posting->file_index )
+	{
+		return( 1 );
+	}
+	if( first_writer_posting->item_index < second_writer_posting->item_index )
+	{
+		return( -1 );
+	}
+	else if( first_writer_posting->item_index > second_writer_posting->item_index )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Sorts the postings and determines the number of distinct keys and postings
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_alias_index_writer_sort_postings(
+     libnk2_internal_alias_index_writer_t *internal_alias_index_writer,
+     libcerror_error_t **error )
+{
+	libnk2_alias_index_writer_posting_t *posting          = NULL;
+	libnk2_alias_index_writer_posting_t *previous_posting = NULL;
+	static char *function                                 = "libnk2_alias_index_writer_sort_postings";
+	uint32_t posting_index                                = 0;
+
+	if( internal_alias_index_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid alias index writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_alias_index_writer->postings_sorted != 0 )
+	{
+		return( 1 );
+	}
+	internal_alias_index_writer->number_of_distinct_keys     = 0;
+	internal_alias_index_writer->distinct_keys_data_size     = 0;
+	internal_alias_index_writer->number_of_distinct_postings = 0;
+
+	/* The keys data is no longer resized hence the key data pointers remain valid
+	 */
+	for( posting_index = 0;
+	     posting_index < internal_alias_index_writer->number_of_postings;
+	     posting_index++ )
+	{
+		posting = &( internal_alias_index_writer->postings[ posting_index ] );
+
+		posting->key_data = &( internal_alias_index_writer->keys_data[ posting->key_offset ] );
+	}
+	if( internal_alias_index_writer->number_of_postings > 1 )
+	{
+		qsort(
+		 internal_alias_index_writer->postings,
+		 (size_t) internal_alias_index_writer->number_of_postings,
+		 sizeof( libnk2_alias_index_writer_posting_t ),
+		 &libnk2_alias_index_writer_posting_compare );
+	}
+	for( posting_index = 0;
+	     posting_index < internal_alias_index_writer->number_of_postings;
+	     posting_index++ )
+	{
+		posting = &( internal_alias_index_writer->postings[ posting_index ] );
+
+		if( ( previous_posting == NULL )
+		 || ( libnk2_alias_index_key_data_compare(
+		       previous_posting->key_data,
+		       (size_t) previous_posting->key_size,
+		       posting->key_data,
+		       (size_t) posting->key_size ) != 0 ) )
+		{
+			internal_alias_index_writer->number_of_distinct_keys     += 1;
+			internal_alias_index_writer->distinct_keys_data_size     += posting->key_size;
+			internal_alias_index_writer->number_of_distinct_postings += 1;
+		}
+		else if( ( previous_posting->file_index != posting->file_index )
+		      || ( previous_posting->item_index != posting->item_index ) )
+		{
+			internal_alias_index_writer->number_of_distinct_postings += 1;
+		}
+		previous_posting = posting;
+	}
+	internal_alias_index_writer->postings_sorted = 1;
+
+	return( 1 );
+}
+
+/* Retrieves the size of the segment that contains the files that were added
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_alias_index_writer_get_segment_size(
+     libnk2_alias_index_writer_t *alias_index_writer,
+     size_t *segment_size,
+     libcerror_error_t **error )
+{
+	libnk2_internal_alias_index_writer_t *internal_alias_index_writer = NULL;
+	static char *function                                             = "libnk2_alias_index_writer_get_segment_size";
+	uint64_t safe_segment_size                                        = 0;
+
+	if( alias_index_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid alias index writer.",
+		 function );
+
+		return( -1 );
+	}
+	internal_alias_index_writer = (libnk2_internal_alias_index_writer_t *) alias_index_writer;
+
+	if( segment_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libnk2_alias_index_writer_sort_postings(
+	     internal_alias_index_writer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to sort postings.",
+		 function );
+
+		return( -1 );
+	}
+	safe_segment_size = ( (uint64_t) internal_alias_index_writer->number_of_files * sizeof( nk2_alias_index_file_entry_t ) )
+	                  + ( ( (uint64_t) internal_alias_index_writer->file_names_data_size + 7 ) & ~( (uint64_t) 7 ) )
+	                  + ( (uint64_t) internal_alias_index_writer->number_of_distinct_keys * sizeof( nk2_alias_index_key_entry_t ) )
+	                  + ( ( (uint64_t) internal_alias_index_writer->distinct_keys_data_size + 7 ) & ~( (uint64_t) 7 ) )
+	                  + ( (uint64_t) internal_alias_index_writer->number_of_distinct_postings * sizeof( nk2_alias_index_posting_t ) )
+	                  + sizeof( nk2_alias_index_segment_footer_t );
+
+	if( safe_segment_size > (uint64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid segment size value exceeds maximum allocation size.",
+		 function );
+
+		return( -1 );
+	}
+	*segment_size = (size_t) safe_segment_size;
+
+	return( 1 );
+}
+
+/* Writes the segment that contains the files that were added to a buffer
+ * The first file identifier must be the number of files in the alias index the segment is appended to
+ * The writer is not cleared, use libnk2_alias_index_writer_clear to start a new segment
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_alias_index_writer_write_segment(
+     libnk2_alias_index_writer_t *alias_index_writer,
+     uint32_t first_file_identifier,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libnk2_alias_index_writer_file_t *writer_file                     = NULL;
+	libnk2_alias_index_writer_posting_t *posting                      = NULL;
+	libnk2_alias_index_writer_posting_t *previous_posting             = NULL;
+	libnk2_internal_alias_index_writer_t *internal_alias_index_writer = NULL;
+	nk2_alias_index_file_entry_t *file_entry                          = NULL;
+	nk2_alias_index_key_entry_t *key_entry                            = NULL;
+	nk2_alias_index_posting_t *segment_posting                        = NULL;
+	nk2_alias_index_segment_footer_t *segment_footer                  = NULL;
+	uint8_t *file_entries                                             = NULL;
+	uint8_t *file_names_data                                          = NULL;
+	uint8_t *key_entries                                              = NULL;
+	uint8_t *keys_data                                                = NULL;
+	uint8_t *postings                                                 = NULL;
+	static char *function                                             = "libnk2_alias_index_writer_write_segment";
+	size_t data_offset                                                = 0;
+	size_t keys_data_offset                                           = 0;
+	size_t segment_size                                               = 0;
+	uint32_t file_index                                               = 0;
+	uint32_t key_index                                                = 0;
+	uint32_t number_of_key_postings                                   = 0;
+	uint32_t posting_index                                            = 0;
+	uint32_t segment_posting_index                                    = 0;
+
+	if( alias_index_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid alias index writer.",
+		 function );
+
+		return( -1 );
+	}
+	internal_alias_index_writer = (libnk2_internal_alias_index_writer_t *) alias_index_writer;
+
+	if( internal_alias_index_writer->number_of_files > ( UINT32_MAX - first_file_identifier ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid first file identifier value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libnk2_alias_index_writer_get_segment_size(
+	     alias_index_writer,
+	     &segment_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment size.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size < segment_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	/* The padding is cleared by clearing the segment
+	 */
+	if( memory_set(
+	     data,
+	     0,
+	     segment_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data.",
+		 function );
+
+		return( -1 );
+	}
+	file_entries = data;
+	data_offset  = (size_t) internal_alias_index_writer->number_of_files * sizeof( nk2_alias_index_file_entry_t );
+
+	file_names_data = &( data[ data_offset ] );
+	data_offset    += ( internal_alias_index_writer->file_names_data_size + 7 ) & ~( (size_t) 7 );
+
+	key_entries  = &( data[ data_offset ] );
+	data_offset += (size_t) internal_alias_index_writer->number_of_distinct_keys * sizeof( nk2_alias_index_key_entry_t );
+
+	keys_data    = &( data[ data_offset ] );
+	data_offset += ( internal_alias_index_writer->distinct_keys_data_size + 7 ) & ~( (size_t) 7 );
+
+	postings = &( data[ data_offset ] );
+
+	for( file_index = 0;
+	     file_index < internal_alias_index_writer->number_of_files;
+	     file_index++ )
+	{
+		writer_file = &( internal_alias_index_writer->files[ file_index ] );
+		file_entry  = (nk2_alias_index_file_entry_t *) &( file_entries[ file_index * sizeof( nk2_alias_index_file_entry_t ) ] );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 file_entry->modification_time,
+		 writer_file->modification_time );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 file_entry->name_offset,
+		 writer_file->name_offset );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 file_entry->name_size,
+		 writer_file->name_size );
+	}
+	if( internal_alias_index_writer->file_names_data_size > 0 )
+	{
+		if( memory_copy(
+		     file_names_data,
+		     internal_alias_index_writer->file_names_data,
+		     internal_alias_index_writer->file_names_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy file names data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* The postings are sorted by key hence the postings of a key are contiguous
+	 */
+	for( posting_index = 0;
+	     posting_index < internal_alias_index_writer->number_of_postings;
+	     posting_index++ )
+	{
+		posting = &( internal_alias_index_writer->postings[ posting_index ] );
+
+		if( ( previous_posting == NULL )
+		 || ( libnk2_alias_index_key_data_compare(
+		       previous_posting->key_data,
+		       (size_t) previous_posting->key_size,
+		       posting->key_data,
+		       (size_t) posting->key_size ) != 0 ) )
+		{
+			if( key_entry != NULL )
+			{
+				byte_stream_copy_from_uint32_little_endian(
+				 key_entry->number_of_postings,
+				 number_of_key_postings );
+			}
+			key_entry = (nk2_alias_index_key_entry_t *) &( key_entries[ key_index * sizeof( nk2_alias_index_key_entry_t ) ] );
+
+			byte_stream_copy_from_uint32_little_endian(
+			 key_entry->key_offset,
+			 (uint32_t) keys_data_offset );
+
+			byte_stream_copy_from_uint32_little_endian(
+			 key_entry->key_size,
+			 posting->key_size );
+
+			byte_stream_copy_from_uint32_little_endian(
+			 key_entry->first_posting_index,
+			 segment_posting_index );
+
+			if( memory_copy(
+			     &( keys_data[ keys_data_offset ] ),
+			     posting->key_data,
+			     (size_t) posting->key_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy key: %" PRIu32 ".",
+				 function,
+				 key_index );
+
+				return( -1 );
+			}
+			keys_data_offset += posting->key_size;
+
+			key_index++;
+
+			number_of_key_postings = 0;
+		}
+		else if( ( previous_posting->file_index == posting->file_index )
+		      && ( previous_posting->item_index == posting->item_index ) )
+		{
+			continue;
+		}
+		segment_posting = (nk2_alias_index_posting_t *) &( postings[ segment_posting_index * sizeof( nk2_alias_index_posting_t ) ] );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 segment_posting->file_index,
+		 posting->file_index );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 segment_posting->item_index,
+		 posting->item_index );
+
+		segment_posting_index++;
+
+		number_of_key_postings++;
+
+		previous_posting = posting;
+	}
+	if( key_entry != NULL )
+	{
+		byte_stream_copy_from_uint32_little_endian(
+		 key_entry->number_of_postings,
+		 number_of_key_postings );
+	}
+	segment_footer = (nk2_alias_index_segment_footer_t *) &( data[ segment_size - sizeof( nk2_alias_index_segment_footer_t ) ] );
+
+	if( memory_copy(
+	     segment_footer->signature,
+	     nk2_alias_index_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 segment_footer->format_version,
+	 LIBNK2_ALIAS_INDEX_FORMAT_VERSION );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 segment_footer->first_file_identifier,
+	 first_file_identifier );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 segment_footer->number_of_files,
+	 internal_alias_index_writer->number_of_files );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 segment_footer->number_of_keys,
+	 internal_alias_index_writer->number_of_distinct_keys );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 segment_footer->number_of_postings,
+	 internal_alias_index_writer->number_of_distinct_postings );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 segment_footer->file_names_data_size,
+	 (uint32_t) internal_alias_index_writer->file_names_data_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 segment_footer->keys_data_size,
+	 (uint32_t) internal_alias_index_writer->distinct_keys_data_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 segment_footer->segment_size,
+	 (uint64_t) segment_size );
+
+	return( 1 );
+}
+
@@ -0,0 +1,209 @@
+/*
+ * Alias index writer functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBNK2_ALIAS_INDEX_WRITER_H )
+#define _LIBNK2_ALIAS_INDEX_WRITER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libnk2_extern.h"
+#include "libnk2_libcerror.h"
+#include "libnk2_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libnk2_alias_index_writer_file libnk2_alias_index_writer_file_t;
+
+struct libnk2_alias_index_writer_file
+{
+	/* The modification date and time
+	 */
+	uint64_t modification_time;
+
+	/* The offset of the name in the file names data
+	 */
+	uint32_t name_offset;
+
+	/* The size of the name
+	 */
+	uint32_t name_size;
+};
+
+typedef struct libnk2_alias_index_writer_posting libnk2_alias_index_writer_posting_t;
+
+struct libnk2_alias_index_writer_posting
+{
+	/* The key data, which is set before the postings are sorted
+	 */
+	const uint8_t *key_data;
+
+	/* The offset of the key in the keys data
+	 */
+	uint32_t key_offset;
+
+	/* The size of the key
+	 */
+	uint32_t key_size;
+
+	/* The index of the file
+	 */
+	uint32_t file_index;
+
+	/* The index of the item
+	 */
+	uint32_t item_index;
+};
+
+typedef struct libnk2_internal_alias_index_writer libnk2_internal_alias_index_writer_t;
+
+struct libnk2_internal_alias_index_writer
+{
+	/* The files
+	 */
+	libnk2_alias_index_writer_file_t *files;
+
+	/* The number of files
+	 */
+	uint32_t number_of_files;
+
+	/* The allocated size of the files
+	 */
+	size_t files_allocated_size;
+
+	/* The file names data
+	 */
+	uint8_t *file_names_data;
+
+	/* The file names data size
+	 */
+	size_t file_names_data_size;
+
+	/* The allocated size of the file names data
+	 */
+	size_t file_names_data_allocated_size;
+
+	/* The postings
+	 */
+	libnk2_alias_index_writer_posting_t *postings;
+
+	/* The number of postings, including duplicates
+	 */
+	uint32_t number_of_postings;
+
+	/* The allocated size of the postings
+	 */
+	size_t postings_allocated_size;
+
+	/* The keys data, including duplicates
+	 */
+	uint8_t *keys_data;
+
+	/* The keys data size
+	 */
+	size_t keys_data_size;
+
+	/* The allocated size of the keys data
+	 */
+	size_t keys_data_allocated_size;
+
+	/* Value to indicate the postings are sorted
+	 */
+	uint8_t postings_sorted;
+
+	/* The number of distinct keys, which is determined when the postings are sorted
+	 */
+	uint32_t number_of_distinct_keys;
+
+	/* The size of the distinct keys data, which is determined when the postings are sorted
+	 */
+	size_t distinct_keys_data_size;
+
+	/* The number of distinct postings, which is determined when the postings are sorted
+	 */
+	uint32_t number_of_distinct_postings;
+};
+
+LIBNK2_EXTERN \
+int libnk2_alias_index_writer_initialize(
+     libnk2_alias_index_writer_t **alias_index_writer,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_alias_index_writer_free(
+     libnk2_alias_index_writer_t **alias_index_writer,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_alias_index_writer_clear(
+     libnk2_alias_index_writer_t *alias_index_writer,
+     libcerror_error_t **error );
+
+int libnk2_alias_index_writer_resize_buffer(
+     uint8_t **buffer,
+     size_t *allocated_size,
+     size_t required_size,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_alias_index_writer_add_file(
+     libnk2_alias_index_writer_t *alias_index_writer,
+     libnk2_file_t *file,
+     const uint8_t *utf8_file_name,
+     size_t utf8_file_name_length,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_alias_index_writer_get_number_of_files(
+     libnk2_alias_index_writer_t *alias_index_writer,
+     uint32_t *number_of_files,
+     libcerror_error_t **error );
+
+int libnk2_alias_index_writer_posting_compare(
+     const void *first_posting,
+     const void *second_posting );
+
+int libnk2_alias_index_writer_sort_postings(
+     libnk2_internal_alias_index_writer_t *internal_alias_index_writer,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_alias_index_writer_get_segment_size(
+     libnk2_alias_index_writer_t *alias_index_writer,
+     size_t *segment_size,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_alias_index_writer_write_segment(
+     libnk2_alias_index_writer_t *alias_index_writer,
+     uint32_t first_file_identifier,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBNK2_ALIAS_INDEX_WRITER_H ) */
+
@@ -0,0 +1,1297 @@
+/*
+ * Arrow C data interface export functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libnk2_arrow.h"
+#include "libnk2_item.h"
+#include "libnk2_libcdata.h"
+#include "libnk2_libcerror.h"
+#include "libnk2_mapi.h"
+#include "libnk2_mapi_value.h"
+#include "libnk2_record_entry.h"
+
+/* The number of microseconds between January 1, 1601 and January 1, 1970
+ */
+#define LIBNK2_ARROW_FILETIME_EPOCH_DIFFERENCE	11644473600000000LL
+
+/* The formats of the columns
+ */
+static const char *libnk2_arrow_column_formats[ LIBNK2_ARROW_NUMBER_OF_COLUMNS ] = {
+	"I",
+	"I",
+	"I",
+	"l",
+	"g",
+	"tsu:UTC",
+	"u",
+	"z" };
+
+/* The names of the columns
+ */
+static const char *libnk2_arrow_column_names[ LIBNK2_ARROW_NUMBER_OF_COLUMNS ] = {
+	"item_index",
+	"entry_type",
+	"value_type",
+	"integer",
+	"floating_point",
+	"timestamp",
+	"string",
+	"data" };
+
+/* Releases a schema
+ * This function is used as the release callback of the schema
+ */
+void libnk2_arrow_schema_release(
+      struct ArrowSchema *schema )
+{
+	libnk2_arrow_private_data_t *private_data = NULL;
+	int64_t child_index                       = 0;
+
+	if( schema == NULL )
+	{
+		return;
+	}
+	if( schema->release == NULL )
+	{
+		return;
+	}
+	private_data = (libnk2_arrow_private_data_t *) schema->private_data;
+
+	if( private_data != NULL )
+	{
+		for( child_index = 0;
+		     child_index < schema->n_children;
+		     child_index++ )
+		{
+			if( private_data->schemas[ child_index ] == NULL )
+			{
+				continue;
+			}
+			if( private_data->schemas[ child_index ]->release != NULL )
+			{
+				private_data->schemas[ child_index ]->release(
+				 private_data->schemas[ child_index ] );
+			}
+			memory_free(
+			 private_data->schemas[ child_index ] );
+		}
+		memory_free(
+		 private_data );
+	}
+	schema->private_data = NULL;
+	schema->release      = NULL;
+}
+
+/* Initializes a schema
+ * The format and name must remain valid for the lifetime of the schema
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_arrow_schema_initialize(
+     struct ArrowSchema *schema,
+     const char *format,
+     const char *name,
+     int64_t flags,
+     int number_of_children,
+     libcerror_error_t **error )
+{
+	libnk2_arrow_private_data_t *private_data = NULL;
+	static char *function                     = "libnk2_arrow_schema_initialize";
+	int child_index                           = 0;
+
+	if( schema == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid schema.",
+		 function );
+
+		return( -1 );
+	}
+	if( format == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid format.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_children < 0 )
+	 || ( number_of_children > LIBNK2_ARROW_NUMBER_OF_COLUMNS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of children value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     schema,
+	     0,
+	     sizeof( struct ArrowSchema ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear schema.",
+		 function );
+
+		return( -1 );
+	}
+	private_data = memory_allocate_structure(
+	                libnk2_arrow_private_data_t );
+
+	if( private_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create private data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     private_data,
+	     0,
+	     sizeof( libnk2_arrow_private_data_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear private data.",
+		 function );
+
+		memory_free(
+		 private_data );
+
+		return( -1 );
+	}
+	schema->format       = format;
+	schema->name         = name;
+	schema->flags        = flags;
+	schema->n_children   = (int64_t) number_of_children;
+	schema->release      = &libnk2_arrow_schema_release;
+	schema->private_data = private_data;
+
+	if( number_of_children > 0 )
+	{
+		schema->children = private_data->schemas;
+	}
+	for( child_index = 0;
+	     child_index < number_of_children;
+	     child_index++ )
+	{
+		private_data->schemas[ child_index ] = memory_allocate_structure(
+		                                        struct ArrowSchema );
+
+		if( private_data->schemas[ child_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create child schema: %d.",
+			 function,
+			 child_index );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     private_data->schemas[ child_index ],
+		     0,
+		     sizeof( struct ArrowSchema ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear child schema: %d.",
+			 function,
+			 child_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	libnk2_arrow_schema_release(
+	 schema );
+
+	return( -1 );
+}
+
+/* Releases an array
+ * This function is used as the release callback of the array
+ */
+void libnk2_arrow_array_release(
+      struct ArrowArray *array )
+{
+	libnk2_arrow_private_data_t *private_data = NULL;
+	int64_t buffer_index                      = 0;
+	int64_t child_index                       = 0;
+
+	if( array == NULL )
+	{
+		return;
+	}
+	if( array->release == NULL )
+	{
+		return;
+	}
+	private_data = (libnk2_arrow_private_data_t *) array->private_data;
+
+	if( private_data != NULL )
+	{
+		for( buffer_index = 0;
+		     buffer_index < array->n_buffers;
+		     buffer_index++ )
+		{
+			if( private_data->buffers[ buffer_index ] != NULL )
+			{
+				memory_free(
+				 (void *) private_data->buffers[ buffer_index ] );
+			}
+		}
+		for( child_index = 0;
+		     child_index < array->n_children;
+		     child_index++ )
+		{
+			if( private_data->arrays[ child_index ] == NULL )
+			{
+				continue;
+			}
+			if( private_data->arrays[ child_index ]->release != NULL )
+			{
+				private_data->arrays[ child_index ]->release(
+				 private_data->arrays[ child_index ] );
+			}
+			memory_free(
+			 private_data->arrays[ child_index ] );
+		}
+		memory_free(
+		 private_data );
+	}
+	array->private_data = NULL;
+	array->release      = NULL;
+}
+
+/* Initializes an array
+ * A buffer with a size of 0 is not allocated and is represented by NULL,
+ * the buffers are zero filled
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_arrow_array_initialize(
+     struct ArrowArray *array,
+     int64_t length,
+     int number_of_buffers,
+     const size_t *buffer_sizes,
+     int number_of_children,
+     libcerror_error_t **error )
+{
+	libnk2_arrow_private_data_t *private_data = NULL;
+	void *buffer                              = NULL;
+	static char *function                     = "libnk2_arrow_array_initialize";
+	int buffer_index                          = 0;
+	int child_index                           = 0;
+
+	if( array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid array.",
+		 function );
+
+		return( -1 );
+	}
+	if( length < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid length value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_buffers < 0 )
+	 || ( number_of_buffers > 3 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of buffers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_children < 0 )
+	 || ( number_of_children > LIBNK2_ARROW_NUMBER_OF_COLUMNS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of children value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     array,
+	     0,
+	     sizeof( struct ArrowArray ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear array.",
+		 function );
+
+		return( -1 );
+	}
+	private_data = memory_allocate_structure(
+	                libnk2_arrow_private_data_t );
+
+	if( private_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create private data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     private_data,
+	     0,
+	     sizeof( libnk2_arrow_private_data_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear private data.",
+		 function );
+
+		memory_free(
+		 private_data );
+
+		return( -1 );
+	}
+	array->length       = length;
+	array->n_buffers    = (int64_t) number_of_buffers;
+	array->n_children   = (int64_t) number_of_children;
+	array->buffers      = private_data->buffers;
+	array->release      = &libnk2_arrow_array_release;
+	array->private_data = private_data;
+
+	if( number_of_children > 0 )
+	{
+		array->children = private_data->arrays;
+	}
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		if( buffer_sizes[ buffer_index ] == 0 )
+		{
+			continue;
+		}
+		if( buffer_sizes[ buffer_index ] > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid buffer: %d size value exceeds maximum allocation size.",
+			 function,
+			 buffer_index );
+
+			goto on_error;
+		}
+		buffer = memory_allocate(
+		          buffer_sizes[ buffer_index ] );
+
+		if( buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer: %d.",
+			 function,
+			 buffer_index );
+
+			goto on_error;
+		}
+		private_data->buffers[ buffer_index ] = buffer;
+
+		if( memory_set(
+		     buffer,
+		     0,
+		     buffer_sizes[ buffer_index ] ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear buffer: %d.",
+			 function,
+			 buffer_index );
+
+			goto on_error;
+		}
+	}
+	for( child_index = 0;
+	     child_index < number_of_children;
+	     child_index++ )
+	{
+		private_data->arrays[ child_index ] = memory_allocate_structure(
+		                                       struct ArrowArray );
+
+		if( private_data->arrays[ child_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create child array: %d.",
+			 function,
+			 child_index );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     private_data->arrays[ child_index ],
+		     0,
+		     sizeof( struct ArrowArray ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear child array: %d.",
+			 function,
+			 child_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	libnk2_arrow_array_release(
+	 array );
+
+	return( -1 );
+}
+
+/* Retrieves the size of the value data of a record entry formatted as an UTF-8 string
+ * The returned size does not include the end of string character
+ * Returns 1 if successful, 0 if the value data cannot be formatted as an UTF-8 string or -1 on error
+ */
+int libnk2_arrow_get_utf8_string_size(
+     libnk2_internal_record_entry_t *internal_record_entry,
+     size_t *utf8_string_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libnk2_arrow_get_utf8_string_size";
+	size_t safe_utf8_size = 0;
+
+	if( internal_record_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string size.",
+		 function );
+
+		return( -1 );
+	}
+	*utf8_string_size = 0;
+
+	if( ( internal_record_entry->value_type != LIBNK2_VALUE_TYPE_STRING_ASCII )
+	 && ( internal_record_entry->value_type != LIBNK2_VALUE_TYPE_STRING_UNICODE ) )
+	{
+		return( 0 );
+	}
+	if( internal_record_entry->value_data == NULL )
+	{
+		return( 0 );
+	}
+	/* Value data that cannot be converted is exported as a NULL string
+	 */
+	if( libnk2_mapi_value_get_data_as_utf8_string_size(
+	     internal_record_entry->value_type,
+	     internal_record_entry->value_data,
+	     internal_record_entry->value_data_size,
+	     internal_record_entry->ascii_codepage,
+	     &safe_utf8_size,
+	     NULL ) != 1 )
+	{
+		return( 0 );
+	}
+	if( safe_utf8_size > 0 )
+	{
+		safe_utf8_size -= 1;
+	}
+	*utf8_string_size = safe_utf8_size;
+
+	return( 1 );
+}
+
+/* Exports the record entries of the items as an Arrow record batch
+ * The record batch contains a row per record entry, the columns are defined by LIBNK2_ARROW_COLUMNS
+ * On success the schema and array must be released by the caller using their release callback
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_arrow_export_items(
+     libcdata_array_t *items_array,
+     struct ArrowSchema *schema,
+     struct ArrowArray *array,
+     libcerror_error_t **error )
+{
+	size_t buffer_sizes[ 3 ];
+	int64_t null_counts[ LIBNK2_ARROW_NUMBER_OF_COLUMNS ];
+	uint8_t column_is_valid[ LIBNK2_ARROW_NUMBER_OF_COLUMNS ];
+	uint8_t *validity_bitmaps[ LIBNK2_ARROW_NUMBER_OF_COLUMNS ];
+
+	byte_stream_float64_t value_double;
+	byte_stream_float32_t value_float;
+	libnk2_internal_item_t *internal_item                 = NULL;
+	libnk2_internal_record_entry_t *internal_record_entry = NULL;
+	static char *function                                 = "libnk2_arrow_export_items";
+	uint8_t *data                                         = NULL;
+	uint8_t *string_data                                  = NULL;
+	double *floating_points                               = NULL;
+	size_t data_offset                                    = 0;
+	size_t data_size                                      = 0;
+	size_t string_data_offset                             = 0;
+	size_t string_data_size                               = 0;
+	size_t utf8_string_size                               = 0;
+	uint64_t value_64bit                                  = 0;
+	uint32_t *entry_types                                 = NULL;
+	uint32_t *item_indexes                                = NULL;
+	uint32_t *value_types                                 = NULL;
+	uint32_t value_32bit                                  = 0;
+	uint16_t value_16bit                                  = 0;
+	int64_t *integers                                     = NULL;
+	int64_t *timestamps                                   = NULL;
+	int64_t number_of_rows                                = 0;
+	int64_t row_index                                     = 0;
+	int32_t *data_offsets                                 = NULL;
+	int32_t *string_data_offsets                          = NULL;
+	uint8_t row_bit                                       = 0;
+	int column_index                                      = 0;
+	int entry_index                                       = 0;
+	int item_index                                        = 0;
+	int number_of_entries                                 = 0;
+	int number_of_items                                   = 0;
+	int result                                            = 0;
+
+	if( items_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid items array.",
+		 function );
+
+		return( -1 );
+	}
+	if( schema == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid schema.",
+		 function );
+
+		return( -1 );
+	}
+	if( array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid array.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     schema,
+	     0,
+	     sizeof( struct ArrowSchema ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear schema.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     array,
+	     0,
+	     sizeof( struct ArrowArray ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear array.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     null_counts,
+	     0,
+	     sizeof( int64_t ) * LIBNK2_ARROW_NUMBER_OF_COLUMNS ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear null counts.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     items_array,
+	     &number_of_items,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of items.",
+		 function );
+
+		return( -1 );
+	}
+	/* Determine the number of rows and the size of the variable size data
+	 * so that every buffer is allocated once
+	 */
+	for( item_index = 0;
+	     item_index < number_of_items;
+	     item_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     items_array,
+		     item_index,
+		     (intptr_t **) &internal_item,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve item: %d.",
+			 function,
+			 item_index );
+
+			return( -1 );
+		}
+		if( internal_item == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing item: %d.",
+			 function,
+			 item_index );
+
+			return( -1 );
+		}
+		if( libcdata_array_get_number_of_entries(
+		     internal_item->entries_array,
+		     &number_of_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of entries of item: %d.",
+			 function,
+			 item_index );
+
+			return( -1 );
+		}
+		for( entry_index = 0;
+		     entry_index < number_of_entries;
+		     entry_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     internal_item->entries_array,
+			     entry_index,
+			     (intptr_t **) &internal_record_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve record entry: %d of item: %d.",
+				 function,
+				 entry_index,
+				 item_index );
+
+				return( -1 );
+			}
+			result = libnk2_arrow_get_utf8_string_size(
+			          internal_record_entry,
+			          &utf8_string_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve UTF-8 string size of record entry: %d of item: %d.",
+				 function,
+				 entry_index,
+				 item_index );
+
+				return( -1 );
+			}
+			string_data_size += utf8_string_size;
+
+			if( internal_record_entry->value_data != NULL )
+			{
+				data_size += internal_record_entry->value_data_size;
+			}
+			number_of_rows++;
+		}
+	}
+	/* The string and binary columns use 32-bit offsets
+	 */
+	if( ( number_of_rows >= (int64_t) INT32_MAX )
+	 || ( string_data_size >= (size_t) INT32_MAX )
+	 || ( data_size > (size_t) INT32_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of rows or data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libnk2_arrow_schema_initialize(
+	     schema,
+	     "+s",
+	     "",
+	     0,
+	     LIBNK2_ARROW_NUMBER_OF_COLUMNS,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize schema.",
+		 function );
+
+		goto on_error;
+	}
+	buffer_sizes[ 0 ] = 0;
+
+	if( libnk2_arrow_array_initialize(
+	     array,
+	     number_of_rows,
+	     1,
+	     buffer_sizes,
+	     LIBNK2_ARROW_NUMBER_OF_COLUMNS,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize array.",
+		 function );
+
+		goto on_error;
+	}
+	for( column_index = 0;
+	     column_index < LIBNK2_ARROW_NUMBER_OF_COLUMNS;
+	     column_index++ )
+	{
+		buffer_sizes[ 0 ] = 0;
+		buffer_sizes[ 2 ] = 0;
+
+		switch( column_index )
+		{
+			case LIBNK2_ARROW_COLUMN_ITEM_INDEX:
+			case LIBNK2_ARROW_COLUMN_ENTRY_TYPE:
+			case LIBNK2_ARROW_COLUMN_VALUE_TYPE:
+				buffer_sizes[ 1 ] = sizeof( uint32_t ) * (size_t) number_of_rows;
+				break;
+
+			case LIBNK2_ARROW_COLUMN_INTEGER:
+			case LIBNK2_ARROW_COLUMN_TIMESTAMP:
+				buffer_sizes[ 0 ] = (size_t) ( ( number_of_rows + 7 ) / 8 );
+				buffer_sizes[ 1 ] = sizeof( int64_t ) * (size_t) number_of_rows;
+				break;
+
+			case LIBNK2_ARROW_COLUMN_FLOATING_POINT:
+				buffer_sizes[ 0 ] = (size_t) ( ( number_of_rows + 7 ) / 8 );
+				buffer_sizes[ 1 ] = sizeof( double ) * (size_t) number_of_rows;
+				break;
+
+			case LIBNK2_ARROW_COLUMN_STRING:
+				/* The UTF-8 conversion writes an end of string character after each string
+				 * which is overwritten by the next string
+				 */
+				buffer_sizes[ 0 ] = (size_t) ( ( number_of_rows + 7 ) / 8 );
+				buffer_sizes[ 1 ] = sizeof( int32_t ) * (size_t) ( number_of_rows + 1 );
+				buffer_sizes[ 2 ] = string_data_size + 1;
+				break;
+
+			case LIBNK2_ARROW_COLUMN_DATA:
+				buffer_sizes[ 1 ] = sizeof( int32_t ) * (size_t) ( number_of_rows + 1 );
+				buffer_sizes[ 2 ] = data_size;
+				break;
+		}
+		if( libnk2_arrow_schema_initialize(
+		     schema->children[ column_index ],
+		     libnk2_arrow_column_formats[ column_index ],
+		     libnk2_arrow_column_names[ column_index ],
+		     ( buffer_sizes[ 0 ] != 0 ) ? ARROW_FLAG_NULLABLE : 0,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize schema of column: %d.",
+			 function,
+			 column_index );
+
+			goto on_error;
+		}
+		if( libnk2_arrow_array_initialize(
+		     array->children[ column_index ],
+		     number_of_rows,
+		     ( column_index >= LIBNK2_ARROW_COLUMN_STRING ) ? 3 : 2,
+		     buffer_sizes,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize array of column: %d.",
+			 function,
+			 column_index );
+
+			goto on_error;
+		}
+		validity_bitmaps[ column_index ] = (uint8_t *) array->children[ column_index ]->buffers[ 0 ];
+	}
+	item_indexes        = (uint32_t *) array->children[ LIBNK2_ARROW_COLUMN_ITEM_INDEX ]->buffers[ 1 ];
+	entry_types         = (uint32_t *) array->children[ LIBNK2_ARROW_COLUMN_ENTRY_TYPE ]->buffers[ 1 ];
+	value_types         = (uint32_t *) array->children[ LIBNK2_ARROW_COLUMN_VALUE_TYPE ]->buffers[ 1 ];
+	integers            = (int64_t *) array->children[ LIBNK2_ARROW_COLUMN_INTEGER ]->buffers[ 1 ];
+	floating_points     = (double *) array->children[ LIBNK2_ARROW_COLUMN_FLOATING_POINT ]->buffers[ 1 ];
+	timestamps          = (int64_t *) array->children[ LIBNK2_ARROW_COLUMN_TIMESTAMP ]->buffers[ 1 ];
+	string_data_offsets = (int32_t *) array->children[ LIBNK2_ARROW_COLUMN_STRING ]->buffers[ 1 ];
+	string_data         = (uint8_t *) array->children[ LIBNK2_ARROW_COLUMN_STRING ]->buffers[ 2 ];
+	data_offsets        = (int32_t *) array->children[ LIBNK2_ARROW_COLUMN_DATA ]->buffers[ 1 ];
+	data                = (uint8_t *) array->children[ LIBNK2_ARROW_COLUMN_DATA ]->buffers[ 2 ];
+
+	for( item_index = 0;
+	     item_index < number_of_items;
+	     item_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     items_array,
+		     item_index,
+		     (intptr_t **) &internal_item,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve item: %d.",
+			 function,
+			 item_index );
+
+			goto on_error;
+		}
+		if( libcdata_array_get_number_of_entries(
+		     internal_item->entries_array,
+		     &number_of_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of entries of item: %d.",
+			 function,
+			 item_index );
+
+			goto on_error;
+		}
+		for( entry_index = 0;
+		     entry_index < number_of_entries;
+		     entry_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     internal_item->entries_array,
+			     entry_index,
+			     (intptr_t **) &internal_record_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve record entry: %d of item: %d.",
+				 function,
+				 entry_index,
+				 item_index );
+
+				goto on_error;
+			}
+			if( row_index >= number_of_rows )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid row index value out of bounds.",
+				 function );
+
+				goto on_error;
+			}
+			item_indexes[ row_index ] = (uint32_t) item_index;
+			entry_types[ row_index ]  = internal_record_entry->entry_type;
+			value_types[ row_index ]  = internal_record_entry->value_type;
+
+			column_is_valid[ LIBNK2_ARROW_COLUMN_INTEGER ]        = 0;
+			column_is_valid[ LIBNK2_ARROW_COLUMN_FLOATING_POINT ] = 0;
+			column_is_valid[ LIBNK2_ARROW_COLUMN_TIMESTAMP ]      = 0;
+			column_is_valid[ LIBNK2_ARROW_COLUMN_STRING ]         = 0;
+
+			if( internal_record_entry->value_data != NULL )
+			{
+				switch( internal_record_entry->value_type )
+				{
+					case LIBNK2_VALUE_TYPE_BOOLEAN:
+					case LIBNK2_VALUE_TYPE_INTEGER_16BIT_SIGNED:
+						if( internal_record_entry->value_data_size == 2 )
+						{
+							byte_stream_copy_to_uint16_little_endian(
+							 internal_record_entry->value_data,
+							 value_16bit );
+
+							if( internal_record_entry->value_type == LIBNK2_VALUE_TYPE_BOOLEAN )
+							{
+								integers[ row_index ] = (int64_t) ( value_16bit != 0 );
+							}
+							else
+							{
+								integers[ row_index ] = (int64_t) ( (int16_t) value_16bit );
+							}
+							column_is_valid[ LIBNK2_ARROW_COLUMN_INTEGER ] = 1;
+						}
+						break;
+
+					case LIBNK2_VALUE_TYPE_ERROR:
+					case LIBNK2_VALUE_TYPE_INTEGER_32BIT_SIGNED:
+						if( internal_record_entry->value_data_size == 4 )
+						{
+							byte_stream_copy_to_uint32_little_endian(
+							 internal_record_entry->value_data,
+							 value_32bit );
+
+							if( internal_record_entry->value_type == LIBNK2_VALUE_TYPE_ERROR )
+							{
+								integers[ row_index ] = (int64_t) value_32bit;
+							}
+							else
+							{
+								integers[ row_index ] = (int64_t) ( (int32_t) value_32bit );
+							}
+							column_is_valid[ LIBNK2_ARROW_COLUMN_INTEGER ] = 1;
+						}
+						break;
+
+					case LIBNK2_VALUE_TYPE_INTEGER_64BIT_SIGNED:
+						if( internal_record_entry->value_data_size == 8 )
+						{
+							byte_stream_copy_to_uint64_little_endian(
+							 internal_record_entry->value_data,
+							 value_64bit );
+
+							integers[ row_index ] = (int64_t) value_64bit;
+
+							column_is_valid[ LIBNK2_ARROW_COLUMN_INTEGER ] = 1;
+						}
+						break;
+
+					case LIBNK2_VALUE_TYPE_FLOAT_32BIT:
+						if( internal_record_entry->value_data_size == 4 )
+						{
+							byte_stream_copy_to_uint32_little_endian(
+							 internal_record_entry->value_data,
+							 value_float.integer );
+
+							floating_points[ row_index ] = (double) value_float.floating_point;
+
+							column_is_valid[ LIBNK2_ARROW_COLUMN_FLOATING_POINT ] = 1;
+						}
+						break;
+
+					case LIBNK2_VALUE_TYPE_DOUBLE_64BIT:
+					case LIBNK2_VALUE_TYPE_FLOATINGTIME:
+						if( internal_record_entry->value_data_size == 8 )
+						{
+							byte_stream_copy_to_uint64_little_endian(
+							 internal_record_entry->value_data,
+							 value_double.integer );
+
+							floating_points[ row_index ] = value_double.floating_point;
+
+							column_is_valid[ LIBNK2_ARROW_COLUMN_FLOATING_POINT ] = 1;
+						}
+						break;
+
+					case LIBNK2_VALUE_TYPE_FILETIME:
+						if( internal_record_entry->value_data_size == 8 )
+						{
+							byte_stream_copy_to_uint64_little_endian(
+							 internal_record_entry->value_data,
+							 value_64bit );
+
+							/* A FILETIME contains the number of 100th nano seconds since January 1, 1601
+							 */
+							timestamps[ row_index ] = (int64_t) ( value_64bit / 10 ) - LIBNK2_ARROW_FILETIME_EPOCH_DIFFERENCE;
+
+							column_is_valid[ LIBNK2_ARROW_COLUMN_TIMESTAMP ] = 1;
+						}
+						break;
+
+					default:
+						break;
+				}
+			}
+			result = libnk2_arrow_get_utf8_string_size(
+			          internal_record_entry,
+			          &utf8_string_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve UTF-8 string size of record entry: %d of item: %d.",
+				 function,
+				 entry_index,
+				 item_index );
+
+				goto on_error;
+			}
+			string_data_offsets[ row_index ] = (int32_t) string_data_offset;
+
+			if( result != 0 )
+			{
+				if( utf8_string_size > ( string_data_size - string_data_offset ) )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+					 "%s: invalid UTF-8 string size value out of bounds.",
+					 function );
+
+					goto on_error;
+				}
+				if( utf8_string_size > 0 )
+				{
+					if( libnk2_mapi_value_get_data_as_utf8_string(
+					     internal_record_entry->value_type,
+					     internal_record_entry->value_data,
+					     internal_record_entry->value_data_size,
+					     internal_record_entry->ascii_codepage,
+					     &( string_data[ string_data_offset ] ),
+					     utf8_string_size + 1,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+						 "%s: unable to retrieve UTF-8 string of record entry: %d of item: %d.",
+						 function,
+						 entry_index,
+						 item_index );
+
+						goto on_error;
+					}
+					string_data_offset += utf8_string_size;
+				}
+				column_is_valid[ LIBNK2_ARROW_COLUMN_STRING ] = 1;
+			}
+			data_offsets[ row_index ] = (int32_t) data_offset;
+
+			if( ( internal_record_entry->value_data != NULL )
+			 && ( internal_record_entry->value_data_size > 0 ) )
+			{
+				if( internal_record_entry->value_data_size > ( data_size - data_offset ) )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+					 "%s: invalid value data size value out of bounds.",
+					 function );
+
+					goto on_error;
+				}
+				if( memory_copy(
+				     &( data[ data_offset ] ),
+				     internal_record_entry->value_data,
+				     internal_record_entry->value_data_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy value data of record entry: %d of item: %d.",
+					 function,
+					 entry_index,
+					 item_index );
+
+					goto on_error;
+				}
+				data_offset += internal_record_entry->value_data_size;
+			}
+			row_bit = (uint8_t) ( 1 << ( row_index % 8 ) );
+
+			for( column_index = LIBNK2_ARROW_COLUMN_INTEGER;
+			     column_index <= LIBNK2_ARROW_COLUMN_STRING;
+			     column_index++ )
+			{
+				if( column_is_valid[ column_index ] != 0 )
+				{
+					validity_bitmaps[ column_index ][ row_index / 8 ] |= row_bit;
+				}
+				else
+				{
+					null_counts[ column_index ] += 1;
+				}
+			}
+			row_index++;
+		}
+	}
+	string_data_offsets[ number_of_rows ] = (int32_t) string_data_offset;
+	data_offsets[ number_of_rows ]        = (int32_t) data_offset;
+
+	for( column_index = 0;
+	     column_index < LIBNK2_ARROW_NUMBER_OF_COLUMNS;
+	     column_index++ )
+	{
+		array->children[ column_index ]->null_count = null_counts[ column_index ];
+	}
+	return( 1 );
+
+on_error:
+	if( array->release != NULL )
+	{
+		array->release(
+		 array );
+	}
+	if( schema->release != NULL )
+	{
+		schema->release(
+		 schema );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,820 @@
+/*
+ * Carving functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libnk2_carve.h"
+#include "libnk2_io_handle.h"
+#include "libnk2_item.h"
+#include "libnk2_libbfio.h"
+#include "libnk2_libcerror.h"
+#include "libnk2_mapi.h"
+#include "libnk2_mapi_value.h"
+
+#include "nk2_file_footer.h"
+#include "nk2_file_header.h"
+#include "nk2_item.h"
+
+/* Scans a buffer for the file signature
+ * The first byte of the signature is searched for with memchr, which is optimized
+ * by most C libraries, before the remainder of the signature is compared
+ * Returns 1 if the signature was found, 0 if not or -1 on error
+ */
+int libnk2_carve_scan_buffer_for_signature(
+     const uint8_t *buffer,
+     size_t buffer_size,
+     size_t *signature_offset,
+     libcerror_error_t **error )
+{
+	const uint8_t *buffer_end = NULL;
+	const uint8_t *match      = NULL;
+	static char *function     = "libnk2_carve_scan_buffer_for_signature";
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( signature_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid signature offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size < 4 )
+	{
+		return( 0 );
+	}
+	match      = buffer;
+	buffer_end = &( buffer[ buffer_size - 3 ] );
+
+	while( match < buffer_end )
+	{
+		match = (const uint8_t *) memchr(
+		                           match,
+		                           nk2_file_signature[ 0 ],
+		                           (size_t) ( buffer_end - match ) );
+
+		if( match == NULL )
+		{
+			break;
+		}
+		if( ( match[ 1 ] == nk2_file_signature[ 1 ] )
+		 && ( match[ 2 ] == nk2_file_signature[ 2 ] )
+		 && ( match[ 3 ] == nk2_file_signature[ 3 ] ) )
+		{
+			*signature_offset = (size_t) ( match - buffer );
+
+			return( 1 );
+		}
+		match++;
+	}
+	return( 0 );
+}
+
+/* Validates the file header, items and file footer of a NK2 file that starts at a specific offset
+ * The record entries are validated with the same rules as when reading a file
+ * without allocating them
+ * The function does not keep state, candidates can be validated concurrently
+ * if every thread uses its own file IO handle
+ * Returns 1 if valid, 0 if not or -1 on error
+ */
+int libnk2_carve_validate_file_io_handle(
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     size64_t *carved_size,
+     uint32_t *number_of_items,
+     libcerror_error_t **error )
+{
+	uint8_t file_header_data[ sizeof( nk2_file_header_t ) ];
+	uint8_t record_entry_data[ sizeof( nk2_item_value_entry_t ) ];
+	uint8_t value_data_size_data[ 4 ];
+
+	static char *function             = "libnk2_carve_validate_file_io_handle";
+	size64_t file_size                = 0;
+	size64_t remaining_size           = 0;
+	size_t value_data_size            = 0;
+	ssize_t read_count                = 0;
+	off64_t end_offset                = 0;
+	off64_t current_offset            = 0;
+	uint32_t item_index               = 0;
+	uint32_t number_of_header_items   = 0;
+	uint32_t number_of_record_entries = 0;
+	uint32_t record_entry_index       = 0;
+	uint32_t stored_value_data_size   = 0;
+	uint16_t value_type               = 0;
+
+	if( file_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid file offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( carved_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carved size.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_items == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of items.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to retrieve file size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( (size64_t) file_offset >= file_size )
+	 || ( ( file_size - (size64_t) file_offset ) < (size64_t) ( sizeof( nk2_file_header_t ) + sizeof( nk2_file_footer_t ) ) ) )
+	{
+		return( 0 );
+	}
+	/* The items of the candidate cannot extend into the last file footer sized part of the file
+	 */
+	end_offset = (off64_t) ( file_size - sizeof( nk2_file_footer_t ) );
+
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              file_io_handle,
+	              file_header_data,
+	              sizeof( nk2_file_header_t ),
+	              file_offset,
+	              error );
+
+	if( read_count != (ssize_t) sizeof( nk2_file_header_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file header data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		return( -1 );
+	}
+	if( memory_compare(
+	     ( (nk2_file_header_t *) file_header_data )->signature,
+	     nk2_file_signature,
+	     4 ) != 0 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (nk2_file_header_t *) file_header_data )->number_of_items,
+	 number_of_header_items );
+
+	current_offset = file_offset + sizeof( nk2_file_header_t );
+	remaining_size = (size64_t) ( end_offset - current_offset );
+
+	/* Every item contains a number of record entries and at least 1 record entry,
+	 * except for an item without record entries that terminates the items
+	 */
+	if( (size64_t) number_of_header_items > ( ( remaining_size / ( 4 + sizeof( nk2_item_value_entry_t ) ) ) + 1 ) )
+	{
+		return( 0 );
+	}
+	for( item_index = 0;
+	     item_index < number_of_header_items;
+	     item_index++ )
+	{
+		if( ( current_offset + 4 ) > end_offset )
+		{
+			return( 0 );
+		}
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              file_io_handle,
+		              value_data_size_data,
+		              4,
+		              current_offset,
+		              error );
+
+		if( read_count != (ssize_t) 4 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read item: %" PRIu32 " number of record entries data.",
+			 function,
+			 item_index );
+
+			return( -1 );
+		}
+		current_offset += 4;
+
+		byte_stream_copy_to_uint32_little_endian(
+		 value_data_size_data,
+		 number_of_record_entries );
+
+		if( number_of_record_entries == 0 )
+		{
+			break;
+		}
+		remaining_size = (size64_t) ( end_offset - current_offset );
+
+		if( (size64_t) number_of_record_entries > ( remaining_size / sizeof( nk2_item_value_entry_t ) ) )
+		{
+			return( 0 );
+		}
+		for( record_entry_index = 0;
+		     record_entry_index < number_of_record_entries;
+		     record_entry_index++ )
+		{
+			if( ( current_offset + (off64_t) sizeof( nk2_item_value_entry_t ) ) > end_offset )
+			{
+				return( 0 );
+			}
+			read_count = libbfio_handle_read_buffer_at_offset(
+			              file_io_handle,
+			              record_entry_data,
+			              sizeof( nk2_item_value_entry_t ),
+			              current_offset,
+			              error );
+
+			if( read_count != (ssize_t) sizeof( nk2_item_value_entry_t ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read item: %" PRIu32 " record entry: %" PRIu32 " data.",
+				 function,
+				 item_index,
+				 record_entry_index );
+
+				return( -1 );
+			}
+			current_offset += sizeof( nk2_item_value_entry_t );
+
+			byte_stream_copy_to_uint16_little_endian(
+			 ( (nk2_item_value_entry_t *) record_entry_data )->value_type,
+			 value_type );
+
+			/* An unsupported value type is not an error but an invalid candidate
+			 */
+			if( libnk2_mapi_value_get_data_size(
+			     (uint32_t) value_type,
+			     &value_data_size,
+			     NULL ) != 1 )
+			{
+				return( 0 );
+			}
+			if( value_data_size != 0 )
+			{
+				continue;
+			}
+			if( ( current_offset + 4 ) > end_offset )
+			{
+				return( 0 );
+			}
+			read_count = libbfio_handle_read_buffer_at_offset(
+			              file_io_handle,
+			              value_data_size_data,
+			              4,
+			              current_offset,
+			              error );
+
+			if( read_count != (ssize_t) 4 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read item: %" PRIu32 " record entry: %" PRIu32 " value data size.",
+				 function,
+				 item_index,
+				 record_entry_index );
+
+				return( -1 );
+			}
+			current_offset += 4;
+
+			byte_stream_copy_to_uint32_little_endian(
+			 value_data_size_data,
+			 stored_value_data_size );
+
+			remaining_size = (size64_t) ( end_offset - current_offset );
+
+			if( ( stored_value_data_size == 0 )
+			 || ( (size64_t) stored_value_data_size > remaining_size ) )
+			{
+				return( 0 );
+			}
+			current_offset += stored_value_data_size;
+		}
+	}
+	*carved_size     = (size64_t) ( current_offset - file_offset ) + sizeof( nk2_file_footer_t );
+	*number_of_items = item_index;
+
+	return( 1 );
+}
+
+/* Determines if the data contains a plausible item without a file header
+ * An item consists of the number of record entries followed by the record entries
+ * The cheapest checks are done first so that most non-item data is rejected
+ * before the record entries are walked
+ * Returns 1 if valid, 0 if not or -1 on error
+ */
+int libnk2_carve_validate_item_data(
+     const uint8_t *data,
+     size_t data_size,
+     size_t *item_data_size,
+     uint32_t *number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function           = "libnk2_carve_validate_item_data";
+	size_t data_offset              = 0;
+	size_t value_data_size          = 0;
+	uint32_t number_of_item_entries = 0;
+	uint32_t record_entry_index     = 0;
+	uint32_t stored_value_data_size = 0;
+	uint16_t entry_type             = 0;
+	uint16_t value_type             = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( item_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size < ( 4 + sizeof( nk2_item_value_entry_t ) ) )
+	{
+		return( 0 );
+	}
+	/* All supported value types are smaller than 0x0200
+	 */
+	if( ( data[ 2 ] != 0 )
+	 || ( data[ 3 ] != 0 )
+	 || ( data[ 5 ] > 0x01 ) )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 data,
+	 number_of_item_entries );
+
+	if( ( number_of_item_entries == 0 )
+	 || ( number_of_item_entries > LIBNK2_CARVE_MAXIMUM_NUMBER_OF_ENTRIES )
+	 || ( (size_t) number_of_item_entries > ( ( data_size - 4 ) / sizeof( nk2_item_value_entry_t ) ) ) )
+	{
+		return( 0 );
+	}
+	data_offset = 4;
+
+	for( record_entry_index = 0;
+	     record_entry_index < number_of_item_entries;
+	     record_entry_index++ )
+	{
+		if( sizeof( nk2_item_value_entry_t ) > ( data_size - data_offset ) )
+		{
+			return( 0 );
+		}
+		byte_stream_copy_to_uint16_little_endian(
+		 ( (nk2_item_value_entry_t *) &( data[ data_offset ] ) )->value_type,
+		 value_type );
+
+		byte_stream_copy_to_uint16_little_endian(
+		 ( (nk2_item_value_entry_t *) &( data[ data_offset ] ) )->entry_type,
+		 entry_type );
+
+		data_offset += sizeof( nk2_item_value_entry_t );
+
+		/* MAPI property identifiers 0x0000 and 0xffff are not used
+		 */
+		if( ( entry_type == 0x0000 )
+		 || ( entry_type == 0xffff ) )
+		{
+			return( 0 );
+		}
+		if( libnk2_mapi_value_get_data_size(
+		     (uint32_t) value_type,
+		     &value_data_size,
+		     NULL ) != 1 )
+		{
+			return( 0 );
+		}
+		if( value_data_size != 0 )
+		{
+			continue;
+		}
+		if( 4 > ( data_size - data_offset ) )
+		{
+			return( 0 );
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 &( data[ data_offset ] ),
+		 stored_value_data_size );
+
+		data_offset += 4;
+
+		if( ( stored_value_data_size == 0 )
+		 || ( (size_t) stored_value_data_size > ( data_size - data_offset ) ) )
+		{
+			return( 0 );
+		}
+		/* A UTF-16 string consists of 2 byte characters
+		 */
+		if( ( value_type == LIBNK2_VALUE_TYPE_STRING_UNICODE )
+		 && ( ( stored_value_data_size % 2 ) != 0 ) )
+		{
+			return( 0 );
+		}
+		data_offset += stored_value_data_size;
+	}
+	*item_data_size    = data_offset;
+	*number_of_entries = number_of_item_entries;
+
+	return( 1 );
+}
+
+/* Scans a buffer for a plausible item without a file header
+ * Returns 1 if an item was found, 0 if not or -1 on error
+ */
+int libnk2_carve_scan_buffer_for_item(
+     const uint8_t *buffer,
+     size_t buffer_size,
+     size_t *item_offset,
+     size_t *item_data_size,
+     uint32_t *number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libnk2_carve_scan_buffer_for_item";
+	size_t buffer_offset  = 0;
+	size_t last_offset    = 0;
+	int result            = 0;
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( item_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size < ( 4 + sizeof( nk2_item_value_entry_t ) ) )
+	{
+		return( 0 );
+	}
+	last_offset = buffer_size - ( 4 + sizeof( nk2_item_value_entry_t ) );
+
+	for( buffer_offset = 0;
+	     buffer_offset <= last_offset;
+	     buffer_offset++ )
+	{
+		/* Fast rejection of data that cannot be the start of an item
+		 * the number of entries is non-zero and smaller than 65536
+		 */
+		if( ( buffer[ buffer_offset + 3 ] != 0 )
+		 || ( buffer[ buffer_offset + 2 ] != 0 )
+		 || ( ( buffer[ buffer_offset ] | buffer[ buffer_offset + 1 ] ) == 0 ) )
+		{
+			continue;
+		}
+		result = libnk2_carve_validate_item_data(
+		          &( buffer[ buffer_offset ] ),
+		          buffer_size - buffer_offset,
+		          item_data_size,
+		          number_of_entries,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to validate item data at offset: %" PRIzd ".",
+			 function,
+			 buffer_offset );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			*item_offset = buffer_offset;
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Reads an item without a file header that starts at a specific offset
+ * The offset should refer to the number of record entries of the item
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_carve_read_item_file_io_handle(
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     int ascii_codepage,
+     libnk2_item_t **item,
+     libcerror_error_t **error )
+{
+	uint8_t number_of_record_entries_data[ 4 ];
+
+	libnk2_io_handle_t *io_handle     = NULL;
+	libnk2_item_t *safe_item          = NULL;
+	static char *function             = "libnk2_carve_read_item_file_io_handle";
+	size64_t file_size                = 0;
+	ssize_t read_count                = 0;
+	uint32_t number_of_record_entries = 0;
+
+	if( file_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid file offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
+
+		return( -1 );
+	}
+	if( *item != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid item value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to retrieve file size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libnk2_io_handle_initialize(
+	     &io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	io_handle->ascii_codepage   = ascii_codepage;
+	io_handle->items_end_offset = (off64_t) file_size;
+
+	read_count = libnk2_io_handle_read_buffer_at_offset(
+	              io_handle,
+	              file_io_handle,
+	              number_of_record_entries_data,
+	              4,
+	              file_offset,
+	              error );
+
+	if( read_count != (ssize_t) 4 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read number of record entries data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		goto on_error;
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 number_of_record_entries_data,
+	 number_of_record_entries );
+
+	if( ( number_of_record_entries == 0 )
+	 || ( number_of_record_entries > LIBNK2_CARVE_MAXIMUM_NUMBER_OF_ENTRIES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of record entries value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( libnk2_item_initialize(
+	     &safe_item,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create item.",
+		 function );
+
+		goto on_error;
+	}
+	/* The record entries are read from the current offset of the file IO handle
+	 */
+	if( libnk2_item_read_record_entries(
+	     (libnk2_internal_item_t *) safe_item,
+	     io_handle,
+	     file_io_handle,
+	     0,
+	     number_of_record_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read record entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( libnk2_io_handle_free(
+	     &io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	*item = safe_item;
+
+	return( 1 );
+
+on_error:
+	if( safe_item != NULL )
+	{
+		libnk2_item_free(
+		 &safe_item,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libnk2_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,86 @@
+/*
+ * Carving functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBNK2_CARVE_H )
+#define _LIBNK2_CARVE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libnk2_extern.h"
+#include "libnk2_libbfio.h"
+#include "libnk2_libcerror.h"
+#include "libnk2_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The maximum number of record entries of a carved item
+ */
+#define LIBNK2_CARVE_MAXIMUM_NUMBER_OF_ENTRIES		512
+
+LIBNK2_EXTERN \
+int libnk2_carve_scan_buffer_for_signature(
+     const uint8_t *buffer,
+     size_t buffer_size,
+     size_t *signature_offset,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_carve_validate_file_io_handle(
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     size64_t *carved_size,
+     uint32_t *number_of_items,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_carve_validate_item_data(
+     const uint8_t *data,
+     size_t data_size,
+     size_t *item_data_size,
+     uint32_t *number_of_entries,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_carve_scan_buffer_for_item(
+     const uint8_t *buffer,
+     size_t buffer_size,
+     size_t *item_offset,
+     size_t *item_data_size,
+     uint32_t *number_of_entries,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_carve_read_item_file_io_handle(
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     int ascii_codepage,
+     libnk2_item_t **item,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBNK2_CARVE_H ) */
+
@@ -0,0 +1,1564 @@
+/*
+ * Diff functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libnk2_alias_index.h"
+#include "libnk2_alias_index_writer.h"
+#include "libnk2_diff.h"
+#include "libnk2_index.h"
+#include "libnk2_item.h"
+#include "libnk2_libcdata.h"
+#include "libnk2_libcerror.h"
+#include "libnk2_mapi.h"
+#include "libnk2_mapi_value.h"
+#include "libnk2_record_entry.h"
+#include "libnk2_types.h"
+
+/* Creates a diff table of the items of a file
+ * Make sure the value diff_table is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_diff_table_initialize(
+     libnk2_diff_table_t **diff_table,
+     libcdata_array_t *items_array,
+     libcerror_error_t **error )
+{
+	libnk2_diff_item_t *diff_item         = NULL;
+	libnk2_diff_table_t *safe_diff_table  = NULL;
+	libnk2_internal_item_t *internal_item = NULL;
+	static char *function                 = "libnk2_diff_table_initialize";
+	uint32_t bucket_index                 = 0;
+	int item_index                        = 0;
+	int number_of_items                   = 0;
+
+	if( diff_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid diff table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *diff_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid diff table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     items_array,
+	     &number_of_items,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of items.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size_t) number_of_items > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libnk2_diff_item_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of items value exceeds maximum allocation size.",
+		 function );
+
+		return( -1 );
+	}
+	safe_diff_table = memory_allocate_structure(
+	                   libnk2_diff_table_t );
+
+	if( safe_diff_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create diff table.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     safe_diff_table,
+	     0,
+	     sizeof( libnk2_diff_table_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear diff table.",
+		 function );
+
+		memory_free(
+		 safe_diff_table );
+
+		return( -1 );
+	}
+	if( number_of_items > 0 )
+	{
+		safe_diff_table->items = (libnk2_diff_item_t *) memory_allocate(
+		                                                 sizeof( libnk2_diff_item_t ) * number_of_items );
+
+		if( safe_diff_table->items == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create items.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     safe_diff_table->items,
+		     0,
+		     sizeof( libnk2_diff_item_t ) * number_of_items ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear items.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( item_index = 0;
+	     item_index < number_of_items;
+	     item_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     items_array,
+		     item_index,
+		     (intptr_t **) &internal_item,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve item: %d.",
+			 function,
+			 item_index );
+
+			goto on_error;
+		}
+		if( internal_item == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing item: %d.",
+			 function,
+			 item_index );
+
+			goto on_error;
+		}
+		diff_item = &( safe_diff_table->items[ item_index ] );
+
+		diff_item->internal_item = internal_item;
+		diff_item->match_index   = -1;
+		diff_item->next_index    = -1;
+	}
+	safe_diff_table->number_of_items   = number_of_items;
+	safe_diff_table->number_of_buckets = 16;
+
+	while( safe_diff_table->number_of_buckets < (uint32_t) number_of_items )
+	{
+		safe_diff_table->number_of_buckets *= 2;
+	}
+	safe_diff_table->buckets = (int *) memory_allocate(
+	                                    sizeof( int ) * safe_diff_table->number_of_buckets );
+
+	if( safe_diff_table->buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buckets.",
+		 function );
+
+		goto on_error;
+	}
+	for( bucket_index = 0;
+	     bucket_index < safe_diff_table->number_of_buckets;
+	     bucket_index++ )
+	{
+		safe_diff_table->buckets[ bucket_index ] = -1;
+	}
+	*diff_table = safe_diff_table;
+
+	return( 1 );
+
+on_error:
+	if( safe_diff_table != NULL )
+	{
+		libnk2_diff_table_free(
+		 &safe_diff_table,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a diff table
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_diff_table_free(
+     libnk2_diff_table_t **diff_table,
+     libcerror_error_t **error )
+{
+	static char *function = "libnk2_diff_table_free";
+
+	if( diff_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid diff table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *diff_table != NULL )
+	{
+		if( ( *diff_table )->buckets != NULL )
+		{
+			memory_free(
+			 ( *diff_table )->buckets );
+		}
+		if( ( *diff_table )->items != NULL )
+		{
+			memory_free(
+			 ( *diff_table )->items );
+		}
+		memory_free(
+		 *diff_table );
+
+		*diff_table = NULL;
+	}
+	return( 1 );
+}
+
+/* Fills the buckets of a diff table with the items that have no matching item
+ * The items are bucketed by either their content hash or their identity hash
+ */
+void libnk2_diff_table_fill_buckets(
+      libnk2_diff_table_t *diff_table,
+      uint8_t use_identity_hash )
+{
+	libnk2_diff_item_t *diff_item = NULL;
+	uint64_t hash                 = 0;
+	uint32_t bucket_index         = 0;
+	int item_index                = 0;
+
+	if( ( diff_table == NULL )
+	 || ( diff_table->buckets == NULL ) )
+	{
+		return;
+	}
+	for( bucket_index = 0;
+	     bucket_index < diff_table->number_of_buckets;
+	     bucket_index++ )
+	{
+		diff_table->buckets[ bucket_index ] = -1;
+	}
+	/* The items are added in reverse order so that the items in a bucket
+	 * are stored in ascending item index order
+	 */
+	for( item_index = diff_table->number_of_items - 1;
+	     item_index >= 0;
+	     item_index-- )
+	{
+		diff_item = &( diff_table->items[ item_index ] );
+
+		diff_item->next_index = -1;
+
+		if( diff_item->match_index != -1 )
+		{
+			continue;
+		}
+		if( use_identity_hash != 0 )
+		{
+			if( diff_item->has_identity_hash == 0 )
+			{
+				continue;
+			}
+			hash = diff_item->identity_hash;
+		}
+		else
+		{
+			hash = diff_item->internal_item->content_hash;
+		}
+		bucket_index = (uint32_t) ( hash & ( diff_table->number_of_buckets - 1 ) );
+
+		diff_item->next_index               = diff_table->buckets[ bucket_index ];
+		diff_table->buckets[ bucket_index ] = item_index;
+	}
+}
+
+/* Retrieves the identity of an item
+ * The identity of an item is its normalized email address or, if not available, its display name
+ * The identity is stored in utf8_string without an end-of-string character
+ * Returns 1 if successful, 0 if the item has no identity or -1 on error
+ */
+int libnk2_diff_get_identity(
+     libnk2_internal_item_t *internal_item,
+     uint8_t **utf8_string,
+     size_t *utf8_string_allocated_size,
+     size_t *utf8_string_length,
+     uint32_t *entry_type,
+     libcerror_error_t **error )
+{
+	libnk2_internal_record_entry_t *display_name_record_entry  = NULL;
+	libnk2_internal_record_entry_t *email_address_record_entry = NULL;
+	libnk2_internal_record_entry_t *internal_record_entry      = NULL;
+	static char *function                                      = "libnk2_diff_get_identity";
+	size_t utf8_string_length_value                            = 0;
+	size_t utf8_string_size                                    = 0;
+	int entry_index                                            = 0;
+	int number_of_entries                                      = 0;
+	int result                                                 = 0;
+
+	if( internal_item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_length == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string length.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry type.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_item->entries_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_item->entries_array,
+		     entry_index,
+		     (intptr_t **) &internal_record_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve record entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( ( internal_record_entry->entry_type == LIBNK2_ENTRY_TYPE_EMAIL_ADDRESS )
+		 && ( email_address_record_entry == NULL ) )
+		{
+			email_address_record_entry = internal_record_entry;
+		}
+		else if( ( internal_record_entry->entry_type == LIBNK2_ENTRY_TYPE_DISPLAY_NAME )
+		      && ( display_name_record_entry == NULL ) )
+		{
+			display_name_record_entry = internal_record_entry;
+		}
+	}
+	internal_record_entry = email_address_record_entry;
+
+	if( internal_record_entry == NULL )
+	{
+		internal_record_entry = display_name_record_entry;
+	}
+	while( internal_record_entry != NULL )
+	{
+		result = libnk2_index_get_key_string_size(
+		          internal_record_entry,
+		          &utf8_string_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve key string size.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			if( libnk2_alias_index_writer_resize_buffer(
+			     utf8_string,
+			     utf8_string_allocated_size,
+			     utf8_string_size + 1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+				 "%s: unable to resize UTF-8 string.",
+				 function );
+
+				return( -1 );
+			}
+			if( libnk2_mapi_value_get_data_as_utf8_string(
+			     internal_record_entry->value_type,
+			     internal_record_entry->value_data,
+			     internal_record_entry->value_data_size,
+			     internal_record_entry->ascii_codepage,
+			     *utf8_string,
+			     utf8_string_size + 1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve UTF-8 string.",
+				 function );
+
+				return( -1 );
+			}
+			utf8_string_length_value = utf8_string_size;
+
+			if( internal_record_entry->entry_type == LIBNK2_ENTRY_TYPE_EMAIL_ADDRESS )
+			{
+				if( libnk2_alias_index_normalize_utf8_string(
+				     *utf8_string,
+				     &utf8_string_length_value,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to normalize UTF-8 string.",
+					 function );
+
+					return( -1 );
+				}
+			}
+			if( utf8_string_length_value > 0 )
+			{
+				*utf8_string_length = utf8_string_length_value;
+				*entry_type         = internal_record_entry->entry_type;
+
+				return( 1 );
+			}
+		}
+		if( internal_record_entry == display_name_record_entry )
+		{
+			break;
+		}
+		internal_record_entry = display_name_record_entry;
+	}
+	return( 0 );
+}
+
+/* Retrieves the identity hash of an item
+ * Returns 1 if successful, 0 if the item has no identity or -1 on error
+ */
+int libnk2_diff_get_identity_hash(
+     libnk2_internal_item_t *internal_item,
+     uint8_t **utf8_string,
+     size_t *utf8_string_allocated_size,
+     uint64_t *identity_hash,
+     libcerror_error_t **error )
+{
+	uint8_t entry_type_data[ 4 ];
+
+	static char *function     = "libnk2_diff_get_identity_hash";
+	size_t utf8_string_length = 0;
+	uint32_t entry_type       = 0;
+	int result                = 0;
+
+	if( identity_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid identity hash.",
+		 function );
+
+		return( -1 );
+	}
+	result = libnk2_diff_get_identity(
+	          internal_item,
+	          utf8_string,
+	          utf8_string_allocated_size,
+	          &utf8_string_length,
+	          &entry_type,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve identity.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		/* The entry type is part of the hash so that an email address
+		 * does not match a display name with the same value
+		 */
+		byte_stream_copy_from_uint32_little_endian(
+		 entry_type_data,
+		 entry_type );
+
+		*identity_hash = libnk2_item_update_content_hash(
+		                  LIBNK2_ITEM_CONTENT_HASH_INITIAL_VALUE,
+		                  entry_type_data,
+		                  4 );
+
+		*identity_hash = libnk2_item_update_content_hash(
+		                  *identity_hash,
+		                  *utf8_string,
+		                  utf8_string_length );
+	}
+	return( result );
+}
+
+/* Compares the identities of two items
+ * Returns 1 if equal, 0 if not or -1 on error
+ */
+int libnk2_diff_compare_identities(
+     libnk2_internal_item_t *internal_item,
+     libnk2_internal_item_t *other_internal_item,
+     uint8_t **utf8_string,
+     size_t *utf8_string_allocated_size,
+     uint8_t **other_utf8_string,
+     size_t *other_utf8_string_allocated_size,
+     libcerror_error_t **error )
+{
+	static char *function           = "libnk2_diff_compare_identities";
+	size_t other_utf8_string_length = 0;
+	size_t utf8_string_length       = 0;
+	uint32_t entry_type             = 0;
+	uint32_t other_entry_type       = 0;
+	int result                      = 0;
+
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( other_utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid other UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	result = libnk2_diff_get_identity(
+	          internal_item,
+	          utf8_string,
+	          utf8_string_allocated_size,
+	          &utf8_string_length,
+	          &entry_type,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve identity.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	result = libnk2_diff_get_identity(
+	          other_internal_item,
+	          other_utf8_string,
+	          other_utf8_string_allocated_size,
+	          &other_utf8_string_length,
+	          &other_entry_type,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve identity of other item.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( ( entry_type != other_entry_type )
+	 || ( utf8_string_length != other_utf8_string_length ) )
+	{
+		return( 0 );
+	}
+	if( memory_compare(
+	     *utf8_string,
+	     *other_utf8_string,
+	     utf8_string_length ) != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Compares two record entries
+ * Returns 1 if equal or 0 if not
+ */
+int libnk2_diff_compare_record_entries(
+     libnk2_internal_record_entry_t *internal_record_entry,
+     libnk2_internal_record_entry_t *other_internal_record_entry )
+{
+	if( ( internal_record_entry == NULL )
+	 || ( other_internal_record_entry == NULL ) )
+	{
+		return( 0 );
+	}
+	if( ( internal_record_entry->entry_type != other_internal_record_entry->entry_type )
+	 || ( internal_record_entry->value_type != other_internal_record_entry->value_type )
+	 || ( internal_record_entry->value_data_size != other_internal_record_entry->value_data_size ) )
+	{
+		return( 0 );
+	}
+	if( internal_record_entry->value_data_size == 0 )
+	{
+		return( 1 );
+	}
+	if( ( internal_record_entry->value_data == NULL )
+	 || ( other_internal_record_entry->value_data == NULL ) )
+	{
+		return( 0 );
+	}
+	/* Value data shared by a value table is compared by reference
+	 */
+	if( internal_record_entry->value_data == other_internal_record_entry->value_data )
+	{
+		return( 1 );
+	}
+	if( memory_compare(
+	     internal_record_entry->value_data,
+	     other_internal_record_entry->value_data,
+	     internal_record_entry->value_data_size ) != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Compares the record entries of two items
+ * Returns 1 if equal, 0 if not or -1 on error
+ */
+int libnk2_diff_compare_items(
+     libnk2_internal_item_t *internal_item,
+     libnk2_internal_item_t *other_internal_item,
+     libcerror_error_t **error )
+{
+	libnk2_internal_record_entry_t *internal_record_entry       = NULL;
+	libnk2_internal_record_entry_t *other_internal_record_entry = NULL;
+	static char *function                                       = "libnk2_diff_compare_items";
+	int entry_index                                             = 0;
+	int number_of_entries                                       = 0;
+	int other_number_of_entries                                 = 0;
+
+	if( internal_item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
+
+		return( -1 );
+	}
+	if( other_internal_item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid other item.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_item->content_hash != other_internal_item->content_hash )
+	{
+		return( 0 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_item->entries_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     other_internal_item->entries_array,
+	     &other_number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries of other item.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_entries != other_number_of_entries )
+	{
+		return( 0 );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_item->entries_array,
+		     entry_index,
+		     (intptr_t **) &internal_record_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve record entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( libcdata_array_get_entry_by_index(
+		     other_internal_item->entries_array,
+		     entry_index,
+		     (intptr_t **) &other_internal_record_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve record entry: %d of other item.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( libnk2_diff_compare_record_entries(
+		     internal_record_entry,
+		     other_internal_record_entry ) != 1 )
+		{
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
+
+/* Reports the record entries that differ between two matching items
+ * Record entries are matched by entry type, in order of occurrence
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_diff_item_entries(
+     libnk2_internal_item_t *internal_item,
+     libnk2_internal_item_t *other_internal_item,
+     libnk2_diff_callbacks_t *callbacks,
+     void *callback_data,
+     uint8_t **entry_is_matched,
+     size_t *entry_is_matched_allocated_size,
+     libcerror_error_t **error )
+{
+	libnk2_internal_record_entry_t *internal_record_entry       = NULL;
+	libnk2_internal_record_entry_t *other_internal_record_entry = NULL;
+	static char *function                                       = "libnk2_diff_item_entries";
+	int entry_index                                             = 0;
+	int number_of_entries                                       = 0;
+	int other_entry_index                                       = 0;
+	int other_number_of_entries                                 = 0;
+
+	if( internal_item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
+
+		return( -1 );
+	}
+	if( other_internal_item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid other item.",
+		 function );
+
+		return( -1 );
+	}
+	if( callbacks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callbacks.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_is_matched == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry is matched.",
+		 function );
+
+		return( -1 );
+	}
+	if( callbacks->entry_changed == NULL )
+	{
+		return( 1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_item->entries_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     other_internal_item->entries_array,
+	     &other_number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries of other item.",
+		 function );
+
+		return( -1 );
+	}
+	if( other_number_of_entries > 0 )
+	{
+		if( libnk2_alias_index_writer_resize_buffer(
+		     entry_is_matched,
+		     entry_is_matched_allocated_size,
+		     (size_t) other_number_of_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize entry is matched.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     *entry_is_matched,
+		     0,
+		     (size_t) other_number_of_entries ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear entry is matched.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_item->entries_array,
+		     entry_index,
+		     (intptr_t **) &internal_record_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve record entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		for( other_entry_index = 0;
+		     other_entry_index < other_number_of_entries;
+		     other_entry_index++ )
+		{
+			if( ( *entry_is_matched )[ other_entry_index ] != 0 )
+			{
+				continue;
+			}
+			if( libcdata_array_get_entry_by_index(
+			     other_internal_item->entries_array,
+			     other_entry_index,
+			     (intptr_t **) &other_internal_record_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve record entry: %d of other item.",
+				 function,
+				 other_entry_index );
+
+				return( -1 );
+			}
+			if( other_internal_record_entry->entry_type == internal_record_entry->entry_type )
+			{
+				break;
+			}
+		}
+		if( other_entry_index < other_number_of_entries )
+		{
+			( *entry_is_matched )[ other_entry_index ] = 1;
+
+			if( libnk2_diff_compare_record_entries(
+			     internal_record_entry,
+			     other_internal_record_entry ) == 1 )
+			{
+				continue;
+			}
+		}
+		else
+		{
+			other_internal_record_entry = NULL;
+		}
+		if( callbacks->entry_changed(
+		     (libnk2_record_entry_t *) internal_record_entry,
+		     (libnk2_record_entry_t *) other_internal_record_entry,
+		     callback_data ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: entry changed callback failed for record entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+	}
+	for( other_entry_index = 0;
+	     other_entry_index < other_number_of_entries;
+	     other_entry_index++ )
+	{
+		if( ( *entry_is_matched )[ other_entry_index ] != 0 )
+		{
+			continue;
+		}
+		if( libcdata_array_get_entry_by_index(
+		     other_internal_item->entries_array,
+		     other_entry_index,
+		     (intptr_t **) &other_internal_record_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve record entry: %d of other item.",
+			 function,
+			 other_entry_index );
+
+			return( -1 );
+		}
+		if( callbacks->entry_changed(
+		     NULL,
+		     (libnk2_record_entry_t *) other_internal_record_entry,
+		     callback_data ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: entry changed callback failed for record entry: %d of other item.",
+			 function,
+			 other_entry_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Reports the differences between the items of two files
+ * Items are first matched by content hash, which detects the unchanged items,
+ * the remaining items are matched by identity, which detects the modified items
+ * Both matches use hash tables so that the diff is linear in the number of items
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_diff_items(
+     libcdata_array_t *items_array,
+     libcdata_array_t *other_items_array,
+     libnk2_diff_callbacks_t *callbacks,
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	libnk2_diff_item_t *diff_item           = NULL;
+	libnk2_diff_item_t *other_diff_item     = NULL;
+	libnk2_diff_table_t *diff_table         = NULL;
+	libnk2_diff_table_t *other_diff_table   = NULL;
+	uint8_t *entry_is_matched               = NULL;
+	uint8_t *other_utf8_string              = NULL;
+	uint8_t *utf8_string                    = NULL;
+	static char *function                   = "libnk2_diff_items";
+	size_t entry_is_matched_allocated_size  = 0;
+	size_t other_utf8_string_allocated_size = 0;
+	size_t utf8_string_allocated_size       = 0;
+	uint32_t bucket_index                   = 0;
+	int item_index                          = 0;
+	int other_item_index                    = 0;
+	int result                              = 0;
+
+	if( callbacks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callbacks.",
+		 function );
+
+		return( -1 );
+	}
+	if( libnk2_diff_table_initialize(
+	     &diff_table,
+	     items_array,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create diff table.",
+		 function );
+
+		goto on_error;
+	}
+	if( libnk2_diff_table_initialize(
+	     &other_diff_table,
+	     other_items_array,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create other diff table.",
+		 function );
+
+		goto on_error;
+	}
+	/* The first pass matches the unchanged items by content hash
+	 */
+	libnk2_diff_table_fill_buckets(
+	 other_diff_table,
+	 0 );
+
+	for( item_index = 0;
+	     item_index < diff_table->number_of_items;
+	     item_index++ )
+	{
+		diff_item = &( diff_table->items[ item_index ] );
+
+		bucket_index = (uint32_t) ( diff_item->internal_item->content_hash & ( other_diff_table->number_of_buckets - 1 ) );
+
+		for( other_item_index = other_diff_table->buckets[ bucket_index ];
+		     other_item_index != -1;
+		     other_item_index = other_diff_item->next_index )
+		{
+			other_diff_item = &( other_diff_table->items[ other_item_index ] );
+
+			if( other_diff_item->match_index != -1 )
+			{
+				continue;
+			}
+			result = libnk2_diff_compare_items(
+			          diff_item->internal_item,
+			          other_diff_item->internal_item,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to compare item: %d with other item: %d.",
+				 function,
+				 item_index,
+				 other_item_index );
+
+				goto on_error;
+			}
+			else if( result != 0 )
+			{
+				diff_item->match_index       = other_item_index;
+				other_diff_item->match_index = item_index;
+
+				break;
+			}
+		}
+	}
+	/* The second pass matches the modified items by identity
+	 */
+	for( item_index = 0;
+	     item_index < diff_table->number_of_items;
+	     item_index++ )
+	{
+		diff_item = &( diff_table->items[ item_index ] );
+
+		if( diff_item->match_index != -1 )
+		{
+			continue;
+		}
+		result = libnk2_diff_get_identity_hash(
+		          diff_item->internal_item,
+		          &utf8_string,
+		          &utf8_string_allocated_size,
+		          &( diff_item->identity_hash ),
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve identity hash of item: %d.",
+			 function,
+			 item_index );
+
+			goto on_error;
+		}
+		diff_item->has_identity_hash = (uint8_t) result;
+	}
+	for( other_item_index = 0;
+	     other_item_index < other_diff_table->number_of_items;
+	     other_item_index++ )
+	{
+		other_diff_item = &( other_diff_table->items[ other_item_index ] );
+
+		if( other_diff_item->match_index != -1 )
+		{
+			continue;
+		}
+		result = libnk2_diff_get_identity_hash(
+		          other_diff_item->internal_item,
+		          &utf8_string,
+		          &utf8_string_allocated_size,
+		          &( other_diff_item->identity_hash ),
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve identity hash of other item: %d.",
+			 function,
+			 other_item_index );
+
+			goto on_error;
+		}
+		other_diff_item->has_identity_hash = (uint8_t) result;
+	}
+	libnk2_diff_table_fill_buckets(
+	 other_diff_table,
+	 1 );
+
+	for( item_index = 0;
+	     item_index < diff_table->number_of_items;
+	     item_index++ )
+	{
+		diff_item = &( diff_table->items[ item_index ] );
+
+		if( ( diff_item->match_index != -1 )
+		 || ( diff_item->has_identity_hash == 0 ) )
+		{
+			continue;
+		}
+		bucket_index = (uint32_t) ( diff_item->identity_hash & ( other_diff_table->number_of_buckets - 1 ) );
+
+		for( other_item_index = other_diff_table->buckets[ bucket_index ];
+		     other_item_index != -1;
+		     other_item_index = other_diff_item->next_index )
+		{
+			other_diff_item = &( other_diff_table->items[ other_item_index ] );
+
+			if( ( other_diff_item->match_index != -1 )
+			 || ( other_diff_item->identity_hash != diff_item->identity_hash ) )
+			{
+				continue;
+			}
+			/* The identities are compared since different identities can have the same hash
+			 */
+			result = libnk2_diff_compare_identities(
+			          diff_item->internal_item,
+			          other_diff_item->internal_item,
+			          &utf8_string,
+			          &utf8_string_allocated_size,
+			          &other_utf8_string,
+			          &other_utf8_string_allocated_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to compare identity of item: %d with other item: %d.",
+				 function,
+				 item_index,
+				 other_item_index );
+
+				goto on_error;
+			}
+			else if( result != 0 )
+			{
+				diff_item->match_index       = other_item_index;
+				diff_item->is_modified       = 1;
+				other_diff_item->match_index = item_index;
+				other_diff_item->is_modified = 1;
+
+				break;
+			}
+		}
+	}
+	/* The removed and modified items are reported in order of the file
+	 * followed by the added items in order of the other file
+	 */
+	for( item_index = 0;
+	     item_index < diff_table->number_of_items;
+	     item_index++ )
+	{
+		diff_item = &( diff_table->items[ item_index ] );
+
+		if( diff_item->match_index == -1 )
+		{
+			if( callbacks->item_removed != NULL )
+			{
+				if( callbacks->item_removed(
+				     (libnk2_item_t *) diff_item->internal_item,
+				     item_index,
+				     callback_data ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: item removed callback failed for item: %d.",
+					 function,
+					 item_index );
+
+					goto on_error;
+				}
+			}
+			continue;
+		}
+		if( diff_item->is_modified == 0 )
+		{
+			continue;
+		}
+		other_diff_item = &( other_diff_table->items[ diff_item->match_index ] );
+
+		if( callbacks->item_modified != NULL )
+		{
+			if( callbacks->item_modified(
+			     (libnk2_item_t *) diff_item->internal_item,
+			     item_index,
+			     (libnk2_item_t *) other_diff_item->internal_item,
+			     diff_item->match_index,
+			     callback_data ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: item modified callback failed for item: %d.",
+				 function,
+				 item_index );
+
+				goto on_error;
+			}
+		}
+		if( libnk2_diff_item_entries(
+		     diff_item->internal_item,
+		     other_diff_item->internal_item,
+		     callbacks,
+		     callback_data,
+		     &entry_is_matched,
+		     &entry_is_matched_allocated_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to diff record entries of item: %d.",
+			 function,
+			 item_index );
+
+			goto on_error;
+		}
+	}
+	for( other_item_index = 0;
+	     other_item_index < other_diff_table->number_of_items;
+	     other_item_index++ )
+	{
+		other_diff_item = &( other_diff_table->items[ other_item_index ] );
+
+		if( other_diff_item->match_index != -1 )
+		{
+			continue;
+		}
+		if( callbacks->item_added != NULL )
+		{
+			if( callbacks->item_added(
+			     (libnk2_item_t *) other_diff_item->internal_item,
+			     other_item_index,
+			     callback_data ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: item added callback failed for item: %d.",
+				 function,
+				 other_item_index );
+
+				goto on_error;
+			}
+		}
+	}
+	if( entry_is_matched != NULL )
+	{
+		memory_free(
+		 entry_is_matched );
+
+		entry_is_matched = NULL;
+	}
+	if( other_utf8_string != NULL )
+	{
+		memory_free(
+		 other_utf8_string );
+
+		other_utf8_string = NULL;
+	}
+	if( utf8_string != NULL )
+	{
+		memory_free(
+		 utf8_string );
+
+		utf8_string = NULL;
+	}
+	if( libnk2_diff_table_free(
+	     &other_diff_table,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free other diff table.",
+		 function );
+
+		goto on_error;
+	}
+	if( libnk2_diff_table_free(
+	     &diff_table,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free diff table.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( entry_is_matched != NULL )
+	{
+		memory_free(
+		 entry_is_matched );
+	}
+	if( other_utf8_string != NULL )
+	{
+		memory_free(
+		 other_utf8_string );
+	}
+	if( utf8_string != NULL )
+	{
+		memory_free(
+		 utf8_string );
+	}
+	if( other_diff_table != NULL )
+	{
+		libnk2_diff_table_free(
+		 &other_diff_table,
+		 NULL );
+	}
+	if( diff_table != NULL )
+	{
+		libnk2_diff_table_free(
+		 &diff_table,
+		 NULL );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,155 @@
+/*
+ * Diff functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBNK2_DIFF_H )
+#define _LIBNK2_DIFF_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libnk2_item.h"
+#include "libnk2_libcdata.h"
+#include "libnk2_libcerror.h"
+#include "libnk2_record_entry.h"
+#include "libnk2_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libnk2_diff_item libnk2_diff_item_t;
+
+struct libnk2_diff_item
+{
+	/* The item
+	 */
+	libnk2_internal_item_t *internal_item;
+
+	/* The identity hash, a 64-bit FNV-1a hash of the normalized email address or the display name
+	 */
+	uint64_t identity_hash;
+
+	/* Value to indicate the identity hash is set
+	 */
+	uint8_t has_identity_hash;
+
+	/* Value to indicate the matching item has different record entries
+	 */
+	uint8_t is_modified;
+
+	/* The index of the matching item in the other table or -1 if not set
+	 */
+	int match_index;
+
+	/* The index of the next item in the bucket or -1 if not set
+	 */
+	int next_index;
+};
+
+typedef struct libnk2_diff_table libnk2_diff_table_t;
+
+struct libnk2_diff_table
+{
+	/* The items
+	 */
+	libnk2_diff_item_t *items;
+
+	/* The number of items
+	 */
+	int number_of_items;
+
+	/* The buckets, that contain the index of the first item or -1 if not set
+	 */
+	int *buckets;
+
+	/* The number of buckets, which is a power of 2
+	 */
+	uint32_t number_of_buckets;
+};
+
+int libnk2_diff_table_initialize(
+     libnk2_diff_table_t **diff_table,
+     libcdata_array_t *items_array,
+     libcerror_error_t **error );
+
+int libnk2_diff_table_free(
+     libnk2_diff_table_t **diff_table,
+     libcerror_error_t **error );
+
+void libnk2_diff_table_fill_buckets(
+      libnk2_diff_table_t *diff_table,
+      uint8_t use_identity_hash );
+
+int libnk2_diff_get_identity(
+     libnk2_internal_item_t *internal_item,
+     uint8_t **utf8_string,
+     size_t *utf8_string_allocated_size,
+     size_t *utf8_string_length,
+     uint32_t *entry_type,
+     libcerror_error_t **error );
+
+int libnk2_diff_get_identity_hash(
+     libnk2_internal_item_t *internal_item,
+     uint8_t **utf8_string,
+     size_t *utf8_string_allocated_size,
+     uint64_t *identity_hash,
+     libcerror_error_t **error );
+
+int libnk2_diff_compare_identities(
+     libnk2_internal_item_t *internal_item,
+     libnk2_internal_item_t *other_internal_item,
+     uint8_t **utf8_string,
+     size_t *utf8_string_allocated_size,
+     uint8_t **other_utf8_string,
+     size_t *other_utf8_string_allocated_size,
+     libcerror_error_t **error );
+
+int libnk2_diff_compare_record_entries(
+     libnk2_internal_record_entry_t *internal_record_entry,
+     libnk2_internal_record_entry_t *other_internal_record_entry );
+
+int libnk2_diff_compare_items(
+     libnk2_internal_item_t *internal_item,
+     libnk2_internal_item_t *other_internal_item,
+     libcerror_error_t **error );
+
+int libnk2_diff_item_entries(
+     libnk2_internal_item_t *internal_item,
+     libnk2_internal_item_t *other_internal_item,
+     libnk2_diff_callbacks_t *callbacks,
+     void *callback_data,
+     uint8_t **entry_is_matched,
+     size_t *entry_is_matched_allocated_size,
+     libcerror_error_t **error );
+
+int libnk2_diff_items(
+     libcdata_array_t *items_array,
+     libcdata_array_t *other_items_array,
+     libnk2_diff_callbacks_t *callbacks,
+     void *callback_data,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBNK2_DIFF_H ) */
+
@@ -0,0 +1,832 @@
+/*
+ * Digest functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libnk2_definitions.h"
+#include "libnk2_digest.h"
+#include "libnk2_libcerror.h"
+
+#define libnk2_digest_rotate_left( value, number_of_bits ) \
+	( ( ( value ) << ( number_of_bits ) ) | ( ( value ) >> ( 32 - ( number_of_bits ) ) ) )
+
+#define libnk2_digest_rotate_right( value, number_of_bits ) \
+	( ( ( value ) >> ( number_of_bits ) ) | ( ( value ) << ( 32 - ( number_of_bits ) ) ) )
+
+/* The MD5 sine derived constants
+ */
+const uint32_t libnk2_digest_md5_constants[ 64 ] = {
+	0xd76aa478UL, 0xe8c7b756UL, 0x242070dbUL, 0xc1bdceeeUL, 0xf57c0fafUL, 0x4787c62aUL, 0xa8304613UL, 0xfd469501UL,
+	0x698098d8UL, 0x8b44f7afUL, 0xffff5bb1UL, 0x895cd7beUL, 0x6b901122UL, 0xfd987193UL, 0xa679438eUL, 0x49b40821UL,
+	0xf61e2562UL, 0xc040b340UL, 0x265e5a51UL, 0xe9b6c7aaUL, 0xd62f105dUL, 0x02441453UL, 0xd8a1e681UL, 0xe7d3fbc8UL,
+	0x21e1cde6UL, 0xc33707d6UL, 0xf4d50d87UL, 0x455a14edUL, 0xa9e3e905UL, 0xfcefa3f8UL, 0x676f02d9UL, 0x8d2a4c8aUL,
+	0xfffa3942UL, 0x8771f681UL, 0x6d9d6122UL, 0xfde5380cUL, 0xa4beea44UL, 0x4bdecfa9UL, 0xf6bb4b60UL, 0xbebfbc70UL,
+	0x289b7ec6UL, 0xeaa127faUL, 0xd4ef3085UL, 0x04881d05UL, 0xd9d4d039UL, 0xe6db99e5UL, 0x1fa27cf8UL, 0xc4ac5665UL,
+	0xf4292244UL, 0x432aff97UL, 0xab9423a7UL, 0xfc93a039UL, 0x655b59c3UL, 0x8f0ccc92UL, 0xffeff47dUL, 0x85845dd1UL,
+	0x6fa87e4fUL, 0xfe2ce6e0UL, 0xa3014314UL, 0x4e0811a1UL, 0xf7537e82UL, 0xbd3af235UL, 0x2ad7d2bbUL, 0xeb86d391UL };
+
+/* The MD5 number of bits to rotate per round
+ */
+const uint8_t libnk2_digest_md5_shifts[ 16 ] = {
+	7, 12, 17, 22, 5, 9, 14, 20, 4, 11, 16, 23, 6, 10, 15, 21 };
+
+/* The SHA256 round constants
+ */
+const uint32_t libnk2_digest_sha256_constants[ 64 ] = {
+	0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL, 0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
+	0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL, 0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
+	0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL, 0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL,
+	0x983e5152UL, 0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL, 0xc6e00bf3UL, 0xd5a79147UL, 0x06ca6351UL, 0x14292967UL,
+	0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL, 0x53380d13UL, 0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+	0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL, 0xd192e819UL, 0xd6990624UL, 0xf40e3585UL, 0x106aa070UL,
+	0x19a4c116UL, 0x1e376c08UL, 0x2748774cUL, 0x34b0bcb5UL, 0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL, 0x682e6ff3UL,
+	0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL, 0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL };
+
+/* Creates a digest
+ * The digest types are a combination of LIBNK2_DIGEST_TYPE values
+ * Make sure the value digest is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_digest_initialize(
+     libnk2_digest_t **digest,
+     int digest_types,
+     libcerror_error_t **error )
+{
+	static char *function = "libnk2_digest_initialize";
+
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid digest value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( digest_types & ~( LIBNK2_DIGEST_TYPE_MD5 | LIBNK2_DIGEST_TYPE_SHA1 | LIBNK2_DIGEST_TYPE_SHA256 ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported digest types: 0x%02x.",
+		 function,
+		 digest_types );
+
+		return( -1 );
+	}
+	*digest = memory_allocate_structure(
+	           libnk2_digest_t );
+
+	if( *digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create digest.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *digest,
+	     0,
+	     sizeof( libnk2_digest_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear digest.",
+		 function );
+
+		goto on_error;
+	}
+	( *digest )->digest_types = digest_types;
+
+	( *digest )->md5_state[ 0 ] = 0x67452301UL;
+	( *digest )->md5_state[ 1 ] = 0xefcdab89UL;
+	( *digest )->md5_state[ 2 ] = 0x98badcfeUL;
+	( *digest )->md5_state[ 3 ] = 0x10325476UL;
+
+	( *digest )->sha1_state[ 0 ] = 0x67452301UL;
+	( *digest )->sha1_state[ 1 ] = 0xefcdab89UL;
+	( *digest )->sha1_state[ 2 ] = 0x98badcfeUL;
+	( *digest )->sha1_state[ 3 ] = 0x10325476UL;
+	( *digest )->sha1_state[ 4 ] = 0xc3d2e1f0UL;
+
+	( *digest )->sha256_state[ 0 ] = 0x6a09e667UL;
+	( *digest )->sha256_state[ 1 ] = 0xbb67ae85UL;
+	( *digest )->sha256_state[ 2 ] = 0x3c6ef372UL;
+	( *digest )->sha256_state[ 3 ] = 0xa54ff53aUL;
+	( *digest )->sha256_state[ 4 ] = 0x510e527fUL;
+	( *digest )->sha256_state[ 5 ] = 0x9b05688cUL;
+	( *digest )->sha256_state[ 6 ] = 0x1f83d9abUL;
+	( *digest )->sha256_state[ 7 ] = 0x5be0cd19UL;
+
+	return( 1 );
+
+on_error:
+	if( *digest != NULL )
+	{
+		memory_free(
+		 *digest );
+
+		*digest = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a digest
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_digest_free(
+     libnk2_digest_t **digest,
+     libcerror_error_t **error )
+{
+	static char *function = "libnk2_digest_free";
+
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest != NULL )
+	{
+		memory_free(
+		 *digest );
+
+		*digest = NULL;
+	}
+	return( 1 );
+}
+
+/* Applies the MD5 compression function to a 64-byte data block
+ */
+void libnk2_digest_md5_transform(
+      uint32_t state[ 4 ],
+      const uint8_t *block )
+{
+	uint32_t values_32bit[ 16 ];
+
+	uint32_t a          = 0;
+	uint32_t b          = 0;
+	uint32_t c          = 0;
+	uint32_t d          = 0;
+	uint32_t f          = 0;
+	uint8_t round_index = 0;
+	uint8_t value_index = 0;
+
+	for( value_index = 0;
+	     value_index < 16;
+	     value_index++ )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( block[ value_index * 4 ] ),
+		 values_32bit[ value_index ] );
+	}
+	a = state[ 0 ];
+	b = state[ 1 ];
+	c = state[ 2 ];
+	d = state[ 3 ];
+
+	for( round_index = 0;
+	     round_index < 64;
+	     round_index++ )
+	{
+		if( round_index < 16 )
+		{
+			f           = ( b & c ) | ( ~b & d );
+			value_index = round_index;
+		}
+		else if( round_index < 32 )
+		{
+			f           = ( d & b ) | ( ~d & c );
+			value_index = ( ( 5 * round_index ) + 1 ) & 0x0f;
+		}
+		else if( round_index < 48 )
+		{
+			f           = b ^ c ^ d;
+			value_index = ( ( 3 * round_index ) + 5 ) & 0x0f;
+		}
+		else
+		{
+			f           = c ^ ( b | ~d );
+			value_index = ( 7 * round_index ) & 0x0f;
+		}
+		f += a + libnk2_digest_md5_constants[ round_index ] + values_32bit[ value_index ];
+
+		a = d;
+		d = c;
+		c = b;
+		b = b + libnk2_digest_rotate_left(
+		         f,
+		         libnk2_digest_md5_shifts[ ( ( round_index >> 4 ) << 2 ) | ( round_index & 0x03 ) ] );
+	}
+	state[ 0 ] += a;
+	state[ 1 ] += b;
+	state[ 2 ] += c;
+	state[ 3 ] += d;
+}
+
+/* Applies the SHA1 compression function to a 64-byte data block
+ */
+void libnk2_digest_sha1_transform(
+      uint32_t state[ 5 ],
+      const uint8_t *block )
+{
+	uint32_t values_32bit[ 80 ];
+
+	uint32_t a          = 0;
+	uint32_t b          = 0;
+	uint32_t c          = 0;
+	uint32_t d          = 0;
+	uint32_t e          = 0;
+	uint32_t f          = 0;
+	uint32_t k          = 0;
+	uint32_t t          = 0;
+	uint8_t value_index = 0;
+
+	for( value_index = 0;
+	     value_index < 16;
+	     value_index++ )
+	{
+		byte_stream_copy_to_uint32_big_endian(
+		 &( block[ value_index * 4 ] ),
+		 values_32bit[ value_index ] );
+	}
+	for( value_index = 16;
+	     value_index < 80;
+	     value_index++ )
+	{
+		t = values_32bit[ value_index - 3 ]
+		  ^ values_32bit[ value_index - 8 ]
+		  ^ values_32bit[ value_index - 14 ]
+		  ^ values_32bit[ value_index - 16 ];
+
+		values_32bit[ value_index ] = libnk2_digest_rotate_left(
+		                               t,
+		                               1 );
+	}
+	a = state[ 0 ];
+	b = state[ 1 ];
+	c = state[ 2 ];
+	d = state[ 3 ];
+	e = state[ 4 ];
+
+	for( value_index = 0;
+	     value_index < 80;
+	     value_index++ )
+	{
+		if( value_index < 20 )
+		{
+			f = ( b & c ) | ( ~b & d );
+			k = 0x5a827999UL;
+		}
+		else if( value_index < 40 )
+		{
+			f = b ^ c ^ d;
+			k = 0x6ed9eba1UL;
+		}
+		else if( value_index < 60 )
+		{
+			f = ( b & c ) | ( b & d ) | ( c & d );
+			k = 0x8f1bbcdcUL;
+		}
+		else
+		{
+			f = b ^ c ^ d;
+			k = 0xca62c1d6UL;
+		}
+		t = libnk2_digest_rotate_left( a, 5 ) + f + e + k + values_32bit[ value_index ];
+		e = d;
+		d = c;
+		c = libnk2_digest_rotate_left( b, 30 );
+		b = a;
+		a = t;
+	}
+	state[ 0 ] += a;
+	state[ 1 ] += b;
+	state[ 2 ] += c;
+	state[ 3 ] += d;
+	state[ 4 ] += e;
+}
+
+/* Applies the SHA256 compression function to a 64-byte data block
+ */
+void libnk2_digest_sha256_transform(
+      uint32_t state[ 8 ],
+      const uint8_t *block )
+{
+	uint32_t values_32bit[ 64 ];
+	uint32_t working_state[ 8 ];
+
+	uint32_t s0         = 0;
+	uint32_t s1         = 0;
+	uint32_t t1         = 0;
+	uint32_t t2         = 0;
+	uint8_t state_index = 0;
+	uint8_t value_index = 0;
+
+	for( value_index = 0;
+	     value_index < 16;
+	     value_index++ )
+	{
+		byte_stream_copy_to_uint32_big_endian(
+		 &( block[ value_index * 4 ] ),
+		 values_32bit[ value_index ] );
+	}
+	for( value_index = 16;
+	     value_index < 64;
+	     value_index++ )
+	{
+		s0 = libnk2_digest_rotate_right( values_32bit[ value_index - 15 ], 7 )
+		   ^ libnk2_digest_rotate_right( values_32bit[ value_index - 15 ], 18 )
+		   ^ ( values_32bit[ value_index - 15 ] >> 3 );
+
+		s1 = libnk2_digest_rotate_right( values_32bit[ value_index - 2 ], 17 )
+		   ^ libnk2_digest_rotate_right( values_32bit[ value_index - 2 ], 19 )
+		   ^ ( values_32bit[ value_index - 2 ] >> 10 );
+
+		values_32bit[ value_index ] = values_32bit[ value_index - 16 ] + s0 + values_32bit[ value_index - 7 ] + s1;
+	}
+	for( state_index = 0;
+	     state_index < 8;
+	     state_index++ )
+	{
+		working_state[ state_index ] = state[ state_index ];
+	}
+	for( value_index = 0;
+	     value_index < 64;
+	     value_index++ )
+	{
+		s1 = libnk2_digest_rotate_right( working_state[ 4 ], 6 )
+		   ^ libnk2_digest_rotate_right( working_state[ 4 ], 11 )
+		   ^ libnk2_digest_rotate_right( working_state[ 4 ], 25 );
+
+		t1 = working_state[ 7 ] + s1
+		   + ( ( working_state[ 4 ] & working_state[ 5 ] ) ^ ( ~working_state[ 4 ] & working_state[ 6 ] ) )
+		   + libnk2_digest_sha256_constants[ value_index ] + values_32bit[ value_index ];
+
+		s0 = libnk2_digest_rotate_right( working_state[ 0 ], 2 )
+		   ^ libnk2_digest_rotate_right( working_state[ 0 ], 13 )
+		   ^ libnk2_digest_rotate_right( working_state[ 0 ], 22 );
+
+		t2 = s0
+		   + ( ( working_state[ 0 ] & working_state[ 1 ] ) ^ ( working_state[ 0 ] & working_state[ 2 ] ) ^ ( working_state[ 1 ] & working_state[ 2 ] ) );
+
+		working_state[ 7 ] = working_state[ 6 ];
+		working_state[ 6 ] = working_state[ 5 ];
+		working_state[ 5 ] = working_state[ 4 ];
+		working_state[ 4 ] = working_state[ 3 ] + t1;
+		working_state[ 3 ] = working_state[ 2 ];
+		working_state[ 2 ] = working_state[ 1 ];
+		working_state[ 1 ] = working_state[ 0 ];
+		working_state[ 0 ] = t1 + t2;
+	}
+	for( state_index = 0;
+	     state_index < 8;
+	     state_index++ )
+	{
+		state[ state_index ] += working_state[ state_index ];
+	}
+}
+
+/* Applies the compression functions of the digest types to a 64-byte data block
+ */
+void libnk2_digest_transform_block(
+      libnk2_digest_t *digest,
+      const uint8_t *block )
+{
+	if( ( digest->digest_types & LIBNK2_DIGEST_TYPE_MD5 ) != 0 )
+	{
+		libnk2_digest_md5_transform(
+		 digest->md5_state,
+		 block );
+	}
+	if( ( digest->digest_types & LIBNK2_DIGEST_TYPE_SHA1 ) != 0 )
+	{
+		libnk2_digest_sha1_transform(
+		 digest->sha1_state,
+		 block );
+	}
+	if( ( digest->digest_types & LIBNK2_DIGEST_TYPE_SHA256 ) != 0 )
+	{
+		libnk2_digest_sha256_transform(
+		 digest->sha256_state,
+		 block );
+	}
+}
+
+/* Updates the digest with data
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_digest_update(
+     libnk2_digest_t *digest,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "libnk2_digest_update";
+	size_t buffer_offset  = 0;
+	size_t copy_size      = 0;
+
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest->is_finalized != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid digest - already finalized.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	digest->data_size += (uint64_t) size;
+
+	if( digest->digest_types == 0 )
+	{
+		return( 1 );
+	}
+	if( digest->block_size > 0 )
+	{
+		copy_size = LIBNK2_DIGEST_BLOCK_SIZE - digest->block_size;
+
+		if( copy_size > size )
+		{
+			copy_size = size;
+		}
+		if( memory_copy(
+		     &( digest->block[ digest->block_size ] ),
+		     buffer,
+		     copy_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data to block.",
+			 function );
+
+			return( -1 );
+		}
+		digest->block_size += copy_size;
+		buffer_offset       = copy_size;
+
+		if( digest->block_size < LIBNK2_DIGEST_BLOCK_SIZE )
+		{
+			return( 1 );
+		}
+		libnk2_digest_transform_block(
+		 digest,
+		 digest->block );
+
+		digest->block_size = 0;
+	}
+	/* Full blocks are transformed directly from the buffer
+	 */
+	while( ( size - buffer_offset ) >= LIBNK2_DIGEST_BLOCK_SIZE )
+	{
+		libnk2_digest_transform_block(
+		 digest,
+		 &( buffer[ buffer_offset ] ) );
+
+		buffer_offset += LIBNK2_DIGEST_BLOCK_SIZE;
+	}
+	if( buffer_offset < size )
+	{
+		if( memory_copy(
+		     digest->block,
+		     &( buffer[ buffer_offset ] ),
+		     size - buffer_offset ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data to block.",
+			 function );
+
+			return( -1 );
+		}
+		digest->block_size = size - buffer_offset;
+	}
+	return( 1 );
+}
+
+/* Finalizes the digest, which pads the remaining data and determines the hashes
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_digest_finalize(
+     libnk2_digest_t *digest,
+     libcerror_error_t **error )
+{
+	static char *function = "libnk2_digest_finalize";
+	uint64_t bit_size     = 0;
+	uint8_t state_index   = 0;
+
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest->is_finalized != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid digest - already finalized.",
+		 function );
+
+		return( -1 );
+	}
+	bit_size = digest->data_size * 8;
+
+	/* The padding consists of a 1-bit, 0-bits and the 64-bit data size in bits,
+	 * which MD5 stores in little-endian and SHA1 and SHA256 in big-endian
+	 */
+	digest->block[ digest->block_size++ ] = 0x80;
+
+	if( digest->block_size > ( LIBNK2_DIGEST_BLOCK_SIZE - 8 ) )
+	{
+		if( memory_set(
+		     &( digest->block[ digest->block_size ] ),
+		     0,
+		     LIBNK2_DIGEST_BLOCK_SIZE - digest->block_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear block.",
+			 function );
+
+			return( -1 );
+		}
+		libnk2_digest_transform_block(
+		 digest,
+		 digest->block );
+
+		digest->block_size = 0;
+	}
+	if( memory_set(
+	     &( digest->block[ digest->block_size ] ),
+	     0,
+	     LIBNK2_DIGEST_BLOCK_SIZE - 8 - digest->block_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( digest->digest_types & LIBNK2_DIGEST_TYPE_MD5 ) != 0 )
+	{
+		byte_stream_copy_from_uint64_little_endian(
+		 &( digest->block[ LIBNK2_DIGEST_BLOCK_SIZE - 8 ] ),
+		 bit_size );
+
+		libnk2_digest_md5_transform(
+		 digest->md5_state,
+		 digest->block );
+
+		for( state_index = 0;
+		     state_index < 4;
+		     state_index++ )
+		{
+			byte_stream_copy_from_uint32_little_endian(
+			 &( digest->md5_hash[ state_index * 4 ] ),
+			 digest->md5_state[ state_index ] );
+		}
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 &( digest->block[ LIBNK2_DIGEST_BLOCK_SIZE - 8 ] ),
+	 bit_size );
+
+	if( ( digest->digest_types & LIBNK2_DIGEST_TYPE_SHA1 ) != 0 )
+	{
+		libnk2_digest_sha1_transform(
+		 digest->sha1_state,
+		 digest->block );
+
+		for( state_index = 0;
+		     state_index < 5;
+		     state_index++ )
+		{
+			byte_stream_copy_from_uint32_big_endian(
+			 &( digest->sha1_hash[ state_index * 4 ] ),
+			 digest->sha1_state[ state_index ] );
+		}
+	}
+	if( ( digest->digest_types & LIBNK2_DIGEST_TYPE_SHA256 ) != 0 )
+	{
+		libnk2_digest_sha256_transform(
+		 digest->sha256_state,
+		 digest->block );
+
+		for( state_index = 0;
+		     state_index < 8;
+		     state_index++ )
+		{
+			byte_stream_copy_from_uint32_big_endian(
+			 &( digest->sha256_hash[ state_index * 4 ] ),
+			 digest->sha256_state[ state_index ] );
+		}
+	}
+	digest->block_size   = 0;
+	digest->is_finalized = 1;
+
+	return( 1 );
+}
+
+/* Retrieves the hash of a specific digest type
+ * Returns 1 if successful, 0 if the digest type was not calculated or -1 on error
+ */
+int libnk2_digest_get_hash(
+     libnk2_digest_t *digest,
+     int digest_type,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error )
+{
+	uint8_t *digest_hash    = NULL;
+	static char *function   = "libnk2_digest_get_hash";
+	size_t digest_hash_size = 0;
+
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest->is_finalized == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid digest - not finalized.",
+		 function );
+
+		return( -1 );
+	}
+	switch( digest_type )
+	{
+		case LIBNK2_DIGEST_TYPE_MD5:
+			digest_hash      = digest->md5_hash;
+			digest_hash_size = LIBNK2_DIGEST_HASH_SIZE_MD5;
+			break;
+
+		case LIBNK2_DIGEST_TYPE_SHA1:
+			digest_hash      = digest->sha1_hash;
+			digest_hash_size = LIBNK2_DIGEST_HASH_SIZE_SHA1;
+			break;
+
+		case LIBNK2_DIGEST_TYPE_SHA256:
+			digest_hash      = digest->sha256_hash;
+			digest_hash_size = LIBNK2_DIGEST_HASH_SIZE_SHA256;
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported digest type: 0x%02x.",
+			 function,
+			 digest_type );
+
+			return( -1 );
+	}
+	if( hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_size < digest_hash_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid hash size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( digest->digest_types & digest_type ) == 0 )
+	{
+		return( 0 );
+	}
+	if( memory_copy(
+	     hash,
+	     digest_hash,
+	     digest_hash_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy hash.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,134 @@
+/*
+ * Digest functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBNK2_DIGEST_H )
+#define _LIBNK2_DIGEST_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libnk2_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The size of a digest data block
+ */
+#define LIBNK2_DIGEST_BLOCK_SIZE	64
+
+typedef struct libnk2_digest libnk2_digest_t;
+
+struct libnk2_digest
+{
+	/* The digest types
+	 */
+	int digest_types;
+
+	/* The MD5 state
+	 */
+	uint32_t md5_state[ 4 ];
+
+	/* The SHA1 state
+	 */
+	uint32_t sha1_state[ 5 ];
+
+	/* The SHA256 state
+	 */
+	uint32_t sha256_state[ 8 ];
+
+	/* The data block, which is shared by all digest types
+	 */
+	uint8_t block[ LIBNK2_DIGEST_BLOCK_SIZE ];
+
+	/* The number of bytes in the data block
+	 */
+	size_t block_size;
+
+	/* The total number of bytes of data
+	 */
+	uint64_t data_size;
+
+	/* The MD5 hash
+	 */
+	uint8_t md5_hash[ 16 ];
+
+	/* The SHA1 hash
+	 */
+	uint8_t sha1_hash[ 20 ];
+
+	/* The SHA256 hash
+	 */
+	uint8_t sha256_hash[ 32 ];
+
+	/* Value to indicate if the digest was finalized
+	 */
+	uint8_t is_finalized;
+};
+
+int libnk2_digest_initialize(
+     libnk2_digest_t **digest,
+     int digest_types,
+     libcerror_error_t **error );
+
+int libnk2_digest_free(
+     libnk2_digest_t **digest,
+     libcerror_error_t **error );
+
+void libnk2_digest_md5_transform(
+      uint32_t state[ 4 ],
+      const uint8_t *block );
+
+void libnk2_digest_sha1_transform(
+      uint32_t state[ 5 ],
+      const uint8_t *block );
+
+void libnk2_digest_sha256_transform(
+      uint32_t state[ 8 ],
+      const uint8_t *block );
+
+void libnk2_digest_transform_block(
+      libnk2_digest_t *digest,
+      const uint8_t *block );
+
+int libnk2_digest_update(
+     libnk2_digest_t *digest,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+int libnk2_digest_finalize(
+     libnk2_digest_t *digest,
+     libcerror_error_t **error );
+
+int libnk2_digest_get_hash(
+     libnk2_digest_t *digest,
+     int digest_type,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBNK2_DIGEST_H ) */
+
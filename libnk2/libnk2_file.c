@@ -25,9 +25,12 @@
 #include <types.h>
 #include <wide_string.h>
 
+#include "libnk2_arrow.h"
 #include "libnk2_codepage.h"
 #include "libnk2_debug.h"
+#include "libnk2_diff.h"
 #include "libnk2_definitions.h"
+#include "libnk2_digest.h"
 #include "libnk2_io_handle.h"
 #include "libnk2_item.h"
 #include "libnk2_file.h"
@@ -37,6 +40,14 @@
 #include "libnk2_libcdata.h"
 #include "libnk2_libcerror.h"
 #include "libnk2_libcnotify.h"
+#include "libnk2_libcthreads.h"
+#include "libnk2_lookup_table.h"
+#include "libnk2_mapi.h"
+#include "libnk2_statistics.h"
+
+#include "nk2_file_footer.h"
+#include "nk2_file_header.h"
+#include "nk2_item.h"
 
 /* Creates a file
  * Make sure the value file is referencing, is set to NULL
@@ -129,6 +140,21 @@ int libnk2_file_initialize(
 
 		goto on_error;
 	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( internal_file->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	*file = (libnk2_file_t *) internal_file;
 
 	return( 1 );
@@ -136,6 +162,12 @@ int libnk2_file_initialize(
 on_error:
 	if( internal_file != NULL )
 	{
+		if( internal_file->io_handle != NULL )
+		{
+			libnk2_io_handle_free(
+			 &( internal_file->io_handle ),
+			 NULL );
+		}
 		if( internal_file->items_array != NULL )
 		{
 			libcdata_array_free(
@@ -220,6 +252,21 @@ int libnk2_file_free(
 
 			result = -1;
 		}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( internal_file->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 internal_file );
 	}
@@ -378,19 +425,56 @@ int libnk2_file_open(
 	     file_io_handle,
 	     access_flags,
 	     error ) != 1 )
+	{
+		/* In lightweight error mode a rejected file does not get an error message
+		 */
+		if( ( internal_file->io_handle == NULL )
+		 || ( internal_file->io_handle->error_mode != LIBNK2_ERROR_MODE_LIGHTWEIGHT ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file: %s.",
+			 function,
+			 filename );
+		}
+		goto on_error;
+	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open file: %s.",
-		 function,
-		 filename );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
 		goto on_error;
 	}
+#endif
 	internal_file->file_io_handle_created_in_library = 1;
 
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		internal_file->file_io_handle_created_in_library = 0;
+
+		goto on_error;
+	}
+#endif
 	return( 1 );
 
 on_error:
@@ -518,19 +602,56 @@ int libnk2_file_open_wide(
 	     file_io_handle,
 	     access_flags,
 	     error ) != 1 )
+	{
+		/* In lightweight error mode a rejected file does not get an error message
+		 */
+		if( ( internal_file->io_handle == NULL )
+		 || ( internal_file->io_handle->error_mode != LIBNK2_ERROR_MODE_LIGHTWEIGHT ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file: %ls.",
+			 function,
+			 filename );
+		}
+		goto on_error;
+	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open file: %ls.",
-		 function,
-		 filename );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
 		goto on_error;
 	}
+#endif
 	internal_file->file_io_handle_created_in_library = 1;
 
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		internal_file->file_io_handle_created_in_library = 0;
+
+		goto on_error;
+	}
+#endif
 	return( 1 );
 
 on_error:
@@ -555,6 +676,7 @@ int libnk2_file_open_file_io_handle(
      libcerror_error_t **error )
 {
 	libnk2_internal_file_t *internal_file = NULL;
+	libcerror_error_t **read_error        = NULL;
 	static char *function                 = "libnk2_file_open_file_io_handle";
 	int bfio_access_flags                 = 0;
 	int file_io_handle_is_open            = 0;
@@ -621,16 +743,41 @@ int libnk2_file_open_file_io_handle(
 	{
 		bfio_access_flags = LIBBFIO_ACCESS_FLAG_READ;
 	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	internal_file->file_io_handle = file_io_handle;
 
+	read_error = error;
+
+	/* In lightweight error mode no error messages are formatted while opening
+	 * and reading, only the domain, code and offset of the error are retained
+	 */
+	if( ( internal_file->io_handle != NULL )
+	 && ( internal_file->io_handle->error_mode == LIBNK2_ERROR_MODE_LIGHTWEIGHT ) )
+	{
+		read_error = NULL;
+	}
 	file_io_handle_is_open = libbfio_handle_is_open(
 	                          internal_file->file_io_handle,
-	                          error );
+	                          read_error );
 
 	if( file_io_handle_is_open == -1 )
 	{
 		libcerror_error_set(
-		 error,
+		 read_error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_OPEN_FAILED,
 		 "%s: unable to determine if file IO handle is open.",
@@ -643,10 +790,23 @@ int libnk2_file_open_file_io_handle(
 		if( libbfio_handle_open(
 		     internal_file->file_io_handle,
 		     bfio_access_flags,
-		     error ) != 1 )
+		     read_error ) != 1 )
 		{
+			if( read_error == NULL )
+			{
+				libnk2_io_handle_clear_last_error(
+				 internal_file->io_handle,
+				 NULL );
+
+				libnk2_io_handle_set_last_error(
+				 internal_file->io_handle,
+				 NULL,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 NULL );
+			}
 			libcerror_error_set(
-			 error,
+			 read_error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_OPEN_FAILED,
 			 "%s: unable to open file IO handle.",
@@ -659,10 +819,10 @@ int libnk2_file_open_file_io_handle(
 	if( libnk2_file_open_read(
 	     internal_file,
 	     file_io_handle,
-	     error ) != 1 )
+	     read_error ) != 1 )
 	{
 		libcerror_error_set(
-		 error,
+		 read_error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
 		 "%s: unable to read from file handle.",
@@ -672,6 +832,21 @@ int libnk2_file_open_file_io_handle(
 	}
 	internal_file->file_io_handle = file_io_handle;
 
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	return( 1 );
 
 on_error:
@@ -680,12 +855,17 @@ on_error:
 	{
 		libbfio_handle_close(
 		 file_io_handle,
-		 error );
+		 NULL );
 
 		internal_file->file_io_handle_opened_in_library = 0;
 	}
 	internal_file->file_io_handle = NULL;
 
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_file->read_write_lock,
+	 NULL );
+#endif
 	return( -1 );
 }
 
@@ -724,6 +904,21 @@ int libnk2_file_close(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -808,8 +1003,55 @@ int libnk2_file_close(
 
 		result = -1;
 	}
+	if( internal_file->lookup_table != NULL )
+	{
+		if( libnk2_lookup_table_free(
+		     &( internal_file->lookup_table ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free lookup table.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_file->digest != NULL )
+	{
+		if( libnk2_digest_free(
+		     &( internal_file->digest ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free digest.",
+			 function );
+
+			result = -1;
+		}
+	}
 	internal_file->modification_time = 0;
 
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	return( result );
 }
 
@@ -821,9 +1063,16 @@ int libnk2_file_open_read(
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error )
 {
+	uint8_t file_footer_data[ sizeof( nk2_file_footer_t ) ];
+	uint8_t file_header_data[ sizeof( nk2_file_header_t ) ];
+
 	libnk2_file_footer_t *file_footer = NULL;
 	libnk2_file_header_t *file_header = NULL;
 	static char *function             = "libnk2_file_open_read";
+	size64_t file_size                = 0;
+	ssize_t read_count                = 0;
+	uint64_t end_time                 = 0;
+	uint64_t start_time               = 0;
 
 	if( internal_file == NULL )
 	{
@@ -849,133 +1098,398 @@ int libnk2_file_open_read(
 	}
 	internal_file->io_handle->abort = 0;
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "Reading file header:\n" );
-	}
-#endif
-	if( libnk2_file_header_initialize(
-	     &file_header,
+	if( libnk2_io_handle_clear_statistics(
+	     internal_file->io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file header.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear statistics.",
 		 function );
 
 		goto on_error;
 	}
-	if( libnk2_file_header_read_file_io_handle(
-	     file_header,
-	     file_io_handle,
+	if( libnk2_io_handle_clear_last_error(
+	     internal_file->io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read file header.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear last error.",
 		 function );
 
 		goto on_error;
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( internal_file->digest_types != 0 )
 	{
-		libcnotify_printf(
-		 "Reading items:\n" );
+		if( libnk2_digest_initialize(
+		     &( internal_file->digest ),
+		     internal_file->digest_types,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create digest.",
+			 function );
+
+			goto on_error;
+		}
+		internal_file->io_handle->digest        = internal_file->digest;
+		internal_file->io_handle->digest_offset = 0;
 	}
-#endif
-	if( libnk2_file_read_items(
-	     internal_file,
+	if( libbfio_handle_get_size(
 	     file_io_handle,
-	     file_header->number_of_items,
+	     &file_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read items.",
+		 "%s: unable to retrieve file size.",
 		 function );
 
 		goto on_error;
 	}
-	if( libnk2_file_header_free(
-	     &file_header,
-	     error ) != 1 )
+	if( file_size < (size64_t) ( sizeof( nk2_file_header_t ) + sizeof( nk2_file_footer_t ) ) )
 	{
+		libnk2_io_handle_set_last_error(
+		 internal_file->io_handle,
+		 NULL,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 NULL );
+
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free file header.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file size value out of bounds.",
 		 function );
 
 		goto on_error;
 	}
+	/* The items are stored between the file header and the file footer
+	 */
+	internal_file->io_handle->items_end_offset = (off64_t) ( file_size - sizeof( nk2_file_footer_t ) );
+
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
 		libcnotify_printf(
-		 "Reading file footer:\n" );
+		 "Reading file header:\n" );
 	}
 #endif
-	if( libnk2_file_footer_initialize(
-	     &file_footer,
+	if( libnk2_statistics_get_current_time(
+	     &start_time,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file footer.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
 		 function );
 
 		goto on_error;
 	}
-	if( libnk2_file_footer_read_file_io_handle(
-	     file_footer,
-	     file_io_handle,
+	if( libnk2_file_header_initialize(
+	     &file_header,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read file footer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file header.",
 		 function );
 
 		goto on_error;
 	}
-	internal_file->modification_time = file_footer->modification_time;
+	read_count = libnk2_io_handle_read_buffer_at_offset(
+	              internal_file->io_handle,
+	              file_io_handle,
+	              file_header_data,
+	              sizeof( nk2_file_header_t ),
+	              0,
+	              error );
 
-	if( libnk2_file_footer_free(
-	     &file_footer,
-	     error ) != 1 )
+	if( read_count != (ssize_t) sizeof( nk2_file_header_t ) )
 	{
+		libnk2_io_handle_set_last_error(
+		 internal_file->io_handle,
+		 file_io_handle,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 NULL );
+
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free file footer.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file header data.",
 		 function );
 
 		goto on_error;
 	}
-	internal_file->io_handle->abort = 0;
-
-	return( 1 );
-
-on_error:
-	if( file_footer != NULL )
+	if( libnk2_file_header_read_data(
+	     file_header,
+	     file_header_data,
+	     sizeof( nk2_file_header_t ),
+	     error ) != 1 )
 	{
-		libnk2_file_footer_free(
-		 &file_footer,
+		libnk2_io_handle_set_last_error(
+		 internal_file->io_handle,
+		 NULL,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 NULL );
+
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file header.",
+		 function );
+
+		goto on_error;
+	}
+	if( libnk2_io_handle_add_allocation(
+	     internal_file->io_handle,
+	     sizeof( libnk2_file_header_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to add file header allocation to statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( libnk2_statistics_get_current_time(
+	     &end_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		goto on_error;
+	}
+	internal_file->io_handle->statistics.file_header_read_time = end_time - start_time;
+
+	start_time = end_time;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "Reading items:\n" );
+	}
+#endif
+	if( libnk2_file_read_items(
+	     internal_file,
+	     file_io_handle,
+	     file_header->number_of_items,
+	     error ) != 1 )
+	{
+		libnk2_io_handle_set_last_error(
+		 internal_file->io_handle,
+		 file_io_handle,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 NULL );
+
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read items.",
+		 function );
+
+		goto on_error;
+	}
+	if( libnk2_statistics_get_current_time(
+	     &end_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		goto on_error;
+	}
+	internal_file->io_handle->statistics.items_read_time = end_time - start_time;
+
+	start_time = end_time;
+
+	if( libnk2_file_header_free(
+	     &file_header,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file header.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "Reading file footer:\n" );
+	}
+#endif
+	if( libnk2_file_footer_initialize(
+	     &file_footer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file footer.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libnk2_io_handle_read_buffer(
+	              internal_file->io_handle,
+	              file_io_handle,
+	              file_footer_data,
+	              sizeof( nk2_file_footer_t ),
+	              error );
+
+	if( read_count != (ssize_t) sizeof( nk2_file_footer_t ) )
+	{
+		libnk2_io_handle_set_last_error(
+		 internal_file->io_handle,
+		 file_io_handle,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 NULL );
+
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file footer data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libnk2_file_footer_read_data(
+	     file_footer,
+	     file_footer_data,
+	     sizeof( nk2_file_footer_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file footer.",
+		 function );
+
+		goto on_error;
+	}
+	if( libnk2_io_handle_add_allocation(
+	     internal_file->io_handle,
+	     sizeof( libnk2_file_footer_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to add file footer allocation to statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( libnk2_statistics_get_current_time(
+	     &end_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		goto on_error;
+	}
+	internal_file->io_handle->statistics.file_footer_read_time = end_time - start_time;
+
+	internal_file->modification_time = file_footer->modification_time;
+
+	if( libnk2_file_footer_free(
+	     &file_footer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file footer.",
+		 function );
+
+		goto on_error;
+	}
+	if( internal_file->digest != NULL )
+	{
+		if( libnk2_file_complete_digest(
+		     internal_file,
+		     file_io_handle,
+		     file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to complete digest.",
+			 function );
+
+			goto on_error;
+		}
+		internal_file->io_handle->digest = NULL;
+	}
+	internal_file->io_handle->abort = 0;
+
+	return( 1 );
+
+on_error:
+	if( internal_file->digest != NULL )
+	{
+		libnk2_digest_free(
+		 &( internal_file->digest ),
+		 NULL );
+	}
+	internal_file->io_handle->digest = NULL;
+
+	if( file_footer != NULL )
+	{
+		libnk2_file_footer_free(
+		 &file_footer,
 		 NULL );
 	}
 	if( file_header != NULL )
@@ -994,23 +1508,21 @@ on_error:
 	return( -1 );
 }
 
-/* Reads the items into the items array
+/* Completes the digest
+ * Data that was not read while opening the file, such as data after a gap, is read
+ * so that the digest covers all the data of the file
  * Returns 1 if successful or -1 on error
  */
-int libnk2_file_read_items(
+int libnk2_file_complete_digest(
      libnk2_internal_file_t *internal_file,
      libbfio_handle_t *file_io_handle,
-     uint32_t number_of_items,
+     size64_t file_size,
      libcerror_error_t **error )
 {
-	uint8_t number_of_record_entries_data[ 4 ];
-
-	libnk2_item_t *item               = NULL;
-	static char *function             = "libnk2_file_read_items";
-	ssize_t read_count                = 0;
-	uint32_t item_index               = 0;
-	uint32_t number_of_record_entries = 0;
-	int entry_index                   = 0;
+	uint8_t *buffer       = NULL;
+	static char *function = "libnk2_file_complete_digest";
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
 
 	if( internal_file == NULL )
 	{
@@ -1023,61 +1535,287 @@ int libnk2_file_read_items(
 
 		return( -1 );
 	}
-	if( libcdata_array_empty(
-	     internal_file->items_array,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libnk2_internal_item_free,
-	     error ) != 1 )
+	if( internal_file->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty items array.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid internal file - missing IO handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	for( item_index = 0;
-	     item_index < number_of_items;
-	     item_index++ )
+	if( internal_file->digest == NULL )
 	{
-		read_count = libbfio_handle_read_buffer(
-			      file_io_handle,
-			      number_of_record_entries_data,
-			      4,
-			      error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid internal file - missing digest.",
+		 function );
 
-		if( read_count != (ssize_t) 4 )
+		return( -1 );
+	}
+	if( (size64_t) internal_file->io_handle->digest_offset < file_size )
+	{
+		buffer = (uint8_t *) memory_allocate(
+		                      sizeof( uint8_t ) * LIBNK2_FILE_DIGEST_READ_SIZE );
+
+		if( buffer == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read item: %" PRIu32 " number of record entries data.",
-			 function,
-			 item_index );
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer.",
+			 function );
 
 			goto on_error;
 		}
-		byte_stream_copy_to_uint32_little_endian(
-		 number_of_record_entries_data,
-		 number_of_record_entries );
-
-		if( number_of_record_entries == 0 )
-		{
-			break;
-		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
+		while( (size64_t) internal_file->io_handle->digest_offset < file_size )
 		{
-			libcnotify_printf(
-			 "%s: item: %03" PRIu32 " number of record entries\t\t: %" PRIu32 "\n",
-			 function,
-			 item_index,
-			 number_of_record_entries );
+			read_size = LIBNK2_FILE_DIGEST_READ_SIZE;
 
-			libcnotify_printf(
-			 "\n" );
+			if( (size64_t) read_size > ( file_size - internal_file->io_handle->digest_offset ) )
+			{
+				read_size = (size_t) ( file_size - internal_file->io_handle->digest_offset );
+			}
+			/* The data is read directly from the file IO handle so that
+			 * it is not counted in the read statistics of the parser
+			 */
+			read_count = libbfio_handle_read_buffer_at_offset(
+			              file_io_handle,
+			              buffer,
+			              read_size,
+			              internal_file->io_handle->digest_offset,
+			              error );
+
+			if( read_count != (ssize_t) read_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read digest data.",
+				 function );
+
+				goto on_error;
+			}
+			if( libnk2_io_handle_update_digest(
+			     internal_file->io_handle,
+			     buffer,
+			     read_size,
+			     internal_file->io_handle->digest_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update digest.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		memory_free(
+		 buffer );
+
+		buffer = NULL;
+	}
+	if( libnk2_digest_finalize(
+	     internal_file->digest,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize digest.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( -1 );
+}
+
+/* Reads the items into the items array
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_file_read_items(
+     libnk2_internal_file_t *internal_file,
+     libbfio_handle_t *file_io_handle,
+     uint32_t number_of_items,
+     libcerror_error_t **error )
+{
+	uint8_t number_of_record_entries_data[ 4 ];
+
+	libnk2_item_t *item               = NULL;
+	static char *function             = "libnk2_file_read_items";
+	size64_t remaining_size           = 0;
+	ssize_t read_count                = 0;
+	uint32_t item_index               = 0;
+	uint32_t number_of_record_entries = 0;
+	int entry_index                   = 0;
+	int result                        = 0;
+
+	if( internal_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid internal file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_empty(
+	     internal_file->items_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libnk2_internal_item_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty items array.",
+		 function );
+
+		goto on_error;
+	}
+	result = libnk2_io_handle_get_remaining_items_size(
+	          internal_file->io_handle,
+	          &remaining_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve remaining items size.",
+		 function );
+
+		goto on_error;
+	}
+	/* Every item contains a number of record entries and at least 1 record entry,
+	 * except for an item without record entries that terminates the items
+	 */
+	if( ( result != 0 )
+	 && ( (size64_t) number_of_items > ( ( remaining_size / ( 4 + sizeof( nk2_item_value_entry_t ) ) ) + 1 ) ) )
+	{
+		libnk2_io_handle_set_last_error(
+		 internal_file->io_handle,
+		 file_io_handle,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 NULL );
+
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of items value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	for( item_index = 0;
+	     item_index < number_of_items;
+	     item_index++ )
+	{
+		read_count = libnk2_io_handle_read_buffer(
+			      internal_file->io_handle,
+			      file_io_handle,
+			      number_of_record_entries_data,
+			      4,
+			      error );
+
+		if( read_count != (ssize_t) 4 )
+		{
+			libnk2_io_handle_set_last_error(
+			 internal_file->io_handle,
+			 file_io_handle,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 NULL );
+
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read item: %" PRIu32 " number of record entries data.",
+			 function,
+			 item_index );
+
+			goto on_error;
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 number_of_record_entries_data,
+		 number_of_record_entries );
+
+		if( number_of_record_entries == 0 )
+		{
+			break;
+		}
+		result = libnk2_io_handle_get_remaining_items_size(
+		          internal_file->io_handle,
+		          &remaining_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve remaining items size.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( result != 0 )
+		 && ( (size64_t) number_of_record_entries > ( remaining_size / sizeof( nk2_item_value_entry_t ) ) ) )
+		{
+			libnk2_io_handle_set_last_error(
+			 internal_file->io_handle,
+			 file_io_handle,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 NULL );
+
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid item: %" PRIu32 " number of record entries value exceeds maximum.",
+			 function,
+			 item_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: item: %03" PRIu32 " number of record entries\t\t: %" PRIu32 "\n",
+			 function,
+			 item_index,
+			 number_of_record_entries );
+
+			libcnotify_printf(
+			 "\n" );
 		}
 #endif
 		if( libnk2_item_initialize(
@@ -1093,6 +1831,20 @@ int libnk2_file_read_items(
 
 			goto on_error;
 		}
+		if( libnk2_io_handle_add_allocation(
+		     internal_file->io_handle,
+		     sizeof( libnk2_internal_item_t ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add item allocation to statistics.",
+			 function );
+
+			goto on_error;
+		}
 		if( libnk2_item_read_record_entries(
 		     (libnk2_internal_item_t *) item,
 		     internal_file->io_handle,
@@ -1127,6 +1879,8 @@ int libnk2_file_read_items(
 			goto on_error;
 		}
 		item = NULL;
+
+		internal_file->io_handle->statistics.number_of_items += 1;
 	}
 	return( 1 );
 
@@ -1148,15 +1902,1229 @@ on_error:
 /* Retrieves the file ASCII codepage
  * Returns 1 if successful or -1 on error
  */
-int libnk2_file_get_ascii_codepage(
-     libnk2_file_t *file,
-     int *ascii_codepage,
+int libnk2_file_get_ascii_codepage(
+     libnk2_file_t *file,
+     int *ascii_codepage,
+     libcerror_error_t **error )
+{
+	libnk2_internal_file_t *internal_file = NULL;
+	static char *function                 = "libnk2_file_get_ascii_codepage";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libnk2_internal_file_t *) file;
+
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid internal file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ascii_codepage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ASCII codepage.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*ascii_codepage = internal_file->io_handle->ascii_codepage;
+
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the file ASCII codepage
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_file_set_ascii_codepage(
+     libnk2_file_t *file,
+     int ascii_codepage,
+     libcerror_error_t **error )
+{
+	libnk2_internal_file_t *internal_file = NULL;
+	static char *function                 = "libnk2_file_set_ascii_codepage";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libnk2_internal_file_t *) file;
+
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid internal file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ascii_codepage != LIBNK2_CODEPAGE_ASCII )
+	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_874 )
+	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_932 )
+	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_936 )
+	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_949 )
+	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_950 )
+	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_1250 )
+	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_1251 )
+	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_1252 )
+	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_1253 )
+	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_1254 )
+	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_1255 )
+	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_1256 )
+	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_1257 )
+	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_1258 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported ASCII codepage.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_file->io_handle->ascii_codepage = ascii_codepage;
+
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the modification time
+ * The returned time is a 64-bit version of a filetime value
+ * Returns 1 if successful, 0 if not set or -1 on error
+ */
+int libnk2_file_get_modification_time(
+     libnk2_file_t *file,
+     uint64_t *filetime,
+     libcerror_error_t **error )
+{
+	libnk2_internal_file_t *internal_file = NULL;
+	static char *function                 = "libnk2_file_get_modification_time";
+	int result                            = 0;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libnk2_internal_file_t *) file;
+
+	if( filetime == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filetime.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_file->file_io_handle != NULL )
+	{
+		*filetime = internal_file->modification_time;
+
+		result = 1;
+	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of items
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_file_get_number_of_items(
+     libnk2_file_t *file,
+     int *number_of_items,
+     libcerror_error_t **error )
+{
+	libnk2_internal_file_t *internal_file = NULL;
+	static char *function                 = "libnk2_file_get_number_of_items";
+	int result                            = 1;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libnk2_internal_file_t *) file;
+
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_get_number_of_entries(
+	     internal_file->items_array,
+	     number_of_items,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of items.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves a specific item
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_file_get_item(
+     libnk2_file_t *file,
+     int item_index,
+     libnk2_item_t **item,
+     libcerror_error_t **error )
+{
+	libnk2_internal_file_t *internal_file = NULL;
+	static char *function                 = "libnk2_file_get_item";
+	int result                            = 1;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libnk2_internal_file_t *) file;
+
+	if( internal_file->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
+
+		return( -1 );
+	}
+	if( *item != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid item value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_get_entry_by_index(
+	     internal_file->items_array,
+	     item_index,
+	     (intptr_t **) item,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve item: %d.",
+		 function,
+		 item_index );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the parse statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_file_get_statistics(
+     libnk2_file_t *file,
+     libnk2_statistics_t *statistics,
+     libcerror_error_t **error )
+{
+	libnk2_internal_file_t *internal_file = NULL;
+	static char *function                 = "libnk2_file_get_statistics";
+	int result                            = 1;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libnk2_internal_file_t *) file;
+
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( memory_copy(
+	     statistics,
+	     &( internal_file->io_handle->statistics ),
+	     sizeof( libnk2_statistics_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy statistics.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of (record) entries of a specific value type
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_file_get_number_of_entries_by_value_type(
+     libnk2_file_t *file,
+     uint32_t value_type,
+     uint64_t *number_of_entries,
+     libcerror_error_t **error )
+{
+	libnk2_internal_file_t *internal_file = NULL;
+	static char *function                 = "libnk2_file_get_number_of_entries_by_value_type";
+	int result                            = 1;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libnk2_internal_file_t *) file;
+
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libnk2_io_handle_get_number_of_entries_by_value_type(
+	     internal_file->io_handle,
+	     value_type,
+	     number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries of value type: 0x%04" PRIx32 ".",
+		 function,
+		 value_type );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the error mode
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_file_get_error_mode(
+     libnk2_file_t *file,
+     int *error_mode,
+     libcerror_error_t **error )
+{
+	libnk2_internal_file_t *internal_file = NULL;
+	static char *function                 = "libnk2_file_get_error_mode";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libnk2_internal_file_t *) file;
+
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( error_mode == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid error mode.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*error_mode = internal_file->io_handle->error_mode;
+
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the error mode
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_file_set_error_mode(
+     libnk2_file_t *file,
+     int error_mode,
+     libcerror_error_t **error )
+{
+	libnk2_internal_file_t *internal_file = NULL;
+	static char *function                 = "libnk2_file_set_error_mode";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libnk2_internal_file_t *) file;
+
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( error_mode != LIBNK2_ERROR_MODE_DEFAULT )
+	 && ( error_mode != LIBNK2_ERROR_MODE_LIGHTWEIGHT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported error mode.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_file->io_handle->error_mode = error_mode;
+
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the domain, code and offset of the last error that occurred while reading
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libnk2_file_get_last_error(
+     libnk2_file_t *file,
+     int *error_domain,
+     int *error_code,
+     off64_t *error_offset,
+     libcerror_error_t **error )
+{
+	libnk2_internal_file_t *internal_file = NULL;
+	static char *function                 = "libnk2_file_get_last_error";
+	int result                            = 0;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libnk2_internal_file_t *) file;
+
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( error_domain == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid error domain.",
+		 function );
+
+		return( -1 );
+	}
+	if( error_code == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid error code.",
+		 function );
+
+		return( -1 );
+	}
+	if( error_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid error offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_file->io_handle->last_error_domain != 0 )
+	{
+		*error_domain = internal_file->io_handle->last_error_domain;
+		*error_code   = internal_file->io_handle->last_error_code;
+		*error_offset = internal_file->io_handle->last_error_offset;
+
+		result = 1;
+	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the value table
+ * When set, identical variable size value data is shared between the record entries
+ * of the file and of other files that use the same value table
+ * The value table must be set before the file is opened, use NULL to not share value data
+ * The value table must not be freed before the file is closed
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_file_set_value_table(
+     libnk2_file_t *file,
+     libnk2_value_table_t *value_table,
+     libcerror_error_t **error )
+{
+	libnk2_internal_file_t *internal_file = NULL;
+	static char *function                 = "libnk2_file_set_value_table";
+	int result                            = 1;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libnk2_internal_file_t *) file;
+
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_file->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file - file IO handle already set.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		internal_file->io_handle->value_table = value_table;
+	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the digest types
+ * The digest types are a combination of LIBNK2_DIGEST_TYPE values, use 0 to not calculate a digest
+ * When set, the digests are calculated over all the data of the file, in file order,
+ * from the data that is read when the file is opened
+ * The digest types must be set before the file is opened
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_file_set_digest_types(
+     libnk2_file_t *file,
+     int digest_types,
+     libcerror_error_t **error )
+{
+	libnk2_internal_file_t *internal_file = NULL;
+	static char *function                 = "libnk2_file_set_digest_types";
+	int result                            = 1;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libnk2_internal_file_t *) file;
+
+	if( ( digest_types & ~( LIBNK2_DIGEST_TYPE_MD5 | LIBNK2_DIGEST_TYPE_SHA1 | LIBNK2_DIGEST_TYPE_SHA256 ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported digest types: 0x%02x.",
+		 function,
+		 digest_types );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_file->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file - file IO handle already set.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		internal_file->digest_types = digest_types;
+	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the digest hash of a specific digest type
+ * The digest hash size must be at least the LIBNK2_DIGEST_HASH_SIZE of the digest type
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libnk2_file_get_digest(
+     libnk2_file_t *file,
+     int digest_type,
+     uint8_t *digest_hash,
+     size_t digest_hash_size,
+     libcerror_error_t **error )
+{
+	libnk2_internal_file_t *internal_file = NULL;
+	static char *function                 = "libnk2_file_get_digest";
+	int result                            = 0;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libnk2_internal_file_t *) file;
+
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_file->digest != NULL )
+	{
+		result = libnk2_digest_get_hash(
+		          internal_file->digest,
+		          digest_type,
+		          digest_hash,
+		          digest_hash_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve digest hash.",
+			 function );
+		}
+	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Exports the record entries of the items as an Arrow C data interface record batch
+ * The record batch contains a row per record entry, the columns are defined by LIBNK2_ARROW_COLUMNS
+ * On success the schema and array must be released by the caller using their release callback
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_file_export_arrow(
+     libnk2_file_t *file,
+     struct ArrowSchema *schema,
+     struct ArrowArray *array,
+     libcerror_error_t **error )
+{
+	libnk2_internal_file_t *internal_file = NULL;
+	static char *function                 = "libnk2_file_export_arrow";
+	int result                            = 1;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libnk2_internal_file_t *) file;
+
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libnk2_arrow_export_items(
+	     internal_file->items_array,
+	     schema,
+	     array,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to export items.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the first item with a specific UTF-8 formatted key
+ * The lookup table is created on first use
+ * Returns 1 if successful, 0 if no such item or -1 on error
+ */
+int libnk2_internal_file_get_item_by_utf8_key(
+     libnk2_internal_file_t *internal_file,
+     uint32_t entry_type,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libnk2_item_t **item,
      libcerror_error_t **error )
 {
-	libnk2_internal_file_t *internal_file = NULL;
-	static char *function                 = "libnk2_file_get_ascii_codepage";
+	static char *function = "libnk2_internal_file_get_item_by_utf8_key";
+	int item_index        = 0;
+	int result            = 0;
 
-	if( file == NULL )
+	if( internal_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -1167,112 +3135,191 @@ int libnk2_file_get_ascii_codepage(
 
 		return( -1 );
 	}
-	internal_file = (libnk2_internal_file_t *) file;
+	if( item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
 
-	if( internal_file->io_handle == NULL )
+		return( -1 );
+	}
+	if( *item != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid internal file - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid item value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( ascii_codepage == NULL )
+	/* The lookup table is created under the write lock, so that concurrent
+	 * callers do not create it more than once
+	 */
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid ASCII codepage.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	*ascii_codepage = internal_file->io_handle->ascii_codepage;
-
-	return( 1 );
-}
+#endif
+	if( internal_file->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing file IO handle.",
+		 function );
 
-/* Sets the file ASCII codepage
- * Returns 1 if successful or -1 on error
- */
-int libnk2_file_set_ascii_codepage(
-     libnk2_file_t *file,
-     int ascii_codepage,
-     libcerror_error_t **error )
-{
-	libnk2_internal_file_t *internal_file = NULL;
-	static char *function                 = "libnk2_file_set_ascii_codepage";
+		result = -1;
+	}
+	else if( internal_file->lookup_table == NULL )
+	{
+		if( libnk2_lookup_table_initialize(
+		     &( internal_file->lookup_table ),
+		     internal_file->items_array,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create lookup table.",
+			 function );
 
-	if( file == NULL )
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	internal_file = (libnk2_internal_file_t *) file;
+#endif
+	if( result == -1 )
+	{
+		return( -1 );
+	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
 
-	if( internal_file->io_handle == NULL )
+		return( -1 );
+	}
+#endif
+	/* The file can have been closed after the write lock was released
+	 */
+	if( internal_file->lookup_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid internal file - missing IO handle.",
+		 "%s: invalid file - missing lookup table.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	if( ( ascii_codepage != LIBNK2_CODEPAGE_ASCII )
-	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_874 )
-	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_932 )
-	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_936 )
-	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_949 )
-	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_950 )
-	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_1250 )
-	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_1251 )
-	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_1252 )
-	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_1253 )
-	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_1254 )
-	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_1255 )
-	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_1256 )
-	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_1257 )
-	 && ( ascii_codepage != LIBNK2_CODEPAGE_WINDOWS_1258 ) )
+	else
+	{
+		result = libnk2_lookup_table_get_item_index(
+		          internal_file->lookup_table,
+		          entry_type,
+		          utf8_string,
+		          utf8_string_length,
+		          &item_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve item index from lookup table.",
+			 function );
+		}
+		else if( result != 0 )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     internal_file->items_array,
+			     item_index,
+			     (intptr_t **) item,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve item: %d.",
+				 function,
+				 item_index );
+
+				result = -1;
+			}
+		}
+	}
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported ASCII codepage.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	internal_file->io_handle->ascii_codepage = ascii_codepage;
-
-	return( 1 );
+#endif
+	return( result );
 }
 
-/* Retrieves the modification time
- * The returned time is a 64-bit version of a filetime value
- * Returns 1 if successful, 0 if not set or -1 on error
+/* Retrieves the first item with a specific UTF-8 encoded email address
+ * The email address is matched case insensitive
+ * Returns 1 if successful, 0 if no such item or -1 on error
  */
-int libnk2_file_get_modification_time(
+int libnk2_file_get_item_by_utf8_email_address(
      libnk2_file_t *file,
-     uint64_t *filetime,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libnk2_item_t **item,
      libcerror_error_t **error )
 {
-	libnk2_internal_file_t *internal_file = NULL;
-	static char *function                 = "libnk2_file_get_modification_time";
-	int result                            = 0;
+	static char *function = "libnk2_file_get_item_by_utf8_email_address";
+	int result            = 0;
 
 	if( file == NULL )
 	{
@@ -1285,38 +3332,40 @@ int libnk2_file_get_modification_time(
 
 		return( -1 );
 	}
-	internal_file = (libnk2_internal_file_t *) file;
+	result = libnk2_internal_file_get_item_by_utf8_key(
+	          (libnk2_internal_file_t *) file,
+	          LIBNK2_ENTRY_TYPE_EMAIL_ADDRESS,
+	          utf8_string,
+	          utf8_string_length,
+	          item,
+	          error );
 
-	if( filetime == NULL )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid filetime.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve item by email address.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_file->file_io_handle != NULL )
-	{
-		*filetime = internal_file->modification_time;
-
-		result = 1;
-	}
 	return( result );
 }
 
-/* Retrieves the number of items
- * Returns 1 if successful or -1 on error
+/* Retrieves the first item with a specific UTF-8 encoded display name
+ * Returns 1 if successful, 0 if no such item or -1 on error
  */
-int libnk2_file_get_number_of_items(
+int libnk2_file_get_item_by_utf8_display_name(
      libnk2_file_t *file,
-     int *number_of_items,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libnk2_item_t **item,
      libcerror_error_t **error )
 {
-	libnk2_internal_file_t *internal_file = NULL;
-	static char *function                 = "libnk2_file_get_number_of_items";
+	static char *function = "libnk2_file_get_item_by_utf8_display_name";
+	int result            = 0;
 
 	if( file == NULL )
 	{
@@ -1329,36 +3378,50 @@ int libnk2_file_get_number_of_items(
 
 		return( -1 );
 	}
-	internal_file = (libnk2_internal_file_t *) file;
+	result = libnk2_internal_file_get_item_by_utf8_key(
+	          (libnk2_internal_file_t *) file,
+	          LIBNK2_ENTRY_TYPE_DISPLAY_NAME,
+	          utf8_string,
+	          utf8_string_length,
+	          item,
+	          error );
 
-	if( libcdata_array_get_number_of_entries(
-	     internal_file->items_array,
-	     number_of_items,
-	     error ) != 1 )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of items.",
+		 "%s: unable to retrieve item by display name.",
 		 function );
 
 		return( -1 );
 	}
-	return( 1 );
+	return( result );
 }
 
-/* Retrieves a specific item
+/* Reports the differences between the items of two files
+ * Items that are only in the file are reported as removed, items that are only
+ * in the other file as added and items with the same identity but different
+ * record entries as modified, followed by the record entries that differ
  * Returns 1 if successful or -1 on error
  */
-int libnk2_file_get_item(
+int libnk2_file_diff(
      libnk2_file_t *file,
-     int item_index,
-     libnk2_item_t **item,
+     libnk2_file_t *other_file,
+     libnk2_diff_callbacks_t *callbacks,
+     void *callback_data,
      libcerror_error_t **error )
 {
-	libnk2_internal_file_t *internal_file = NULL;
-	static char *function                 = "libnk2_file_get_item";
+	libnk2_internal_file_t *internal_file       = NULL;
+	libnk2_internal_file_t *other_internal_file = NULL;
+	static char *function                       = "libnk2_file_diff";
+	int result                                  = 1;
+
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	libnk2_internal_file_t *first_locked_file   = NULL;
+	libnk2_internal_file_t *second_locked_file  = NULL;
+#endif
 
 	if( file == NULL )
 	{
@@ -1373,6 +3436,68 @@ int libnk2_file_get_item(
 	}
 	internal_file = (libnk2_internal_file_t *) file;
 
+	if( other_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid other file.",
+		 function );
+
+		return( -1 );
+	}
+	other_internal_file = (libnk2_internal_file_t *) other_file;
+
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	/* The read/write locks are grabbed in a fixed order to prevent a deadlock
+	 * with a diff of the same files in the opposite order
+	 */
+	first_locked_file = internal_file;
+
+	if( other_internal_file < internal_file )
+	{
+		first_locked_file  = other_internal_file;
+		second_locked_file = internal_file;
+	}
+	else if( other_internal_file > internal_file )
+	{
+		second_locked_file = other_internal_file;
+	}
+	if( libcthreads_read_write_lock_grab_for_read(
+	     first_locked_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+	if( second_locked_file != NULL )
+	{
+		if( libcthreads_read_write_lock_grab_for_read(
+		     second_locked_file->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for reading.",
+			 function );
+
+			libcthreads_read_write_lock_release_for_read(
+			 first_locked_file->read_write_lock,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+#endif
 	if( internal_file->file_io_handle == NULL )
 	{
 		libcerror_error_set(
@@ -1382,46 +3507,66 @@ int libnk2_file_get_item(
 		 "%s: invalid file - missing file IO handle.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	if( item == NULL )
+	else if( other_internal_file->file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid item.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid other file - missing file IO handle.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	if( *item != NULL )
+	else if( libnk2_diff_items(
+	          internal_file->items_array,
+	          other_internal_file->items_array,
+	          callbacks,
+	          callback_data,
+	          error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid item value already set.",
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to diff items.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	if( libcdata_array_get_entry_by_index(
-	     internal_file->items_array,
-	     item_index,
-	     (intptr_t **) item,
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	if( second_locked_file != NULL )
+	{
+		if( libcthreads_read_write_lock_release_for_read(
+		     second_locked_file->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for reading.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_read_write_lock_release_for_read(
+	     first_locked_file->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve item: %d.",
-		 function,
-		 item_index );
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
 
 		return( -1 );
 	}
-	return( 1 );
+#endif
+	return( result );
 }
 
@@ -25,17 +25,25 @@
 #include <common.h>
 #include <types.h>
 
+#include "libnk2_arrow.h"
 #include "libnk2_extern.h"
+#include "libnk2_digest.h"
 #include "libnk2_io_handle.h"
 #include "libnk2_libbfio.h"
 #include "libnk2_libcdata.h"
 #include "libnk2_libcerror.h"
+#include "libnk2_libcthreads.h"
+#include "libnk2_lookup_table.h"
 #include "libnk2_types.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+/* The size of the reads used to complete the digest
+ */
+#define LIBNK2_FILE_DIGEST_READ_SIZE	( 64 * 1024 )
+
 typedef struct libnk2_internal_file libnk2_internal_file_t;
 
 struct libnk2_internal_file
@@ -63,6 +71,24 @@ struct libnk2_internal_file
 	/* The last modification date and time
 	 */
 	uint64_t modification_time;
+
+	/* The item lookup table, which is created on first use
+	 */
+	libnk2_lookup_table_t *lookup_table;
+
+	/* The digest types that are calculated when the file is opened
+	 */
+	int digest_types;
+
+	/* The digest or NULL if not calculated
+	 */
+	libnk2_digest_t *digest;
+
+#if defined( HAVE_LIBNK2_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
 };
 
 LIBNK2_EXTERN \
@@ -115,6 +141,12 @@ int libnk2_file_open_read(
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
+int libnk2_file_complete_digest(
+     libnk2_internal_file_t *internal_file,
+     libbfio_handle_t *file_io_handle,
+     size64_t file_size,
+     libcerror_error_t **error );
+
 int libnk2_file_read_items(
      libnk2_internal_file_t *internal_file,
      libbfio_handle_t *file_io_handle,
@@ -152,6 +184,98 @@ int libnk2_file_get_item(
      libnk2_item_t **item,
      libcerror_error_t **error );
 
+LIBNK2_EXTERN \
+int libnk2_file_get_statistics(
+     libnk2_file_t *file,
+     libnk2_statistics_t *statistics,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_file_get_number_of_entries_by_value_type(
+     libnk2_file_t *file,
+     uint32_t value_type,
+     uint64_t *number_of_entries,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_file_get_error_mode(
+     libnk2_file_t *file,
+     int *error_mode,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_file_set_error_mode(
+     libnk2_file_t *file,
+     int error_mode,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_file_get_last_error(
+     libnk2_file_t *file,
+     int *error_domain,
+     int *error_code,
+     off64_t *error_offset,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_file_set_value_table(
+     libnk2_file_t *file,
+     libnk2_value_table_t *value_table,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_file_set_digest_types(
+     libnk2_file_t *file,
+     int digest_types,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_file_get_digest(
+     libnk2_file_t *file,
+     int digest_type,
+     uint8_t *digest_hash,
+     size_t digest_hash_size,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_file_export_arrow(
+     libnk2_file_t *file,
+     struct ArrowSchema *schema,
+     struct ArrowArray *array,
+     libcerror_error_t **error );
+
+int libnk2_internal_file_get_item_by_utf8_key(
+     libnk2_internal_file_t *internal_file,
+     uint32_t entry_type,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libnk2_item_t **item,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_file_get_item_by_utf8_email_address(
+     libnk2_file_t *file,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libnk2_item_t **item,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_file_get_item_by_utf8_display_name(
+     libnk2_file_t *file,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libnk2_item_t **item,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_file_diff(
+     libnk2_file_t *file,
+     libnk2_file_t *other_file,
+     libnk2_diff_callbacks_t *callbacks,
+     void *callback_data,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
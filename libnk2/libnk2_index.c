@@ -0,0 +1,889 @@
+/*
+ * Alias index functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "libnk2_file.h"
+#include "libnk2_index.h"
+#include "libnk2_item.h"
+#include "libnk2_libcdata.h"
+#include "libnk2_libcerror.h"
+#include "libnk2_mapi.h"
+#include "libnk2_mapi_value.h"
+#include "libnk2_record_entry.h"
+
+/* Creates an index of the display names and email addresses of the items of a file
+ * The index is built from the items that are read when the file is opened
+ * and does not reference the file after it was created
+ * Make sure the value index is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_index_initialize(
+     libnk2_index_t **index,
+     libnk2_file_t *file,
+     libcerror_error_t **error )
+{
+	libnk2_internal_file_t *internal_file                 = NULL;
+	libnk2_internal_index_t *internal_index               = NULL;
+	libnk2_internal_item_t *internal_item                 = NULL;
+	libnk2_internal_record_entry_t *internal_record_entry = NULL;
+	static char *function                                 = "libnk2_index_initialize";
+	size_t keys_data_offset                               = 0;
+	size_t keys_data_size                                 = 0;
+	size_t utf8_string_size                               = 0;
+	int entry_index                                       = 0;
+	int item_index                                        = 0;
+	int key_index                                         = 0;
+	int number_of_entries                                 = 0;
+	int number_of_keys                                    = 0;
+	int number_of_items                                   = 0;
+	int pass                                              = 0;
+	int result                                            = 0;
+
+	if( index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libnk2_internal_file_t *) file;
+
+	if( libcdata_array_get_number_of_entries(
+	     internal_file->items_array,
+	     &number_of_items,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of items.",
+		 function );
+
+		return( -1 );
+	}
+	internal_index = memory_allocate_structure(
+	                  libnk2_internal_index_t );
+
+	if( internal_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_index,
+	     0,
+	     sizeof( libnk2_internal_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear index.",
+		 function );
+
+		memory_free(
+		 internal_index );
+
+		return( -1 );
+	}
+	internal_index->number_of_items = number_of_items;
+
+	/* The first pass determines the number of keys and the size of their data
+	 * the second pass copies the case folded keys
+	 */
+	for( pass = 0;
+	     pass < 2;
+	     pass++ )
+	{
+		if( pass == 1 )
+		{
+			if( number_of_keys == 0 )
+			{
+				break;
+			}
+			if( ( (size_t) number_of_keys > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libnk2_index_key_t ) ) )
+			 || ( keys_data_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid number of keys or keys data size value exceeds maximum allocation size.",
+				 function );
+
+				goto on_error;
+			}
+			internal_index->keys = (libnk2_index_key_t *) memory_allocate(
+			                                               sizeof( libnk2_index_key_t ) * number_of_keys );
+
+			if( internal_index->keys == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create keys.",
+				 function );
+
+				goto on_error;
+			}
+			internal_index->keys_data = (uint8_t *) memory_allocate(
+			                                         sizeof( uint8_t ) * keys_data_size );
+
+			if( internal_index->keys_data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create keys data.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		for( item_index = 0;
+		     item_index < number_of_items;
+		     item_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     internal_file->items_array,
+			     item_index,
+			     (intptr_t **) &internal_item,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve item: %d.",
+				 function,
+				 item_index );
+
+				goto on_error;
+			}
+			if( internal_item == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing item: %d.",
+				 function,
+				 item_index );
+
+				goto on_error;
+			}
+			if( libcdata_array_get_number_of_entries(
+			     internal_item->entries_array,
+			     &number_of_entries,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of entries of item: %d.",
+				 function,
+				 item_index );
+
+				goto on_error;
+			}
+			for( entry_index = 0;
+			     entry_index < number_of_entries;
+			     entry_index++ )
+			{
+				if( libcdata_array_get_entry_by_index(
+				     internal_item->entries_array,
+				     entry_index,
+				     (intptr_t **) &internal_record_entry,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve record entry: %d of item: %d.",
+					 function,
+					 entry_index,
+					 item_index );
+
+					goto on_error;
+				}
+				result = libnk2_index_get_key_string_size(
+				          internal_record_entry,
+				          &utf8_string_size,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve key string size of record entry: %d of item: %d.",
+					 function,
+					 entry_index,
+					 item_index );
+
+					goto on_error;
+				}
+				else if( result == 0 )
+				{
+					continue;
+				}
+				if( pass == 0 )
+				{
+					if( number_of_keys == INT_MAX )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+						 "%s: invalid number of keys value exceeds maximum.",
+						 function );
+
+						goto on_error;
+					}
+					number_of_keys++;
+
+					keys_data_size += utf8_string_size + 1;
+
+					continue;
+				}
+				if( ( key_index >= number_of_keys )
+				 || ( ( utf8_string_size + 1 ) > ( keys_data_size - keys_data_offset ) ) )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+					 "%s: invalid key index value out of bounds.",
+					 function );
+
+					goto on_error;
+				}
+				if( libnk2_mapi_value_get_data_as_utf8_string(
+				     internal_record_entry->value_type,
+				     internal_record_entry->value_data,
+				     internal_record_entry->value_data_size,
+				     internal_record_entry->ascii_codepage,
+				     &( internal_index->keys_data[ keys_data_offset ] ),
+				     utf8_string_size + 1,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve UTF-8 string of record entry: %d of item: %d.",
+					 function,
+					 entry_index,
+					 item_index );
+
+					goto on_error;
+				}
+				libnk2_index_case_fold_utf8_string(
+				 &( internal_index->keys_data[ keys_data_offset ] ),
+				 utf8_string_size );
+
+				internal_index->keys[ key_index ].data       = &( internal_index->keys_data[ keys_data_offset ] );
+				internal_index->keys[ key_index ].data_size  = utf8_string_size;
+				internal_index->keys[ key_index ].item_index = (uint32_t) item_index;
+
+				keys_data_offset += utf8_string_size + 1;
+
+				key_index++;
+			}
+		}
+	}
+	internal_index->number_of_keys = key_index;
+
+	if( internal_index->number_of_keys > 1 )
+	{
+		qsort(
+		 internal_index->keys,
+		 (size_t) internal_index->number_of_keys,
+		 sizeof( libnk2_index_key_t ),
+		 &libnk2_index_key_compare );
+	}
+	*index = (libnk2_index_t *) internal_index;
+
+	return( 1 );
+
+on_error:
+	if( internal_index != NULL )
+	{
+		if( internal_index->keys_data != NULL )
+		{
+			memory_free(
+			 internal_index->keys_data );
+		}
+		if( internal_index->keys != NULL )
+		{
+			memory_free(
+			 internal_index->keys );
+		}
+		memory_free(
+		 internal_index );
+	}
+	return( -1 );
+}
+
+/* Frees an index
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_index_free(
+     libnk2_index_t **index,
+     libcerror_error_t **error )
+{
+	libnk2_internal_index_t *internal_index = NULL;
+	static char *function                   = "libnk2_index_free";
+
+	if( index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index != NULL )
+	{
+		internal_index = (libnk2_internal_index_t *) *index;
+		*index         = NULL;
+
+		if( internal_index->keys_data != NULL )
+		{
+			memory_free(
+			 internal_index->keys_data );
+		}
+		if( internal_index->keys != NULL )
+		{
+			memory_free(
+			 internal_index->keys );
+		}
+		memory_free(
+		 internal_index );
+	}
+	return( 1 );
+}
+
+/* Case folds an UTF-8 string in place
+ * Folds the upper case letters of the ASCII and Latin-1 Supplement blocks,
+ * other characters are left as-is since case folding them does not change their UTF-8 size
+ */
+void libnk2_index_case_fold_utf8_string(
+      uint8_t *utf8_string,
+      size_t utf8_string_size )
+{
+	size_t string_index = 0;
+
+	if( utf8_string == NULL )
+	{
+		return;
+	}
+	while( string_index < utf8_string_size )
+	{
+		if( ( utf8_string[ string_index ] >= (uint8_t) 'A' )
+		 && ( utf8_string[ string_index ] <= (uint8_t) 'Z' ) )
+		{
+			utf8_string[ string_index ] += (uint8_t) ( 'a' - 'A' );
+		}
+		/* U+00C0 to U+00DE, except for U+00D7, are encoded as 0xc3 0x80 to 0xc3 0x9e
+		 * and their lower case equivalents as 0xc3 0xa0 to 0xc3 0xbe
+		 */
+		else if( ( utf8_string[ string_index ] == 0xc3 )
+		      && ( ( string_index + 1 ) < utf8_string_size ) )
+		{
+			string_index++;
+
+			if( ( utf8_string[ string_index ] >= 0x80 )
+			 && ( utf8_string[ string_index ] <= 0x9e )
+			 && ( utf8_string[ string_index ] != 0x97 ) )
+			{
+				utf8_string[ string_index ] += 0x20;
+			}
+		}
+		string_index++;
+	}
+}
+
+/* Compares two keys
+ * This function is used as the comparison function of qsort
+ * Returns a negative value if the first key sorts before the second key, 0 if equal or a positive value otherwise
+ */
+int libnk2_index_key_compare(
+     const void *first_key,
+     const void *second_key )
+{
+	const libnk2_index_key_t *first_index_key  = (const libnk2_index_key_t *) first_key;
+	const libnk2_index_key_t *second_index_key = (const libnk2_index_key_t *) second_key;
+	size_t compare_size                        = 0;
+	int result                                 = 0;
+
+	compare_size = first_index_key->data_size;
+
+	if( compare_size > second_index_key->data_size )
+	{
+		compare_size = second_index_key->data_size;
+	}
+	if( compare_size > 0 )
+	{
+		result = memory_compare(
+		          first_index_key->data,
+		          second_index_key->data,
+		          compare_size );
+	}
+	if( result != 0 )
+	{
+		return( result );
+	}
+	if( first_index_key->data_size < second_index_key->data_size )
+	{
+		return( -1 );
+	}
+	else if( first_index_key->data_size > second_index_key->data_size )
+	{
+		return( 1 );
+	}
+	if( first_index_key->item_index < second_index_key->item_index )
+	{
+		return( -1 );
+	}
+	else if( first_index_key->item_index > second_index_key->item_index )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Retrieves the size of the key string of a record entry
+ * Only the display name and email address record entries are used as keys
+ * The returned size does not include the end of string character
+ * Returns 1 if successful, 0 if the record entry is not a key or -1 on error
+ */
+int libnk2_index_get_key_string_size(
+     libnk2_internal_record_entry_t *internal_record_entry,
+     size_t *utf8_string_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libnk2_index_get_key_string_size";
+	size_t safe_utf8_size = 0;
+
+	if( internal_record_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string size.",
+		 function );
+
+		return( -1 );
+	}
+	*utf8_string_size = 0;
+
+	if( ( internal_record_entry->entry_type != LIBNK2_ENTRY_TYPE_DISPLAY_NAME )
+	 && ( internal_record_entry->entry_type != LIBNK2_ENTRY_TYPE_EMAIL_ADDRESS ) )
+	{
+		return( 0 );
+	}
+	if( ( internal_record_entry->value_type != LIBNK2_VALUE_TYPE_STRING_ASCII )
+	 && ( internal_record_entry->value_type != LIBNK2_VALUE_TYPE_STRING_UNICODE ) )
+	{
+		return( 0 );
+	}
+	if( internal_record_entry->value_data == NULL )
+	{
+		return( 0 );
+	}
+	/* Value data that cannot be converted is not indexed
+	 */
+	if( libnk2_mapi_value_get_data_as_utf8_string_size(
+	     internal_record_entry->value_type,
+	     internal_record_entry->value_data,
+	     internal_record_entry->value_data_size,
+	     internal_record_entry->ascii_codepage,
+	     &safe_utf8_size,
+	     NULL ) != 1 )
+	{
+		return( 0 );
+	}
+	if( safe_utf8_size <= 1 )
+	{
+		return( 0 );
+	}
+	*utf8_string_size = safe_utf8_size - 1;
+
+	return( 1 );
+}
+
+/* Retrieves the number of keys
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_index_get_number_of_keys(
+     libnk2_index_t *index,
+     int *number_of_keys,
+     libcerror_error_t **error )
+{
+	libnk2_internal_index_t *internal_index = NULL;
+	static char *function                   = "libnk2_index_get_number_of_keys";
+
+	if( index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index.",
+		 function );
+
+		return( -1 );
+	}
+	internal_index = (libnk2_internal_index_t *) index;
+
+	if( number_of_keys == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of keys.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_keys = internal_index->number_of_keys;
+
+	return( 1 );
+}
+
+/* Searches the index for items with a display name or email address that starts with an UTF-8 formatted prefix
+ * The prefix is matched case insensitive
+ * The item indexes are stored in ascending order, without duplicates, and are limited to maximum_number_of_item_indexes
+ * Returns 1 if successful, 0 if no matching items were found or -1 on error
+ */
+int libnk2_index_prefix_search(
+     libnk2_index_t *index,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     uint32_t *item_indexes,
+     int maximum_number_of_item_indexes,
+     int *number_of_item_indexes,
+     libcerror_error_t **error )
+{
+	libnk2_index_key_t prefix_key;
+
+	libnk2_internal_index_t *internal_index = NULL;
+	uint8_t *item_bitmap                    = NULL;
+	uint8_t *prefix                         = NULL;
+	static char *function                   = "libnk2_index_prefix_search";
+	size_t item_bitmap_size                 = 0;
+	int item_index                          = 0;
+	int key_index                           = 0;
+	int lower_key_index                     = 0;
+	int safe_number_of_item_indexes         = 0;
+	int upper_key_index                     = 0;
+
+	if( index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index.",
+		 function );
+
+		return( -1 );
+	}
+	internal_index = (libnk2_internal_index_t *) index;
+
+	if( ( utf8_string == NULL )
+	 && ( utf8_string_length > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_length > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE - 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-8 string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( item_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item indexes.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_item_indexes < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of item indexes value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_item_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of item indexes.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_item_indexes = 0;
+
+	if( internal_index->number_of_keys == 0 )
+	{
+		return( 0 );
+	}
+	prefix = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * ( utf8_string_length + 1 ) );
+
+	if( prefix == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create prefix.",
+		 function );
+
+		goto on_error;
+	}
+	if( utf8_string_length > 0 )
+	{
+		if( memory_copy(
+		     prefix,
+		     utf8_string,
+		     utf8_string_length ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy prefix.",
+			 function );
+
+			goto on_error;
+		}
+		libnk2_index_case_fold_utf8_string(
+		 prefix,
+		 utf8_string_length );
+	}
+	prefix[ utf8_string_length ] = 0;
+
+	/* Find the first key that does not sort before the prefix
+	 * the prefix sorts before any key with the same item index and a larger size
+	 */
+	prefix_key.data       = prefix;
+	prefix_key.data_size  = utf8_string_length;
+	prefix_key.item_index = 0;
+
+	lower_key_index = 0;
+	upper_key_index = internal_index->number_of_keys;
+
+	while( lower_key_index < upper_key_index )
+	{
+		key_index = lower_key_index + ( ( upper_key_index - lower_key_index ) / 2 );
+
+		if( libnk2_index_key_compare(
+		     &( internal_index->keys[ key_index ] ),
+		     &prefix_key ) < 0 )
+		{
+			lower_key_index = key_index + 1;
+		}
+		else
+		{
+			upper_key_index = key_index;
+		}
+	}
+	item_bitmap_size = (size_t) ( internal_index->number_of_items / 8 ) + 1;
+
+	item_bitmap = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * item_bitmap_size );
+
+	if( item_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create item bitmap.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     item_bitmap,
+	     0,
+	     item_bitmap_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear item bitmap.",
+		 function );
+
+		goto on_error;
+	}
+	/* The matching keys are stored consecutively
+	 */
+	for( key_index = lower_key_index;
+	     key_index < internal_index->number_of_keys;
+	     key_index++ )
+	{
+		if( internal_index->keys[ key_index ].data_size < utf8_string_length )
+		{
+			break;
+		}
+		if( ( utf8_string_length > 0 )
+		 && ( memory_compare(
+		       internal_index->keys[ key_index ].data,
+		       prefix,
+		       utf8_string_length ) != 0 ) )
+		{
+			break;
+		}
+		item_index = (int) internal_index->keys[ key_index ].item_index;
+
+		item_bitmap[ item_index / 8 ] |= (uint8_t) ( 1 << ( item_index % 8 ) );
+	}
+	for( item_index = 0;
+	     item_index < internal_index->number_of_items;
+	     item_index++ )
+	{
+		if( safe_number_of_item_indexes >= maximum_number_of_item_indexes )
+		{
+			break;
+		}
+		if( ( item_bitmap[ item_index / 8 ] & ( 1 << ( item_index % 8 ) ) ) != 0 )
+		{
+			item_indexes[ safe_number_of_item_indexes++ ] = (uint32_t) item_index;
+		}
+	}
+	memory_free(
+	 item_bitmap );
+
+	memory_free(
+	 prefix );
+
+	*number_of_item_indexes = safe_number_of_item_indexes;
+
+	if( safe_number_of_item_indexes == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+
+on_error:
+	if( item_bitmap != NULL )
+	{
+		memory_free(
+		 item_bitmap );
+	}
+	if( prefix != NULL )
+	{
+		memory_free(
+		 prefix );
+	}
+	return( -1 );
+}
+
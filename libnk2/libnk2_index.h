@@ -0,0 +1,120 @@
+/*
+ * Alias index functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBNK2_INDEX_H )
+#define _LIBNK2_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libnk2_extern.h"
+#include "libnk2_libcerror.h"
+#include "libnk2_record_entry.h"
+#include "libnk2_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libnk2_index_key libnk2_index_key_t;
+
+struct libnk2_index_key
+{
+	/* The case folded UTF-8 string of the key
+	 */
+	const uint8_t *data;
+
+	/* The size of the key, without the end of string character
+	 */
+	size_t data_size;
+
+	/* The index of the item that contains the key
+	 */
+	uint32_t item_index;
+};
+
+typedef struct libnk2_internal_index libnk2_internal_index_t;
+
+struct libnk2_internal_index
+{
+	/* The keys sorted by their data
+	 */
+	libnk2_index_key_t *keys;
+
+	/* The number of keys
+	 */
+	int number_of_keys;
+
+	/* The data of the keys
+	 */
+	uint8_t *keys_data;
+
+	/* The number of items
+	 */
+	int number_of_items;
+};
+
+LIBNK2_EXTERN \
+int libnk2_index_initialize(
+     libnk2_index_t **index,
+     libnk2_file_t *file,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_index_free(
+     libnk2_index_t **index,
+     libcerror_error_t **error );
+
+void libnk2_index_case_fold_utf8_string(
+      uint8_t *utf8_string,
+      size_t utf8_string_size );
+
+int libnk2_index_key_compare(
+     const void *first_key,
+     const void *second_key );
+
+int libnk2_index_get_key_string_size(
+     libnk2_internal_record_entry_t *internal_record_entry,
+     size_t *utf8_string_size,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_index_get_number_of_keys(
+     libnk2_index_t *index,
+     int *number_of_keys,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_index_prefix_search(
+     libnk2_index_t *index,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     uint32_t *item_indexes,
+     int maximum_number_of_item_indexes,
+     int *number_of_item_indexes,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBNK2_INDEX_H ) */
+
@@ -25,7 +25,9 @@
 #include <types.h>
 
 #include "libnk2_codepage.h"
+#include "libnk2_digest.h"
 #include "libnk2_io_handle.h"
+#include "libnk2_libbfio.h"
 #include "libnk2_libcerror.h"
 
 const uint8_t nk2_file_signature[ 4 ] = { 0x0d, 0xf0, 0xad, 0xba };
@@ -142,7 +144,9 @@ int libnk2_io_handle_clear(
      libnk2_io_handle_t *io_handle,
      libcerror_error_t **error )
 {
-	static char *function = "libnk2_io_handle_clear";
+	libnk2_value_table_t *value_table = NULL;
+	static char *function             = "libnk2_io_handle_clear";
+	int error_mode                    = 0;
 
 	if( io_handle == NULL )
 	{
@@ -155,6 +159,11 @@ int libnk2_io_handle_clear(
 
 		return( -1 );
 	}
+	/* The error mode and value table are retained so that they apply to subsequent opens
+	 */
+	error_mode  = io_handle->error_mode;
+	value_table = io_handle->value_table;
+
 	if( memory_set(
 	     io_handle,
 	     0,
@@ -170,6 +179,508 @@ int libnk2_io_handle_clear(
 		return( -1 );
 	}
 	io_handle->ascii_codepage = LIBNK2_CODEPAGE_WINDOWS_1252;
+	io_handle->error_mode     = error_mode;
+	io_handle->value_table    = value_table;
+
+	return( 1 );
+}
+
+/* Clears the parse statistics of the IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_io_handle_clear_statistics(
+     libnk2_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libnk2_io_handle_clear_statistics";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &( io_handle->statistics ),
+	     0,
+	     sizeof( libnk2_statistics_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear statistics.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle->statistics_number_of_value_types = 0;
+
+	return( 1 );
+}
+
+/* Reads a buffer from the current offset of the file IO handle
+ * This function keeps track of the number of read calls and bytes read
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libnk2_io_handle_read_buffer(
+         libnk2_io_handle_t *io_handle,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libnk2_io_handle_read_buffer";
+	ssize_t read_count    = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libbfio_handle_read_buffer(
+	              file_io_handle,
+	              buffer,
+	              size,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->digest != NULL )
+	{
+		if( libnk2_io_handle_update_digest(
+		     io_handle,
+		     buffer,
+		     (size_t) read_count,
+		     io_handle->current_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update digest.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	io_handle->current_offset                  += (off64_t) read_count;
+	io_handle->statistics.number_of_read_calls += 1;
+	io_handle->statistics.number_of_bytes_read += (uint64_t) read_count;
+
+	return( read_count );
+}
+
+/* Reads a buffer at a specific offset and updates the parse statistics
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libnk2_io_handle_read_buffer_at_offset(
+         libnk2_io_handle_t *io_handle,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "libnk2_io_handle_read_buffer_at_offset";
+	ssize_t read_count    = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              file_io_handle,
+	              buffer,
+	              size,
+	              offset,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	if( io_handle->digest != NULL )
+	{
+		if( libnk2_io_handle_update_digest(
+		     io_handle,
+		     buffer,
+		     (size_t) read_count,
+		     offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update digest.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	io_handle->current_offset                  = offset + (off64_t) read_count;
+	io_handle->statistics.number_of_read_calls += 1;
+	io_handle->statistics.number_of_bytes_read += (uint64_t) read_count;
+
+	return( read_count );
+}
+
+/* Updates the digest with data that was read at a specific offset
+ * Only data that continues the digest in file order is added, data that was
+ * read before is skipped and data after a gap is left to be read when the
+ * digest is completed
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_io_handle_update_digest(
+     libnk2_io_handle_t *io_handle,
+     const uint8_t *buffer,
+     size_t size,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	static char *function = "libnk2_io_handle_update_digest";
+	size_t buffer_offset  = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset > io_handle->digest_offset )
+	 || ( ( offset + (off64_t) size ) <= io_handle->digest_offset ) )
+	{
+		return( 1 );
+	}
+	buffer_offset = (size_t) ( io_handle->digest_offset - offset );
+
+	if( libnk2_digest_update(
+	     io_handle->digest,
+	     &( buffer[ buffer_offset ] ),
+	     size - buffer_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update digest.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle->digest_offset = offset + (off64_t) size;
+
+	return( 1 );
+}
+
+/* Retrieves the number of bytes remaining between the current offset and the end of the items
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libnk2_io_handle_get_remaining_items_size(
+     libnk2_io_handle_t *io_handle,
+     size64_t *remaining_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libnk2_io_handle_get_remaining_items_size";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( remaining_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid remaining size.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->items_end_offset <= 0 )
+	{
+		return( 0 );
+	}
+	if( io_handle->current_offset >= io_handle->items_end_offset )
+	{
+		*remaining_size = 0;
+	}
+	else
+	{
+		*remaining_size = (size64_t) ( io_handle->items_end_offset - io_handle->current_offset );
+	}
+	return( 1 );
+}
+
+/* Adds an allocation to the parse statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_io_handle_add_allocation(
+     libnk2_io_handle_t *io_handle,
+     size_t allocation_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libnk2_io_handle_add_allocation";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle->statistics.number_of_allocations     += 1;
+	io_handle->statistics.number_of_bytes_allocated += (uint64_t) allocation_size;
+
+	return( 1 );
+}
+
+/* Adds an entry of a specific value type to the parse statistics
+ * Only the first LIBNK2_IO_HANDLE_MAXIMUM_NUMBER_OF_STATISTICS_VALUE_TYPES
+ * distinct value types are counted individually
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_io_handle_add_entry_value_type(
+     libnk2_io_handle_t *io_handle,
+     uint32_t value_type,
+     libcerror_error_t **error )
+{
+	static char *function = "libnk2_io_handle_add_entry_value_type";
+	int value_type_index  = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( io_handle->statistics_number_of_value_types < 0 )
+	 || ( io_handle->statistics_number_of_value_types > LIBNK2_IO_HANDLE_MAXIMUM_NUMBER_OF_STATISTICS_VALUE_TYPES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid IO handle - number of statistics value types value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle->statistics.number_of_entries += 1;
+
+	for( value_type_index = 0;
+	     value_type_index < io_handle->statistics_number_of_value_types;
+	     value_type_index++ )
+	{
+		if( io_handle->statistics_value_types[ value_type_index ] == value_type )
+		{
+			io_handle->statistics_number_of_entries_per_value_type[ value_type_index ] += 1;
+
+			return( 1 );
+		}
+	}
+	if( value_type_index < LIBNK2_IO_HANDLE_MAXIMUM_NUMBER_OF_STATISTICS_VALUE_TYPES )
+	{
+		io_handle->statistics_value_types[ value_type_index ]                       = value_type;
+		io_handle->statistics_number_of_entries_per_value_type[ value_type_index ] = 1;
+
+		io_handle->statistics_number_of_value_types += 1;
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of entries of a specific value type from the parse statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_io_handle_get_number_of_entries_by_value_type(
+     libnk2_io_handle_t *io_handle,
+     uint32_t value_type,
+     uint64_t *number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libnk2_io_handle_get_number_of_entries_by_value_type";
+	int value_type_index  = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_entries = 0;
+
+	for( value_type_index = 0;
+	     value_type_index < io_handle->statistics_number_of_value_types;
+	     value_type_index++ )
+	{
+		if( io_handle->statistics_value_types[ value_type_index ] == value_type )
+		{
+			*number_of_entries = io_handle->statistics_number_of_entries_per_value_type[ value_type_index ];
+
+			break;
+		}
+	}
+	return( 1 );
+}
+
+/* Clears the last error
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_io_handle_clear_last_error(
+     libnk2_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libnk2_io_handle_clear_last_error";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle->last_error_domain = 0;
+	io_handle->last_error_code   = 0;
+	io_handle->last_error_offset = 0;
+
+	return( 1 );
+}
+
+/* Sets the last error
+ * Only the first error after the last error was cleared is retained,
+ * which is the failure closest to its cause
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_io_handle_set_last_error(
+     libnk2_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     int error_domain,
+     int error_code,
+     libcerror_error_t **error )
+{
+	static char *function = "libnk2_io_handle_set_last_error";
+	off64_t offset        = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->last_error_domain != 0 )
+	{
+		return( 1 );
+	}
+	if( file_io_handle != NULL )
+	{
+		if( libbfio_handle_get_offset(
+		     file_io_handle,
+		     &offset,
+		     NULL ) != 1 )
+		{
+			offset = -1;
+		}
+	}
+	io_handle->last_error_domain = error_domain;
+	io_handle->last_error_code   = error_code;
+	io_handle->last_error_offset = offset;
 
 	return( 1 );
 }
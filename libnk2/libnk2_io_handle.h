@@ -25,12 +25,20 @@
 #include <common.h>
 #include <types.h>
 
+#include "libnk2_digest.h"
+#include "libnk2_libbfio.h"
 #include "libnk2_libcerror.h"
+#include "libnk2_types.h"
+#include "libnk2_value_table.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+/* The maximum number of distinct value types for which statistics are kept
+ */
+#define LIBNK2_IO_HANDLE_MAXIMUM_NUMBER_OF_STATISTICS_VALUE_TYPES	64
+
 extern const uint8_t nk2_file_signature[ 4 ];
 
 typedef struct libnk2_io_handle libnk2_io_handle_t;
@@ -44,6 +52,58 @@ struct libnk2_io_handle
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
+
+	/* The parse statistics
+	 */
+	libnk2_statistics_t statistics;
+
+	/* The value types for which the number of entries is counted
+	 */
+	uint32_t statistics_value_types[ LIBNK2_IO_HANDLE_MAXIMUM_NUMBER_OF_STATISTICS_VALUE_TYPES ];
+
+	/* The number of entries per value type
+	 */
+	uint64_t statistics_number_of_entries_per_value_type[ LIBNK2_IO_HANDLE_MAXIMUM_NUMBER_OF_STATISTICS_VALUE_TYPES ];
+
+	/* The number of value types for which the number of entries is counted
+	 */
+	int statistics_number_of_value_types;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+	/* The offset of the end of the items, which is the start of the file footer, or 0 if not known
+	 */
+	off64_t items_end_offset;
+
+	/* The error mode
+	 */
+	int error_mode;
+
+	/* The domain of the last error or 0 if not set
+	 */
+	int last_error_domain;
+
+	/* The code of the last error
+	 */
+	int last_error_code;
+
+	/* The offset of the last error
+	 */
+	off64_t last_error_offset;
+
+	/* The value table used to share identical value data or NULL if not set
+	 */
+	libnk2_value_table_t *value_table;
+
+	/* The digest that is calculated over the data read or NULL if not set
+	 */
+	libnk2_digest_t *digest;
+
+	/* The offset up to which the digest has been calculated
+	 */
+	off64_t digest_offset;
 };
 
 int libnk2_io_handle_initialize(
@@ -58,6 +118,64 @@ int libnk2_io_handle_clear(
      libnk2_io_handle_t *io_handle,
      libcerror_error_t **error );
 
+int libnk2_io_handle_clear_statistics(
+     libnk2_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+ssize_t libnk2_io_handle_read_buffer(
+         libnk2_io_handle_t *io_handle,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t libnk2_io_handle_read_buffer_at_offset(
+         libnk2_io_handle_t *io_handle,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+int libnk2_io_handle_update_digest(
+     libnk2_io_handle_t *io_handle,
+     const uint8_t *buffer,
+     size_t size,
+     off64_t offset,
+     libcerror_error_t **error );
+
+int libnk2_io_handle_get_remaining_items_size(
+     libnk2_io_handle_t *io_handle,
+     size64_t *remaining_size,
+     libcerror_error_t **error );
+
+int libnk2_io_handle_add_allocation(
+     libnk2_io_handle_t *io_handle,
+     size_t allocation_size,
+     libcerror_error_t **error );
+
+int libnk2_io_handle_add_entry_value_type(
+     libnk2_io_handle_t *io_handle,
+     uint32_t value_type,
+     libcerror_error_t **error );
+
+int libnk2_io_handle_get_number_of_entries_by_value_type(
+     libnk2_io_handle_t *io_handle,
+     uint32_t value_type,
+     uint64_t *number_of_entries,
+     libcerror_error_t **error );
+
+int libnk2_io_handle_clear_last_error(
+     libnk2_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+int libnk2_io_handle_set_last_error(
+     libnk2_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     int error_domain,
+     int error_code,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -20,6 +20,7 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <memory.h>
 #include <types.h>
 
@@ -36,6 +37,20 @@
 
 #include "nk2_item.h"
 
+/* The xxHash64 primes used by the content hash
+ */
+#define LIBNK2_ITEM_CONTENT_HASH_PRIME1		0x9e3779b185ebca87ULL
+#define LIBNK2_ITEM_CONTENT_HASH_PRIME2		0xc2b2ae3d27d4eb4fULL
+#define LIBNK2_ITEM_CONTENT_HASH_PRIME3		0x165667b19e3779f9ULL
+#define LIBNK2_ITEM_CONTENT_HASH_PRIME4		0x85ebca77c2b2ae63ULL
+#define LIBNK2_ITEM_CONTENT_HASH_PRIME5		0x27d4eb2f165667c5ULL
+
+#define libnk2_item_content_hash_rotate_left( value, number_of_bits ) \
+	( ( ( value ) << ( number_of_bits ) ) | ( ( value ) >> ( 64 - ( number_of_bits ) ) ) )
+
+#define libnk2_item_content_hash_round( accumulator, value ) \
+	( libnk2_item_content_hash_rotate_left( ( accumulator ) + ( ( value ) * LIBNK2_ITEM_CONTENT_HASH_PRIME2 ), 31 ) * LIBNK2_ITEM_CONTENT_HASH_PRIME1 )
+
 /* Creates an item
  * Make sure the value item is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
@@ -114,6 +129,8 @@ int libnk2_item_initialize(
 
 		goto on_error;
 	}
+	internal_item->content_hash = LIBNK2_ITEM_CONTENT_HASH_INITIAL_VALUE;
+
 	*item = (libnk2_item_t *) internal_item;
 
 	return( 1 );
@@ -199,6 +216,119 @@ int libnk2_internal_item_free(
 	return( result );
 }
 
+/* Updates the content hash with data
+ * The data is hashed with xxHash64 using the current content hash as the seed
+ * Returns the updated content hash
+ */
+uint64_t libnk2_item_update_content_hash(
+          uint64_t content_hash,
+          const uint8_t *data,
+          size_t data_size )
+{
+	uint64_t value_64bit = 0;
+	uint64_t value1      = 0;
+	uint64_t value2      = 0;
+	uint64_t value3      = 0;
+	uint64_t value4      = 0;
+	size_t data_offset   = 0;
+
+	if( data == NULL )
+	{
+		return( content_hash );
+	}
+	if( data_size >= 32 )
+	{
+		value1 = content_hash + LIBNK2_ITEM_CONTENT_HASH_PRIME1 + LIBNK2_ITEM_CONTENT_HASH_PRIME2;
+		value2 = content_hash + LIBNK2_ITEM_CONTENT_HASH_PRIME2;
+		value3 = content_hash;
+		value4 = content_hash - LIBNK2_ITEM_CONTENT_HASH_PRIME1;
+
+		while( ( data_offset + 32 ) <= data_size )
+		{
+			byte_stream_copy_to_uint64_little_endian(
+			 &( data[ data_offset ] ),
+			 value_64bit );
+
+			value1 = libnk2_item_content_hash_round( value1, value_64bit );
+
+			byte_stream_copy_to_uint64_little_endian(
+			 &( data[ data_offset + 8 ] ),
+			 value_64bit );
+
+			value2 = libnk2_item_content_hash_round( value2, value_64bit );
+
+			byte_stream_copy_to_uint64_little_endian(
+			 &( data[ data_offset + 16 ] ),
+			 value_64bit );
+
+			value3 = libnk2_item_content_hash_round( value3, value_64bit );
+
+			byte_stream_copy_to_uint64_little_endian(
+			 &( data[ data_offset + 24 ] ),
+			 value_64bit );
+
+			value4 = libnk2_item_content_hash_round( value4, value_64bit );
+
+			data_offset += 32;
+		}
+		content_hash = libnk2_item_content_hash_rotate_left( value1, 1 )
+		             + libnk2_item_content_hash_rotate_left( value2, 7 )
+		             + libnk2_item_content_hash_rotate_left( value3, 12 )
+		             + libnk2_item_content_hash_rotate_left( value4, 18 );
+
+		content_hash ^= libnk2_item_content_hash_round( 0, value1 );
+		content_hash  = ( content_hash * LIBNK2_ITEM_CONTENT_HASH_PRIME1 ) + LIBNK2_ITEM_CONTENT_HASH_PRIME4;
+		content_hash ^= libnk2_item_content_hash_round( 0, value2 );
+		content_hash  = ( content_hash * LIBNK2_ITEM_CONTENT_HASH_PRIME1 ) + LIBNK2_ITEM_CONTENT_HASH_PRIME4;
+		content_hash ^= libnk2_item_content_hash_round( 0, value3 );
+		content_hash  = ( content_hash * LIBNK2_ITEM_CONTENT_HASH_PRIME1 ) + LIBNK2_ITEM_CONTENT_HASH_PRIME4;
+		content_hash ^= libnk2_item_content_hash_round( 0, value4 );
+		content_hash  = ( content_hash * LIBNK2_ITEM_CONTENT_HASH_PRIME1 ) + LIBNK2_ITEM_CONTENT_HASH_PRIME4;
+	}
+	else
+	{
+		content_hash += LIBNK2_ITEM_CONTENT_HASH_PRIME5;
+	}
+	content_hash += (uint64_t) data_size;
+
+	while( ( data_offset + 8 ) <= data_size )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 &( data[ data_offset ] ),
+		 value_64bit );
+
+		content_hash ^= libnk2_item_content_hash_round( 0, value_64bit );
+		content_hash  = ( libnk2_item_content_hash_rotate_left( content_hash, 27 ) * LIBNK2_ITEM_CONTENT_HASH_PRIME1 ) + LIBNK2_ITEM_CONTENT_HASH_PRIME4;
+
+		data_offset += 8;
+	}
+	if( ( data_offset + 4 ) <= data_size )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( data[ data_offset ] ),
+		 value_64bit );
+
+		content_hash ^= value_64bit * LIBNK2_ITEM_CONTENT_HASH_PRIME1;
+		content_hash  = ( libnk2_item_content_hash_rotate_left( content_hash, 23 ) * LIBNK2_ITEM_CONTENT_HASH_PRIME2 ) + LIBNK2_ITEM_CONTENT_HASH_PRIME3;
+
+		data_offset += 4;
+	}
+	while( data_offset < data_size )
+	{
+		content_hash ^= (uint64_t) data[ data_offset ] * LIBNK2_ITEM_CONTENT_HASH_PRIME5;
+		content_hash  = libnk2_item_content_hash_rotate_left( content_hash, 11 ) * LIBNK2_ITEM_CONTENT_HASH_PRIME1;
+
+		data_offset += 1;
+	}
+	content_hash ^= content_hash >> 33;
+	content_hash *= LIBNK2_ITEM_CONTENT_HASH_PRIME2;
+	content_hash ^= content_hash >> 29;
+	content_hash *= LIBNK2_ITEM_CONTENT_HASH_PRIME3;
+	content_hash ^= content_hash >> 32;
+
+	return( content_hash );
+}
+
 /* Reads the record entries
  * Returns 1 if successful or -1 on error
  */
@@ -210,10 +340,13 @@ int libnk2_item_read_record_entries(
      uint32_t number_of_record_entries,
      libcerror_error_t **error )
 {
-	libnk2_record_entry_t *record_entry = NULL;
-	static char *function               = "libnk2_item_read_record_entries";
-	uint32_t record_entry_index         = 0;
-	int entry_index                     = 0;
+	uint8_t hash_data[ 12 ];
+
+	libnk2_internal_record_entry_t *internal_record_entry = NULL;
+	libnk2_record_entry_t *record_entry                   = NULL;
+	static char *function                                 = "libnk2_item_read_record_entries";
+	uint32_t record_entry_index                           = 0;
+	int entry_index                                       = 0;
 
 	LIBNK2_UNREFERENCED_PARAMETER( item_index )
 
@@ -267,8 +400,23 @@ int libnk2_item_read_record_entries(
 
 			goto on_error;
 		}
+		if( libnk2_io_handle_add_allocation(
+		     io_handle,
+		     sizeof( libnk2_internal_record_entry_t ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add record entry allocation to statistics.",
+			 function );
+
+			goto on_error;
+		}
 		if( libnk2_record_entry_read_file_io_handle(
 		     record_entry,
+		     io_handle,
 		     file_io_handle,
 		     error ) != 1 )
 		{
@@ -281,6 +429,47 @@ int libnk2_item_read_record_entries(
 
 			goto on_error;
 		}
+		if( libnk2_io_handle_add_entry_value_type(
+		     io_handle,
+		     ( (libnk2_internal_record_entry_t *) record_entry )->value_type,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add record entry value type to statistics.",
+			 function );
+
+			goto on_error;
+		}
+		internal_record_entry = (libnk2_internal_record_entry_t *) record_entry;
+
+		/* The content hash covers the entry type, value type, value data size and value data
+		 * so that items with equal record entries have equal content hashes
+		 */
+		byte_stream_copy_from_uint32_little_endian(
+		 &( hash_data[ 0 ] ),
+		 internal_record_entry->entry_type );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 &( hash_data[ 4 ] ),
+		 internal_record_entry->value_type );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 &( hash_data[ 8 ] ),
+		 (uint32_t) internal_record_entry->value_data_size );
+
+		internal_item->content_hash = libnk2_item_update_content_hash(
+		                               internal_item->content_hash,
+		                               hash_data,
+		                               12 );
+
+		internal_item->content_hash = libnk2_item_update_content_hash(
+		                               internal_item->content_hash,
+		                               internal_record_entry->value_data,
+		                               internal_record_entry->value_data_size );
+
 /* TODO refactor */
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( libcnotify_verbose != 0 )
@@ -353,6 +542,8 @@ on_error:
 	 (int (*)(intptr_t **, libcerror_error_t **)) &libnk2_internal_record_entry_free,
 	 NULL );
 
+	internal_item->content_hash = LIBNK2_ITEM_CONTENT_HASH_INITIAL_VALUE;
+
 	return( -1 );
 }
 
@@ -398,6 +589,48 @@ int libnk2_item_get_number_of_entries(
 	return( 1 );
 }
 
+/* Retrieves the content hash
+ * The content hash is a 64-bit xxHash of the entry type, value type, value data size
+ * and value data of the record entries, calculated when the item was read
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_item_get_content_hash(
+     libnk2_item_t *item,
+     uint64_t *content_hash,
+     libcerror_error_t **error )
+{
+	libnk2_internal_item_t *internal_item = NULL;
+	static char *function                 = "libnk2_item_get_content_hash";
+
+	if( item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
+
+		return( -1 );
+	}
+	internal_item = (libnk2_internal_item_t *) item;
+
+	if( content_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid content hash.",
+		 function );
+
+		return( -1 );
+	}
+	*content_hash = internal_item->content_hash;
+
+	return( 1 );
+}
+
 /* Retrieves a specific entry from the item
  * Returns 1 if successful or -1 on error
  */
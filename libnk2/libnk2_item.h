@@ -43,8 +43,16 @@ struct libnk2_internal_item
 	/* The record entries array
 	 */
 	libcdata_array_t *entries_array;
+
+	/* The content hash, a chained 64-bit xxHash of the record entries
+	 */
+	uint64_t content_hash;
 };
 
+/* The initial value of the content hash
+ */
+#define LIBNK2_ITEM_CONTENT_HASH_INITIAL_VALUE	0
+
 int libnk2_item_initialize(
      libnk2_item_t **item,
      libcerror_error_t **error );
@@ -58,6 +66,17 @@ int libnk2_internal_item_free(
      libnk2_internal_item_t **internal_item,
      libcerror_error_t **error );
 
+uint64_t libnk2_item_update_content_hash(
+          uint64_t content_hash,
+          const uint8_t *data,
+          size_t data_size );
+
+LIBNK2_EXTERN \
+int libnk2_item_get_content_hash(
+     libnk2_item_t *item,
+     uint64_t *content_hash,
+     libcerror_error_t **error );
+
 int libnk2_item_read_record_entries(
      libnk2_internal_item_t *internal_item,
      libnk2_io_handle_t *io_handle,
@@ -0,0 +1,605 @@
+/*
+ * Item lookup table functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libnk2_index.h"
+#include "libnk2_item.h"
+#include "libnk2_libcdata.h"
+#include "libnk2_libcerror.h"
+#include "libnk2_lookup_table.h"
+#include "libnk2_mapi.h"
+#include "libnk2_mapi_value.h"
+#include "libnk2_record_entry.h"
+#include "libnk2_value_table.h"
+
+/* Creates a lookup table of the display names and email addresses of items
+ * Make sure the value lookup_table is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_lookup_table_initialize(
+     libnk2_lookup_table_t **lookup_table,
+     libcdata_array_t *items_array,
+     libcerror_error_t **error )
+{
+	libnk2_internal_item_t *internal_item                 = NULL;
+	libnk2_internal_record_entry_t *internal_record_entry = NULL;
+	libnk2_lookup_table_entry_t *lookup_table_entry       = NULL;
+	libnk2_lookup_table_t *safe_lookup_table              = NULL;
+	static char *function                                 = "libnk2_lookup_table_initialize";
+	size_t entries_data_offset                            = 0;
+	size_t entries_data_size                              = 0;
+	size_t utf8_string_size                               = 0;
+	uint32_t bucket_index                                 = 0;
+	int entry_index                                       = 0;
+	int item_index                                        = 0;
+	int lookup_table_entry_index                          = 0;
+	int number_of_entries                                 = 0;
+	int number_of_items                                   = 0;
+	int number_of_lookup_table_entries                    = 0;
+	int pass                                              = 0;
+	int result                                            = 0;
+
+	if( lookup_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid lookup table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *lookup_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid lookup table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     items_array,
+	     &number_of_items,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of items.",
+		 function );
+
+		return( -1 );
+	}
+	safe_lookup_table = memory_allocate_structure(
+	                     libnk2_lookup_table_t );
+
+	if( safe_lookup_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create lookup table.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     safe_lookup_table,
+	     0,
+	     sizeof( libnk2_lookup_table_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear lookup table.",
+		 function );
+
+		memory_free(
+		 safe_lookup_table );
+
+		return( -1 );
+	}
+	/* The first pass determines the number of entries and the size of their data
+	 * the second pass copies the keys
+	 */
+	for( pass = 0;
+	     pass < 2;
+	     pass++ )
+	{
+		if( pass == 1 )
+		{
+			if( number_of_lookup_table_entries == 0 )
+			{
+				break;
+			}
+			if( ( (size_t) number_of_lookup_table_entries > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libnk2_lookup_table_entry_t ) ) )
+			 || ( entries_data_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid number of entries or entries data size value exceeds maximum allocation size.",
+				 function );
+
+				goto on_error;
+			}
+			safe_lookup_table->entries = (libnk2_lookup_table_entry_t *) memory_allocate(
+			                                                              sizeof( libnk2_lookup_table_entry_t ) * number_of_lookup_table_entries );
+
+			if( safe_lookup_table->entries == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create entries.",
+				 function );
+
+				goto on_error;
+			}
+			safe_lookup_table->entries_data = (uint8_t *) memory_allocate(
+			                                               sizeof( uint8_t ) * entries_data_size );
+
+			if( safe_lookup_table->entries_data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create entries data.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		for( item_index = 0;
+		     item_index < number_of_items;
+		     item_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     items_array,
+			     item_index,
+			     (intptr_t **) &internal_item,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve item: %d.",
+				 function,
+				 item_index );
+
+				goto on_error;
+			}
+			if( internal_item == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing item: %d.",
+				 function,
+				 item_index );
+
+				goto on_error;
+			}
+			if( libcdata_array_get_number_of_entries(
+			     internal_item->entries_array,
+			     &number_of_entries,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of entries of item: %d.",
+				 function,
+				 item_index );
+
+				goto on_error;
+			}
+			for( entry_index = 0;
+			     entry_index < number_of_entries;
+			     entry_index++ )
+			{
+				if( libcdata_array_get_entry_by_index(
+				     internal_item->entries_array,
+				     entry_index,
+				     (intptr_t **) &internal_record_entry,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve record entry: %d of item: %d.",
+					 function,
+					 entry_index,
+					 item_index );
+
+					goto on_error;
+				}
+				result = libnk2_index_get_key_string_size(
+				          internal_record_entry,
+				          &utf8_string_size,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve key string size of record entry: %d of item: %d.",
+					 function,
+					 entry_index,
+					 item_index );
+
+					goto on_error;
+				}
+				else if( result == 0 )
+				{
+					continue;
+				}
+				if( pass == 0 )
+				{
+					if( number_of_lookup_table_entries == INT_MAX )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+						 "%s: invalid number of entries value exceeds maximum.",
+						 function );
+
+						goto on_error;
+					}
+					number_of_lookup_table_entries++;
+
+					entries_data_size += utf8_string_size + 1;
+
+					continue;
+				}
+				if( ( lookup_table_entry_index >= number_of_lookup_table_entries )
+				 || ( ( utf8_string_size + 1 ) > ( entries_data_size - entries_data_offset ) ) )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+					 "%s: invalid entry index value out of bounds.",
+					 function );
+
+					goto on_error;
+				}
+				if( libnk2_mapi_value_get_data_as_utf8_string(
+				     internal_record_entry->value_type,
+				     internal_record_entry->value_data,
+				     internal_record_entry->value_data_size,
+				     internal_record_entry->ascii_codepage,
+				     &( safe_lookup_table->entries_data[ entries_data_offset ] ),
+				     utf8_string_size + 1,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve UTF-8 string of record entry: %d of item: %d.",
+					 function,
+					 entry_index,
+					 item_index );
+
+					goto on_error;
+				}
+				if( internal_record_entry->entry_type == LIBNK2_ENTRY_TYPE_EMAIL_ADDRESS )
+				{
+					libnk2_index_case_fold_utf8_string(
+					 &( safe_lookup_table->entries_data[ entries_data_offset ] ),
+					 utf8_string_size );
+				}
+				lookup_table_entry = &( safe_lookup_table->entries[ lookup_table_entry_index ] );
+
+				lookup_table_entry->data             = &( safe_lookup_table->entries_data[ entries_data_offset ] );
+				lookup_table_entry->data_size        = utf8_string_size;
+				lookup_table_entry->entry_type       = internal_record_entry->entry_type;
+				lookup_table_entry->item_index       = item_index;
+				lookup_table_entry->next_entry_index = -1;
+				lookup_table_entry->hash             = libnk2_value_table_calculate_hash(
+				                                        lookup_table_entry->data,
+				                                        lookup_table_entry->data_size );
+
+				entries_data_offset += utf8_string_size + 1;
+
+				lookup_table_entry_index++;
+			}
+		}
+	}
+	safe_lookup_table->number_of_entries = lookup_table_entry_index;
+	safe_lookup_table->number_of_buckets = 16;
+
+	while( safe_lookup_table->number_of_buckets < (uint32_t) safe_lookup_table->number_of_entries )
+	{
+		safe_lookup_table->number_of_buckets *= 2;
+	}
+	safe_lookup_table->buckets = (int *) memory_allocate(
+	                                      sizeof( int ) * safe_lookup_table->number_of_buckets );
+
+	if( safe_lookup_table->buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buckets.",
+		 function );
+
+		goto on_error;
+	}
+	for( bucket_index = 0;
+	     bucket_index < safe_lookup_table->number_of_buckets;
+	     bucket_index++ )
+	{
+		safe_lookup_table->buckets[ bucket_index ] = -1;
+	}
+	/* The entries are added in reverse order so that the entries in a bucket
+	 * are stored in ascending item index order
+	 */
+	for( lookup_table_entry_index = safe_lookup_table->number_of_entries - 1;
+	     lookup_table_entry_index >= 0;
+	     lookup_table_entry_index-- )
+	{
+		lookup_table_entry = &( safe_lookup_table->entries[ lookup_table_entry_index ] );
+
+		bucket_index = lookup_table_entry->hash & ( safe_lookup_table->number_of_buckets - 1 );
+
+		lookup_table_entry->next_entry_index       = safe_lookup_table->buckets[ bucket_index ];
+		safe_lookup_table->buckets[ bucket_index ] = lookup_table_entry_index;
+	}
+	*lookup_table = safe_lookup_table;
+
+	return( 1 );
+
+on_error:
+	if( safe_lookup_table != NULL )
+	{
+		libnk2_lookup_table_free(
+		 &safe_lookup_table,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a lookup table
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_lookup_table_free(
+     libnk2_lookup_table_t **lookup_table,
+     libcerror_error_t **error )
+{
+	static char *function = "libnk2_lookup_table_free";
+
+	if( lookup_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid lookup table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *lookup_table != NULL )
+	{
+		if( ( *lookup_table )->buckets != NULL )
+		{
+			memory_free(
+			 ( *lookup_table )->buckets );
+		}
+		if( ( *lookup_table )->entries_data != NULL )
+		{
+			memory_free(
+			 ( *lookup_table )->entries_data );
+		}
+		if( ( *lookup_table )->entries != NULL )
+		{
+			memory_free(
+			 ( *lookup_table )->entries );
+		}
+		memory_free(
+		 *lookup_table );
+
+		*lookup_table = NULL;
+	}
+	return( 1 );
+}
+
+/* Retrieves the index of the first item that contains a specific UTF-8 formatted key
+ * Email addresses are matched case insensitive, display names are matched exactly
+ * Returns 1 if successful, 0 if no such item or -1 on error
+ */
+int libnk2_lookup_table_get_item_index(
+     libnk2_lookup_table_t *lookup_table,
+     uint32_t entry_type,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     int *item_index,
+     libcerror_error_t **error )
+{
+	uint8_t key_data[ 256 ];
+
+	libnk2_lookup_table_entry_t *lookup_table_entry = NULL;
+	const uint8_t *key                              = NULL;
+	uint8_t *allocated_key                          = NULL;
+	static char *function                           = "libnk2_lookup_table_get_item_index";
+	uint32_t hash                                   = 0;
+	int lookup_table_entry_index                    = 0;
+	int result                                      = 0;
+
+	if( lookup_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid lookup table.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_length > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-8 string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( item_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item index.",
+		 function );
+
+		return( -1 );
+	}
+	key = utf8_string;
+
+	if( ( entry_type == LIBNK2_ENTRY_TYPE_EMAIL_ADDRESS )
+	 && ( utf8_string_length > 0 ) )
+	{
+		/* Email addresses are at most 254 characters, longer keys are case folded in a temporary buffer
+		 */
+		if( utf8_string_length <= 256 )
+		{
+			key = key_data;
+		}
+		else
+		{
+			allocated_key = (uint8_t *) memory_allocate(
+			                             sizeof( uint8_t ) * utf8_string_length );
+
+			if( allocated_key == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create key.",
+				 function );
+
+				return( -1 );
+			}
+			key = allocated_key;
+		}
+		if( memory_copy(
+		     (uint8_t *) key,
+		     utf8_string,
+		     utf8_string_length ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy key.",
+			 function );
+
+			goto on_error;
+		}
+		libnk2_index_case_fold_utf8_string(
+		 (uint8_t *) key,
+		 utf8_string_length );
+	}
+	hash = libnk2_value_table_calculate_hash(
+	        key,
+	        utf8_string_length );
+
+	lookup_table_entry_index = lookup_table->buckets[ hash & ( lookup_table->number_of_buckets - 1 ) ];
+
+	while( lookup_table_entry_index >= 0 )
+	{
+		lookup_table_entry = &( lookup_table->entries[ lookup_table_entry_index ] );
+
+		if( ( lookup_table_entry->hash == hash )
+		 && ( lookup_table_entry->entry_type == entry_type )
+		 && ( lookup_table_entry->data_size == utf8_string_length ) )
+		{
+			if( ( utf8_string_length == 0 )
+			 || ( memory_compare(
+			       lookup_table_entry->data,
+			       key,
+			       utf8_string_length ) == 0 ) )
+			{
+				*item_index = lookup_table_entry->item_index;
+
+				result = 1;
+
+				break;
+			}
+		}
+		lookup_table_entry_index = lookup_table_entry->next_entry_index;
+	}
+	if( allocated_key != NULL )
+	{
+		memory_free(
+		 allocated_key );
+	}
+	return( result );
+
+on_error:
+	if( allocated_key != NULL )
+	{
+		memory_free(
+		 allocated_key );
+	}
+	return( -1 );
+}
+
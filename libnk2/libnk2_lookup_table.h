@@ -0,0 +1,111 @@
+/*
+ * Item lookup table functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBNK2_LOOKUP_TABLE_H )
+#define _LIBNK2_LOOKUP_TABLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libnk2_libcdata.h"
+#include "libnk2_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libnk2_lookup_table_entry libnk2_lookup_table_entry_t;
+
+struct libnk2_lookup_table_entry
+{
+	/* The UTF-8 string of the key, email addresses are case folded
+	 */
+	const uint8_t *data;
+
+	/* The size of the key, without the end of string character
+	 */
+	size_t data_size;
+
+	/* The hash of the key
+	 */
+	uint32_t hash;
+
+	/* The entry type of the record entry that contains the key
+	 */
+	uint32_t entry_type;
+
+	/* The index of the item that contains the key
+	 */
+	int item_index;
+
+	/* The index of the next entry in the bucket or -1 if not set
+	 */
+	int next_entry_index;
+};
+
+typedef struct libnk2_lookup_table libnk2_lookup_table_t;
+
+struct libnk2_lookup_table
+{
+	/* The entries
+	 */
+	libnk2_lookup_table_entry_t *entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The data of the keys
+	 */
+	uint8_t *entries_data;
+
+	/* The buckets, that contain the index of the first entry or -1 if not set
+	 */
+	int *buckets;
+
+	/* The number of buckets, which is a power of 2
+	 */
+	uint32_t number_of_buckets;
+};
+
+int libnk2_lookup_table_initialize(
+     libnk2_lookup_table_t **lookup_table,
+     libcdata_array_t *items_array,
+     libcerror_error_t **error );
+
+int libnk2_lookup_table_free(
+     libnk2_lookup_table_t **lookup_table,
+     libcerror_error_t **error );
+
+int libnk2_lookup_table_get_item_index(
+     libnk2_lookup_table_t *lookup_table,
+     uint32_t entry_type,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     int *item_index,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBNK2_LOOKUP_TABLE_H ) */
+
@@ -24,6 +24,7 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libnk2_io_handle.h"
 #include "libnk2_libbfio.h"
 #include "libnk2_libcerror.h"
 #include "libnk2_libcnotify.h"
@@ -32,6 +33,7 @@
 #include "libnk2_mapi.h"
 #include "libnk2_mapi_value.h"
 #include "libnk2_record_entry.h"
+#include "libnk2_value_table.h"
 
 #include "nk2_item.h"
 
@@ -147,6 +149,7 @@ int libnk2_internal_record_entry_free(
      libcerror_error_t **error )
 {
 	static char *function = "libnk2_internal_record_entry_free";
+	int result            = 1;
 
 	if( internal_record_entry == NULL )
 	{
@@ -161,18 +164,81 @@ int libnk2_internal_record_entry_free(
 	}
 	if( *internal_record_entry != NULL )
 	{
-		if( ( ( *internal_record_entry )->value_data != NULL )
-		 && ( ( *internal_record_entry )->value_data != ( *internal_record_entry )->value_data_array ) )
+		if( libnk2_internal_record_entry_free_value_data(
+		     *internal_record_entry,
+		     error ) != 1 )
 		{
-			memory_free(
-			 ( *internal_record_entry )->value_data );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free value data.",
+			 function );
+
+			result = -1;
 		}
 		memory_free(
 		 *internal_record_entry );
 
 		*internal_record_entry = NULL;
 	}
-	return( 1 );
+	return( result );
+}
+
+/* Frees the value data of a record entry
+ * Value data that is stored in a value table is released instead
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_internal_record_entry_free_value_data(
+     libnk2_internal_record_entry_t *internal_record_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libnk2_internal_record_entry_free_value_data";
+	int result            = 1;
+
+	if( internal_record_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_record_entry->value_data != NULL )
+	 && ( internal_record_entry->value_data != internal_record_entry->value_data_array ) )
+	{
+		if( internal_record_entry->value_table != NULL )
+		{
+			if( libnk2_value_table_release_value(
+			     internal_record_entry->value_table,
+			     internal_record_entry->value_data,
+			     internal_record_entry->value_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to release value data.",
+				 function );
+
+				result = -1;
+			}
+		}
+		else
+		{
+			memory_free(
+			 internal_record_entry->value_data );
+		}
+	}
+	internal_record_entry->value_data      = NULL;
+	internal_record_entry->value_data_size = 0;
+	internal_record_entry->value_table     = NULL;
+
+	return( result );
 }
 
 /* Reads the record entry
@@ -350,6 +416,7 @@ int libnk2_record_entry_read_data(
  */
 int libnk2_record_entry_read_file_io_handle(
      libnk2_record_entry_t *record_entry,
+     libnk2_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error )
 {
@@ -357,8 +424,10 @@ int libnk2_record_entry_read_file_io_handle(
 
 	libnk2_internal_record_entry_t *internal_record_entry = NULL;
 	static char *function                                 = "libnk2_record_entry_read_file_io_handle";
-	uint32_t stored_value_data_size                       = 0;
+	size64_t remaining_size                               = 0;
 	ssize_t read_count                                    = 0;
+	uint32_t stored_value_data_size                       = 0;
+	int result                                            = 0;
 
 	if( record_entry == NULL )
 	{
@@ -373,16 +442,32 @@ int libnk2_record_entry_read_file_io_handle(
 	}
 	internal_record_entry = (libnk2_internal_record_entry_t *) record_entry;
 
-	if( ( internal_record_entry->value_data != NULL )
-	 && ( internal_record_entry->value_data != internal_record_entry->value_data_array ) )
+	if( io_handle == NULL )
 	{
-		memory_free(
-		 internal_record_entry->value_data );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
 	}
-	internal_record_entry->value_data      = NULL;
-	internal_record_entry->value_data_size = 0;
+	if( libnk2_internal_record_entry_free_value_data(
+	     internal_record_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free value data.",
+		 function );
 
-	read_count = libbfio_handle_read_buffer(
+		return( -1 );
+	}
+	read_count = libnk2_io_handle_read_buffer(
+		      io_handle,
 		      file_io_handle,
 		      record_entry_data,
 		      sizeof( nk2_item_value_entry_t ),
@@ -390,6 +475,13 @@ int libnk2_record_entry_read_file_io_handle(
 
 	if( read_count != (ssize_t) sizeof( nk2_item_value_entry_t ) )
 	{
+		libnk2_io_handle_set_last_error(
+		 io_handle,
+		 file_io_handle,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 NULL );
+
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
@@ -405,6 +497,13 @@ int libnk2_record_entry_read_file_io_handle(
 	     sizeof( nk2_item_value_entry_t ),
 	     error ) != 1 )
 	{
+		libnk2_io_handle_set_last_error(
+		 io_handle,
+		 file_io_handle,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 NULL );
+
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
@@ -418,7 +517,8 @@ int libnk2_record_entry_read_file_io_handle(
 	{
 		/* The value data size is stored after the item value
 		 */
-		read_count = libbfio_handle_read_buffer(
+		read_count = libnk2_io_handle_read_buffer(
+			      io_handle,
 			      file_io_handle,
 			      internal_record_entry->value_data_array,
 			      4,
@@ -426,6 +526,13 @@ int libnk2_record_entry_read_file_io_handle(
 
 		if( read_count != (ssize_t) 4 )
 		{
+			libnk2_io_handle_set_last_error(
+			 io_handle,
+			 file_io_handle,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 NULL );
+
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
@@ -442,6 +549,13 @@ int libnk2_record_entry_read_file_io_handle(
 #if SIZEOF_SIZE_T <= 4
 		if( stored_value_data_size > (uint32_t) SSIZE_MAX )
 		{
+			libnk2_io_handle_set_last_error(
+			 io_handle,
+			 file_io_handle,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 NULL );
+
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
@@ -465,9 +579,54 @@ int libnk2_record_entry_read_file_io_handle(
 #endif
 	if( internal_record_entry->value_data == NULL )
 	{
+		result = libnk2_io_handle_get_remaining_items_size(
+		          io_handle,
+		          &remaining_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve remaining items size.",
+			 function );
+
+			goto on_error;
+		}
+		/* Reject value data that cannot be stored in the remaining items data
+		 * before allocating it
+		 */
+		if( ( result != 0 )
+		 && ( (size64_t) stored_value_data_size > remaining_size ) )
+		{
+			libnk2_io_handle_set_last_error(
+			 io_handle,
+			 file_io_handle,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 NULL );
+
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid stored value data size value exceeds remaining items size.",
+			 function );
+
+			goto on_error;
+		}
 		if( ( stored_value_data_size == 0 )
 		 || ( stored_value_data_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
 		{
+			libnk2_io_handle_set_last_error(
+			 io_handle,
+			 file_io_handle,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 NULL );
+
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
@@ -482,6 +641,13 @@ int libnk2_record_entry_read_file_io_handle(
 
 		if( internal_record_entry->value_data == NULL )
 		{
+			libnk2_io_handle_set_last_error(
+			 io_handle,
+			 file_io_handle,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 NULL );
+
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_MEMORY,
@@ -491,7 +657,22 @@ int libnk2_record_entry_read_file_io_handle(
 
 			goto on_error;
 		}
-		read_count = libbfio_handle_read_buffer(
+		if( libnk2_io_handle_add_allocation(
+		     io_handle,
+		     internal_record_entry->value_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add value data allocation to statistics.",
+			 function );
+
+			goto on_error;
+		}
+		read_count = libnk2_io_handle_read_buffer(
+		              io_handle,
 		              file_io_handle,
 		              internal_record_entry->value_data,
 		              internal_record_entry->value_data_size,
@@ -499,6 +680,13 @@ int libnk2_record_entry_read_file_io_handle(
 
 		if( read_count != (ssize_t) internal_record_entry->value_data_size )
 		{
+			libnk2_io_handle_set_last_error(
+			 io_handle,
+			 file_io_handle,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 NULL );
+
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
@@ -508,18 +696,35 @@ int libnk2_record_entry_read_file_io_handle(
 
 			goto on_error;
 		}
+		if( io_handle->value_table != NULL )
+		{
+			/* The value table takes ownership of the value data and replaces it
+			 * by identical value data if already stored
+			 */
+			if( libnk2_value_table_insert_value(
+			     io_handle->value_table,
+			     &( internal_record_entry->value_data ),
+			     internal_record_entry->value_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to insert value data into value table.",
+				 function );
+
+				goto on_error;
+			}
+			internal_record_entry->value_table = io_handle->value_table;
+		}
 	}
 	return( 1 );
 
 on_error:
-	if( ( internal_record_entry->value_data != NULL )
-	 && ( internal_record_entry->value_data != internal_record_entry->value_data_array ) )
-	{
-		memory_free(
-		 internal_record_entry->value_data );
-	}
-	internal_record_entry->value_data      = NULL;
-	internal_record_entry->value_data_size = 0;
+	libnk2_internal_record_entry_free_value_data(
+	 internal_record_entry,
+	 NULL );
 
 	return( -1 );
 }
@@ -720,6 +925,71 @@ int libnk2_record_entry_get_data(
 	return( 1 );
 }
 
+/* Retrieves a pointer to the data
+ * The data is owned by the record entry and remains valid until the file is closed
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_record_entry_get_data_pointer(
+     libnk2_record_entry_t *record_entry,
+     const uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	libnk2_internal_record_entry_t *internal_record_entry = NULL;
+	static char *function                                 = "libnk2_record_entry_get_data_pointer";
+
+	if( record_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_record_entry = (libnk2_internal_record_entry_t *) record_entry;
+
+	if( internal_record_entry->value_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid record entry - missing value data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	*data      = internal_record_entry->value_data;
+	*data_size = internal_record_entry->value_data_size;
+
+	return( 1 );
+}
+
 /* Retrieves the data as a boolean value
  * Returns 1 if successful or -1 on error
  */
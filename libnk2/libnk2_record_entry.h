@@ -26,9 +26,11 @@
 #include <types.h>
 
 #include "libnk2_extern.h"
+#include "libnk2_io_handle.h"
 #include "libnk2_libbfio.h"
 #include "libnk2_libcerror.h"
 #include "libnk2_types.h"
+#include "libnk2_value_table.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -58,6 +60,10 @@ struct libnk2_internal_record_entry
 	 */
 	size_t value_data_size;
 
+	/* The value table that stores the value data or NULL if the value data is owned by the record entry
+	 */
+	libnk2_value_table_t *value_table;
+
 	/* The codepage of the extended ASCII strings
 	 */
 	int ascii_codepage;
@@ -77,6 +83,10 @@ int libnk2_internal_record_entry_free(
      libnk2_internal_record_entry_t **internal_record_entry,
      libcerror_error_t **error );
 
+int libnk2_internal_record_entry_free_value_data(
+     libnk2_internal_record_entry_t *internal_record_entry,
+     libcerror_error_t **error );
+
 int libnk2_record_entry_read_data(
      libnk2_record_entry_t *record_entry,
      const uint8_t *data,
@@ -85,6 +95,7 @@ int libnk2_record_entry_read_data(
 
 int libnk2_record_entry_read_file_io_handle(
      libnk2_record_entry_t *record_entry,
+     libnk2_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
@@ -113,6 +124,13 @@ int libnk2_record_entry_get_data(
      size_t data_size,
      libcerror_error_t **error );
 
+LIBNK2_EXTERN \
+int libnk2_record_entry_get_data_pointer(
+     libnk2_record_entry_t *record_entry,
+     const uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error );
+
 LIBNK2_EXTERN \
 int libnk2_record_entry_get_data_as_boolean(
      libnk2_record_entry_t *record_entry,
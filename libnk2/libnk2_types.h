@@ -34,17 +34,138 @@
 /* The following type definitions hide internal data structures
  */
 #if defined( HAVE_DEBUG_OUTPUT ) && !defined( WINAPI )
+typedef struct libnk2_address_filter {}	libnk2_address_filter_t;
+typedef struct libnk2_alias_index {}	libnk2_alias_index_t;
+typedef struct libnk2_alias_index_writer {}	libnk2_alias_index_writer_t;
 typedef struct libnk2_file {}		libnk2_file_t;
+typedef struct libnk2_index {}		libnk2_index_t;
 typedef struct libnk2_item {}		libnk2_item_t;
 typedef struct libnk2_record_entry {}	libnk2_record_entry_t;
+typedef struct libnk2_value_table {}	libnk2_value_table_t;
+typedef struct libnk2_writer {}		libnk2_writer_t;
 
 #else
+typedef intptr_t libnk2_address_filter_t;
+typedef intptr_t libnk2_alias_index_t;
+typedef intptr_t libnk2_alias_index_writer_t;
 typedef intptr_t libnk2_file_t;
+typedef intptr_t libnk2_index_t;
 typedef intptr_t libnk2_item_t;
 typedef intptr_t libnk2_record_entry_t;
+typedef intptr_t libnk2_value_table_t;
+typedef intptr_t libnk2_writer_t;
 
 #endif /* defined( HAVE_DEBUG_OUTPUT ) && !defined( WINAPI ) */
 
+/* The parse statistics
+ */
+typedef struct libnk2_statistics libnk2_statistics_t;
+
+struct libnk2_statistics
+{
+	/* The number of read calls
+	 */
+	uint64_t number_of_read_calls;
+
+	/* The number of bytes read
+	 */
+	uint64_t number_of_bytes_read;
+
+	/* The number of allocations
+	 */
+	uint64_t number_of_allocations;
+
+	/* The number of bytes allocated
+	 */
+	uint64_t number_of_bytes_allocated;
+
+	/* The number of items
+	 */
+	uint64_t number_of_items;
+
+	/* The number of (record) entries
+	 */
+	uint64_t number_of_entries;
+
+	/* The time spent reading the file header in nanoseconds
+	 */
+	uint64_t file_header_read_time;
+
+	/* The time spent reading the items in nanoseconds
+	 */
+	uint64_t items_read_time;
+
+	/* The time spent reading the file footer in nanoseconds
+	 */
+	uint64_t file_footer_read_time;
+};
+
+/* The diff callbacks
+ * A callback that is NULL is not called
+ * The callbacks return 1 if successful or -1 on error, which stops the diff
+ */
+typedef struct libnk2_diff_callbacks libnk2_diff_callbacks_t;
+
+struct libnk2_diff_callbacks
+{
+	/* Called for an item that is only in the other file
+	 */
+	int (*item_added)(
+	       libnk2_item_t *item,
+	       int item_index,
+	       void *callback_data );
+
+	/* Called for an item that is only in the file
+	 */
+	int (*item_removed)(
+	       libnk2_item_t *item,
+	       int item_index,
+	       void *callback_data );
+
+	/* Called for an item that is in both files with different record entries
+	 * before the entry_changed callbacks of the item
+	 */
+	int (*item_modified)(
+	       libnk2_item_t *item,
+	       int item_index,
+	       libnk2_item_t *other_item,
+	       int other_item_index,
+	       void *callback_data );
+
+	/* Called for a record entry of a modified item that differs between the files
+	 * record_entry is NULL if the record entry was added
+	 * other_record_entry is NULL if the record entry was removed
+	 */
+	int (*entry_changed)(
+	       libnk2_record_entry_t *record_entry,
+	       libnk2_record_entry_t *other_record_entry,
+	       void *callback_data );
+};
+
+/* A record entry to write
+ */
+typedef struct libnk2_writer_entry libnk2_writer_entry_t;
+
+struct libnk2_writer_entry
+{
+	/* The entry type
+	 */
+	uint32_t entry_type;
+
+	/* The value type
+	 */
+	uint32_t value_type;
+
+	/* The value data
+	 * Fixed size values contain the little-endian value data
+	 */
+	const uint8_t *value_data;
+
+	/* The value data size
+	 */
+	size_t value_data_size;
+};
+
 #endif /* defined( HAVE_LOCAL_LIBNK2 ) */
 
 #endif /* !defined( _LIBNK2_INTERNAL_TYPES_H ) */
@@ -0,0 +1,645 @@
+/*
+ * Value table functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libnk2_libcerror.h"
+#include "libnk2_value_table.h"
+
+/* Creates a value table
+ * A value table is used to share identical value data between record entries
+ * of a file or of multiple files
+ * Make sure the value value_table is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_value_table_initialize(
+     libnk2_value_table_t **value_table,
+     libcerror_error_t **error )
+{
+	libnk2_internal_value_table_t *internal_value_table = NULL;
+	static char *function                               = "libnk2_value_table_initialize";
+
+	if( value_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *value_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid value table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_value_table = memory_allocate_structure(
+	                        libnk2_internal_value_table_t );
+
+	if( internal_value_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create value table.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_value_table,
+	     0,
+	     sizeof( libnk2_internal_value_table_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear value table.",
+		 function );
+
+		memory_free(
+		 internal_value_table );
+
+		return( -1 );
+	}
+	if( libnk2_value_table_resize(
+	     internal_value_table,
+	     LIBNK2_VALUE_TABLE_INITIAL_NUMBER_OF_BUCKETS,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize buckets.",
+		 function );
+
+		goto on_error;
+	}
+	*value_table = (libnk2_value_table_t *) internal_value_table;
+
+	return( 1 );
+
+on_error:
+	if( internal_value_table != NULL )
+	{
+		memory_free(
+		 internal_value_table );
+	}
+	return( -1 );
+}
+
+/* Frees a value table
+ * All files that use the value table must be closed before it is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_value_table_free(
+     libnk2_value_table_t **value_table,
+     libcerror_error_t **error )
+{
+	libnk2_internal_value_table_t *internal_value_table = NULL;
+	static char *function                               = "libnk2_value_table_free";
+
+	if( value_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *value_table != NULL )
+	{
+		internal_value_table = (libnk2_internal_value_table_t *) *value_table;
+
+		/* Freeing values that are still referenced by record entries would leave
+		 * the record entries with dangling value data
+		 */
+		if( internal_value_table->number_of_values != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid value table - values are still referenced.",
+			 function );
+
+			return( -1 );
+		}
+		*value_table = NULL;
+
+		memory_free(
+		 internal_value_table->buckets );
+
+		memory_free(
+		 internal_value_table );
+	}
+	return( 1 );
+}
+
+/* Calculates the hash of the data
+ * This uses the 32-bit FNV-1a hash
+ * Returns the hash
+ */
+uint32_t libnk2_value_table_calculate_hash(
+          const uint8_t *data,
+          size_t data_size )
+{
+	size_t data_offset = 0;
+	uint32_t hash      = 0x811c9dc5UL;
+
+	if( data == NULL )
+	{
+		return( 0 );
+	}
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset++ )
+	{
+		hash ^= data[ data_offset ];
+		hash *= 0x01000193UL;
+	}
+	return( hash );
+}
+
+/* Resizes the buckets of the value table and rehashes the values
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_value_table_resize(
+     libnk2_internal_value_table_t *internal_value_table,
+     uint32_t number_of_buckets,
+     libcerror_error_t **error )
+{
+	libnk2_value_table_value_t **buckets = NULL;
+	libnk2_value_table_value_t *value    = NULL;
+	static char *function                = "libnk2_value_table_resize";
+	size_t buckets_size                  = 0;
+	uint32_t bucket_index                = 0;
+	uint32_t new_bucket_index            = 0;
+
+	if( internal_value_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value table.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_buckets == 0 )
+	 || ( ( number_of_buckets & ( number_of_buckets - 1 ) ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported number of buckets.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size_t) number_of_buckets > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libnk2_value_table_value_t * ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of buckets value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	buckets_size = sizeof( libnk2_value_table_value_t * ) * number_of_buckets;
+
+	buckets = (libnk2_value_table_value_t **) memory_allocate(
+	                                           buckets_size );
+
+	if( buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buckets.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     buckets,
+	     0,
+	     buckets_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buckets.",
+		 function );
+
+		memory_free(
+		 buckets );
+
+		return( -1 );
+	}
+	for( bucket_index = 0;
+	     bucket_index < internal_value_table->number_of_buckets;
+	     bucket_index++ )
+	{
+		while( internal_value_table->buckets[ bucket_index ] != NULL )
+		{
+			value = internal_value_table->buckets[ bucket_index ];
+
+			internal_value_table->buckets[ bucket_index ] = value->next_value;
+
+			new_bucket_index = value->hash & ( number_of_buckets - 1 );
+
+			value->next_value           = buckets[ new_bucket_index ];
+			buckets[ new_bucket_index ] = value;
+		}
+	}
+	if( internal_value_table->buckets != NULL )
+	{
+		memory_free(
+		 internal_value_table->buckets );
+	}
+	internal_value_table->buckets           = buckets;
+	internal_value_table->number_of_buckets = number_of_buckets;
+
+	return( 1 );
+}
+
+/* Inserts value data into the value table
+ * The value table takes ownership of the data. If identical data is already
+ * stored the data is freed and replaced by the stored data
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_value_table_insert_value(
+     libnk2_value_table_t *value_table,
+     uint8_t **data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libnk2_internal_value_table_t *internal_value_table = NULL;
+	libnk2_value_table_value_t *value                   = NULL;
+	static char *function                               = "libnk2_value_table_insert_value";
+	uint32_t bucket_index                               = 0;
+	uint32_t hash                                       = 0;
+
+	if( value_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value table.",
+		 function );
+
+		return( -1 );
+	}
+	internal_value_table = (libnk2_internal_value_table_t *) value_table;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_value_table->number_of_references >= (uint64_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid value table - number of references value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	hash         = libnk2_value_table_calculate_hash(
+	                *data,
+	                data_size );
+	bucket_index = hash & ( internal_value_table->number_of_buckets - 1 );
+
+	for( value = internal_value_table->buckets[ bucket_index ];
+	     value != NULL;
+	     value = value->next_value )
+	{
+		if( ( value->hash == hash )
+		 && ( value->data_size == data_size )
+		 && ( memory_compare(
+		       value->data,
+		       *data,
+		       data_size ) == 0 ) )
+		{
+			break;
+		}
+	}
+	if( value != NULL )
+	{
+		if( value->data != *data )
+		{
+			memory_free(
+			 *data );
+
+			*data = value->data;
+		}
+		value->number_of_references += 1;
+
+		internal_value_table->number_of_references += 1;
+
+		return( 1 );
+	}
+	if( internal_value_table->number_of_values >= internal_value_table->number_of_buckets )
+	{
+		if( libnk2_value_table_resize(
+		     internal_value_table,
+		     internal_value_table->number_of_buckets * 2,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize buckets.",
+			 function );
+
+			return( -1 );
+		}
+		bucket_index = hash & ( internal_value_table->number_of_buckets - 1 );
+	}
+	value = memory_allocate_structure(
+	         libnk2_value_table_value_t );
+
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create value.",
+		 function );
+
+		return( -1 );
+	}
+	value->hash                 = hash;
+	value->number_of_references = 1;
+	value->data                 = *data;
+	value->data_size            = data_size;
+	value->next_value           = internal_value_table->buckets[ bucket_index ];
+
+	internal_value_table->buckets[ bucket_index ] = value;
+
+	internal_value_table->number_of_values     += 1;
+	internal_value_table->number_of_references += 1;
+
+	return( 1 );
+}
+
+/* Releases value data that was inserted into the value table
+ * The data is freed when it is no longer referenced
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_value_table_release_value(
+     libnk2_value_table_t *value_table,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libnk2_internal_value_table_t *internal_value_table = NULL;
+	libnk2_value_table_value_t *previous_value          = NULL;
+	libnk2_value_table_value_t *value                   = NULL;
+	static char *function                               = "libnk2_value_table_release_value";
+	uint32_t bucket_index                               = 0;
+	uint32_t hash                                       = 0;
+
+	if( value_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value table.",
+		 function );
+
+		return( -1 );
+	}
+	internal_value_table = (libnk2_internal_value_table_t *) value_table;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	hash         = libnk2_value_table_calculate_hash(
+	                data,
+	                data_size );
+	bucket_index = hash & ( internal_value_table->number_of_buckets - 1 );
+
+	for( value = internal_value_table->buckets[ bucket_index ];
+	     value != NULL;
+	     value = value->next_value )
+	{
+		if( value->data == data )
+		{
+			break;
+		}
+		previous_value = value;
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: unable to find value.",
+		 function );
+
+		return( -1 );
+	}
+	value->number_of_references -= 1;
+
+	internal_value_table->number_of_references -= 1;
+
+	if( value->number_of_references == 0 )
+	{
+		if( previous_value == NULL )
+		{
+			internal_value_table->buckets[ bucket_index ] = value->next_value;
+		}
+		else
+		{
+			previous_value->next_value = value->next_value;
+		}
+		internal_value_table->number_of_values -= 1;
+
+		memory_free(
+		 value->data );
+
+		memory_free(
+		 value );
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of distinct values
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_value_table_get_number_of_values(
+     libnk2_value_table_t *value_table,
+     int *number_of_values,
+     libcerror_error_t **error )
+{
+	libnk2_internal_value_table_t *internal_value_table = NULL;
+	static char *function                               = "libnk2_value_table_get_number_of_values";
+
+	if( value_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value table.",
+		 function );
+
+		return( -1 );
+	}
+	internal_value_table = (libnk2_internal_value_table_t *) value_table;
+
+	if( number_of_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_value_table->number_of_values > (uint32_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of values value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_values = (int) internal_value_table->number_of_values;
+
+	return( 1 );
+}
+
+/* Retrieves the number of references to the values
+ * The difference with the number of values is the number of value data
+ * allocations that were saved
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_value_table_get_number_of_references(
+     libnk2_value_table_t *value_table,
+     uint64_t *number_of_references,
+     libcerror_error_t **error )
+{
+	libnk2_internal_value_table_t *internal_value_table = NULL;
+	static char *function                               = "libnk2_value_table_get_number_of_references";
+
+	if( value_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value table.",
+		 function );
+
+		return( -1 );
+	}
+	internal_value_table = (libnk2_internal_value_table_t *) value_table;
+
+	if( number_of_references == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of references.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_references = internal_value_table->number_of_references;
+
+	return( 1 );
+}
+
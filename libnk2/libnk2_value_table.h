@@ -0,0 +1,134 @@
+/*
+ * Value table functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBNK2_VALUE_TABLE_H )
+#define _LIBNK2_VALUE_TABLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libnk2_extern.h"
+#include "libnk2_libcerror.h"
+#include "libnk2_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The initial number of buckets of the value table
+ */
+#define LIBNK2_VALUE_TABLE_INITIAL_NUMBER_OF_BUCKETS	256
+
+typedef struct libnk2_value_table_value libnk2_value_table_value_t;
+
+struct libnk2_value_table_value
+{
+	/* The next value in the bucket
+	 */
+	libnk2_value_table_value_t *next_value;
+
+	/* The hash of the data
+	 */
+	uint32_t hash;
+
+	/* The number of references
+	 */
+	uint32_t number_of_references;
+
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+};
+
+typedef struct libnk2_internal_value_table libnk2_internal_value_table_t;
+
+struct libnk2_internal_value_table
+{
+	/* The buckets
+	 */
+	libnk2_value_table_value_t **buckets;
+
+	/* The number of buckets, which is a power of 2
+	 */
+	uint32_t number_of_buckets;
+
+	/* The number of distinct values
+	 */
+	uint32_t number_of_values;
+
+	/* The number of references to the values
+	 */
+	uint64_t number_of_references;
+};
+
+LIBNK2_EXTERN \
+int libnk2_value_table_initialize(
+     libnk2_value_table_t **value_table,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_value_table_free(
+     libnk2_value_table_t **value_table,
+     libcerror_error_t **error );
+
+uint32_t libnk2_value_table_calculate_hash(
+          const uint8_t *data,
+          size_t data_size );
+
+int libnk2_value_table_resize(
+     libnk2_internal_value_table_t *internal_value_table,
+     uint32_t number_of_buckets,
+     libcerror_error_t **error );
+
+int libnk2_value_table_insert_value(
+     libnk2_value_table_t *value_table,
+     uint8_t **data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libnk2_value_table_release_value(
+     libnk2_value_table_t *value_table,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_value_table_get_number_of_values(
+     libnk2_value_table_t *value_table,
+     int *number_of_values,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_value_table_get_number_of_references(
+     libnk2_value_table_t *value_table,
+     uint64_t *number_of_references,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBNK2_VALUE_TABLE_H ) */
+
@@ -0,0 +1,1382 @@
+/*
+ * Writer functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#include "libnk2_definitions.h"
+#include "libnk2_io_handle.h"
+#include "libnk2_item.h"
+#include "libnk2_libbfio.h"
+#include "libnk2_libcdata.h"
+#include "libnk2_libcerror.h"
+#include "libnk2_mapi_value.h"
+#include "libnk2_record_entry.h"
+#include "libnk2_writer.h"
+
+#include "nk2_file_footer.h"
+#include "nk2_file_header.h"
+#include "nk2_item.h"
+
+/* Creates a writer
+ * Make sure the value writer is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_writer_initialize(
+     libnk2_writer_t **writer,
+     libcerror_error_t **error )
+{
+	libnk2_internal_writer_t *internal_writer = NULL;
+	static char *function                     = "libnk2_writer_initialize";
+
+	if( writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *writer != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid writer value already set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_writer = memory_allocate_structure(
+	                   libnk2_internal_writer_t );
+
+	if( internal_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create writer.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_writer,
+	     0,
+	     sizeof( libnk2_internal_writer_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear writer.",
+		 function );
+
+		memory_free(
+		 internal_writer );
+
+		return( -1 );
+	}
+	internal_writer->buffer = (uint8_t *) memory_allocate(
+	                                       sizeof( uint8_t ) * LIBNK2_WRITER_BUFFER_SIZE );
+
+	if( internal_writer->buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	*writer = (libnk2_writer_t *) internal_writer;
+
+	return( 1 );
+
+on_error:
+	if( internal_writer != NULL )
+	{
+		memory_free(
+		 internal_writer );
+	}
+	return( -1 );
+}
+
+/* Frees a writer
+ * A writer that is still open is closed, which completes the file
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_writer_free(
+     libnk2_writer_t **writer,
+     libcerror_error_t **error )
+{
+	libnk2_internal_writer_t *internal_writer = NULL;
+	static char *function                     = "libnk2_writer_free";
+	int result                                = 1;
+
+	if( writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *writer != NULL )
+	{
+		internal_writer = (libnk2_internal_writer_t *) *writer;
+
+		if( internal_writer->file_io_handle != NULL )
+		{
+			if( libnk2_writer_close(
+			     *writer,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close writer.",
+				 function );
+
+				result = -1;
+			}
+		}
+		*writer = NULL;
+
+		memory_free(
+		 internal_writer->buffer );
+
+		memory_free(
+		 internal_writer );
+	}
+	return( result );
+}
+
+/* Signals the writer to abort its current activity
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_writer_signal_abort(
+     libnk2_writer_t *writer,
+     libcerror_error_t **error )
+{
+	static char *function = "libnk2_writer_signal_abort";
+
+	if( writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid writer.",
+		 function );
+
+		return( -1 );
+	}
+	( (libnk2_internal_writer_t *) writer )->abort = 1;
+
+	return( 1 );
+}
+
+/* Opens a writer
+ * An existing file is truncated
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_writer_open(
+     libnk2_writer_t *writer,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle          = NULL;
+	libnk2_internal_writer_t *internal_writer = NULL;
+	static char *function                     = "libnk2_writer_open";
+	size_t filename_length                    = 0;
+
+	if( writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid writer.",
+		 function );
+
+		return( -1 );
+	}
+	internal_writer = (libnk2_internal_writer_t *) writer;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	filename_length = narrow_string_length(
+	                   filename );
+
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libnk2_writer_open_file_io_handle(
+	     writer,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	internal_writer->file_io_handle_created_in_library = 1;
+
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Opens a writer
+ * An existing file is truncated
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_writer_open_wide(
+     libnk2_writer_t *writer,
+     const wchar_t *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle          = NULL;
+	libnk2_internal_writer_t *internal_writer = NULL;
+	static char *function                     = "libnk2_writer_open_wide";
+	size_t filename_length                    = 0;
+
+	if( writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid writer.",
+		 function );
+
+		return( -1 );
+	}
+	internal_writer = (libnk2_internal_writer_t *) writer;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	filename_length = wide_string_length(
+	                   filename );
+
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libnk2_writer_open_file_io_handle(
+	     writer,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file: %ls.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	internal_writer->file_io_handle_created_in_library = 1;
+
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Opens a writer using a Basic File IO (bfio) handle
+ * The file is written from the start of the file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_writer_open_file_io_handle(
+     libnk2_writer_t *writer,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libnk2_internal_writer_t *internal_writer = NULL;
+	nk2_file_header_t *file_header            = NULL;
+	static char *function                     = "libnk2_writer_open_file_io_handle";
+	int file_io_handle_is_open                = 0;
+
+	if( writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid writer.",
+		 function );
+
+		return( -1 );
+	}
+	internal_writer = (libnk2_internal_writer_t *) writer;
+
+	if( internal_writer->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid writer - file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_handle_is_open = libbfio_handle_is_open(
+	                          file_io_handle,
+	                          error );
+
+	if( file_io_handle_is_open == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to determine if file IO handle is open.",
+		 function );
+
+		return( -1 );
+	}
+	else if( file_io_handle_is_open == 0 )
+	{
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     LIBBFIO_OPEN_WRITE_TRUNCATE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file IO handle.",
+			 function );
+
+			return( -1 );
+		}
+		internal_writer->file_io_handle_opened_in_library = 1;
+	}
+	internal_writer->file_io_handle  = file_io_handle;
+	internal_writer->file_offset     = 0;
+	internal_writer->number_of_items = 0;
+	internal_writer->abort           = 0;
+
+	/* The number of items in the file header is set when the writer is closed
+	 */
+	file_header = (nk2_file_header_t *) internal_writer->buffer;
+
+	if( memory_copy(
+	     file_header->signature,
+	     nk2_file_signature,
+	     4 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header->unknown1,
+	 0x0000000aUL );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header->unknown2,
+	 0x00000001UL );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header->number_of_items,
+	 0 );
+
+	internal_writer->buffer_offset = sizeof( nk2_file_header_t );
+
+	return( 1 );
+
+on_error:
+	if( internal_writer->file_io_handle_opened_in_library != 0 )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+
+		internal_writer->file_io_handle_opened_in_library = 0;
+	}
+	internal_writer->file_io_handle = NULL;
+	internal_writer->buffer_offset  = 0;
+
+	return( -1 );
+}
+
+/* Closes a writer
+ * Writes the file footer and the number of items in the file header
+ * Returns 0 if successful or -1 on error
+ */
+int libnk2_writer_close(
+     libnk2_writer_t *writer,
+     libcerror_error_t **error )
+{
+	uint8_t number_of_items_data[ 4 ];
+	uint8_t file_footer_data[ sizeof( nk2_file_footer_t ) ];
+
+	libnk2_internal_writer_t *internal_writer = NULL;
+	static char *function                     = "libnk2_writer_close";
+	ssize_t write_count                       = 0;
+	uint8_t file_header_in_buffer             = 0;
+	int result                                = 0;
+
+	if( writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid writer.",
+		 function );
+
+		return( -1 );
+	}
+	internal_writer = (libnk2_internal_writer_t *) writer;
+
+	if( internal_writer->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid writer - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (nk2_file_footer_t *) file_footer_data )->unknown1,
+	 0 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (nk2_file_footer_t *) file_footer_data )->modification_time,
+	 internal_writer->modification_time );
+
+	if( libnk2_writer_write_buffer(
+	     internal_writer,
+	     file_footer_data,
+	     sizeof( nk2_file_footer_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file footer.",
+		 function );
+
+		result = -1;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 number_of_items_data,
+	 internal_writer->number_of_items );
+
+	/* If nothing has been flushed yet the file header is still in the buffer
+	 * and the whole file is written at once
+	 */
+	if( ( result == 0 )
+	 && ( internal_writer->file_offset == 0 ) )
+	{
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (nk2_file_header_t *) internal_writer->buffer )->number_of_items,
+		 internal_writer->number_of_items );
+
+		file_header_in_buffer = 1;
+	}
+	if( result == 0 )
+	{
+		if( libnk2_writer_flush(
+		     internal_writer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush buffer.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( ( result == 0 )
+	 && ( file_header_in_buffer == 0 ) )
+	{
+		write_count = libbfio_handle_write_buffer_at_offset(
+		               internal_writer->file_io_handle,
+		               number_of_items_data,
+		               4,
+		               12,
+		               error );
+
+		if( write_count != (ssize_t) 4 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write number of items in file header.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_writer->file_io_handle_opened_in_library != 0 )
+	{
+		if( libbfio_handle_close(
+		     internal_writer->file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		internal_writer->file_io_handle_opened_in_library = 0;
+	}
+	if( internal_writer->file_io_handle_created_in_library != 0 )
+	{
+		if( libbfio_handle_free(
+		     &( internal_writer->file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		internal_writer->file_io_handle_created_in_library = 0;
+	}
+	internal_writer->file_io_handle  = NULL;
+	internal_writer->buffer_offset   = 0;
+	internal_writer->file_offset     = 0;
+	internal_writer->number_of_items = 0;
+
+	return( result );
+}
+
+/* Flushes the write buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_writer_flush(
+     libnk2_internal_writer_t *internal_writer,
+     libcerror_error_t **error )
+{
+	static char *function = "libnk2_writer_flush";
+	ssize_t write_count   = 0;
+
+	if( internal_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_writer->buffer_offset == 0 )
+	{
+		return( 1 );
+	}
+	write_count = libbfio_handle_write_buffer_at_offset(
+	               internal_writer->file_io_handle,
+	               internal_writer->buffer,
+	               internal_writer->buffer_offset,
+	               internal_writer->file_offset,
+	               error );
+
+	if( write_count != (ssize_t) internal_writer->buffer_offset )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 internal_writer->file_offset,
+		 internal_writer->file_offset );
+
+		return( -1 );
+	}
+	internal_writer->file_offset  += (off64_t) internal_writer->buffer_offset;
+	internal_writer->buffer_offset = 0;
+
+	return( 1 );
+}
+
+/* Writes data using the write buffer
+ * Data that does not fit in the write buffer is written directly
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_writer_write_buffer(
+     libnk2_internal_writer_t *internal_writer,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libnk2_writer_write_buffer";
+	ssize_t write_count   = 0;
+
+	if( internal_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > ( LIBNK2_WRITER_BUFFER_SIZE - internal_writer->buffer_offset ) )
+	{
+		if( libnk2_writer_flush(
+		     internal_writer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( buffer_size >= LIBNK2_WRITER_BUFFER_SIZE )
+	{
+		write_count = libbfio_handle_write_buffer_at_offset(
+		               internal_writer->file_io_handle,
+		               buffer,
+		               buffer_size,
+		               internal_writer->file_offset,
+		               error );
+
+		if( write_count != (ssize_t) buffer_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 internal_writer->file_offset,
+			 internal_writer->file_offset );
+
+			return( -1 );
+		}
+		internal_writer->file_offset += (off64_t) buffer_size;
+	}
+	else if( buffer_size > 0 )
+	{
+		if( memory_copy(
+		     &( internal_writer->buffer[ internal_writer->buffer_offset ] ),
+		     buffer,
+		     buffer_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data to buffer.",
+			 function );
+
+			return( -1 );
+		}
+		internal_writer->buffer_offset += buffer_size;
+	}
+	return( 1 );
+}
+
+/* Sets the modification date and time
+ * The value is stored in the file footer when the writer is closed
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_writer_set_modification_time(
+     libnk2_writer_t *writer,
+     uint64_t filetime,
+     libcerror_error_t **error )
+{
+	static char *function = "libnk2_writer_set_modification_time";
+
+	if( writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid writer.",
+		 function );
+
+		return( -1 );
+	}
+	( (libnk2_internal_writer_t *) writer )->modification_time = filetime;
+
+	return( 1 );
+}
+
+/* Retrieves the number of items written
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_writer_get_number_of_items(
+     libnk2_writer_t *writer,
+     int *number_of_items,
+     libcerror_error_t **error )
+{
+	libnk2_internal_writer_t *internal_writer = NULL;
+	static char *function                     = "libnk2_writer_get_number_of_items";
+
+	if( writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid writer.",
+		 function );
+
+		return( -1 );
+	}
+	internal_writer = (libnk2_internal_writer_t *) writer;
+
+	if( number_of_items == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of items.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_items = (int) internal_writer->number_of_items;
+
+	return( 1 );
+}
+
+/* Appends an item
+ * The item must contain at least one entry
+ * The entries are validated before the item is written, an item that is
+ * rejected leaves the file unchanged
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_writer_append_item(
+     libnk2_writer_t *writer,
+     const libnk2_writer_entry_t *entries,
+     int number_of_entries,
+     libcerror_error_t **error )
+{
+	uint8_t entry_data[ sizeof( nk2_item_value_entry_t ) ];
+	uint8_t size_data[ 4 ];
+
+	const libnk2_writer_entry_t *entry        = NULL;
+	libnk2_internal_writer_t *internal_writer = NULL;
+	static char *function                     = "libnk2_writer_append_item";
+	size_t value_data_size                    = 0;
+	int entry_index                           = 0;
+
+	if( writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid writer.",
+		 function );
+
+		return( -1 );
+	}
+	internal_writer = (libnk2_internal_writer_t *) writer;
+
+	if( internal_writer->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid writer - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_writer->abort != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_ABORT_REQUESTED,
+		 "%s: abort requested.",
+		 function );
+
+		return( -1 );
+	}
+	/* An item without entries terminates the items when the file is read
+	 */
+	if( number_of_entries < 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of entries value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_writer->number_of_items >= (uint32_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid writer - number of items value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		entry = &( entries[ entry_index ] );
+
+		if( entry->entry_type > 0x0000ffffUL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid entry: %d - entry type value out of bounds.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( libnk2_mapi_value_get_data_size(
+		     entry->value_type,
+		     &value_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: invalid entry: %d - unsupported value type.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		/* Fixed size values are stored in the record entry, variable size values
+		 * follow the record entry and cannot be empty
+		 */
+		if( ( ( value_data_size != 0 )
+		  &&  ( entry->value_data_size != value_data_size ) )
+		 || ( entry->value_data_size == 0 )
+		 || ( entry->value_data_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid entry: %d - value data size value out of bounds.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( entry->value_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid entry: %d - missing value data.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 size_data,
+	 (uint32_t) number_of_entries );
+
+	if( libnk2_writer_write_buffer(
+	     internal_writer,
+	     size_data,
+	     4,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		entry = &( entries[ entry_index ] );
+
+		if( memory_set(
+		     entry_data,
+		     0,
+		     sizeof( nk2_item_value_entry_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear entry data.",
+			 function );
+
+			return( -1 );
+		}
+		byte_stream_copy_from_uint16_little_endian(
+		 ( (nk2_item_value_entry_t *) entry_data )->value_type,
+		 (uint16_t) entry->value_type );
+
+		byte_stream_copy_from_uint16_little_endian(
+		 ( (nk2_item_value_entry_t *) entry_data )->entry_type,
+		 (uint16_t) entry->entry_type );
+
+		if( libnk2_mapi_value_get_data_size(
+		     entry->value_type,
+		     &value_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d value data size.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( value_data_size != 0 )
+		{
+			if( memory_copy(
+			     ( (nk2_item_value_entry_t *) entry_data )->value_data_array,
+			     entry->value_data,
+			     value_data_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy entry: %d value data.",
+				 function,
+				 entry_index );
+
+				return( -1 );
+			}
+		}
+		if( libnk2_writer_write_buffer(
+		     internal_writer,
+		     entry_data,
+		     sizeof( nk2_item_value_entry_t ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( value_data_size != 0 )
+		{
+			continue;
+		}
+		byte_stream_copy_from_uint32_little_endian(
+		 size_data,
+		 (uint32_t) entry->value_data_size );
+
+		if( libnk2_writer_write_buffer(
+		     internal_writer,
+		     size_data,
+		     4,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write entry: %d value data size.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( libnk2_writer_write_buffer(
+		     internal_writer,
+		     entry->value_data,
+		     entry->value_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write entry: %d value data.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+	}
+	internal_writer->number_of_items += 1;
+
+	return( 1 );
+}
+
+/* Appends a copy of an item read from a file
+ * Returns 1 if successful or -1 on error
+ */
+int libnk2_writer_append_file_item(
+     libnk2_writer_t *writer,
+     libnk2_item_t *item,
+     libcerror_error_t **error )
+{
+	libnk2_internal_item_t *internal_item                 = NULL;
+	libnk2_internal_record_entry_t *internal_record_entry = NULL;
+	libnk2_writer_entry_t *entries                        = NULL;
+	static char *function                                 = "libnk2_writer_append_file_item";
+	size_t entries_size                                   = 0;
+	int entry_index                                       = 0;
+	int number_of_entries                                 = 0;
+
+	if( writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
+
+		return( -1 );
+	}
+	internal_item = (libnk2_internal_item_t *) item;
+
+	if( libcdata_array_get_number_of_entries(
+	     internal_item->entries_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_entries > 0 )
+	{
+		entries_size = sizeof( libnk2_writer_entry_t ) * (size_t) number_of_entries;
+
+		if( entries_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid entries size value exceeds maximum allocation size.",
+			 function );
+
+			goto on_error;
+		}
+		entries = (libnk2_writer_entry_t *) memory_allocate(
+		                                     entries_size );
+
+		if( entries == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create entries.",
+			 function );
+
+			goto on_error;
+		}
+		for( entry_index = 0;
+		     entry_index < number_of_entries;
+		     entry_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     internal_item->entries_array,
+			     entry_index,
+			     (intptr_t **) &internal_record_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve record entry: %d.",
+				 function,
+				 entry_index );
+
+				goto on_error;
+			}
+			if( internal_record_entry == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing record entry: %d.",
+				 function,
+				 entry_index );
+
+				goto on_error;
+			}
+			entries[ entry_index ].entry_type      = internal_record_entry->entry_type;
+			entries[ entry_index ].value_type      = internal_record_entry->value_type;
+			entries[ entry_index ].value_data      = internal_record_entry->value_data;
+			entries[ entry_index ].value_data_size = internal_record_entry->value_data_size;
+		}
+	}
+	if( libnk2_writer_append_item(
+	     writer,
+	     entries,
+	     number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to append item.",
+		 function );
+
+		goto on_error;
+	}
+	if( entries != NULL )
+	{
+		memory_free(
+		 entries );
+	}
+	return( 1 );
+
+on_error:
+	if( entries != NULL )
+	{
+		memory_free(
+		 entries );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,164 @@
+/*
+ * Writer functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBNK2_WRITER_H )
+#define _LIBNK2_WRITER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libnk2_extern.h"
+#include "libnk2_libbfio.h"
+#include "libnk2_libcerror.h"
+#include "libnk2_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The size of the write buffer
+ */
+#define LIBNK2_WRITER_BUFFER_SIZE	( 64 * 1024 )
+
+typedef struct libnk2_internal_writer libnk2_internal_writer_t;
+
+struct libnk2_internal_writer
+{
+	/* The file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* Value to indicate if the file IO handle was created inside the library
+	 */
+	uint8_t file_io_handle_created_in_library;
+
+	/* Value to indicate if the file IO handle was opened inside the library
+	 */
+	uint8_t file_io_handle_opened_in_library;
+
+	/* The write buffer
+	 */
+	uint8_t *buffer;
+
+	/* The write buffer offset
+	 */
+	size_t buffer_offset;
+
+	/* The file offset of the start of the write buffer
+	 */
+	off64_t file_offset;
+
+	/* The number of items written
+	 */
+	uint32_t number_of_items;
+
+	/* The modification date and time, which is stored in the file footer
+	 */
+	uint64_t modification_time;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+LIBNK2_EXTERN \
+int libnk2_writer_initialize(
+     libnk2_writer_t **writer,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_writer_free(
+     libnk2_writer_t **writer,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_writer_signal_abort(
+     libnk2_writer_t *writer,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_writer_open(
+     libnk2_writer_t *writer,
+     const char *filename,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBNK2_EXTERN \
+int libnk2_writer_open_wide(
+     libnk2_writer_t *writer,
+     const wchar_t *filename,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+LIBNK2_EXTERN \
+int libnk2_writer_open_file_io_handle(
+     libnk2_writer_t *writer,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_writer_close(
+     libnk2_writer_t *writer,
+     libcerror_error_t **error );
+
+int libnk2_writer_flush(
+     libnk2_internal_writer_t *internal_writer,
+     libcerror_error_t **error );
+
+int libnk2_writer_write_buffer(
+     libnk2_internal_writer_t *internal_writer,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_writer_set_modification_time(
+     libnk2_writer_t *writer,
+     uint64_t filetime,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_writer_get_number_of_items(
+     libnk2_writer_t *writer,
+     int *number_of_items,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_writer_append_item(
+     libnk2_writer_t *writer,
+     const libnk2_writer_entry_t *entries,
+     int number_of_entries,
+     libcerror_error_t **error );
+
+LIBNK2_EXTERN \
+int libnk2_writer_append_file_item(
+     libnk2_writer_t *writer,
+     libnk2_item_t *item,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBNK2_WRITER_H ) */
+
@@ -0,0 +1,94 @@
+/*
+ * The address filter format definition
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _NK2_ADDRESS_FILTER_H )
+#define _NK2_ADDRESS_FILTER_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* An address filter is a Bloom filter over the normalized email addresses of an NK2 file.
+ * It consists of the header followed by the bitmap, which contains number of bits / 8 bytes.
+ * Bit N of the bitmap is stored in byte N / 8 as ( 1 << ( N % 8 ) ).
+ * The bit indexes of an address are determined by double hashing of the 64-bit FNV-1a hash
+ * of the normalized address, where the lower 32-bits are used as the first hash and
+ * the upper 32-bits with the least significant bit set as the second hash.
+ * All values are stored in little-endian.
+ */
+
+typedef struct nk2_address_filter_header nk2_address_filter_header_t;
+
+struct nk2_address_filter_header
+{
+	/* Signature
+	 * Consists of 8 bytes
+	 * "NK2BLOOM"
+	 */
+	uint8_t signature[ 8 ];
+
+	/* Format version
+	 * Consists of 4 bytes
+	 */
+	uint8_t format_version[ 4 ];
+
+	/* Number of hash functions
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_hash_functions[ 4 ];
+
+	/* Number of bits
+	 * Consists of 4 bytes
+	 * Contains a multiple of 64
+	 */
+	uint8_t number_of_bits[ 4 ];
+
+	/* Number of addresses
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_addresses[ 4 ];
+
+	/* Modification date and time
+	 * Consists of 8 bytes
+	 * Contains a filetime from the NK2 file footer
+	 */
+	uint8_t modification_time[ 8 ];
+
+	/* Number of items
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_items[ 4 ];
+
+	/* Unknown (reserved)
+	 * Consists of 4 bytes
+	 */
+	uint8_t unknown1[ 4 ];
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _NK2_ADDRESS_FILTER_H ) */
+
@@ -0,0 +1,175 @@
+/*
+ * The alias index format definition
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _NK2_ALIAS_INDEX_H )
+#define _NK2_ALIAS_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* An alias index consists of one or more segments, where every segment contains:
+ *   the file entries
+ *   the file names data, padded to a multiple of 8 bytes
+ *   the key entries, sorted by their key data
+ *   the keys data, padded to a multiple of 8 bytes
+ *   the postings
+ *   the segment footer
+ * New segments are appended to the end of the alias index, hence the last
+ * segment footer is stored in the last 48 bytes of the alias index.
+ * All values are stored in little-endian.
+ */
+
+typedef struct nk2_alias_index_segment_footer nk2_alias_index_segment_footer_t;
+
+struct nk2_alias_index_segment_footer
+{
+	/* Signature
+	 * Consists of 8 bytes
+	 * "NK2ALIAS"
+	 */
+	uint8_t signature[ 8 ];
+
+	/* Format version
+	 * Consists of 4 bytes
+	 */
+	uint8_t format_version[ 4 ];
+
+	/* First file identifier
+	 * Consists of 4 bytes
+	 * Contains the number of files in the preceding segments
+	 */
+	uint8_t first_file_identifier[ 4 ];
+
+	/* Number of files
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_files[ 4 ];
+
+	/* Number of keys
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_keys[ 4 ];
+
+	/* Number of postings
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_postings[ 4 ];
+
+	/* File names data size
+	 * Consists of 4 bytes
+	 * Does not include the padding
+	 */
+	uint8_t file_names_data_size[ 4 ];
+
+	/* Keys data size
+	 * Consists of 4 bytes
+	 * Does not include the padding
+	 */
+	uint8_t keys_data_size[ 4 ];
+
+	/* Unknown (reserved)
+	 * Consists of 4 bytes
+	 */
+	uint8_t unknown1[ 4 ];
+
+	/* Segment size
+	 * Consists of 8 bytes
+	 * Includes the segment footer
+	 */
+	uint8_t segment_size[ 8 ];
+};
+
+typedef struct nk2_alias_index_file_entry nk2_alias_index_file_entry_t;
+
+struct nk2_alias_index_file_entry
+{
+	/* Modification date and time
+	 * Consists of 8 bytes
+	 * Contains a filetime from the NK2 file footer
+	 */
+	uint8_t modification_time[ 8 ];
+
+	/* Name offset
+	 * Consists of 4 bytes
+	 * Contains an offset relative to the start of the file names data
+	 */
+	uint8_t name_offset[ 4 ];
+
+	/* Name size
+	 * Consists of 4 bytes
+	 * Contains the size of the UTF-8 encoded name, without end of string character
+	 */
+	uint8_t name_size[ 4 ];
+};
+
+typedef struct nk2_alias_index_key_entry nk2_alias_index_key_entry_t;
+
+struct nk2_alias_index_key_entry
+{
+	/* Key offset
+	 * Consists of 4 bytes
+	 * Contains an offset relative to the start of the keys data
+	 */
+	uint8_t key_offset[ 4 ];
+
+	/* Key size
+	 * Consists of 4 bytes
+	 * Contains the size of the normalized UTF-8 encoded address, without end of string character
+	 */
+	uint8_t key_size[ 4 ];
+
+	/* First posting index
+	 * Consists of 4 bytes
+	 */
+	uint8_t first_posting_index[ 4 ];
+
+	/* Number of postings
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_postings[ 4 ];
+};
+
+typedef struct nk2_alias_index_posting nk2_alias_index_posting_t;
+
+struct nk2_alias_index_posting
+{
+	/* File index
+	 * Consists of 4 bytes
+	 * Contains an index relative to the first file identifier of the segment
+	 */
+	uint8_t file_index[ 4 ];
+
+	/* Item index
+	 * Consists of 4 bytes
+	 */
+	uint8_t item_index[ 4 ];
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _NK2_ALIAS_INDEX_H ) */
+
@@ -0,0 +1,1831 @@
+/*
+ * Alias handle
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_FCNTL_H ) && !defined( WINAPI )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_MMAN_H ) && !defined( WINAPI )
+#include <sys/mman.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "alias_handle.h"
+#include "nk2input.h"
+#include "nk2tools_libcerror.h"
+#include "nk2tools_libcfile.h"
+#include "nk2tools_libcnotify.h"
+#include "nk2tools_libfdatetime.h"
+#include "nk2tools_libnk2.h"
+#include "nk2tools_libuna.h"
+
+/* The alias index is memory mapped when supported, otherwise it is read into memory
+ */
+#if defined( HAVE_FCNTL_H ) && defined( HAVE_SYS_MMAN_H ) && defined( HAVE_MMAP ) && defined( HAVE_MUNMAP ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) && !defined( WINAPI )
+#define ALIAS_HANDLE_HAVE_MMAP
+#endif
+
+#define ALIAS_HANDLE_NOTIFY_STREAM		stdout
+
+/* Creates an alias handle
+ * Make sure the value alias_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int alias_handle_initialize(
+     alias_handle_t **alias_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "alias_handle_initialize";
+
+	if( alias_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid alias handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *alias_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid alias handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*alias_handle = memory_allocate_structure(
+	                 alias_handle_t );
+
+	if( *alias_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create alias handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *alias_handle,
+	     0,
+	     sizeof( alias_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear alias handle.",
+		 function );
+
+		memory_free(
+		 *alias_handle );
+
+		*alias_handle = NULL;
+
+		return( -1 );
+	}
+	if( libnk2_alias_index_writer_initialize(
+	     &( ( *alias_handle )->alias_index_writer ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create alias index writer.",
+		 function );
+
+		goto on_error;
+	}
+	( *alias_handle )->number_of_files_per_segment = ALIAS_HANDLE_DEFAULT_NUMBER_OF_FILES_PER_SEGMENT;
+	( *alias_handle )->notify_stream               = ALIAS_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *alias_handle != NULL )
+	{
+		memory_free(
+		 *alias_handle );
+
+		*alias_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an alias handle
+ * Returns 1 if successful or -1 on error
+ */
+int alias_handle_free(
+     alias_handle_t **alias_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "alias_handle_free";
+	int result            = 1;
+
+	if( alias_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid alias handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *alias_handle != NULL )
+	{
+		if( ( *alias_handle )->alias_index != NULL )
+		{
+			if( alias_handle_close_index(
+			     *alias_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close alias index.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libnk2_alias_index_writer_free(
+		     &( ( *alias_handle )->alias_index_writer ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free alias index writer.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *alias_handle )->segment_data != NULL )
+		{
+			memory_free(
+			 ( *alias_handle )->segment_data );
+		}
+		memory_free(
+		 *alias_handle );
+
+		*alias_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the alias handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int alias_handle_signal_abort(
+     alias_handle_t *alias_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "alias_handle_signal_abort";
+
+	if( alias_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid alias handle.",
+		 function );
+
+		return( -1 );
+	}
+	alias_handle->abort = 1;
+
+	return( 1 );
+}
+
+/* Copies a system string to a newly allocated UTF-8 string
+ * Returns 1 if successful or -1 on error
+ */
+int alias_handle_copy_to_utf8_string(
+     const system_character_t *string,
+     uint8_t **utf8_string,
+     size_t *utf8_string_length,
+     libcerror_error_t **error )
+{
+	static char *function   = "alias_handle_copy_to_utf8_string";
+	size_t string_length    = 0;
+	size_t utf8_string_size = 0;
+	int result              = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( *utf8_string != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid UTF-8 string value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_length == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string length.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#if SIZEOF_WCHAR_T == 4
+	result = libuna_utf8_string_size_from_utf32(
+	          (libuna_utf32_character_t *) string,
+	          string_length + 1,
+	          &utf8_string_size,
+	          error );
+#elif SIZEOF_WCHAR_T == 2
+	result = libuna_utf8_string_size_from_utf16(
+	          (libuna_utf16_character_t *) string,
+	          string_length + 1,
+	          &utf8_string_size,
+	          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+#else
+	utf8_string_size = string_length + 1;
+	result           = 1;
+#endif /* defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine UTF-8 string size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( utf8_string_size == 0 )
+	 || ( utf8_string_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid UTF-8 string size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	*utf8_string = (uint8_t *) memory_allocate(
+	                            sizeof( uint8_t ) * utf8_string_size );
+
+	if( *utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create UTF-8 string.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#if SIZEOF_WCHAR_T == 4
+	result = libuna_utf8_string_copy_from_utf32(
+	          *utf8_string,
+	          utf8_string_size,
+	          (libuna_utf32_character_t *) string,
+	          string_length + 1,
+	          error );
+#elif SIZEOF_WCHAR_T == 2
+	result = libuna_utf8_string_copy_from_utf16(
+	          *utf8_string,
+	          utf8_string_size,
+	          (libuna_utf16_character_t *) string,
+	          string_length + 1,
+	          error );
+#endif /* SIZEOF_WCHAR_T */
+#else
+	result = 1;
+
+	if( memory_copy(
+	     *utf8_string,
+	     string,
+	     utf8_string_size ) == NULL )
+	{
+		result = -1;
+	}
+#endif /* defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy UTF-8 string.",
+		 function );
+
+		goto on_error;
+	}
+	*utf8_string_length = utf8_string_size - 1;
+
+	return( 1 );
+
+on_error:
+	if( *utf8_string != NULL )
+	{
+		memory_free(
+		 *utf8_string );
+
+		*utf8_string = NULL;
+	}
+	return( -1 );
+}
+
+/* Sets the maximum number of files per segment
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int alias_handle_set_number_of_files_per_segment(
+     alias_handle_t *alias_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "alias_handle_set_number_of_files_per_segment";
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( alias_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid alias handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = nk2input_determine_decimal_value(
+	          string,
+	          &value_64bit,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine number of files per segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( result != 0 )
+	 && ( value_64bit > 0 )
+	 && ( value_64bit <= (uint64_t) UINT32_MAX ) )
+	{
+		alias_handle->number_of_files_per_segment = (uint32_t) value_64bit;
+
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Opens the alias index
+ * The alias index data is memory mapped when supported
+ * Returns 1 if successful, 0 if the alias index does not exist or is empty or -1 on error
+ */
+int alias_handle_open_index(
+     alias_handle_t *alias_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+#if defined( ALIAS_HANDLE_HAVE_MMAP )
+	void *mapped_data     = NULL;
+	off_t file_size       = 0;
+	int file_descriptor   = -1;
+#else
+	libcfile_file_t *file = NULL;
+	size64_t file_size    = 0;
+	ssize_t read_count    = 0;
+#endif
+	static char *function = "alias_handle_open_index";
+	int result            = 0;
+
+	if( alias_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid alias handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( alias_handle->alias_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid alias handle - alias index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libcfile_file_exists_wide(
+	          filename,
+	          error );
+#else
+	result = libcfile_file_exists(
+	          filename,
+	          error );
+#endif
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to determine if alias index: %" PRIs_SYSTEM " exists.",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+#if defined( ALIAS_HANDLE_HAVE_MMAP )
+	file_descriptor = open(
+	                   filename,
+	                   O_RDONLY );
+
+	if( file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open alias index: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	file_size = lseek(
+	             file_descriptor,
+	             0,
+	             SEEK_END );
+
+	if( file_size < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to determine size of alias index.",
+		 function );
+
+		goto on_error;
+	}
+	if( (uint64_t) file_size > (uint64_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid alias index size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_size > 0 )
+	{
+		mapped_data = mmap(
+		               NULL,
+		               (size_t) file_size,
+		               PROT_READ,
+		               MAP_PRIVATE,
+		               file_descriptor,
+		               0 );
+
+		if( mapped_data == MAP_FAILED )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to map alias index.",
+			 function );
+
+			goto on_error;
+		}
+		alias_handle->index_data           = (uint8_t *) mapped_data;
+		alias_handle->index_data_size      = (size_t) file_size;
+		alias_handle->index_data_is_mapped = 1;
+	}
+	/* The mapping remains valid after the file descriptor is closed
+	 */
+	if( close(
+	     file_descriptor ) != 0 )
+	{
+		file_descriptor = -1;
+
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close alias index.",
+		 function );
+
+		goto on_error;
+	}
+	file_descriptor = -1;
+#else
+	if( libcfile_file_initialize(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libcfile_file_open_wide(
+	          file,
+	          filename,
+	          LIBCFILE_OPEN_READ,
+	          error );
+#else
+	result = libcfile_file_open(
+	          file,
+	          filename,
+	          LIBCFILE_OPEN_READ,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open alias index: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( libcfile_file_get_size(
+	     file,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size of alias index.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_size > (size64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid alias index size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_size > 0 )
+	{
+		alias_handle->index_data = (uint8_t *) memory_allocate(
+		                                        sizeof( uint8_t ) * (size_t) file_size );
+
+		if( alias_handle->index_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create alias index data.",
+			 function );
+
+			goto on_error;
+		}
+		alias_handle->index_data_size = (size_t) file_size;
+
+		read_count = libcfile_file_read_buffer(
+		              file,
+		              alias_handle->index_data,
+		              alias_handle->index_data_size,
+		              error );
+
+		if( read_count != (ssize_t) alias_handle->index_data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read alias index data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcfile_file_close(
+	     file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close alias index.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file.",
+		 function );
+
+		goto on_error;
+	}
+#endif /* defined( ALIAS_HANDLE_HAVE_MMAP ) */
+
+	/* An empty file is treated as an alias index without segments
+	 */
+	if( alias_handle->index_data_size == 0 )
+	{
+		return( 0 );
+	}
+	if( libnk2_alias_index_initialize(
+	     &( alias_handle->alias_index ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create alias index.",
+		 function );
+
+		goto on_error;
+	}
+	if( libnk2_alias_index_open_data(
+	     alias_handle->alias_index,
+	     alias_handle->index_data,
+	     alias_handle->index_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open alias index: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( alias_handle->alias_index != NULL )
+	{
+		libnk2_alias_index_free(
+		 &( alias_handle->alias_index ),
+		 NULL );
+	}
+#if defined( ALIAS_HANDLE_HAVE_MMAP )
+	if( file_descriptor != -1 )
+	{
+		close(
+		 file_descriptor );
+	}
+	if( alias_handle->index_data != NULL )
+	{
+		munmap(
+		 alias_handle->index_data,
+		 alias_handle->index_data_size );
+	}
+#else
+	if( file != NULL )
+	{
+		libcfile_file_free(
+		 &file,
+		 NULL );
+	}
+	if( alias_handle->index_data != NULL )
+	{
+		memory_free(
+		 alias_handle->index_data );
+	}
+#endif
+	alias_handle->index_data           = NULL;
+	alias_handle->index_data_size      = 0;
+	alias_handle->index_data_is_mapped = 0;
+
+	return( -1 );
+}
+
+/* Closes the alias index
+ * Returns the 0 if succesful or -1 on error
+ */
+int alias_handle_close_index(
+     alias_handle_t *alias_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "alias_handle_close_index";
+	int result            = 0;
+
+	if( alias_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid alias handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( alias_handle->alias_index != NULL )
+	{
+		if( libnk2_alias_index_free(
+		     &( alias_handle->alias_index ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free alias index.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( alias_handle->index_data != NULL )
+	{
+#if defined( ALIAS_HANDLE_HAVE_MMAP )
+		if( alias_handle->index_data_is_mapped != 0 )
+		{
+			if( munmap(
+			     alias_handle->index_data,
+			     alias_handle->index_data_size ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to unmap alias index.",
+				 function );
+
+				result = -1;
+			}
+		}
+		else
+#endif
+		{
+			memory_free(
+			 alias_handle->index_data );
+		}
+		alias_handle->index_data = NULL;
+	}
+	alias_handle->index_data_size      = 0;
+	alias_handle->index_data_is_mapped = 0;
+
+	return( result );
+}
+
+/* Writes the files that were added as a segment to the end of the alias index
+ * The first file identifier is updated to the identifier of the next segment
+ * Returns 1 if successful or -1 on error
+ */
+int alias_handle_write_segment(
+     alias_handle_t *alias_handle,
+     libcfile_file_t *index_file,
+     uint32_t *first_file_identifier,
+     libcerror_error_t **error )
+{
+	uint8_t *segment_data    = NULL;
+	static char *function    = "alias_handle_write_segment";
+	size_t segment_size      = 0;
+	ssize_t write_count      = 0;
+	uint32_t number_of_files = 0;
+
+	if( alias_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid alias handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_file_identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid first file identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( libnk2_alias_index_writer_get_number_of_files(
+	     alias_handle->alias_index_writer,
+	     &number_of_files,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of files.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_files == 0 )
+	{
+		return( 1 );
+	}
+	if( libnk2_alias_index_writer_get_segment_size(
+	     alias_handle->alias_index_writer,
+	     &segment_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_size == 0 )
+	 || ( segment_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_size > alias_handle->segment_data_size )
+	{
+		segment_data = (uint8_t *) memory_reallocate(
+		                            alias_handle->segment_data,
+		                            sizeof( uint8_t ) * segment_size );
+
+		if( segment_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize segment data.",
+			 function );
+
+			return( -1 );
+		}
+		alias_handle->segment_data      = segment_data;
+		alias_handle->segment_data_size = segment_size;
+	}
+	if( libnk2_alias_index_writer_write_segment(
+	     alias_handle->alias_index_writer,
+	     *first_file_identifier,
+	     alias_handle->segment_data,
+	     segment_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write segment.",
+		 function );
+
+		return( -1 );
+	}
+	/* The segment is written with a single write so that its footer,
+	 * which is stored at the end, is only present when the segment is complete
+	 */
+	write_count = libcfile_file_write_buffer(
+	               index_file,
+	               alias_handle->segment_data,
+	               segment_size,
+	               error );
+
+	if( write_count != (ssize_t) segment_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write segment data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libnk2_alias_index_writer_clear(
+	     alias_handle->alias_index_writer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear alias index writer.",
+		 function );
+
+		return( -1 );
+	}
+	*first_file_identifier                 += number_of_files;
+	alias_handle->number_of_appended_files += number_of_files;
+
+	return( 1 );
+}
+
+/* Adds the email addresses of a file to the alias index writer
+ * Returns 1 if successful or -1 on error
+ */
+int alias_handle_add_file(
+     alias_handle_t *alias_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	libnk2_file_t *file       = NULL;
+	uint8_t *utf8_filename    = NULL;
+	static char *function     = "alias_handle_add_file";
+	size_t utf8_filename_size = 0;
+	int result                = 0;
+
+	if( alias_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid alias handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libnk2_file_initialize(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libnk2_file_open_wide(
+	          file,
+	          filename,
+	          LIBNK2_OPEN_READ,
+	          error );
+#else
+	result = libnk2_file_open(
+	          file,
+	          filename,
+	          LIBNK2_OPEN_READ,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( alias_handle_copy_to_utf8_string(
+	     filename,
+	     &utf8_filename,
+	     &utf8_filename_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy filename to UTF-8 string.",
+		 function );
+
+		goto on_error;
+	}
+	if( libnk2_alias_index_writer_add_file(
+	     alias_handle->alias_index_writer,
+	     file,
+	     utf8_filename,
+	     utf8_filename_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to add file: %" PRIs_SYSTEM " to alias index writer.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	memory_free(
+	 utf8_filename );
+
+	utf8_filename = NULL;
+
+	if( libnk2_file_close(
+	     file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libnk2_file_free(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( utf8_filename != NULL )
+	{
+		memory_free(
+		 utf8_filename );
+	}
+	if( file != NULL )
+	{
+		libnk2_file_free(
+		 &file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Appends the email addresses of the source files to the alias index
+ * The alias index is created if it does not exist
+ * Sources that cannot be read are reported and skipped
+ * Returns 1 if successful or -1 on error
+ */
+int alias_handle_append_files(
+     alias_handle_t *alias_handle,
+     const system_character_t *index_filename,
+     system_character_t * const sources[],
+     int number_of_sources,
+     libcerror_error_t **error )
+{
+	libcerror_error_t *add_error   = NULL;
+	libcfile_file_t *index_file    = NULL;
+	static char *function          = "alias_handle_append_files";
+	uint32_t first_file_identifier = 0;
+	uint32_t number_of_files       = 0;
+	int result                     = 0;
+	int source_index               = 0;
+
+	if( alias_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid alias handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( sources == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sources.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_sources < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of sources value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	/* The file identifiers of the appended segments continue after those of the existing alias index
+	 */
+	result = alias_handle_open_index(
+	          alias_handle,
+	          index_filename,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open alias index.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( libnk2_alias_index_get_number_of_files(
+		     alias_handle->alias_index,
+		     &first_file_identifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of files.",
+			 function );
+
+			goto on_error;
+		}
+		if( alias_handle_close_index(
+		     alias_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close alias index.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcfile_file_initialize(
+	     &index_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create index file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libcfile_file_open_wide(
+	          index_file,
+	          index_filename,
+	          LIBCFILE_OPEN_WRITE,
+	          error );
+#else
+	result = libcfile_file_open(
+	          index_file,
+	          index_filename,
+	          LIBCFILE_OPEN_WRITE,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open index file: %" PRIs_SYSTEM ".",
+		 function,
+		 index_filename );
+
+		goto on_error;
+	}
+	if( libcfile_file_seek_offset(
+	     index_file,
+	     0,
+	     SEEK_END,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek end of index file.",
+		 function );
+
+		goto on_error;
+	}
+	for( source_index = 0;
+	     source_index < number_of_sources;
+	     source_index++ )
+	{
+		if( alias_handle->abort != 0 )
+		{
+			break;
+		}
+		if( alias_handle_add_file(
+		     alias_handle,
+		     sources[ source_index ],
+		     &add_error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to add: %" PRIs_SYSTEM ".\n",
+			 sources[ source_index ] );
+
+			libcnotify_print_error_backtrace(
+			 add_error );
+			libcerror_error_free(
+			 &add_error );
+
+			continue;
+		}
+		if( libnk2_alias_index_writer_get_number_of_files(
+		     alias_handle->alias_index_writer,
+		     &number_of_files,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of files.",
+			 function );
+
+			goto on_error;
+		}
+		if( number_of_files >= alias_handle->number_of_files_per_segment )
+		{
+			if( alias_handle_write_segment(
+			     alias_handle,
+			     index_file,
+			     &first_file_identifier,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write segment.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	if( alias_handle_write_segment(
+	     alias_handle,
+	     index_file,
+	     &first_file_identifier,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write segment.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_close(
+	     index_file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close index file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &index_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free index file.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 alias_handle->notify_stream,
+	 "Appended %" PRIu32 " of %d files to alias index.\n",
+	 alias_handle->number_of_appended_files,
+	 number_of_sources );
+
+	return( 1 );
+
+on_error:
+	if( index_file != NULL )
+	{
+		libcfile_file_free(
+		 &index_file,
+		 NULL );
+	}
+	libnk2_alias_index_writer_clear(
+	 alias_handle->alias_index_writer,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Prints the matches of an address in the alias index
+ * Returns 1 if successful or -1 on error
+ */
+int alias_handle_search_address(
+     alias_handle_t *alias_handle,
+     const system_character_t *address,
+     libcerror_error_t **error )
+{
+	char filetime_string[ 48 ];
+
+	libfdatetime_filetime_t *filetime = NULL;
+	uint8_t *utf8_address             = NULL;
+	uint8_t *utf8_file_name           = NULL;
+	uint32_t *file_identifiers        = NULL;
+	uint32_t *item_indexes            = NULL;
+	void *reallocation                = NULL;
+	static char *function             = "alias_handle_search_address";
+	size_t utf8_address_length        = 0;
+	size_t utf8_file_name_size        = 0;
+	uint64_t modification_time        = 0;
+	int maximum_number_of_postings    = 0;
+	int number_of_postings            = 0;
+	int posting_index                 = 0;
+	int result                        = 0;
+
+	if( alias_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid alias handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( alias_handle->alias_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid alias handle - missing alias index.",
+		 function );
+
+		return( -1 );
+	}
+	if( alias_handle_copy_to_utf8_string(
+	     address,
+	     &utf8_address,
+	     &utf8_address_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy address to UTF-8 string.",
+		 function );
+
+		goto on_error;
+	}
+	/* The search is repeated with larger buffers until all postings fit
+	 */
+	do
+	{
+		if( maximum_number_of_postings == 0 )
+		{
+			maximum_number_of_postings = ALIAS_HANDLE_INITIAL_NUMBER_OF_POSTINGS;
+		}
+		else if( maximum_number_of_postings <= ( INT_MAX / 2 ) )
+		{
+			maximum_number_of_postings *= 2;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid maximum number of postings value exceeds maximum.",
+			 function );
+
+			goto on_error;
+		}
+		if( (size_t) maximum_number_of_postings > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( uint32_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid maximum number of postings value exceeds maximum.",
+			 function );
+
+			goto on_error;
+		}
+		reallocation = memory_reallocate(
+		                file_identifiers,
+		                sizeof( uint32_t ) * maximum_number_of_postings );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize file identifiers.",
+			 function );
+
+			goto on_error;
+		}
+		file_identifiers = (uint32_t *) reallocation;
+
+		reallocation = memory_reallocate(
+		                item_indexes,
+		                sizeof( uint32_t ) * maximum_number_of_postings );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize item indexes.",
+			 function );
+
+			goto on_error;
+		}
+		item_indexes = (uint32_t *) reallocation;
+
+		result = libnk2_alias_index_search_utf8_address(
+		          alias_handle->alias_index,
+		          utf8_address,
+		          utf8_address_length,
+		          file_identifiers,
+		          item_indexes,
+		          maximum_number_of_postings,
+		          &number_of_postings,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to search alias index.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	while( number_of_postings == maximum_number_of_postings );
+
+	fprintf(
+	 alias_handle->notify_stream,
+	 "Alias index search:\n" );
+
+	fprintf(
+	 alias_handle->notify_stream,
+	 "\tAddress\t\t\t: %" PRIs_SYSTEM "\n",
+	 address );
+
+	fprintf(
+	 alias_handle->notify_stream,
+	 "\tNumber of matches\t: %d\n",
+	 number_of_postings );
+
+	fprintf(
+	 alias_handle->notify_stream,
+	 "\n" );
+
+	if( number_of_postings > 0 )
+	{
+		if( libfdatetime_filetime_initialize(
+		     &filetime,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create filetime.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( posting_index = 0;
+	     posting_index < number_of_postings;
+	     posting_index++ )
+	{
+		if( libnk2_alias_index_get_utf8_file_name_size(
+		     alias_handle->alias_index,
+		     file_identifiers[ posting_index ],
+		     &utf8_file_name_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file: %" PRIu32 " name size.",
+			 function,
+			 file_identifiers[ posting_index ] );
+
+			goto on_error;
+		}
+		utf8_file_name = (uint8_t *) memory_allocate(
+		                              sizeof( uint8_t ) * utf8_file_name_size );
+
+		if( utf8_file_name == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create file name.",
+			 function );
+
+			goto on_error;
+		}
+		if( libnk2_alias_index_get_utf8_file_name(
+		     alias_handle->alias_index,
+		     file_identifiers[ posting_index ],
+		     utf8_file_name,
+		     utf8_file_name_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file: %" PRIu32 " name.",
+			 function,
+			 file_identifiers[ posting_index ] );
+
+			goto on_error;
+		}
+		if( libnk2_alias_index_get_file_modification_time(
+		     alias_handle->alias_index,
+		     file_identifiers[ posting_index ],
+		     &modification_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file: %" PRIu32 " modification time.",
+			 function,
+			 file_identifiers[ posting_index ] );
+
+			goto on_error;
+		}
+		if( libfdatetime_filetime_copy_from_64bit(
+		     filetime,
+		     modification_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy filetime from 64-bit value.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfdatetime_filetime_copy_to_utf8_string(
+		     filetime,
+		     (uint8_t *) filetime_string,
+		     48,
+		     LIBFDATETIME_STRING_FORMAT_TYPE_CTIME | LIBFDATETIME_STRING_FORMAT_FLAG_DATE_TIME_NANO_SECONDS,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy filetime to string.",
+			 function );
+
+			goto on_error;
+		}
+		fprintf(
+		 alias_handle->notify_stream,
+		 "%s\titem: %" PRIu32 "\tmodification time: %s UTC\n",
+		 (char *) utf8_file_name,
+		 item_indexes[ posting_index ],
+		 filetime_string );
+
+		memory_free(
+		 utf8_file_name );
+
+		utf8_file_name = NULL;
+	}
+	if( filetime != NULL )
+	{
+		if( libfdatetime_filetime_free(
+		     &filetime,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free filetime.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 item_indexes );
+
+	memory_free(
+	 file_identifiers );
+
+	memory_free(
+	 utf8_address );
+
+	return( 1 );
+
+on_error:
+	if( filetime != NULL )
+	{
+		libfdatetime_filetime_free(
+		 &filetime,
+		 NULL );
+	}
+	if( utf8_file_name != NULL )
+	{
+		memory_free(
+		 utf8_file_name );
+	}
+	if( item_indexes != NULL )
+	{
+		memory_free(
+		 item_indexes );
+	}
+	if( file_identifiers != NULL )
+	{
+		memory_free(
+		 file_identifiers );
+	}
+	if( utf8_address != NULL )
+	{
+		memory_free(
+		 utf8_address );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,154 @@
+/*
+ * Alias handle
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _ALIAS_HANDLE_H )
+#define _ALIAS_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "nk2tools_libcerror.h"
+#include "nk2tools_libcfile.h"
+#include "nk2tools_libnk2.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The default number of files per alias index segment
+ */
+#define ALIAS_HANDLE_DEFAULT_NUMBER_OF_FILES_PER_SEGMENT	1024
+
+/* The initial number of postings retrieved per search
+ */
+#define ALIAS_HANDLE_INITIAL_NUMBER_OF_POSTINGS			256
+
+typedef struct alias_handle alias_handle_t;
+
+struct alias_handle
+{
+	/* The alias index
+	 */
+	libnk2_alias_index_t *alias_index;
+
+	/* The alias index data
+	 */
+	uint8_t *index_data;
+
+	/* The alias index data size
+	 */
+	size_t index_data_size;
+
+	/* Value to indicate the alias index data is memory mapped
+	 */
+	int index_data_is_mapped;
+
+	/* The alias index writer
+	 */
+	libnk2_alias_index_writer_t *alias_index_writer;
+
+	/* The segment data
+	 */
+	uint8_t *segment_data;
+
+	/* The segment data size
+	 */
+	size_t segment_data_size;
+
+	/* The maximum number of files per segment
+	 */
+	uint32_t number_of_files_per_segment;
+
+	/* The number of files that were appended
+	 */
+	uint32_t number_of_appended_files;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int alias_handle_initialize(
+     alias_handle_t **alias_handle,
+     libcerror_error_t **error );
+
+int alias_handle_free(
+     alias_handle_t **alias_handle,
+     libcerror_error_t **error );
+
+int alias_handle_signal_abort(
+     alias_handle_t *alias_handle,
+     libcerror_error_t **error );
+
+int alias_handle_copy_to_utf8_string(
+     const system_character_t *string,
+     uint8_t **utf8_string,
+     size_t *utf8_string_length,
+     libcerror_error_t **error );
+
+int alias_handle_set_number_of_files_per_segment(
+     alias_handle_t *alias_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int alias_handle_open_index(
+     alias_handle_t *alias_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int alias_handle_close_index(
+     alias_handle_t *alias_handle,
+     libcerror_error_t **error );
+
+int alias_handle_write_segment(
+     alias_handle_t *alias_handle,
+     libcfile_file_t *index_file,
+     uint32_t *first_file_identifier,
+     libcerror_error_t **error );
+
+int alias_handle_add_file(
+     alias_handle_t *alias_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int alias_handle_append_files(
+     alias_handle_t *alias_handle,
+     const system_character_t *index_filename,
+     system_character_t * const sources[],
+     int number_of_sources,
+     libcerror_error_t **error );
+
+int alias_handle_search_address(
+     alias_handle_t *alias_handle,
+     const system_character_t *address,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _ALIAS_HANDLE_H ) */
+
@@ -0,0 +1,458 @@
+/*
+ * Carve block
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "carve_block.h"
+#include "nk2tools_libbfio.h"
+#include "nk2tools_libcerror.h"
+
+/* Creates a carve block
+ * The input handle is cloned so that the block can be read independently of other blocks
+ * Make sure the value carve_block is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int carve_block_initialize(
+     carve_block_t **carve_block,
+     libbfio_handle_t *input_handle,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "carve_block_initialize";
+	int result            = 0;
+
+	if( carve_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carve block.",
+		 function );
+
+		return( -1 );
+	}
+	if( *carve_block != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid carve block value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*carve_block = memory_allocate_structure(
+	                carve_block_t );
+
+	if( *carve_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create carve block.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *carve_block,
+	     0,
+	     sizeof( carve_block_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear carve block.",
+		 function );
+
+		memory_free(
+		 *carve_block );
+
+		*carve_block = NULL;
+
+		return( -1 );
+	}
+	( *carve_block )->buffer = (uint8_t *) memory_allocate(
+	                                        sizeof( uint8_t ) * buffer_size );
+
+	if( ( *carve_block )->buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	( *carve_block )->buffer_size = buffer_size;
+
+	if( libbfio_handle_clone(
+	     &( ( *carve_block )->input_handle ),
+	     input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create input handle.",
+		 function );
+
+		goto on_error;
+	}
+	result = libbfio_handle_is_open(
+	          ( *carve_block )->input_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if input handle is open.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libbfio_handle_open(
+		     ( *carve_block )->input_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open input handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( *carve_block != NULL )
+	{
+		if( ( *carve_block )->input_handle != NULL )
+		{
+			libbfio_handle_free(
+			 &( ( *carve_block )->input_handle ),
+			 NULL );
+		}
+		if( ( *carve_block )->buffer != NULL )
+		{
+			memory_free(
+			 ( *carve_block )->buffer );
+		}
+		memory_free(
+		 *carve_block );
+
+		*carve_block = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a carve block
+ * Returns 1 if successful or -1 on error
+ */
+int carve_block_free(
+     carve_block_t **carve_block,
+     libcerror_error_t **error )
+{
+	static char *function = "carve_block_free";
+	int result            = 1;
+
+	if( carve_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carve block.",
+		 function );
+
+		return( -1 );
+	}
+	if( *carve_block != NULL )
+	{
+		/* The cloned input handle is closed when it is freed
+		 */
+		if( libbfio_handle_free(
+		     &( ( *carve_block )->input_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input handle.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *carve_block )->candidates != NULL )
+		{
+			memory_free(
+			 ( *carve_block )->candidates );
+		}
+		if( ( *carve_block )->error != NULL )
+		{
+			libcerror_error_free(
+			 &( ( *carve_block )->error ) );
+		}
+		memory_free(
+		 ( *carve_block )->buffer );
+
+		memory_free(
+		 *carve_block );
+
+		*carve_block = NULL;
+	}
+	return( result );
+}
+
+/* Sets the range of the input that is scanned by the carve block
+ * This clears the candidates and the result of a previous scan
+ * Returns 1 if successful or -1 on error
+ */
+int carve_block_set_range(
+     carve_block_t *carve_block,
+     off64_t offset,
+     size_t size,
+     off64_t next_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "carve_block_set_range";
+
+	if( carve_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carve block.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > carve_block->buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( next_offset < offset )
+	 || ( next_offset > ( offset + (off64_t) size ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid next offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( carve_block->error != NULL )
+	{
+		libcerror_error_free(
+		 &( carve_block->error ) );
+	}
+	carve_block->offset               = offset;
+	carve_block->size                 = size;
+	carve_block->next_offset          = next_offset;
+	carve_block->number_of_candidates = 0;
+	carve_block->result               = 0;
+
+	return( 1 );
+}
+
+/* Reads the data of the carve block
+ * Returns 1 if successful or -1 on error
+ */
+int carve_block_read(
+     carve_block_t *carve_block,
+     libcerror_error_t **error )
+{
+	static char *function = "carve_block_read";
+	ssize_t read_count    = 0;
+
+	if( carve_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carve block.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              carve_block->input_handle,
+	              carve_block->buffer,
+	              carve_block->size,
+	              carve_block->offset,
+	              error );
+
+	if( read_count != (ssize_t) carve_block->size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 carve_block->offset,
+		 carve_block->offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Appends a candidate to the carve block
+ * Returns 1 if successful or -1 on error
+ */
+int carve_block_append_candidate(
+     carve_block_t *carve_block,
+     off64_t offset,
+     size64_t size,
+     uint32_t number_of_items,
+     libcerror_error_t **error )
+{
+	carve_candidate_t *candidates      = NULL;
+	static char *function              = "carve_block_append_candidate";
+	size_t candidates_size             = 0;
+	int number_of_allocated_candidates = 0;
+
+	if( carve_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carve block.",
+		 function );
+
+		return( -1 );
+	}
+	if( carve_block->number_of_candidates >= carve_block->number_of_allocated_candidates )
+	{
+		if( carve_block->number_of_allocated_candidates == 0 )
+		{
+			number_of_allocated_candidates = 16;
+		}
+		else if( carve_block->number_of_allocated_candidates > ( INT_MAX / 2 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid carve block - number of allocated candidates value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		else
+		{
+			number_of_allocated_candidates = carve_block->number_of_allocated_candidates * 2;
+		}
+		candidates_size = sizeof( carve_candidate_t ) * (size_t) number_of_allocated_candidates;
+
+		if( candidates_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid candidates size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		candidates = (carve_candidate_t *) memory_reallocate(
+		                                    carve_block->candidates,
+		                                    candidates_size );
+
+		if( candidates == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize candidates.",
+			 function );
+
+			return( -1 );
+		}
+		carve_block->candidates                     = candidates;
+		carve_block->number_of_allocated_candidates = number_of_allocated_candidates;
+	}
+	carve_block->candidates[ carve_block->number_of_candidates ].offset          = offset;
+	carve_block->candidates[ carve_block->number_of_candidates ].size            = size;
+	carve_block->candidates[ carve_block->number_of_candidates ].number_of_items = number_of_items;
+
+	carve_block->number_of_candidates += 1;
+
+	return( 1 );
+}
+
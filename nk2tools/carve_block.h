@@ -0,0 +1,136 @@
+/*
+ * Carve block
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _CARVE_BLOCK_H )
+#define _CARVE_BLOCK_H
+
+#include <common.h>
+#include <types.h>
+
+#include "nk2tools_libbfio.h"
+#include "nk2tools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct carve_candidate carve_candidate_t;
+
+struct carve_candidate
+{
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The size
+	 */
+	size64_t size;
+
+	/* The number of items, only used when carving files
+	 */
+	uint32_t number_of_items;
+};
+
+typedef struct carve_block carve_block_t;
+
+struct carve_block
+{
+	/* The input file IO handle
+	 * Every block has its own input handle so that blocks can be scanned concurrently
+	 */
+	libbfio_handle_t *input_handle;
+
+	/* The offset of the block
+	 */
+	off64_t offset;
+
+	/* The size of the block
+	 */
+	size_t size;
+
+	/* The offset at which the next block starts
+	 * Candidates at or after this offset are found when the next block is scanned
+	 */
+	off64_t next_offset;
+
+	/* The block buffer
+	 */
+	uint8_t *buffer;
+
+	/* The size of the block buffer
+	 */
+	size_t buffer_size;
+
+	/* The candidates
+	 */
+	carve_candidate_t *candidates;
+
+	/* The number of candidates
+	 */
+	int number_of_candidates;
+
+	/* The number of allocated candidates
+	 */
+	int number_of_allocated_candidates;
+
+	/* The result of scanning the block
+	 */
+	int result;
+
+	/* The error of scanning the block
+	 */
+	libcerror_error_t *error;
+};
+
+int carve_block_initialize(
+     carve_block_t **carve_block,
+     libbfio_handle_t *input_handle,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int carve_block_free(
+     carve_block_t **carve_block,
+     libcerror_error_t **error );
+
+int carve_block_set_range(
+     carve_block_t *carve_block,
+     off64_t offset,
+     size_t size,
+     off64_t next_offset,
+     libcerror_error_t **error );
+
+int carve_block_read(
+     carve_block_t *carve_block,
+     libcerror_error_t **error );
+
+int carve_block_append_candidate(
+     carve_block_t *carve_block,
+     off64_t offset,
+     size64_t size,
+     uint32_t number_of_items,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _CARVE_BLOCK_H ) */
+
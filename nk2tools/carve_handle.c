@@ -0,0 +1,1926 @@
+/*
+ * Carve handle
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "carve_block.h"
+#include "carve_handle.h"
+#include "nk2input.h"
+#include "nk2tools_libbfio.h"
+#include "nk2tools_libcerror.h"
+#include "nk2tools_libcfile.h"
+#include "nk2tools_libcthreads.h"
+#include "nk2tools_libnk2.h"
+
+#define CARVE_HANDLE_NOTIFY_STREAM		stdout
+
+/* Creates a carve handle
+ * Make sure the value carve_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int carve_handle_initialize(
+     carve_handle_t **carve_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "carve_handle_initialize";
+
+	if( carve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carve handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *carve_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid carve handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*carve_handle = memory_allocate_structure(
+	                 carve_handle_t );
+
+	if( *carve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create carve handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *carve_handle,
+	     0,
+	     sizeof( carve_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear carve handle.",
+		 function );
+
+		memory_free(
+		 *carve_handle );
+
+		*carve_handle = NULL;
+
+		return( -1 );
+	}
+	( *carve_handle )->copy_buffer = (uint8_t *) memory_allocate(
+	                                              sizeof( uint8_t ) * CARVE_HANDLE_COPY_BUFFER_SIZE );
+
+	if( ( *carve_handle )->copy_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create copy buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_initialize(
+	     &( ( *carve_handle )->input_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create input handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *carve_handle )->block_size    = CARVE_HANDLE_DEFAULT_BLOCK_SIZE;
+	( *carve_handle )->notify_stream = CARVE_HANDLE_NOTIFY_STREAM;
+
+#if defined( HAVE_NK2TOOLS_MULTI_THREAD_SUPPORT )
+	( *carve_handle )->number_of_threads = CARVE_HANDLE_DEFAULT_NUMBER_OF_THREADS;
+#endif
+
+	return( 1 );
+
+on_error:
+	if( *carve_handle != NULL )
+	{
+		if( ( *carve_handle )->copy_buffer != NULL )
+		{
+			memory_free(
+			 ( *carve_handle )->copy_buffer );
+		}
+		memory_free(
+		 *carve_handle );
+
+		*carve_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a carve handle
+ * Returns 1 if successful or -1 on error
+ */
+int carve_handle_free(
+     carve_handle_t **carve_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "carve_handle_free";
+	int result            = 1;
+
+	if( carve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carve handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *carve_handle != NULL )
+	{
+		if( libbfio_handle_free(
+		     &( ( *carve_handle )->input_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input handle.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *carve_handle )->copy_buffer );
+
+		memory_free(
+		 *carve_handle );
+
+		*carve_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the carve handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int carve_handle_signal_abort(
+     carve_handle_t *carve_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "carve_handle_signal_abort";
+
+	if( carve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carve handle.",
+		 function );
+
+		return( -1 );
+	}
+	carve_handle->abort = 1;
+
+	return( 1 );
+}
+
+/* Sets the size of the scan block
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int carve_handle_set_block_size(
+     carve_handle_t *carve_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "carve_handle_set_block_size";
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( carve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carve handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = nk2input_determine_decimal_value(
+	          string,
+	          &value_64bit,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine block size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( result != 0 )
+	 && ( value_64bit >= (uint64_t) CARVE_HANDLE_MINIMUM_BLOCK_SIZE )
+	 && ( value_64bit <= (uint64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		carve_handle->block_size = (size_t) value_64bit;
+
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Sets the number of threads used to scan blocks
+ * A number of 0 represents scanning the blocks without threads
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int carve_handle_set_number_of_threads(
+     carve_handle_t *carve_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "carve_handle_set_number_of_threads";
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( carve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carve handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = nk2input_determine_decimal_value(
+	          string,
+	          &value_64bit,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine number of threads.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_NK2TOOLS_MULTI_THREAD_SUPPORT )
+	if( ( result != 0 )
+	 && ( value_64bit <= (uint64_t) CARVE_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
+#else
+	if( ( result != 0 )
+	 && ( value_64bit == 0 ) )
+#endif
+	{
+		carve_handle->number_of_threads = (int) value_64bit;
+
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Sets the target path
+ * The carved files are written to: target_path.offset.nk2
+ * Returns 1 if successful or -1 on error
+ */
+int carve_handle_set_target_path(
+     carve_handle_t *carve_handle,
+     const system_character_t *target_path,
+     libcerror_error_t **error )
+{
+	static char *function = "carve_handle_set_target_path";
+
+	if( carve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carve handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( target_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid target path.",
+		 function );
+
+		return( -1 );
+	}
+	carve_handle->target_path = target_path;
+
+	return( 1 );
+}
+
+/* Opens the input
+ * Returns 1 if successful or -1 on error
+ */
+int carve_handle_open_input(
+     carve_handle_t *carve_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function  = "carve_handle_open_input";
+	size_t filename_length = 0;
+
+	if( carve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carve handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_set_name_wide(
+	     carve_handle->input_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#else
+	if( libbfio_file_set_name(
+	     carve_handle->input_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set input handle filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_open(
+	     carve_handle->input_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_size(
+	     carve_handle->input_handle,
+	     &( carve_handle->input_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve input size.",
+		 function );
+
+		libbfio_handle_close(
+		 carve_handle->input_handle,
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Closes the input
+ * Returns the 0 if succesful or -1 on error
+ */
+int carve_handle_close_input(
+     carve_handle_t *carve_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "carve_handle_close_input";
+
+	if( carve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carve handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_close(
+	     carve_handle->input_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input handle.",
+		 function );
+
+		return( -1 );
+	}
+	carve_handle->input_size = 0;
+
+	return( 0 );
+}
+
+/* Writes a carved file
+ * Returns 1 if successful or -1 on error
+ */
+int carve_handle_write_carved_file(
+     carve_handle_t *carve_handle,
+     off64_t file_offset,
+     size64_t file_size,
+     libcerror_error_t **error )
+{
+	libcfile_file_t *file_handle    = NULL;
+	system_character_t *target_path = NULL;
+	static char *function           = "carve_handle_write_carved_file";
+	size_t read_size                = 0;
+	size_t target_path_length       = 0;
+	size_t target_path_size         = 0;
+	ssize_t read_count              = 0;
+	ssize_t write_count             = 0;
+	int print_count                 = 0;
+
+	if( carve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carve handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( carve_handle->target_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid carve handle - missing target path.",
+		 function );
+
+		return( -1 );
+	}
+	/* The target path is suffixed with: .<16 hexadecimal digits>.nk2
+	 */
+	target_path_size = system_string_length(
+	                    carve_handle->target_path ) + 22;
+
+	target_path = system_string_allocate(
+	               target_path_size );
+
+	if( target_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create target path.",
+		 function );
+
+		goto on_error;
+	}
+	target_path_length = system_string_length(
+	                      carve_handle->target_path );
+
+	if( system_string_copy(
+	     target_path,
+	     carve_handle->target_path,
+	     target_path_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy target path.",
+		 function );
+
+		goto on_error;
+	}
+	print_count = system_string_sprintf(
+	               &( target_path[ target_path_length ] ),
+	               target_path_size - target_path_length,
+	               _SYSTEM_STRING( ".%08x%08x.nk2" ),
+	               (unsigned int) ( (uint64_t) file_offset >> 32 ),
+	               (unsigned int) ( (uint64_t) file_offset & 0xffffffffUL ) );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= ( target_path_size - target_path_length ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set target path.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_initialize(
+	     &file_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcfile_file_open_wide(
+	     file_handle,
+	     target_path,
+	     LIBCFILE_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+#else
+	if( libcfile_file_open(
+	     file_handle,
+	     target_path,
+	     LIBCFILE_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open: %" PRIs_SYSTEM ".",
+		 function,
+		 target_path );
+
+		goto on_error;
+	}
+	while( file_size > 0 )
+	{
+		read_size = CARVE_HANDLE_COPY_BUFFER_SIZE;
+
+		if( file_size < (size64_t) read_size )
+		{
+			read_size = (size_t) file_size;
+		}
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              carve_handle->input_handle,
+		              carve_handle->copy_buffer,
+		              read_size,
+		              file_offset,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 file_offset,
+			 file_offset );
+
+			goto on_error;
+		}
+		write_count = libcfile_file_write_buffer(
+		               file_handle,
+		               carve_handle->copy_buffer,
+		               read_size,
+		               error );
+
+		if( write_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write data.",
+			 function );
+
+			goto on_error;
+		}
+		file_offset += read_size;
+		file_size   -= read_size;
+	}
+	if( libcfile_file_close(
+	     file_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &file_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file handle.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 carve_handle->notify_stream,
+	 "\tcarved to\t\t: %" PRIs_SYSTEM "\n",
+	 target_path );
+
+	memory_free(
+	 target_path );
+
+	carve_handle->number_of_carved_files += 1;
+
+	return( 1 );
+
+on_error:
+	if( file_handle != NULL )
+	{
+		libcfile_file_free(
+		 &file_handle,
+		 NULL );
+	}
+	if( target_path != NULL )
+	{
+		memory_free(
+		 target_path );
+	}
+	return( -1 );
+}
+
+/* Scans a block for NK2 files
+ * Callback function for the carve thread pool
+ * Every signature in the block is validated, the candidates that are part of
+ * a previously carved file are skipped when the blocks are merged
+ * The result of the scan is stored in the carve block
+ * Returns 1 if the block was processed or -1 on error
+ */
+int carve_handle_scan_block_for_files(
+     carve_block_t *carve_block,
+     carve_handle_t *carve_handle )
+{
+	static char *function    = "carve_handle_scan_block_for_files";
+	size64_t carved_size     = 0;
+	size_t block_offset      = 0;
+	size_t signature_offset  = 0;
+	off64_t candidate_offset = 0;
+	uint32_t number_of_items = 0;
+	int result               = 0;
+
+	if( carve_block == NULL )
+	{
+		return( -1 );
+	}
+	if( carve_handle == NULL )
+	{
+		libcerror_error_set(
+		 &( carve_block->error ),
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carve handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( carve_block_read(
+	     carve_block,
+	     &( carve_block->error ) ) != 1 )
+	{
+		libcerror_error_set(
+		 &( carve_block->error ),
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read block.",
+		 function );
+
+		goto on_error;
+	}
+	while( block_offset < carve_block->size )
+	{
+		if( carve_handle->abort != 0 )
+		{
+			break;
+		}
+		result = libnk2_carve_scan_buffer_for_signature(
+		          &( carve_block->buffer[ block_offset ] ),
+		          carve_block->size - block_offset,
+		          &signature_offset,
+		          &( carve_block->error ) );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 &( carve_block->error ),
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to scan block for signature.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		candidate_offset = carve_block->offset + (off64_t) ( block_offset + signature_offset );
+
+		result = libnk2_carve_validate_file_io_handle(
+		          carve_block->input_handle,
+		          candidate_offset,
+		          &carved_size,
+		          &number_of_items,
+		          &( carve_block->error ) );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 &( carve_block->error ),
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to validate candidate at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 candidate_offset,
+			 candidate_offset );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			if( carve_block_append_candidate(
+			     carve_block,
+			     candidate_offset,
+			     carved_size,
+			     number_of_items,
+			     &( carve_block->error ) ) != 1 )
+			{
+				libcerror_error_set(
+				 &( carve_block->error ),
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append candidate.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		block_offset += signature_offset + 1;
+	}
+	carve_block->result = 1;
+
+	return( 1 );
+
+on_error:
+	carve_block->result = -1;
+
+	return( 1 );
+}
+
+/* Scans a block for items without a file header
+ * Callback function for the carve thread pool
+ * Items that start at or after the next offset are left to the next block and
+ * the candidates that are part of a previously carved item are skipped when
+ * the blocks are merged
+ * The result of the scan is stored in the carve block
+ * Returns 1 if the block was processed or -1 on error
+ */
+int carve_handle_scan_block_for_items(
+     carve_block_t *carve_block,
+     carve_handle_t *carve_handle )
+{
+	static char *function      = "carve_handle_scan_block_for_items";
+	size_t block_offset        = 0;
+	size_t item_data_size      = 0;
+	size_t item_offset         = 0;
+	off64_t candidate_offset   = 0;
+	uint32_t number_of_entries = 0;
+	int result                 = 0;
+
+	if( carve_block == NULL )
+	{
+		return( -1 );
+	}
+	if( carve_handle == NULL )
+	{
+		libcerror_error_set(
+		 &( carve_block->error ),
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carve handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( carve_block_read(
+	     carve_block,
+	     &( carve_block->error ) ) != 1 )
+	{
+		libcerror_error_set(
+		 &( carve_block->error ),
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read block.",
+		 function );
+
+		goto on_error;
+	}
+	while( block_offset < carve_block->size )
+	{
+		if( carve_handle->abort != 0 )
+		{
+			break;
+		}
+		result = libnk2_carve_scan_buffer_for_item(
+		          &( carve_block->buffer[ block_offset ] ),
+		          carve_block->size - block_offset,
+		          &item_offset,
+		          &item_data_size,
+		          &number_of_entries,
+		          &( carve_block->error ) );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 &( carve_block->error ),
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to scan block for item.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		candidate_offset = carve_block->offset + (off64_t) ( block_offset + item_offset );
+
+		/* An item in the overlap is found when the next block is scanned
+		 */
+		if( candidate_offset >= carve_block->next_offset )
+		{
+			break;
+		}
+		if( carve_block_append_candidate(
+		     carve_block,
+		     candidate_offset,
+		     (size64_t) item_data_size,
+		     0,
+		     &( carve_block->error ) ) != 1 )
+		{
+			libcerror_error_set(
+			 &( carve_block->error ),
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append candidate.",
+			 function );
+
+			goto on_error;
+		}
+		block_offset += item_offset + 1;
+	}
+	carve_block->result = 1;
+
+	return( 1 );
+
+on_error:
+	carve_block->result = -1;
+
+	return( 1 );
+}
+
+/* Scans blocks
+ * The blocks are scanned by a thread pool if more than one thread is used
+ * Returns 1 if successful or -1 on error
+ */
+int carve_handle_scan_blocks(
+     carve_handle_t *carve_handle,
+     carve_block_t **carve_blocks,
+     int number_of_blocks,
+     int (*scan_function)(
+            carve_block_t *carve_block,
+            carve_handle_t *carve_handle ),
+     libcerror_error_t **error )
+{
+#if defined( HAVE_NK2TOOLS_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_pool_t *thread_pool = NULL;
+	int number_of_threads                  = 0;
+	int result                             = 1;
+#endif
+
+	static char *function                  = "carve_handle_scan_blocks";
+	int block_index                        = 0;
+
+	if( carve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carve handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( carve_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carve blocks.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_blocks < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of blocks value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( scan_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan function.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_NK2TOOLS_MULTI_THREAD_SUPPORT )
+	if( ( carve_handle->number_of_threads > 1 )
+	 && ( number_of_blocks > 1 ) )
+	{
+		number_of_threads = carve_handle->number_of_threads;
+
+		if( number_of_threads > number_of_blocks )
+		{
+			number_of_threads = number_of_blocks;
+		}
+		if( libcthreads_thread_pool_create(
+		     &thread_pool,
+		     NULL,
+		     number_of_threads,
+		     number_of_blocks,
+		     (int (*)(intptr_t *, void *)) scan_function,
+		     (void *) carve_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
+
+			return( -1 );
+		}
+		for( block_index = 0;
+		     block_index < number_of_blocks;
+		     block_index++ )
+		{
+			if( libcthreads_thread_pool_push(
+			     thread_pool,
+			     (intptr_t *) carve_blocks[ block_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to push block: %d onto thread pool.",
+				 function,
+				 block_index );
+
+				result = -1;
+
+				break;
+			}
+		}
+		/* The thread pool is joined after all blocks have been scanned
+		 * and also when a block could not be pushed
+		 */
+		if( libcthreads_thread_pool_join(
+		     &thread_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			result = -1;
+		}
+		return( result );
+	}
+#endif /* defined( HAVE_NK2TOOLS_MULTI_THREAD_SUPPORT ) */
+
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		if( scan_function(
+		     carve_blocks[ block_index ],
+		     carve_handle ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to scan block: %d.",
+			 function,
+			 block_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Creates the carve blocks
+ * One block is created per thread, or a single block if no threads are used
+ * Returns 1 if successful or -1 on error
+ */
+int carve_handle_initialize_blocks(
+     carve_handle_t *carve_handle,
+     carve_block_t ***carve_blocks,
+     int *number_of_blocks,
+     libcerror_error_t **error )
+{
+	static char *function     = "carve_handle_initialize_blocks";
+	int block_index           = 0;
+	int safe_number_of_blocks = 1;
+
+	if( carve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carve handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( carve_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carve blocks.",
+		 function );
+
+		return( -1 );
+	}
+	if( *carve_blocks != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid carve blocks value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of blocks.",
+		 function );
+
+		return( -1 );
+	}
+	if( carve_handle->number_of_threads > 1 )
+	{
+		safe_number_of_blocks = carve_handle->number_of_threads;
+	}
+	*carve_blocks = (carve_block_t **) memory_allocate(
+	                                    sizeof( carve_block_t * ) * safe_number_of_blocks );
+
+	if( *carve_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create carve blocks.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *carve_blocks,
+	     0,
+	     sizeof( carve_block_t * ) * safe_number_of_blocks ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear carve blocks.",
+		 function );
+
+		goto on_error;
+	}
+	for( block_index = 0;
+	     block_index < safe_number_of_blocks;
+	     block_index++ )
+	{
+		if( carve_block_initialize(
+		     &( ( *carve_blocks )[ block_index ] ),
+		     carve_handle->input_handle,
+		     carve_handle->block_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create carve block: %d.",
+			 function,
+			 block_index );
+
+			goto on_error;
+		}
+	}
+	*number_of_blocks = safe_number_of_blocks;
+
+	return( 1 );
+
+on_error:
+	if( *carve_blocks != NULL )
+	{
+		carve_handle_free_blocks(
+		 carve_blocks,
+		 safe_number_of_blocks,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees the carve blocks
+ * Returns 1 if successful or -1 on error
+ */
+int carve_handle_free_blocks(
+     carve_block_t ***carve_blocks,
+     int number_of_blocks,
+     libcerror_error_t **error )
+{
+	static char *function = "carve_handle_free_blocks";
+	int block_index       = 0;
+	int result            = 1;
+
+	if( carve_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carve blocks.",
+		 function );
+
+		return( -1 );
+	}
+	if( *carve_blocks != NULL )
+	{
+		for( block_index = 0;
+		     block_index < number_of_blocks;
+		     block_index++ )
+		{
+			if( ( *carve_blocks )[ block_index ] == NULL )
+			{
+				continue;
+			}
+			if( carve_block_free(
+			     &( ( *carve_blocks )[ block_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free carve block: %d.",
+				 function,
+				 block_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *carve_blocks );
+
+		*carve_blocks = NULL;
+	}
+	return( result );
+}
+
+/* Sets the ranges of the carve blocks that are scanned next
+ * Consecutive blocks overlap by the overlap size, except for the last block of the input
+ * Returns the number of blocks in use if successful or -1 on error
+ */
+int carve_handle_set_block_ranges(
+     carve_handle_t *carve_handle,
+     carve_block_t **carve_blocks,
+     int number_of_blocks,
+     size_t overlap_size,
+     off64_t *scan_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "carve_handle_set_block_ranges";
+	size_t read_size      = 0;
+	off64_t next_offset   = 0;
+	int block_index       = 0;
+
+	if( carve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carve handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( carve_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carve blocks.",
+		 function );
+
+		return( -1 );
+	}
+	if( overlap_size >= carve_handle->block_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid overlap size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( scan_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan offset.",
+		 function );
+
+		return( -1 );
+	}
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		if( (size64_t) *scan_offset >= carve_handle->input_size )
+		{
+			break;
+		}
+		read_size = carve_handle->block_size;
+
+		if( ( carve_handle->input_size - (size64_t) *scan_offset ) < (size64_t) read_size )
+		{
+			read_size = (size_t) ( carve_handle->input_size - (size64_t) *scan_offset );
+		}
+		if( ( (size64_t) *scan_offset + read_size ) >= carve_handle->input_size )
+		{
+			next_offset = (off64_t) carve_handle->input_size;
+		}
+		else
+		{
+			next_offset = *scan_offset + (off64_t) ( read_size - overlap_size );
+		}
+		if( carve_block_set_range(
+		     carve_blocks[ block_index ],
+		     *scan_offset,
+		     read_size,
+		     next_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set range of carve block: %d.",
+			 function,
+			 block_index );
+
+			return( -1 );
+		}
+		*scan_offset = next_offset;
+	}
+	return( block_index );
+}
+
+/* Retrieves the result of scanning a carve block
+ * The error of the carve block is moved to error
+ * Returns 1 if successful or -1 on error
+ */
+int carve_handle_get_block_result(
+     carve_handle_t *carve_handle,
+     carve_block_t *carve_block,
+     libcerror_error_t **error )
+{
+	static char *function = "carve_handle_get_block_result";
+
+	if( carve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carve handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( carve_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carve block.",
+		 function );
+
+		return( -1 );
+	}
+	if( carve_block->result == 1 )
+	{
+		return( 1 );
+	}
+	if( ( error != NULL )
+	 && ( *error == NULL ) )
+	{
+		*error             = carve_block->error;
+		carve_block->error = NULL;
+	}
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_GENERIC,
+	 "%s: unable to scan block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+	 function,
+	 carve_block->offset,
+	 carve_block->offset );
+
+	return( -1 );
+}
+
+/* Scans the input for NK2 files
+ * The input is read in blocks that overlap by the size of the signature - 1
+ * so that a signature that straddles a block boundary is found
+ * The blocks are scanned concurrently and merged in offset order
+ * Returns 1 if successful or -1 on error
+ */
+int carve_handle_carve_input(
+     carve_handle_t *carve_handle,
+     libcerror_error_t **error )
+{
+	carve_block_t **carve_blocks = NULL;
+	carve_candidate_t *candidate = NULL;
+	static char *function        = "carve_handle_carve_input";
+	off64_t carved_end_offset    = 0;
+	off64_t scan_offset          = 0;
+	uint64_t number_of_files     = 0;
+	int block_index              = 0;
+	int candidate_index          = 0;
+	int number_of_blocks         = 0;
+	int number_of_blocks_in_use  = 0;
+
+	if( carve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carve handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( carve_handle_initialize_blocks(
+	     carve_handle,
+	     &carve_blocks,
+	     &number_of_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create carve blocks.",
+		 function );
+
+		goto on_error;
+	}
+	while( (size64_t) scan_offset < carve_handle->input_size )
+	{
+		if( carve_handle->abort != 0 )
+		{
+			break;
+		}
+		number_of_blocks_in_use = carve_handle_set_block_ranges(
+		                           carve_handle,
+		                           carve_blocks,
+		                           number_of_blocks,
+		                           CARVE_HANDLE_FILE_OVERLAP_SIZE,
+		                           &scan_offset,
+		                           error );
+
+		if( number_of_blocks_in_use == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set block ranges.",
+			 function );
+
+			goto on_error;
+		}
+		if( carve_handle_scan_blocks(
+		     carve_handle,
+		     carve_blocks,
+		     number_of_blocks_in_use,
+		     &carve_handle_scan_block_for_files,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to scan blocks.",
+			 function );
+
+			goto on_error;
+		}
+		for( block_index = 0;
+		     block_index < number_of_blocks_in_use;
+		     block_index++ )
+		{
+			if( carve_handle_get_block_result(
+			     carve_handle,
+			     carve_blocks[ block_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve result of block: %d.",
+				 function,
+				 block_index );
+
+				goto on_error;
+			}
+			for( candidate_index = 0;
+			     candidate_index < carve_blocks[ block_index ]->number_of_candidates;
+			     candidate_index++ )
+			{
+				if( carve_handle->abort != 0 )
+				{
+					break;
+				}
+				candidate = &( carve_blocks[ block_index ]->candidates[ candidate_index ] );
+
+				/* Skip candidates that are part of a previously carved file
+				 */
+				if( candidate->offset < carved_end_offset )
+				{
+					continue;
+				}
+				number_of_files++;
+
+				fprintf(
+				 carve_handle->notify_stream,
+				 "NK2 file: %" PRIu64 "\n",
+				 number_of_files );
+
+				fprintf(
+				 carve_handle->notify_stream,
+				 "\toffset\t\t\t: %" PRIi64 " (0x%08" PRIx64 ")\n",
+				 candidate->offset,
+				 candidate->offset );
+
+				fprintf(
+				 carve_handle->notify_stream,
+				 "\tsize\t\t\t: %" PRIu64 "\n",
+				 candidate->size );
+
+				fprintf(
+				 carve_handle->notify_stream,
+				 "\tnumber of items\t\t: %" PRIu32 "\n",
+				 candidate->number_of_items );
+
+				if( carve_handle->target_path != NULL )
+				{
+					if( carve_handle_write_carved_file(
+					     carve_handle,
+					     candidate->offset,
+					     candidate->size,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_WRITE_FAILED,
+						 "%s: unable to write carved file.",
+						 function );
+
+						goto on_error;
+					}
+				}
+				fprintf(
+				 carve_handle->notify_stream,
+				 "\n" );
+
+				carved_end_offset = candidate->offset + (off64_t) candidate->size;
+			}
+		}
+	}
+	if( carve_handle_free_blocks(
+	     &carve_blocks,
+	     number_of_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free carve blocks.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 carve_handle->notify_stream,
+	 "Found: %" PRIu64 " NK2 file(s).\n",
+	 number_of_files );
+
+	return( 1 );
+
+on_error:
+	if( carve_blocks != NULL )
+	{
+		carve_handle_free_blocks(
+		 &carve_blocks,
+		 number_of_blocks,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Scans the input for items without a file header
+ * The input is read in blocks that overlap so that an item that straddles
+ * a block boundary is found if it is smaller than the overlap
+ * The blocks are scanned concurrently and merged in offset order
+ * Returns 1 if successful or -1 on error
+ */
+int carve_handle_carve_input_items(
+     carve_handle_t *carve_handle,
+     libcerror_error_t **error )
+{
+	carve_block_t **carve_blocks = NULL;
+	carve_candidate_t *candidate = NULL;
+	libnk2_item_t *item          = NULL;
+	static char *function        = "carve_handle_carve_input_items";
+	size_t overlap_size          = 0;
+	off64_t carved_end_offset    = 0;
+	off64_t scan_offset          = 0;
+	uint64_t number_of_items     = 0;
+	int block_index              = 0;
+	int candidate_index          = 0;
+	int number_of_blocks         = 0;
+	int number_of_blocks_in_use  = 0;
+	int number_of_item_entries   = 0;
+
+	if( carve_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid carve handle.",
+		 function );
+
+		return( -1 );
+	}
+	overlap_size = carve_handle->block_size / 2;
+
+	if( overlap_size > CARVE_HANDLE_ITEM_OVERLAP_SIZE )
+	{
+		overlap_size = CARVE_HANDLE_ITEM_OVERLAP_SIZE;
+	}
+	if( carve_handle_initialize_blocks(
+	     carve_handle,
+	     &carve_blocks,
+	     &number_of_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create carve blocks.",
+		 function );
+
+		goto on_error;
+	}
+	while( (size64_t) scan_offset < carve_handle->input_size )
+	{
+		if( carve_handle->abort != 0 )
+		{
+			break;
+		}
+		number_of_blocks_in_use = carve_handle_set_block_ranges(
+		                           carve_handle,
+		                           carve_blocks,
+		                           number_of_blocks,
+		                           overlap_size,
+		                           &scan_offset,
+		                           error );
+
+		if( number_of_blocks_in_use == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set block ranges.",
+			 function );
+
+			goto on_error;
+		}
+		if( carve_handle_scan_blocks(
+		     carve_handle,
+		     carve_blocks,
+		     number_of_blocks_in_use,
+		     &carve_handle_scan_block_for_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to scan blocks.",
+			 function );
+
+			goto on_error;
+		}
+		for( block_index = 0;
+		     block_index < number_of_blocks_in_use;
+		     block_index++ )
+		{
+			if( carve_handle_get_block_result(
+			     carve_handle,
+			     carve_blocks[ block_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve result of block: %d.",
+				 function,
+				 block_index );
+
+				goto on_error;
+			}
+			for( candidate_index = 0;
+			     candidate_index < carve_blocks[ block_index ]->number_of_candidates;
+			     candidate_index++ )
+			{
+				if( carve_handle->abort != 0 )
+				{
+					break;
+				}
+				candidate = &( carve_blocks[ block_index ]->candidates[ candidate_index ] );
+
+				/* Skip candidates that are part of a previously carved item
+				 */
+				if( candidate->offset < carved_end_offset )
+				{
+					continue;
+				}
+				if( libnk2_carve_read_item_file_io_handle(
+				     carve_handle->input_handle,
+				     candidate->offset,
+				     LIBNK2_CODEPAGE_WINDOWS_1252,
+				     &item,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read item at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+					 function,
+					 candidate->offset,
+					 candidate->offset );
+
+					goto on_error;
+				}
+				if( libnk2_item_get_number_of_entries(
+				     item,
+				     &number_of_item_entries,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve number of entries.",
+					 function );
+
+					goto on_error;
+				}
+				if( libnk2_item_free(
+				     &item,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free item.",
+					 function );
+
+					goto on_error;
+				}
+				number_of_items++;
+
+				fprintf(
+				 carve_handle->notify_stream,
+				 "Item: %" PRIu64 "\n",
+				 number_of_items );
+
+				fprintf(
+				 carve_handle->notify_stream,
+				 "\toffset\t\t\t: %" PRIi64 " (0x%08" PRIx64 ")\n",
+				 candidate->offset,
+				 candidate->offset );
+
+				fprintf(
+				 carve_handle->notify_stream,
+				 "\tsize\t\t\t: %" PRIu64 "\n",
+				 candidate->size );
+
+				fprintf(
+				 carve_handle->notify_stream,
+				 "\tnumber of entries\t: %d\n",
+				 number_of_item_entries );
+
+				fprintf(
+				 carve_handle->notify_stream,
+				 "\n" );
+
+				carved_end_offset = candidate->offset + (off64_t) candidate->size;
+			}
+		}
+	}
+	if( carve_handle_free_blocks(
+	     &carve_blocks,
+	     number_of_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free carve blocks.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 carve_handle->notify_stream,
+	 "Found: %" PRIu64 " item(s).\n",
+	 number_of_items );
+
+	return( 1 );
+
+on_error:
+	if( item != NULL )
+	{
+		libnk2_item_free(
+		 &item,
+		 NULL );
+	}
+	if( carve_blocks != NULL )
+	{
+		carve_handle_free_blocks(
+		 &carve_blocks,
+		 number_of_blocks,
+		 NULL );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,209 @@
+/*
+ * Carve handle
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _CARVE_HANDLE_H )
+#define _CARVE_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "carve_block.h"
+#include "nk2tools_libbfio.h"
+#include "nk2tools_libcerror.h"
+#include "nk2tools_libcfile.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The default size of the scan block
+ */
+#define CARVE_HANDLE_DEFAULT_BLOCK_SIZE		( 16 * 1024 * 1024 )
+
+/* The minimum size of the scan block
+ */
+#define CARVE_HANDLE_MINIMUM_BLOCK_SIZE		4096
+
+/* The size of the overlap between scan blocks when carving files
+ * A signature that starts in the overlap is found when the next block is scanned
+ */
+#define CARVE_HANDLE_FILE_OVERLAP_SIZE		3
+
+/* The maximum size of the overlap between scan blocks when carving items
+ */
+#define CARVE_HANDLE_ITEM_OVERLAP_SIZE		( 1024 * 1024 )
+
+/* The default number of threads used to scan blocks
+ */
+#define CARVE_HANDLE_DEFAULT_NUMBER_OF_THREADS	4
+
+/* The maximum number of threads used to scan blocks
+ */
+#define CARVE_HANDLE_MAXIMUM_NUMBER_OF_THREADS	32
+
+/* The size of the copy buffer
+ */
+#define CARVE_HANDLE_COPY_BUFFER_SIZE		( 64 * 1024 )
+
+typedef struct carve_handle carve_handle_t;
+
+struct carve_handle
+{
+	/* The input file IO handle
+	 */
+	libbfio_handle_t *input_handle;
+
+	/* The input size
+	 */
+	size64_t input_size;
+
+	/* The size of the scan block
+	 */
+	size_t block_size;
+
+	/* The number of threads used to scan blocks
+	 * where 0 represents scanning the blocks without threads
+	 */
+	int number_of_threads;
+
+	/* The copy buffer
+	 */
+	uint8_t *copy_buffer;
+
+	/* The target path
+	 */
+	const system_character_t *target_path;
+
+	/* Value to indicate if items without a file header should be carved
+	 */
+	int carve_items;
+
+	/* The number of carved files
+	 */
+	uint64_t number_of_carved_files;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int carve_handle_initialize(
+     carve_handle_t **carve_handle,
+     libcerror_error_t **error );
+
+int carve_handle_free(
+     carve_handle_t **carve_handle,
+     libcerror_error_t **error );
+
+int carve_handle_signal_abort(
+     carve_handle_t *carve_handle,
+     libcerror_error_t **error );
+
+int carve_handle_set_block_size(
+     carve_handle_t *carve_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int carve_handle_set_number_of_threads(
+     carve_handle_t *carve_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int carve_handle_set_target_path(
+     carve_handle_t *carve_handle,
+     const system_character_t *target_path,
+     libcerror_error_t **error );
+
+int carve_handle_open_input(
+     carve_handle_t *carve_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int carve_handle_close_input(
+     carve_handle_t *carve_handle,
+     libcerror_error_t **error );
+
+int carve_handle_write_carved_file(
+     carve_handle_t *carve_handle,
+     off64_t file_offset,
+     size64_t file_size,
+     libcerror_error_t **error );
+
+int carve_handle_scan_block_for_files(
+     carve_block_t *carve_block,
+     carve_handle_t *carve_handle );
+
+int carve_handle_scan_block_for_items(
+     carve_block_t *carve_block,
+     carve_handle_t *carve_handle );
+
+int carve_handle_scan_blocks(
+     carve_handle_t *carve_handle,
+     carve_block_t **carve_blocks,
+     int number_of_blocks,
+     int (*scan_function)(
+            carve_block_t *carve_block,
+            carve_handle_t *carve_handle ),
+     libcerror_error_t **error );
+
+int carve_handle_initialize_blocks(
+     carve_handle_t *carve_handle,
+     carve_block_t ***carve_blocks,
+     int *number_of_blocks,
+     libcerror_error_t **error );
+
+int carve_handle_free_blocks(
+     carve_block_t ***carve_blocks,
+     int number_of_blocks,
+     libcerror_error_t **error );
+
+int carve_handle_set_block_ranges(
+     carve_handle_t *carve_handle,
+     carve_block_t **carve_blocks,
+     int number_of_blocks,
+     size_t overlap_size,
+     off64_t *scan_offset,
+     libcerror_error_t **error );
+
+int carve_handle_get_block_result(
+     carve_handle_t *carve_handle,
+     carve_block_t *carve_block,
+     libcerror_error_t **error );
+
+int carve_handle_carve_input(
+     carve_handle_t *carve_handle,
+     libcerror_error_t **error );
+
+int carve_handle_carve_input_items(
+     carve_handle_t *carve_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _CARVE_HANDLE_H ) */
+
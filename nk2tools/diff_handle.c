@@ -0,0 +1,1074 @@
+/*
+ * Diff handle
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "diff_handle.h"
+#include "nk2input.h"
+#include "nk2tools_libcerror.h"
+#include "nk2tools_libnk2.h"
+#include "nk2tools_unused.h"
+
+#define DIFF_HANDLE_NOTIFY_STREAM	stdout
+
+/* Creates a diff handle
+ * Make sure the value diff_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int diff_handle_initialize(
+     diff_handle_t **diff_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "diff_handle_initialize";
+
+	if( diff_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid diff handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *diff_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid diff handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*diff_handle = memory_allocate_structure(
+	                diff_handle_t );
+
+	if( *diff_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create diff handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *diff_handle,
+	     0,
+	     sizeof( diff_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear diff handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libnk2_file_initialize(
+	     &( ( *diff_handle )->input ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input.",
+		 function );
+
+		goto on_error;
+	}
+	if( libnk2_file_initialize(
+	     &( ( *diff_handle )->other_input ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize other input.",
+		 function );
+
+		goto on_error;
+	}
+	( *diff_handle )->ascii_codepage = LIBNK2_CODEPAGE_WINDOWS_1252;
+	( *diff_handle )->notify_stream  = DIFF_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *diff_handle != NULL )
+	{
+		if( ( *diff_handle )->input != NULL )
+		{
+			libnk2_file_free(
+			 &( ( *diff_handle )->input ),
+			 NULL );
+		}
+		memory_free(
+		 *diff_handle );
+
+		*diff_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a diff handle
+ * Returns 1 if successful or -1 on error
+ */
+int diff_handle_free(
+     diff_handle_t **diff_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "diff_handle_free";
+	int result            = 1;
+
+	if( diff_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid diff handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *diff_handle != NULL )
+	{
+		if( ( *diff_handle )->other_input != NULL )
+		{
+			if( libnk2_file_free(
+			     &( ( *diff_handle )->other_input ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free other input.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *diff_handle )->input != NULL )
+		{
+			if( libnk2_file_free(
+			     &( ( *diff_handle )->input ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free input.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *diff_handle );
+
+		*diff_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the diff handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int diff_handle_signal_abort(
+     diff_handle_t *diff_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "diff_handle_signal_abort";
+
+	if( diff_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid diff handle.",
+		 function );
+
+		return( -1 );
+	}
+	diff_handle->abort = 1;
+
+	if( diff_handle->input != NULL )
+	{
+		if( libnk2_file_signal_abort(
+		     diff_handle->input,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( diff_handle->other_input != NULL )
+	{
+		if( libnk2_file_signal_abort(
+		     diff_handle->other_input,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal other input to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the ascii codepage
+ * Returns 1 if successful or -1 on error
+ */
+int diff_handle_set_ascii_codepage(
+     diff_handle_t *diff_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "diff_handle_set_ascii_codepage";
+	int result            = 0;
+
+	if( diff_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid diff handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = nk2input_determine_ascii_codepage(
+	          string,
+	          &( diff_handle->ascii_codepage ),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine ASCII codepage.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Opens the diff handle
+ * Returns 1 if successful or -1 on error
+ */
+int diff_handle_open(
+     diff_handle_t *diff_handle,
+     const system_character_t *filename,
+     const system_character_t *other_filename,
+     libcerror_error_t **error )
+{
+	static char *function = "diff_handle_open";
+
+	if( diff_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid diff handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libnk2_file_set_ascii_codepage(
+	     diff_handle->input,
+	     diff_handle->ascii_codepage,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set ASCII codepage in input.",
+		 function );
+
+		return( -1 );
+	}
+	if( libnk2_file_set_ascii_codepage(
+	     diff_handle->other_input,
+	     diff_handle->ascii_codepage,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set ASCII codepage in other input.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libnk2_file_open_wide(
+	     diff_handle->input,
+	     filename,
+	     LIBNK2_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libnk2_file_open(
+	     diff_handle->input,
+	     filename,
+	     LIBNK2_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libnk2_file_open_wide(
+	     diff_handle->other_input,
+	     other_filename,
+	     LIBNK2_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libnk2_file_open(
+	     diff_handle->other_input,
+	     other_filename,
+	     LIBNK2_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open other input.",
+		 function );
+
+		libnk2_file_close(
+		 diff_handle->input,
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Closes the diff handle
+ * Returns the 0 if succesful or -1 on error
+ */
+int diff_handle_close(
+     diff_handle_t *diff_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "diff_handle_close";
+	int result            = 0;
+
+	if( diff_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid diff handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libnk2_file_close(
+	     diff_handle->other_input,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close other input.",
+		 function );
+
+		result = -1;
+	}
+	if( libnk2_file_close(
+	     diff_handle->input,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Prints the value of a record entry to a stream
+ * Strings are printed as UTF-8, other values as hexadecimal bytes
+ * Returns 1 if successful or -1 on error
+ */
+int diff_handle_record_entry_value_fprint(
+     diff_handle_t *diff_handle,
+     const char *description,
+     libnk2_record_entry_t *record_entry,
+     libcerror_error_t **error )
+{
+	uint8_t *value_data    = NULL;
+	static char *function  = "diff_handle_record_entry_value_fprint";
+	size_t value_data_size = 0;
+	size_t value_offset    = 0;
+	uint32_t value_type    = 0;
+
+	if( diff_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid diff handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libnk2_record_entry_get_value_type(
+	     record_entry,
+	     &value_type,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value type.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( value_type == LIBNK2_VALUE_TYPE_STRING_ASCII )
+	 || ( value_type == LIBNK2_VALUE_TYPE_STRING_UNICODE ) )
+	{
+		if( libnk2_record_entry_get_data_as_utf8_string_size(
+		     record_entry,
+		     &value_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve UTF-8 string size.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		if( libnk2_record_entry_get_data_size(
+		     record_entry,
+		     &value_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data size.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( value_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid value data size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 diff_handle->notify_stream,
+	 "\t\t%s\t: ",
+	 description );
+
+	if( value_data_size > 0 )
+	{
+		value_data = (uint8_t *) memory_allocate(
+		                          sizeof( uint8_t ) * value_data_size );
+
+		if( value_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create value data.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( value_type == LIBNK2_VALUE_TYPE_STRING_ASCII )
+		 || ( value_type == LIBNK2_VALUE_TYPE_STRING_UNICODE ) )
+		{
+			if( libnk2_record_entry_get_data_as_utf8_string(
+			     record_entry,
+			     value_data,
+			     value_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve UTF-8 string.",
+				 function );
+
+				goto on_error;
+			}
+			fprintf(
+			 diff_handle->notify_stream,
+			 "%s",
+			 (char *) value_data );
+		}
+		else
+		{
+			if( libnk2_record_entry_get_data(
+			     record_entry,
+			     value_data,
+			     value_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve data.",
+				 function );
+
+				goto on_error;
+			}
+			for( value_offset = 0;
+			     value_offset < value_data_size;
+			     value_offset++ )
+			{
+				if( value_offset >= DIFF_HANDLE_MAXIMUM_VALUE_DATA_SIZE )
+				{
+					fprintf(
+					 diff_handle->notify_stream,
+					 "..." );
+
+					break;
+				}
+				fprintf(
+				 diff_handle->notify_stream,
+				 "%02" PRIx8 "",
+				 value_data[ value_offset ] );
+			}
+		}
+		memory_free(
+		 value_data );
+
+		value_data = NULL;
+	}
+	fprintf(
+	 diff_handle->notify_stream,
+	 "\n" );
+
+	return( 1 );
+
+on_error:
+	if( value_data != NULL )
+	{
+		memory_free(
+		 value_data );
+	}
+	return( -1 );
+}
+
+/* Prints the display name and email address of an item to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int diff_handle_item_fprint(
+     diff_handle_t *diff_handle,
+     const char *description,
+     libnk2_item_t *item,
+     int item_index,
+     libcerror_error_t **error )
+{
+	libnk2_record_entry_t *record_entry = NULL;
+	static char *function               = "diff_handle_item_fprint";
+	uint32_t value_type                 = 0;
+	int result                          = 0;
+
+	if( diff_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid diff handle.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 diff_handle->notify_stream,
+	 "%s alias: %d\n",
+	 description,
+	 item_index );
+
+	result = libnk2_item_get_entry_by_type(
+	          item,
+	          LIBNK2_ENTRY_TYPE_DISPLAY_NAME,
+	          value_type,
+	          &record_entry,
+	          LIBNK2_ENTRY_VALUE_FLAG_MATCH_ANY_VALUE_TYPE,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve display name record entry.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( diff_handle_record_entry_value_fprint(
+		     diff_handle,
+		     "Display name",
+		     record_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print display name.",
+			 function );
+
+			goto on_error;
+		}
+		if( libnk2_record_entry_free(
+		     &record_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free display name record entry.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	result = libnk2_item_get_entry_by_type(
+	          item,
+	          LIBNK2_ENTRY_TYPE_EMAIL_ADDRESS,
+	          value_type,
+	          &record_entry,
+	          LIBNK2_ENTRY_VALUE_FLAG_MATCH_ANY_VALUE_TYPE,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve email address record entry.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( diff_handle_record_entry_value_fprint(
+		     diff_handle,
+		     "Email address",
+		     record_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print email address.",
+			 function );
+
+			goto on_error;
+		}
+		if( libnk2_record_entry_free(
+		     &record_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free email address record entry.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( record_entry != NULL )
+	{
+		libnk2_record_entry_free(
+		 &record_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Prints an added item
+ * Callback for libnk2_file_diff
+ * Returns 1 if successful or -1 on error
+ */
+int diff_handle_item_added(
+     libnk2_item_t *item,
+     int item_index,
+     void *callback_data )
+{
+	diff_handle_t *diff_handle = NULL;
+
+	if( callback_data == NULL )
+	{
+		return( -1 );
+	}
+	diff_handle = (diff_handle_t *) callback_data;
+
+	if( diff_handle->abort != 0 )
+	{
+		return( -1 );
+	}
+	if( diff_handle_item_fprint(
+	     diff_handle,
+	     "Added",
+	     item,
+	     item_index,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	fprintf(
+	 diff_handle->notify_stream,
+	 "\n" );
+
+	diff_handle->number_of_added_items += 1;
+
+	return( 1 );
+}
+
+/* Prints a removed item
+ * Callback for libnk2_file_diff
+ * Returns 1 if successful or -1 on error
+ */
+int diff_handle_item_removed(
+     libnk2_item_t *item,
+     int item_index,
+     void *callback_data )
+{
+	diff_handle_t *diff_handle = NULL;
+
+	if( callback_data == NULL )
+	{
+		return( -1 );
+	}
+	diff_handle = (diff_handle_t *) callback_data;
+
+	if( diff_handle->abort != 0 )
+	{
+		return( -1 );
+	}
+	if( diff_handle_item_fprint(
+	     diff_handle,
+	     "Removed",
+	     item,
+	     item_index,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	fprintf(
+	 diff_handle->notify_stream,
+	 "\n" );
+
+	diff_handle->number_of_removed_items += 1;
+
+	return( 1 );
+}
+
+/* Prints a modified item
+ * Callback for libnk2_file_diff
+ * Returns 1 if successful or -1 on error
+ */
+int diff_handle_item_modified(
+     libnk2_item_t *item NK2TOOLS_ATTRIBUTE_UNUSED,
+     int item_index,
+     libnk2_item_t *other_item NK2TOOLS_ATTRIBUTE_UNUSED,
+     int other_item_index,
+     void *callback_data )
+{
+	diff_handle_t *diff_handle = NULL;
+
+	NK2TOOLS_UNREFERENCED_PARAMETER( item )
+	NK2TOOLS_UNREFERENCED_PARAMETER( other_item )
+
+	if( callback_data == NULL )
+	{
+		return( -1 );
+	}
+	diff_handle = (diff_handle_t *) callback_data;
+
+	if( diff_handle->abort != 0 )
+	{
+		return( -1 );
+	}
+	fprintf(
+	 diff_handle->notify_stream,
+	 "Modified alias: %d (other alias: %d)\n",
+	 item_index,
+	 other_item_index );
+
+	diff_handle->number_of_modified_items += 1;
+
+	return( 1 );
+}
+
+/* Prints a changed record entry
+ * Callback for libnk2_file_diff
+ * Returns 1 if successful or -1 on error
+ */
+int diff_handle_entry_changed(
+     libnk2_record_entry_t *record_entry,
+     libnk2_record_entry_t *other_record_entry,
+     void *callback_data )
+{
+	diff_handle_t *diff_handle = NULL;
+	const char *change         = NULL;
+	uint32_t entry_type        = 0;
+
+	if( callback_data == NULL )
+	{
+		return( -1 );
+	}
+	diff_handle = (diff_handle_t *) callback_data;
+
+	if( diff_handle->abort != 0 )
+	{
+		return( -1 );
+	}
+	if( record_entry == NULL )
+	{
+		change = "added";
+	}
+	else if( other_record_entry == NULL )
+	{
+		change = "removed";
+	}
+	else
+	{
+		change = "changed";
+	}
+	if( libnk2_record_entry_get_entry_type(
+	     ( record_entry != NULL ) ? record_entry : other_record_entry,
+	     &entry_type,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	fprintf(
+	 diff_handle->notify_stream,
+	 "\tEntry type: 0x%04" PRIx32 " %s\n",
+	 entry_type,
+	 change );
+
+	if( record_entry != NULL )
+	{
+		if( diff_handle_record_entry_value_fprint(
+		     diff_handle,
+		     "Old value",
+		     record_entry,
+		     NULL ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	if( other_record_entry != NULL )
+	{
+		if( diff_handle_record_entry_value_fprint(
+		     diff_handle,
+		     "New value",
+		     other_record_entry,
+		     NULL ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	diff_handle->number_of_changed_entries += 1;
+
+	return( 1 );
+}
+
+/* Prints the differences between the input and the other input to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int diff_handle_diff_fprint(
+     diff_handle_t *diff_handle,
+     libcerror_error_t **error )
+{
+	libnk2_diff_callbacks_t callbacks;
+
+	static char *function = "diff_handle_diff_fprint";
+
+	if( diff_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid diff handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &callbacks,
+	     0,
+	     sizeof( libnk2_diff_callbacks_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear callbacks.",
+		 function );
+
+		return( -1 );
+	}
+	callbacks.item_added    = &diff_handle_item_added;
+	callbacks.item_removed  = &diff_handle_item_removed;
+	callbacks.item_modified = &diff_handle_item_modified;
+	callbacks.entry_changed = &diff_handle_entry_changed;
+
+	diff_handle->number_of_added_items     = 0;
+	diff_handle->number_of_removed_items   = 0;
+	diff_handle->number_of_modified_items  = 0;
+	diff_handle->number_of_changed_entries = 0;
+
+	fprintf(
+	 diff_handle->notify_stream,
+	 "Nickfile differences:\n\n" );
+
+	if( libnk2_file_diff(
+	     diff_handle->input,
+	     diff_handle->other_input,
+	     &callbacks,
+	     (void *) diff_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to diff input with other input.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 diff_handle->notify_stream,
+	 "Summary:\n" );
+
+	fprintf(
+	 diff_handle->notify_stream,
+	 "\tNumber of added aliases\t\t: %d\n",
+	 diff_handle->number_of_added_items );
+
+	fprintf(
+	 diff_handle->notify_stream,
+	 "\tNumber of removed aliases\t: %d\n",
+	 diff_handle->number_of_removed_items );
+
+	fprintf(
+	 diff_handle->notify_stream,
+	 "\tNumber of modified aliases\t: %d\n",
+	 diff_handle->number_of_modified_items );
+
+	fprintf(
+	 diff_handle->notify_stream,
+	 "\tNumber of changed entries\t: %d\n",
+	 diff_handle->number_of_changed_entries );
+
+	fprintf(
+	 diff_handle->notify_stream,
+	 "\n" );
+
+	return( 1 );
+}
+
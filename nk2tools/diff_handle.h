@@ -0,0 +1,152 @@
+/*
+ * Diff handle
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _DIFF_HANDLE_H )
+#define _DIFF_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "nk2tools_libcerror.h"
+#include "nk2tools_libnk2.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The maximum number of bytes of a non-string value that is printed
+ */
+#define DIFF_HANDLE_MAXIMUM_VALUE_DATA_SIZE	32
+
+typedef struct diff_handle diff_handle_t;
+
+struct diff_handle
+{
+	/* The input
+	 */
+	libnk2_file_t *input;
+
+	/* The other input
+	 */
+	libnk2_file_t *other_input;
+
+	/* The ascii codepage
+	 */
+	int ascii_codepage;
+
+	/* The number of added items
+	 */
+	int number_of_added_items;
+
+	/* The number of removed items
+	 */
+	int number_of_removed_items;
+
+	/* The number of modified items
+	 */
+	int number_of_modified_items;
+
+	/* The number of changed record entries
+	 */
+	int number_of_changed_entries;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int diff_handle_initialize(
+     diff_handle_t **diff_handle,
+     libcerror_error_t **error );
+
+int diff_handle_free(
+     diff_handle_t **diff_handle,
+     libcerror_error_t **error );
+
+int diff_handle_signal_abort(
+     diff_handle_t *diff_handle,
+     libcerror_error_t **error );
+
+int diff_handle_set_ascii_codepage(
+     diff_handle_t *diff_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int diff_handle_open(
+     diff_handle_t *diff_handle,
+     const system_character_t *filename,
+     const system_character_t *other_filename,
+     libcerror_error_t **error );
+
+int diff_handle_close(
+     diff_handle_t *diff_handle,
+     libcerror_error_t **error );
+
+int diff_handle_record_entry_value_fprint(
+     diff_handle_t *diff_handle,
+     const char *description,
+     libnk2_record_entry_t *record_entry,
+     libcerror_error_t **error );
+
+int diff_handle_item_fprint(
+     diff_handle_t *diff_handle,
+     const char *description,
+     libnk2_item_t *item,
+     int item_index,
+     libcerror_error_t **error );
+
+int diff_handle_item_added(
+     libnk2_item_t *item,
+     int item_index,
+     void *callback_data );
+
+int diff_handle_item_removed(
+     libnk2_item_t *item,
+     int item_index,
+     void *callback_data );
+
+int diff_handle_item_modified(
+     libnk2_item_t *item,
+     int item_index,
+     libnk2_item_t *other_item,
+     int other_item_index,
+     void *callback_data );
+
+int diff_handle_entry_changed(
+     libnk2_record_entry_t *record_entry,
+     libnk2_record_entry_t *other_record_entry,
+     void *callback_data );
+
+int diff_handle_diff_fprint(
+     diff_handle_t *diff_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _DIFF_HANDLE_H ) */
+
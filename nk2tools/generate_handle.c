@@ -0,0 +1,1390 @@
+/*
+ * Generate handle
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "generate_handle.h"
+#include "nk2input.h"
+#include "nk2tools_libcerror.h"
+#include "nk2tools_libcfile.h"
+#include "nk2tools_libnk2.h"
+
+#define GENERATE_HANDLE_NOTIFY_STREAM		stdout
+
+/* The maximum number of record entries per item
+ */
+#define GENERATE_HANDLE_MAXIMUM_NUMBER_OF_ENTRIES	65535
+
+/* The maximum size of variable size values
+ */
+#define GENERATE_HANDLE_MAXIMUM_VALUE_SIZE		65536
+
+/* The size of a record entry
+ */
+#define GENERATE_HANDLE_RECORD_ENTRY_SIZE		16
+
+/* The entry and value types of the first record entries of every item
+ * these resemble the entries found in Outlook generated nickfiles
+ */
+static uint16_t generate_handle_default_entries[ 12 ][ 2 ] = {
+	{ 0x3001, LIBNK2_VALUE_TYPE_STRING_UNICODE },
+	{ 0x3003, LIBNK2_VALUE_TYPE_STRING_ASCII },
+	{ 0x3002, LIBNK2_VALUE_TYPE_STRING_ASCII },
+	{ 0x39fe, LIBNK2_VALUE_TYPE_STRING_UNICODE },
+	{ 0x0fff, LIBNK2_VALUE_TYPE_BINARY_DATA },
+	{ 0x3a00, LIBNK2_VALUE_TYPE_STRING_UNICODE },
+	{ 0x0ffe, LIBNK2_VALUE_TYPE_INTEGER_32BIT_SIGNED },
+	{ 0x3900, LIBNK2_VALUE_TYPE_INTEGER_32BIT_SIGNED },
+	{ 0x6001, LIBNK2_VALUE_TYPE_INTEGER_32BIT_SIGNED },
+	{ 0x6002, LIBNK2_VALUE_TYPE_BINARY_DATA },
+	{ 0x6003, LIBNK2_VALUE_TYPE_BOOLEAN },
+	{ 0x300b, LIBNK2_VALUE_TYPE_BINARY_DATA } };
+
+/* The value types of the remaining record entries
+ */
+static uint16_t generate_handle_value_types[ 9 ] = {
+	LIBNK2_VALUE_TYPE_INTEGER_16BIT_SIGNED,
+	LIBNK2_VALUE_TYPE_INTEGER_32BIT_SIGNED,
+	LIBNK2_VALUE_TYPE_DOUBLE_64BIT,
+	LIBNK2_VALUE_TYPE_BOOLEAN,
+	LIBNK2_VALUE_TYPE_INTEGER_64BIT_SIGNED,
+	LIBNK2_VALUE_TYPE_FILETIME,
+	LIBNK2_VALUE_TYPE_STRING_ASCII,
+	LIBNK2_VALUE_TYPE_STRING_UNICODE,
+	LIBNK2_VALUE_TYPE_BINARY_DATA };
+
+/* Creates a generate handle
+ * Make sure the value generate_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_initialize(
+     generate_handle_t **generate_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_initialize";
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *generate_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid generate handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*generate_handle = memory_allocate_structure(
+	                    generate_handle_t );
+
+	if( *generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create generate handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *generate_handle,
+	     0,
+	     sizeof( generate_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear generate handle.",
+		 function );
+
+		memory_free(
+		 *generate_handle );
+
+		*generate_handle = NULL;
+
+		return( -1 );
+	}
+	( *generate_handle )->write_buffer = (uint8_t *) memory_allocate(
+	                                                  sizeof( uint8_t ) * GENERATE_HANDLE_WRITE_BUFFER_SIZE );
+
+	if( ( *generate_handle )->write_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create write buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_initialize(
+	     &( ( *generate_handle )->file_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *generate_handle )->number_of_items            = 100;
+	( *generate_handle )->number_of_entries_per_item = 16;
+	( *generate_handle )->maximum_value_size         = 64;
+	( *generate_handle )->notify_stream              = GENERATE_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *generate_handle != NULL )
+	{
+		if( ( *generate_handle )->write_buffer != NULL )
+		{
+			memory_free(
+			 ( *generate_handle )->write_buffer );
+		}
+		memory_free(
+		 *generate_handle );
+
+		*generate_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a generate handle
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_free(
+     generate_handle_t **generate_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_free";
+	int result            = 1;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *generate_handle != NULL )
+	{
+		if( libcfile_file_free(
+		     &( ( *generate_handle )->file_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file handle.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *generate_handle )->write_buffer );
+
+		memory_free(
+		 *generate_handle );
+
+		*generate_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the generate handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_signal_abort(
+     generate_handle_t *generate_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_signal_abort";
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	generate_handle->abort = 1;
+
+	return( 1 );
+}
+
+/* Sets the number of items
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int generate_handle_set_number_of_items(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_set_number_of_items";
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = nk2input_determine_decimal_value(
+	          string,
+	          &value_64bit,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine number of items.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( result != 0 )
+	 && ( value_64bit <= (uint64_t) UINT32_MAX ) )
+	{
+		generate_handle->number_of_items = (uint32_t) value_64bit;
+
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Sets the number of record entries per item
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int generate_handle_set_number_of_entries_per_item(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_set_number_of_entries_per_item";
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = nk2input_determine_decimal_value(
+	          string,
+	          &value_64bit,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine number of entries per item.",
+		 function );
+
+		return( -1 );
+	}
+	/* An item without record entries would terminate the items
+	 */
+	if( ( result != 0 )
+	 && ( value_64bit >= 1 )
+	 && ( value_64bit <= GENERATE_HANDLE_MAXIMUM_NUMBER_OF_ENTRIES ) )
+	{
+		generate_handle->number_of_entries_per_item = (uint32_t) value_64bit;
+
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Sets the maximum size of variable size values
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int generate_handle_set_maximum_value_size(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_set_maximum_value_size";
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = nk2input_determine_decimal_value(
+	          string,
+	          &value_64bit,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine maximum value size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( result != 0 )
+	 && ( value_64bit >= 1 )
+	 && ( value_64bit <= GENERATE_HANDLE_MAXIMUM_VALUE_SIZE ) )
+	{
+		generate_handle->maximum_value_size = (uint32_t) value_64bit;
+
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Sets the seed of the pseudo random generator
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int generate_handle_set_seed(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_set_seed";
+	int result            = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = nk2input_determine_decimal_value(
+	          string,
+	          &( generate_handle->seed ),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine seed.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Sets the malformed type
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int generate_handle_set_malformed_type(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_set_malformed_type";
+	size_t string_length  = 0;
+	int result            = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( string_length == 4 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "none" ),
+		     4 ) == 0 )
+		{
+			generate_handle->malformed_type = GENERATE_HANDLE_MALFORMED_TYPE_NONE;
+			result                          = 1;
+		}
+	}
+	else if( string_length == 9 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "signature" ),
+		     9 ) == 0 )
+		{
+			generate_handle->malformed_type = GENERATE_HANDLE_MALFORMED_TYPE_SIGNATURE;
+			result                          = 1;
+		}
+		else if( system_string_compare(
+		          string,
+		          _SYSTEM_STRING( "truncated" ),
+		          9 ) == 0 )
+		{
+			generate_handle->malformed_type = GENERATE_HANDLE_MALFORMED_TYPE_TRUNCATED;
+			result                          = 1;
+		}
+	}
+	else if( string_length == 10 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "value_size" ),
+		     10 ) == 0 )
+		{
+			generate_handle->malformed_type = GENERATE_HANDLE_MALFORMED_TYPE_VALUE_SIZE;
+			result                          = 1;
+		}
+		else if( system_string_compare(
+		          string,
+		          _SYSTEM_STRING( "value_type" ),
+		          10 ) == 0 )
+		{
+			generate_handle->malformed_type = GENERATE_HANDLE_MALFORMED_TYPE_VALUE_TYPE;
+			result                          = 1;
+		}
+	}
+	else if( string_length == 15 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "number_of_items" ),
+		     15 ) == 0 )
+		{
+			generate_handle->malformed_type = GENERATE_HANDLE_MALFORMED_TYPE_NUMBER_OF_ITEMS;
+			result                          = 1;
+		}
+	}
+	else if( string_length == 17 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "number_of_entries" ),
+		     17 ) == 0 )
+		{
+			generate_handle->malformed_type = GENERATE_HANDLE_MALFORMED_TYPE_NUMBER_OF_ENTRIES;
+			result                          = 1;
+		}
+	}
+	return( result );
+}
+
+/* Opens the output file
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_open(
+     generate_handle_t *generate_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_open";
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcfile_file_open_wide(
+	     generate_handle->file_handle,
+	     filename,
+	     LIBCFILE_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+#else
+	if( libcfile_file_open(
+	     generate_handle->file_handle,
+	     filename,
+	     LIBCFILE_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file handle.",
+		 function );
+
+		return( -1 );
+	}
+	generate_handle->write_buffer_offset     = 0;
+	generate_handle->number_of_bytes_written = 0;
+
+	return( 1 );
+}
+
+/* Closes the output file
+ * Returns the 0 if succesful or -1 on error
+ */
+int generate_handle_close(
+     generate_handle_t *generate_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_close";
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcfile_file_close(
+	     generate_handle->file_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/* Retrieves a pseudo random value
+ * This uses the SplitMix64 generator so the output only depends on the seed
+ * Returns a value in the range 0 to maximum value - 1, or 0 if the maximum value is 0
+ */
+uint32_t generate_handle_get_random_value(
+          generate_handle_t *generate_handle,
+          uint32_t maximum_value )
+{
+	uint64_t value_64bit = 0;
+
+	if( generate_handle == NULL )
+	{
+		return( 0 );
+	}
+	generate_handle->random_state += 0x9e3779b97f4a7c15ULL;
+
+	value_64bit = generate_handle->random_state;
+	value_64bit = ( value_64bit ^ ( value_64bit >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+	value_64bit = ( value_64bit ^ ( value_64bit >> 27 ) ) * 0x94d049bb133111ebULL;
+	value_64bit = value_64bit ^ ( value_64bit >> 31 );
+
+	if( maximum_value == 0 )
+	{
+		return( 0 );
+	}
+	return( (uint32_t) ( value_64bit % maximum_value ) );
+}
+
+/* Writes a buffer to the output file using the write buffer
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_write_buffer(
+     generate_handle_t *generate_handle,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_write_buffer";
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) GENERATE_HANDLE_WRITE_BUFFER_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > ( GENERATE_HANDLE_WRITE_BUFFER_SIZE - generate_handle->write_buffer_offset ) )
+	{
+		if( generate_handle_flush(
+		     generate_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush write buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( memory_copy(
+	     &( generate_handle->write_buffer[ generate_handle->write_buffer_offset ] ),
+	     buffer,
+	     buffer_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy buffer.",
+		 function );
+
+		return( -1 );
+	}
+	generate_handle->write_buffer_offset += buffer_size;
+
+	return( 1 );
+}
+
+/* Flushes the write buffer to the output file
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_flush(
+     generate_handle_t *generate_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_flush";
+	ssize_t write_count   = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( generate_handle->write_buffer_offset == 0 )
+	{
+		return( 1 );
+	}
+	write_count = libcfile_file_write_buffer(
+	               generate_handle->file_handle,
+	               generate_handle->write_buffer,
+	               generate_handle->write_buffer_offset,
+	               error );
+
+	if( write_count != (ssize_t) generate_handle->write_buffer_offset )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write buffer to file handle.",
+		 function );
+
+		return( -1 );
+	}
+	generate_handle->number_of_bytes_written += generate_handle->write_buffer_offset;
+	generate_handle->write_buffer_offset      = 0;
+
+	return( 1 );
+}
+
+/* Writes the file header
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_write_file_header(
+     generate_handle_t *generate_handle,
+     libcerror_error_t **error )
+{
+	uint8_t file_header_data[ 16 ] = {
+		0x0d, 0xf0, 0xad, 0xba, 0x0a, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+	static char *function          = "generate_handle_write_file_header";
+	uint32_t number_of_items       = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_items = generate_handle->number_of_items;
+
+	if( generate_handle->malformed_type == GENERATE_HANDLE_MALFORMED_TYPE_SIGNATURE )
+	{
+		file_header_data[ generate_handle_get_random_value( generate_handle, 4 ) ] ^= 0xff;
+	}
+	else if( generate_handle->malformed_type == GENERATE_HANDLE_MALFORMED_TYPE_NUMBER_OF_ITEMS )
+	{
+		number_of_items = 0x7fffffffUL;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 &( file_header_data[ 12 ] ),
+	 number_of_items );
+
+	if( generate_handle_write_buffer(
+	     generate_handle,
+	     file_header_data,
+	     16,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file header.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Writes a record entry
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_write_record_entry(
+     generate_handle_t *generate_handle,
+     uint32_t item_index,
+     uint32_t entry_index,
+     libcerror_error_t **error )
+{
+	uint8_t value_data[ 128 ];
+	uint8_t record_entry_data[ GENERATE_HANDLE_RECORD_ENTRY_SIZE ];
+
+	static char *function        = "generate_handle_write_record_entry";
+	size_t value_data_index      = 0;
+	uint32_t data_index          = 0;
+	uint32_t number_of_elements  = 0;
+	uint32_t stored_value_size   = 0;
+	uint32_t value_size          = 0;
+	uint32_t random_value        = 0;
+	uint16_t character_value     = 0;
+	uint16_t entry_type          = 0;
+	uint16_t value_type          = 0;
+	uint8_t is_malformed         = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( item_index == generate_handle->malformed_item_index )
+	 && ( entry_index == 0 ) )
+	{
+		is_malformed = 1;
+	}
+	if( entry_index < 12 )
+	{
+		entry_type = generate_handle_default_entries[ entry_index ][ 0 ];
+		value_type = generate_handle_default_entries[ entry_index ][ 1 ];
+	}
+	else
+	{
+		entry_type = (uint16_t) ( 0x6100 + ( entry_index % 0x1000 ) );
+		value_type = generate_handle_value_types[ generate_handle_get_random_value( generate_handle, 9 ) ];
+	}
+	if( memory_set(
+	     record_entry_data,
+	     0,
+	     GENERATE_HANDLE_RECORD_ENTRY_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear record entry data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( is_malformed != 0 )
+	 && ( generate_handle->malformed_type == GENERATE_HANDLE_MALFORMED_TYPE_VALUE_TYPE ) )
+	{
+		byte_stream_copy_from_uint16_little_endian(
+		 record_entry_data,
+		 0x0fff );
+	}
+	else
+	{
+		byte_stream_copy_from_uint16_little_endian(
+		 record_entry_data,
+		 value_type );
+	}
+	byte_stream_copy_from_uint16_little_endian(
+	 &( record_entry_data[ 2 ] ),
+	 entry_type );
+
+	switch( value_type )
+	{
+		case LIBNK2_VALUE_TYPE_BOOLEAN:
+			record_entry_data[ 8 ] = (uint8_t) generate_handle_get_random_value(
+			                                    generate_handle,
+			                                    2 );
+			break;
+
+		case LIBNK2_VALUE_TYPE_INTEGER_16BIT_SIGNED:
+		case LIBNK2_VALUE_TYPE_INTEGER_32BIT_SIGNED:
+			byte_stream_copy_from_uint32_little_endian(
+			 &( record_entry_data[ 8 ] ),
+			 generate_handle_get_random_value(
+			  generate_handle,
+			  0xffffffffUL ) );
+			break;
+
+		case LIBNK2_VALUE_TYPE_DOUBLE_64BIT:
+		case LIBNK2_VALUE_TYPE_INTEGER_64BIT_SIGNED:
+		case LIBNK2_VALUE_TYPE_FILETIME:
+			byte_stream_copy_from_uint32_little_endian(
+			 &( record_entry_data[ 8 ] ),
+			 generate_handle_get_random_value(
+			  generate_handle,
+			  0xffffffffUL ) );
+
+			/* Keep the upper part of the value in a range plausible for a filetime
+			 */
+			byte_stream_copy_from_uint32_little_endian(
+			 &( record_entry_data[ 12 ] ),
+			 0x01c00000UL + generate_handle_get_random_value(
+			                 generate_handle,
+			                 0x00200000UL ) );
+			break;
+
+		case LIBNK2_VALUE_TYPE_STRING_ASCII:
+		case LIBNK2_VALUE_TYPE_BINARY_DATA:
+			value_size = 1 + generate_handle_get_random_value(
+			                  generate_handle,
+			                  generate_handle->maximum_value_size );
+			break;
+
+		case LIBNK2_VALUE_TYPE_STRING_UNICODE:
+			value_size = 2 * ( 1 + generate_handle_get_random_value(
+			                        generate_handle,
+			                        ( generate_handle->maximum_value_size + 1 ) / 2 ) );
+			break;
+
+		default:
+			break;
+	}
+	if( generate_handle_write_buffer(
+	     generate_handle,
+	     record_entry_data,
+	     GENERATE_HANDLE_RECORD_ENTRY_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write record entry data.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_size == 0 )
+	{
+		return( 1 );
+	}
+	stored_value_size = value_size;
+
+	if( ( is_malformed != 0 )
+	 && ( generate_handle->malformed_type == GENERATE_HANDLE_MALFORMED_TYPE_VALUE_SIZE ) )
+	{
+		stored_value_size = 0x7ffffff0UL;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 value_data,
+	 stored_value_size );
+
+	if( generate_handle_write_buffer(
+	     generate_handle,
+	     value_data,
+	     4,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write value data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_type == LIBNK2_VALUE_TYPE_STRING_UNICODE )
+	{
+		number_of_elements = value_size / 2;
+	}
+	else
+	{
+		number_of_elements = value_size;
+	}
+	for( data_index = 0;
+	     data_index < number_of_elements;
+	     data_index++ )
+	{
+		random_value = generate_handle_get_random_value(
+		                generate_handle,
+		                100 );
+
+		switch( value_type )
+		{
+			case LIBNK2_VALUE_TYPE_STRING_ASCII:
+				if( data_index == ( number_of_elements - 1 ) )
+				{
+					value_data[ value_data_index++ ] = 0;
+				}
+				else if( random_value < 90 )
+				{
+					value_data[ value_data_index++ ] = (uint8_t) ( 'a' + ( random_value % 26 ) );
+				}
+				else
+				{
+					/* Extended ASCII characters in the Windows 1252 range
+					 */
+					value_data[ value_data_index++ ] = (uint8_t) ( 0xc0 + ( random_value % 0x40 ) );
+				}
+				break;
+
+			case LIBNK2_VALUE_TYPE_STRING_UNICODE:
+				if( data_index == ( number_of_elements - 1 ) )
+				{
+					character_value = 0;
+				}
+				else if( random_value < 70 )
+				{
+					character_value = (uint16_t) ( 'A' + ( random_value % 26 ) );
+				}
+				else if( random_value < 90 )
+				{
+					character_value = (uint16_t) ( 0x00c0 + ( random_value % 0x40 ) );
+				}
+				else
+				{
+					/* Cyrillic characters
+					 */
+					character_value = (uint16_t) ( 0x0410 + ( random_value % 0x40 ) );
+				}
+				byte_stream_copy_from_uint16_little_endian(
+				 &( value_data[ value_data_index ] ),
+				 character_value );
+
+				value_data_index += 2;
+
+				break;
+
+			default:
+				value_data[ value_data_index++ ] = (uint8_t) generate_handle_get_random_value(
+				                                              generate_handle,
+				                                              256 );
+				break;
+		}
+		if( ( value_data_index >= ( sizeof( value_data ) - 2 ) )
+		 || ( data_index == ( number_of_elements - 1 ) ) )
+		{
+			if( generate_handle_write_buffer(
+			     generate_handle,
+			     value_data,
+			     value_data_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write value data.",
+				 function );
+
+				return( -1 );
+			}
+			value_data_index = 0;
+		}
+	}
+	return( 1 );
+}
+
+/* Writes an item
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_write_item(
+     generate_handle_t *generate_handle,
+     uint32_t item_index,
+     libcerror_error_t **error )
+{
+	uint8_t number_of_entries_data[ 4 ];
+
+	static char *function      = "generate_handle_write_item";
+	uint32_t entry_index       = 0;
+	uint32_t number_of_entries = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_entries = generate_handle->number_of_entries_per_item;
+
+	if( ( item_index == generate_handle->malformed_item_index )
+	 && ( generate_handle->malformed_type == GENERATE_HANDLE_MALFORMED_TYPE_NUMBER_OF_ENTRIES ) )
+	{
+		byte_stream_copy_from_uint32_little_endian(
+		 number_of_entries_data,
+		 0x00ffffffUL );
+	}
+	else
+	{
+		byte_stream_copy_from_uint32_little_endian(
+		 number_of_entries_data,
+		 number_of_entries );
+	}
+	if( generate_handle_write_buffer(
+	     generate_handle,
+	     number_of_entries_data,
+	     4,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write item: %" PRIu32 " number of record entries.",
+		 function,
+		 item_index );
+
+		return( -1 );
+	}
+	/* A truncated file ends halfway the record entries of the malformed item
+	 */
+	if( ( item_index == generate_handle->malformed_item_index )
+	 && ( generate_handle->malformed_type == GENERATE_HANDLE_MALFORMED_TYPE_TRUNCATED ) )
+	{
+		number_of_entries /= 2;
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( generate_handle_write_record_entry(
+		     generate_handle,
+		     item_index,
+		     entry_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write item: %" PRIu32 " record entry: %" PRIu32 ".",
+			 function,
+			 item_index,
+			 entry_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Writes the file footer
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_write_file_footer(
+     generate_handle_t *generate_handle,
+     libcerror_error_t **error )
+{
+	uint8_t file_footer_data[ 12 ];
+
+	static char *function = "generate_handle_write_file_footer";
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 file_footer_data,
+	 0 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( file_footer_data[ 4 ] ),
+	 generate_handle_get_random_value(
+	  generate_handle,
+	  0xffffffffUL ) );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( file_footer_data[ 8 ] ),
+	 0x01d00000UL + generate_handle_get_random_value(
+	                 generate_handle,
+	                 0x00100000UL ) );
+
+	if( generate_handle_write_buffer(
+	     generate_handle,
+	     file_footer_data,
+	     12,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file footer.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Generates the NK2 file
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_generate(
+     generate_handle_t *generate_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_generate";
+	uint32_t item_index   = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	generate_handle->random_state = generate_handle->seed;
+
+	if( generate_handle->malformed_type == GENERATE_HANDLE_MALFORMED_TYPE_NONE )
+	{
+		generate_handle->malformed_item_index = generate_handle->number_of_items;
+	}
+	else
+	{
+		generate_handle->malformed_item_index = generate_handle_get_random_value(
+		                                         generate_handle,
+		                                         generate_handle->number_of_items );
+	}
+	if( generate_handle_write_file_header(
+	     generate_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file header.",
+		 function );
+
+		return( -1 );
+	}
+	for( item_index = 0;
+	     item_index < generate_handle->number_of_items;
+	     item_index++ )
+	{
+		if( generate_handle->abort != 0 )
+		{
+			break;
+		}
+		if( generate_handle_write_item(
+		     generate_handle,
+		     item_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write item: %" PRIu32 ".",
+			 function,
+			 item_index );
+
+			return( -1 );
+		}
+		if( ( item_index == generate_handle->malformed_item_index )
+		 && ( generate_handle->malformed_type == GENERATE_HANDLE_MALFORMED_TYPE_TRUNCATED ) )
+		{
+			break;
+		}
+	}
+	if( ( generate_handle->abort == 0 )
+	 && ( generate_handle->malformed_type != GENERATE_HANDLE_MALFORMED_TYPE_TRUNCATED ) )
+	{
+		if( generate_handle_write_file_footer(
+		     generate_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write file footer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( generate_handle_flush(
+	     generate_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush write buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( generate_handle->abort != 0 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,196 @@
+/*
+ * Generate handle
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _GENERATE_HANDLE_H )
+#define _GENERATE_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "nk2tools_libcerror.h"
+#include "nk2tools_libcfile.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The size of the write buffer
+ */
+#define GENERATE_HANDLE_WRITE_BUFFER_SIZE	( 1024 * 1024 )
+
+enum GENERATE_HANDLE_MALFORMED_TYPES
+{
+	GENERATE_HANDLE_MALFORMED_TYPE_NONE		= 0,
+	GENERATE_HANDLE_MALFORMED_TYPE_SIGNATURE,
+	GENERATE_HANDLE_MALFORMED_TYPE_NUMBER_OF_ITEMS,
+	GENERATE_HANDLE_MALFORMED_TYPE_NUMBER_OF_ENTRIES,
+	GENERATE_HANDLE_MALFORMED_TYPE_VALUE_SIZE,
+	GENERATE_HANDLE_MALFORMED_TYPE_VALUE_TYPE,
+	GENERATE_HANDLE_MALFORMED_TYPE_TRUNCATED
+};
+
+typedef struct generate_handle generate_handle_t;
+
+struct generate_handle
+{
+	/* The number of items
+	 */
+	uint32_t number_of_items;
+
+	/* The number of record entries per item
+	 */
+	uint32_t number_of_entries_per_item;
+
+	/* The maximum size of variable size values
+	 */
+	uint32_t maximum_value_size;
+
+	/* The seed of the pseudo random generator
+	 */
+	uint64_t seed;
+
+	/* The state of the pseudo random generator
+	 */
+	uint64_t random_state;
+
+	/* The malformed type
+	 */
+	int malformed_type;
+
+	/* The index of the item that is malformed
+	 */
+	uint32_t malformed_item_index;
+
+	/* The output file handle
+	 */
+	libcfile_file_t *file_handle;
+
+	/* The write buffer
+	 */
+	uint8_t *write_buffer;
+
+	/* The write buffer offset
+	 */
+	size_t write_buffer_offset;
+
+	/* The number of bytes written
+	 */
+	uint64_t number_of_bytes_written;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int generate_handle_initialize(
+     generate_handle_t **generate_handle,
+     libcerror_error_t **error );
+
+int generate_handle_free(
+     generate_handle_t **generate_handle,
+     libcerror_error_t **error );
+
+int generate_handle_signal_abort(
+     generate_handle_t *generate_handle,
+     libcerror_error_t **error );
+
+int generate_handle_set_number_of_items(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int generate_handle_set_number_of_entries_per_item(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int generate_handle_set_maximum_value_size(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int generate_handle_set_seed(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int generate_handle_set_malformed_type(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int generate_handle_open(
+     generate_handle_t *generate_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int generate_handle_close(
+     generate_handle_t *generate_handle,
+     libcerror_error_t **error );
+
+uint32_t generate_handle_get_random_value(
+          generate_handle_t *generate_handle,
+          uint32_t maximum_value );
+
+int generate_handle_write_buffer(
+     generate_handle_t *generate_handle,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int generate_handle_flush(
+     generate_handle_t *generate_handle,
+     libcerror_error_t **error );
+
+int generate_handle_write_file_header(
+     generate_handle_t *generate_handle,
+     libcerror_error_t **error );
+
+int generate_handle_write_record_entry(
+     generate_handle_t *generate_handle,
+     uint32_t item_index,
+     uint32_t entry_index,
+     libcerror_error_t **error );
+
+int generate_handle_write_item(
+     generate_handle_t *generate_handle,
+     uint32_t item_index,
+     libcerror_error_t **error );
+
+int generate_handle_write_file_footer(
+     generate_handle_t *generate_handle,
+     libcerror_error_t **error );
+
+int generate_handle_generate(
+     generate_handle_t *generate_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _GENERATE_HANDLE_H ) */
+
@@ -0,0 +1,1287 @@
+/*
+ * Merge handle
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "merge_handle.h"
+#include "nk2input.h"
+#include "nk2tools_libcerror.h"
+#include "nk2tools_libcnotify.h"
+#include "nk2tools_libnk2.h"
+
+#define MERGE_HANDLE_NOTIFY_STREAM	stdout
+
+/* Creates a merge handle
+ * Make sure the value merge_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int merge_handle_initialize(
+     merge_handle_t **merge_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "merge_handle_initialize";
+	size_t key_set_size   = 0;
+
+	if( merge_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid merge handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *merge_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid merge handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*merge_handle = memory_allocate_structure(
+	                 merge_handle_t );
+
+	if( *merge_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create merge handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *merge_handle,
+	     0,
+	     sizeof( merge_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear merge handle.",
+		 function );
+
+		memory_free(
+		 *merge_handle );
+
+		*merge_handle = NULL;
+
+		return( -1 );
+	}
+	key_set_size = sizeof( uint64_t ) * MERGE_HANDLE_INITIAL_NUMBER_OF_KEY_SLOTS;
+
+	( *merge_handle )->key_set = (uint64_t *) memory_allocate(
+	                                           key_set_size );
+
+	if( ( *merge_handle )->key_set == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create key set.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *merge_handle )->key_set,
+	     0,
+	     key_set_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear key set.",
+		 function );
+
+		goto on_error;
+	}
+	( *merge_handle )->number_of_key_slots = MERGE_HANDLE_INITIAL_NUMBER_OF_KEY_SLOTS;
+
+	if( libnk2_writer_initialize(
+	     &( ( *merge_handle )->writer ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize writer.",
+		 function );
+
+		goto on_error;
+	}
+	( *merge_handle )->ascii_codepage = LIBNK2_CODEPAGE_WINDOWS_1252;
+	( *merge_handle )->notify_stream  = MERGE_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *merge_handle != NULL )
+	{
+		if( ( *merge_handle )->key_set != NULL )
+		{
+			memory_free(
+			 ( *merge_handle )->key_set );
+		}
+		memory_free(
+		 *merge_handle );
+
+		*merge_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a merge handle
+ * Returns 1 if successful or -1 on error
+ */
+int merge_handle_free(
+     merge_handle_t **merge_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "merge_handle_free";
+	int result            = 1;
+
+	if( merge_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid merge handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *merge_handle != NULL )
+	{
+		if( ( *merge_handle )->input != NULL )
+		{
+			if( libnk2_file_free(
+			     &( ( *merge_handle )->input ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free input.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libnk2_writer_free(
+		     &( ( *merge_handle )->writer ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free writer.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *merge_handle )->key_set );
+
+		memory_free(
+		 *merge_handle );
+
+		*merge_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the merge handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int merge_handle_signal_abort(
+     merge_handle_t *merge_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "merge_handle_signal_abort";
+
+	if( merge_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid merge handle.",
+		 function );
+
+		return( -1 );
+	}
+	merge_handle->abort = 1;
+
+	if( merge_handle->input != NULL )
+	{
+		if( libnk2_file_signal_abort(
+		     merge_handle->input,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( merge_handle->writer != NULL )
+	{
+		if( libnk2_writer_signal_abort(
+		     merge_handle->writer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal writer to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the ascii codepage
+ * Returns 1 if successful or -1 on error
+ */
+int merge_handle_set_ascii_codepage(
+     merge_handle_t *merge_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "merge_handle_set_ascii_codepage";
+	int result            = 0;
+
+	if( merge_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid merge handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = nk2input_determine_ascii_codepage(
+	          string,
+	          &( merge_handle->ascii_codepage ),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine ASCII codepage.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Opens the merge handle, which creates the output file
+ * Returns 1 if successful or -1 on error
+ */
+int merge_handle_open(
+     merge_handle_t *merge_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "merge_handle_open";
+
+	if( merge_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid merge handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libnk2_writer_open_wide(
+	     merge_handle->writer,
+	     filename,
+	     error ) != 1 )
+#else
+	if( libnk2_writer_open(
+	     merge_handle->writer,
+	     filename,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open writer.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Closes the merge handle, which completes the output file
+ * Returns the 0 if succesful or -1 on error
+ */
+int merge_handle_close(
+     merge_handle_t *merge_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "merge_handle_close";
+
+	if( merge_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid merge handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libnk2_writer_set_modification_time(
+	     merge_handle->writer,
+	     merge_handle->modification_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set modification time in writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( libnk2_writer_close(
+	     merge_handle->writer,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close writer.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/* Updates a 64-bit FNV-1a hash of key data
+ * Returns the updated hash
+ */
+uint64_t merge_handle_hash_key_data(
+          uint64_t hash,
+          const uint8_t *data,
+          size_t data_size )
+{
+	size_t data_offset = 0;
+
+	if( data == NULL )
+	{
+		return( hash );
+	}
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset++ )
+	{
+		hash ^= data[ data_offset ];
+		hash *= 0x00000100000001b3ULL;
+	}
+	return( hash );
+}
+
+/* Determines the deduplication key of an item
+ * The key is a hash of the normalized email address or, if the item has
+ * no email address, a hash of the entry identifier
+ * Returns 1 if successful, 0 if the item has no key or -1 on error
+ */
+int merge_handle_get_item_key(
+     merge_handle_t *merge_handle,
+     libnk2_item_t *item,
+     uint64_t *key,
+     libcerror_error_t **error )
+{
+	uint8_t key_prefix[ 1 ];
+
+	libnk2_record_entry_t *record_entry = NULL;
+	uint8_t *key_data                   = NULL;
+	static char *function               = "merge_handle_get_item_key";
+	size_t key_data_end                 = 0;
+	size_t key_data_offset              = 0;
+	size_t key_data_size                = 0;
+	size_t key_data_start               = 0;
+	uint64_t hash                       = 0;
+	uint32_t value_type                 = 0;
+	int result                          = 0;
+
+	if( merge_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid merge handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	result = libnk2_item_get_entry_by_type(
+	          item,
+	          LIBNK2_ENTRY_TYPE_EMAIL_ADDRESS,
+	          value_type,
+	          &record_entry,
+	          LIBNK2_ENTRY_VALUE_FLAG_MATCH_ANY_VALUE_TYPE,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve email address record entry.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		key_prefix[ 0 ] = MERGE_HANDLE_KEY_PREFIX_EMAIL_ADDRESS;
+
+		result = libnk2_record_entry_get_data_as_utf8_string_size(
+		          record_entry,
+		          &key_data_size,
+		          error );
+
+		if( result != 1 )
+		{
+			/* Ignore email addresses that cannot be represented as a string
+			 */
+			libcerror_error_free(
+			 error );
+
+			key_data_size = 0;
+		}
+		if( key_data_size > 1 )
+		{
+			key_data = (uint8_t *) memory_allocate(
+			                        sizeof( uint8_t ) * key_data_size );
+
+			if( key_data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create key data.",
+				 function );
+
+				goto on_error;
+			}
+			if( libnk2_record_entry_get_data_as_utf8_string(
+			     record_entry,
+			     key_data,
+			     key_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve email address.",
+				 function );
+
+				goto on_error;
+			}
+			/* Normalize the email address the same way the alias index does,
+			 * by stripping surrounding whitespace and folding ASCII case
+			 */
+			key_data_end = key_data_size - 1;
+
+			while( ( key_data_end > 0 )
+			    && ( ( key_data[ key_data_end - 1 ] == (uint8_t) ' ' )
+			     ||  ( key_data[ key_data_end - 1 ] == (uint8_t) '\t' ) ) )
+			{
+				key_data_end--;
+			}
+			while( ( key_data_start < key_data_end )
+			    && ( ( key_data[ key_data_start ] == (uint8_t) ' ' )
+			     ||  ( key_data[ key_data_start ] == (uint8_t) '\t' ) ) )
+			{
+				key_data_start++;
+			}
+			for( key_data_offset = key_data_start;
+			     key_data_offset < key_data_end;
+			     key_data_offset++ )
+			{
+				if( ( key_data[ key_data_offset ] >= (uint8_t) 'A' )
+				 && ( key_data[ key_data_offset ] <= (uint8_t) 'Z' ) )
+				{
+					key_data[ key_data_offset ] += (uint8_t) ( 'a' - 'A' );
+				}
+			}
+		}
+		if( libnk2_record_entry_free(
+		     &record_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free email address record entry.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( key_data_start >= key_data_end )
+	{
+		if( key_data != NULL )
+		{
+			memory_free(
+			 key_data );
+
+			key_data = NULL;
+		}
+		key_data_start = 0;
+		key_data_end   = 0;
+
+		result = libnk2_item_get_entry_by_type(
+		          item,
+		          LIBNK2_ENTRY_TYPE_ENTRY_IDENTIFIER,
+		          LIBNK2_VALUE_TYPE_BINARY_DATA,
+		          &record_entry,
+		          0,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry identifier record entry.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			key_prefix[ 0 ] = MERGE_HANDLE_KEY_PREFIX_ENTRY_IDENTIFIER;
+
+			if( libnk2_record_entry_get_data_size(
+			     record_entry,
+			     &key_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve entry identifier size.",
+				 function );
+
+				goto on_error;
+			}
+			if( key_data_size > 0 )
+			{
+				key_data = (uint8_t *) memory_allocate(
+				                        sizeof( uint8_t ) * key_data_size );
+
+				if( key_data == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create key data.",
+					 function );
+
+					goto on_error;
+				}
+				if( libnk2_record_entry_get_data(
+				     record_entry,
+				     key_data,
+				     key_data_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve entry identifier.",
+					 function );
+
+					goto on_error;
+				}
+				key_data_end = key_data_size;
+			}
+			if( libnk2_record_entry_free(
+			     &record_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free entry identifier record entry.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	if( key_data_start >= key_data_end )
+	{
+		if( key_data != NULL )
+		{
+			memory_free(
+			 key_data );
+		}
+		return( 0 );
+	}
+	hash = merge_handle_hash_key_data(
+	        0xcbf29ce484222325ULL,
+	        key_prefix,
+	        1 );
+
+	hash = merge_handle_hash_key_data(
+	        hash,
+	        &( key_data[ key_data_start ] ),
+	        key_data_end - key_data_start );
+
+	memory_free(
+	 key_data );
+
+	/* The value 0 marks an empty slot in the key set
+	 */
+	if( hash == 0 )
+	{
+		hash = 1;
+	}
+	*key = hash;
+
+	return( 1 );
+
+on_error:
+	if( key_data != NULL )
+	{
+		memory_free(
+		 key_data );
+	}
+	if( record_entry != NULL )
+	{
+		libnk2_record_entry_free(
+		 &record_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Inserts a key into the key set
+ * The key set is doubled in size when it becomes half full
+ * Returns 1 if successful, 0 if the key was already in the key set or -1 on error
+ */
+int merge_handle_insert_key(
+     merge_handle_t *merge_handle,
+     uint64_t key,
+     libcerror_error_t **error )
+{
+	uint64_t *key_set          = NULL;
+	static char *function      = "merge_handle_insert_key";
+	size_t key_set_size        = 0;
+	size_t number_of_key_slots = 0;
+	size_t slot_index          = 0;
+	size_t old_slot_index      = 0;
+
+	if( merge_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid merge handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( merge_handle->key_set == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid merge handle - missing key set.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid key value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( merge_handle->number_of_keys + 1 ) * 2 ) > merge_handle->number_of_key_slots )
+	{
+		number_of_key_slots = merge_handle->number_of_key_slots * 2;
+
+		if( number_of_key_slots > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( uint64_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of key slots value exceeds maximum allocation size.",
+			 function );
+
+			return( -1 );
+		}
+		key_set_size = sizeof( uint64_t ) * number_of_key_slots;
+
+		key_set = (uint64_t *) memory_allocate(
+		                        key_set_size );
+
+		if( key_set == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create key set.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     key_set,
+		     0,
+		     key_set_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear key set.",
+			 function );
+
+			memory_free(
+			 key_set );
+
+			return( -1 );
+		}
+		for( old_slot_index = 0;
+		     old_slot_index < merge_handle->number_of_key_slots;
+		     old_slot_index++ )
+		{
+			if( merge_handle->key_set[ old_slot_index ] == 0 )
+			{
+				continue;
+			}
+			slot_index = (size_t) ( merge_handle->key_set[ old_slot_index ] & ( number_of_key_slots - 1 ) );
+
+			while( key_set[ slot_index ] != 0 )
+			{
+				slot_index = ( slot_index + 1 ) & ( number_of_key_slots - 1 );
+			}
+			key_set[ slot_index ] = merge_handle->key_set[ old_slot_index ];
+		}
+		memory_free(
+		 merge_handle->key_set );
+
+		merge_handle->key_set             = key_set;
+		merge_handle->number_of_key_slots = number_of_key_slots;
+	}
+	slot_index = (size_t) ( key & ( merge_handle->number_of_key_slots - 1 ) );
+
+	while( merge_handle->key_set[ slot_index ] != 0 )
+	{
+		if( merge_handle->key_set[ slot_index ] == key )
+		{
+			return( 0 );
+		}
+		slot_index = ( slot_index + 1 ) & ( merge_handle->number_of_key_slots - 1 );
+	}
+	merge_handle->key_set[ slot_index ] = key;
+
+	merge_handle->number_of_keys += 1;
+
+	return( 1 );
+}
+
+/* Merges the items of a file into the output
+ * Items are written as they are read, items with a key that was seen before are skipped
+ * Returns 1 if successful or -1 on error
+ */
+int merge_handle_merge_file(
+     merge_handle_t *merge_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	libnk2_item_t *item        = NULL;
+	static char *function      = "merge_handle_merge_file";
+	uint64_t key               = 0;
+	uint64_t modification_time = 0;
+	int item_index             = 0;
+	int number_of_items        = 0;
+	int result                 = 0;
+
+	if( merge_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid merge handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( merge_handle->input != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid merge handle - input value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libnk2_file_initialize(
+	     &( merge_handle->input ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input.",
+		 function );
+
+		goto on_error;
+	}
+	if( libnk2_file_set_ascii_codepage(
+	     merge_handle->input,
+	     merge_handle->ascii_codepage,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set ASCII codepage in input.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libnk2_file_open_wide(
+	          merge_handle->input,
+	          filename,
+	          LIBNK2_OPEN_READ,
+	          error );
+#else
+	result = libnk2_file_open(
+	          merge_handle->input,
+	          filename,
+	          LIBNK2_OPEN_READ,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( libnk2_file_get_modification_time(
+	     merge_handle->input,
+	     &modification_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve modification time.",
+		 function );
+
+		goto on_error;
+	}
+	if( libnk2_file_get_number_of_items(
+	     merge_handle->input,
+	     &number_of_items,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of items.",
+		 function );
+
+		goto on_error;
+	}
+	for( item_index = 0;
+	     item_index < number_of_items;
+	     item_index++ )
+	{
+		if( merge_handle->abort != 0 )
+		{
+			break;
+		}
+		if( libnk2_file_get_item(
+		     merge_handle->input,
+		     item_index,
+		     &item,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve item: %d.",
+			 function,
+			 item_index );
+
+			goto on_error;
+		}
+		merge_handle->number_of_read_items += 1;
+
+		result = merge_handle_get_item_key(
+		          merge_handle,
+		          item,
+		          &key,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve key of item: %d.",
+			 function,
+			 item_index );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			result = merge_handle_insert_key(
+			          merge_handle,
+			          key,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to insert key of item: %d.",
+				 function,
+				 item_index );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			/* Items without a key cannot be deduplicated and are always written
+			 */
+			result = 1;
+		}
+		if( result == 0 )
+		{
+			merge_handle->number_of_duplicate_items += 1;
+		}
+		else
+		{
+			if( libnk2_writer_append_file_item(
+			     merge_handle->writer,
+			     item,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write item: %d.",
+				 function,
+				 item_index );
+
+				goto on_error;
+			}
+			merge_handle->number_of_written_items += 1;
+		}
+		if( libnk2_item_free(
+		     &item,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free item: %d.",
+			 function,
+			 item_index );
+
+			goto on_error;
+		}
+	}
+	if( libnk2_file_close(
+	     merge_handle->input,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input.",
+		 function );
+
+		goto on_error;
+	}
+	if( libnk2_file_free(
+	     &( merge_handle->input ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free input.",
+		 function );
+
+		goto on_error;
+	}
+	if( modification_time > merge_handle->modification_time )
+	{
+		merge_handle->modification_time = modification_time;
+	}
+	merge_handle->number_of_merged_files += 1;
+
+	return( 1 );
+
+on_error:
+	if( item != NULL )
+	{
+		libnk2_item_free(
+		 &item,
+		 NULL );
+	}
+	if( merge_handle->input != NULL )
+	{
+		libnk2_file_free(
+		 &( merge_handle->input ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Merges the items of the source files into the output
+ * Sources that cannot be read are reported and skipped
+ * Returns 1 if successful or -1 on error
+ */
+int merge_handle_merge_files(
+     merge_handle_t *merge_handle,
+     system_character_t * const sources[],
+     int number_of_sources,
+     libcerror_error_t **error )
+{
+	libcerror_error_t *merge_error = NULL;
+	static char *function          = "merge_handle_merge_files";
+	int source_index               = 0;
+
+	if( merge_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid merge handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( sources == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sources.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_sources < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of sources value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	for( source_index = 0;
+	     source_index < number_of_sources;
+	     source_index++ )
+	{
+		if( merge_handle->abort != 0 )
+		{
+			break;
+		}
+		if( merge_handle_merge_file(
+		     merge_handle,
+		     sources[ source_index ],
+		     &merge_error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to merge: %" PRIs_SYSTEM ".\n",
+			 sources[ source_index ] );
+
+			libcnotify_print_error_backtrace(
+			 merge_error );
+			libcerror_error_free(
+			 &merge_error );
+
+			continue;
+		}
+	}
+	return( 1 );
+}
+
+/* Prints the merge summary
+ * Returns 1 if successful or -1 on error
+ */
+int merge_handle_summary_fprint(
+     merge_handle_t *merge_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "merge_handle_summary_fprint";
+
+	if( merge_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid merge handle.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 merge_handle->notify_stream,
+	 "Summary:\n" );
+
+	fprintf(
+	 merge_handle->notify_stream,
+	 "\tNumber of merged files\t\t: %d\n",
+	 merge_handle->number_of_merged_files );
+
+	fprintf(
+	 merge_handle->notify_stream,
+	 "\tNumber of items read\t\t: %d\n",
+	 merge_handle->number_of_read_items );
+
+	fprintf(
+	 merge_handle->notify_stream,
+	 "\tNumber of items written\t\t: %d\n",
+	 merge_handle->number_of_written_items );
+
+	fprintf(
+	 merge_handle->notify_stream,
+	 "\tNumber of duplicate items\t: %d\n",
+	 merge_handle->number_of_duplicate_items );
+
+	fprintf(
+	 merge_handle->notify_stream,
+	 "\n" );
+
+	return( 1 );
+}
+
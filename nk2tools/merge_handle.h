@@ -0,0 +1,165 @@
+/*
+ * Merge handle
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _MERGE_HANDLE_H )
+#define _MERGE_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "nk2tools_libcerror.h"
+#include "nk2tools_libnk2.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The initial number of slots of the key set, must be a power of 2
+ */
+#define MERGE_HANDLE_INITIAL_NUMBER_OF_KEY_SLOTS	1024
+
+/* The key prefixes, which keep email address and entry identifier keys apart
+ */
+#define MERGE_HANDLE_KEY_PREFIX_EMAIL_ADDRESS		(uint8_t) 'e'
+#define MERGE_HANDLE_KEY_PREFIX_ENTRY_IDENTIFIER	(uint8_t) 'i'
+
+typedef struct merge_handle merge_handle_t;
+
+struct merge_handle
+{
+	/* The output writer
+	 */
+	libnk2_writer_t *writer;
+
+	/* The input that is currently being merged
+	 */
+	libnk2_file_t *input;
+
+	/* The key set, an open addressing hash table of 64-bit key hashes
+	 * where 0 marks an empty slot
+	 */
+	uint64_t *key_set;
+
+	/* The number of slots in the key set
+	 */
+	size_t number_of_key_slots;
+
+	/* The number of keys in the key set
+	 */
+	size_t number_of_keys;
+
+	/* The most recent modification date and time of the inputs
+	 */
+	uint64_t modification_time;
+
+	/* The ascii codepage
+	 */
+	int ascii_codepage;
+
+	/* The number of merged files
+	 */
+	int number_of_merged_files;
+
+	/* The number of items read
+	 */
+	int number_of_read_items;
+
+	/* The number of items written
+	 */
+	int number_of_written_items;
+
+	/* The number of duplicate items
+	 */
+	int number_of_duplicate_items;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int merge_handle_initialize(
+     merge_handle_t **merge_handle,
+     libcerror_error_t **error );
+
+int merge_handle_free(
+     merge_handle_t **merge_handle,
+     libcerror_error_t **error );
+
+int merge_handle_signal_abort(
+     merge_handle_t *merge_handle,
+     libcerror_error_t **error );
+
+int merge_handle_set_ascii_codepage(
+     merge_handle_t *merge_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int merge_handle_open(
+     merge_handle_t *merge_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int merge_handle_close(
+     merge_handle_t *merge_handle,
+     libcerror_error_t **error );
+
+uint64_t merge_handle_hash_key_data(
+          uint64_t hash,
+          const uint8_t *data,
+          size_t data_size );
+
+int merge_handle_get_item_key(
+     merge_handle_t *merge_handle,
+     libnk2_item_t *item,
+     uint64_t *key,
+     libcerror_error_t **error );
+
+int merge_handle_insert_key(
+     merge_handle_t *merge_handle,
+     uint64_t key,
+     libcerror_error_t **error );
+
+int merge_handle_merge_file(
+     merge_handle_t *merge_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int merge_handle_merge_files(
+     merge_handle_t *merge_handle,
+     system_character_t * const sources[],
+     int number_of_sources,
+     libcerror_error_t **error );
+
+int merge_handle_summary_fprint(
+     merge_handle_t *merge_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _MERGE_HANDLE_H ) */
+
@@ -0,0 +1,400 @@
+/*
+ * Searches or appends to an alias index of the email addresses in Nickfiles (NK2)
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "alias_handle.h"
+#include "nk2tools_getopt.h"
+#include "nk2tools_libcerror.h"
+#include "nk2tools_libcfile.h"
+#include "nk2tools_libclocale.h"
+#include "nk2tools_libcnotify.h"
+#include "nk2tools_libnk2.h"
+#include "nk2tools_output.h"
+#include "nk2tools_signal.h"
+#include "nk2tools_unused.h"
+
+alias_handle_t *nk2alias_alias_handle = NULL;
+int nk2alias_abort                    = 0;
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use nk2alias to append the email addresses in Nickfiles (NK2) to an alias\n"
+	                 "index or to search an alias index for the files that contain an address.\n\n" );
+
+	fprintf( stream, "Usage: nk2alias [ -n number_of_files ] [ -hvV ] index source ...\n" );
+	fprintf( stream, "       nk2alias -s address [ -hvV ] index\n\n" );
+
+	fprintf( stream, "\tindex:  the alias index file, created if it does not exist\n" );
+	fprintf( stream, "\tsource: the source files to append to the alias index\n\n" );
+
+	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-n:     maximum number of files per appended segment (default is 1024)\n" );
+	fprintf( stream, "\t-s:     search the alias index for an address, the address is matched\n"
+	                 "\t        case insensitive\n" );
+	fprintf( stream, "\t-v:     verbose output to stderr\n" );
+	fprintf( stream, "\t-V:     print version\n" );
+}
+
+/* Signal handler for nk2alias
+ */
+void nk2alias_signal_handler(
+      nk2tools_signal_t signal NK2TOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function   = "nk2alias_signal_handler";
+
+	NK2TOOLS_UNREFERENCED_PARAMETER( signal )
+
+	nk2alias_abort = 1;
+
+	if( nk2alias_alias_handle != NULL )
+	{
+		if( alias_handle_signal_abort(
+		     nk2alias_alias_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal alias handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcerror_error_t *error                   = NULL;
+	system_character_t *index_filename         = NULL;
+	system_character_t *option_number_of_files = NULL;
+	system_character_t *option_search_address  = NULL;
+	char *program                              = "nk2alias";
+	system_integer_t option                    = 0;
+	int result                                 = 0;
+	int verbose                                = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+	     "nk2tools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( nk2tools_output_initialize(
+	     _IONBF,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	nk2tools_output_version_fprint(
+	 stdout,
+	 program );
+
+	while( ( option = nk2tools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "hn:s:vV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'h':
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'n':
+				option_number_of_files = optarg;
+
+				break;
+
+			case (system_integer_t) 's':
+				option_search_address = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				nk2tools_output_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing index file.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	index_filename = argv[ optind++ ];
+
+	if( ( option_search_address == NULL )
+	 && ( optind == argc ) )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file(s).\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	libcnotify_verbose_set(
+	 verbose );
+	libnk2_notify_set_stream(
+	 stderr,
+	 NULL );
+	libnk2_notify_set_verbose(
+	 verbose );
+
+	if( alias_handle_initialize(
+	     &nk2alias_alias_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize alias handle.\n" );
+
+		goto on_error;
+	}
+	if( option_number_of_files != NULL )
+	{
+		result = alias_handle_set_number_of_files_per_segment(
+		          nk2alias_alias_handle,
+		          option_number_of_files,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of files per segment.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of files per segment defaulting to: %" PRIu32 ".\n",
+			 nk2alias_alias_handle->number_of_files_per_segment );
+		}
+	}
+	if( option_search_address != NULL )
+	{
+		result = alias_handle_open_index(
+		          nk2alias_alias_handle,
+		          index_filename,
+		          &error );
+
+		if( result != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open: %" PRIs_SYSTEM ".\n",
+			 index_filename );
+
+			goto on_error;
+		}
+		if( alias_handle_search_address(
+		     nk2alias_alias_handle,
+		     option_search_address,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to search: %" PRIs_SYSTEM ".\n",
+			 index_filename );
+
+			goto on_error;
+		}
+		if( alias_handle_close_index(
+		     nk2alias_alias_handle,
+		     &error ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to close: %" PRIs_SYSTEM ".\n",
+			 index_filename );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		if( nk2tools_signal_attach(
+		     nk2alias_signal_handler,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to attach signal handler.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+		result = alias_handle_append_files(
+		          nk2alias_alias_handle,
+		          index_filename,
+		          &( argv[ optind ] ),
+		          argc - optind,
+		          &error );
+
+		if( nk2tools_signal_detach(
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to detach signal handler.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+		if( result != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to append to: %" PRIs_SYSTEM ".\n",
+			 index_filename );
+
+			goto on_error;
+		}
+	}
+	if( alias_handle_free(
+	     &nk2alias_alias_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free alias handle.\n" );
+
+		goto on_error;
+	}
+	if( nk2alias_abort != 0 )
+	{
+		fprintf(
+		 stdout,
+		 "Append aborted.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( nk2alias_alias_handle != NULL )
+	{
+		alias_handle_free(
+		 &nk2alias_alias_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
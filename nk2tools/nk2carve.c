@@ -0,0 +1,434 @@
+/*
+ * Carves Nickfiles (NK2) from unallocated space, disk images or memory dumps
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "carve_handle.h"
+#include "nk2tools_getopt.h"
+#include "nk2tools_libbfio.h"
+#include "nk2tools_libcerror.h"
+#include "nk2tools_libcfile.h"
+#include "nk2tools_libclocale.h"
+#include "nk2tools_libcnotify.h"
+#include "nk2tools_libcthreads.h"
+#include "nk2tools_libnk2.h"
+#include "nk2tools_output.h"
+#include "nk2tools_signal.h"
+#include "nk2tools_unused.h"
+
+carve_handle_t *nk2carve_carve_handle = NULL;
+int nk2carve_abort                    = 0;
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use nk2carve to scan a source, such as a disk image, unallocated space\n"
+	                 "or a memory dump, for Nickfiles (NK2).\n\n" );
+
+	fprintf( stream, "Usage: nk2carve [ -b block_size ] [ -j number_of_threads ] [ -t target ]\n"
+	                 "                [ -hivV ] source\n\n" );
+
+	fprintf( stream, "\tsource: the source file\n\n" );
+
+	fprintf( stream, "\t-b:     size of the scan block in bytes (default is 16777216)\n" );
+	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-i:     carve items without a file header instead of files\n" );
+#if defined( HAVE_NK2TOOLS_MULTI_THREAD_SUPPORT )
+	fprintf( stream, "\t-j:     number of threads used to scan blocks, where 0 represents\n"
+	                 "\t        scanning without threads (default is 4)\n" );
+#endif
+	fprintf( stream, "\t-t:     write the carved files to target.offset.nk2, not supported\n"
+	                 "\t        when carving items\n" );
+	fprintf( stream, "\t-v:     verbose output to stderr\n" );
+	fprintf( stream, "\t-V:     print version\n" );
+}
+
+/* Signal handler for nk2carve
+ */
+void nk2carve_signal_handler(
+      nk2tools_signal_t signal NK2TOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function   = "nk2carve_signal_handler";
+
+	NK2TOOLS_UNREFERENCED_PARAMETER( signal )
+
+	nk2carve_abort = 1;
+
+	if( nk2carve_carve_handle != NULL )
+	{
+		if( carve_handle_signal_abort(
+		     nk2carve_carve_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal carve handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcerror_error_t *error              = NULL;
+	system_character_t *option_block_size = NULL;
+	system_character_t *option_threads    = NULL;
+	system_character_t *option_target     = NULL;
+	system_character_t *source            = NULL;
+	char *program                         = "nk2carve";
+	system_integer_t option               = 0;
+	int carve_items                       = 0;
+	int result                            = 0;
+	int verbose                           = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+	     "nk2tools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( nk2tools_output_initialize(
+	     _IONBF,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	nk2tools_output_version_fprint(
+	 stdout,
+	 program );
+
+	while( ( option = nk2tools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "b:hij:t:vV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'b':
+				option_block_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'i':
+				carve_items = 1;
+
+				break;
+
+			case (system_integer_t) 'j':
+				option_threads = optarg;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_target = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				nk2tools_output_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind ];
+
+	libcnotify_verbose_set(
+	 verbose );
+	libnk2_notify_set_stream(
+	 stderr,
+	 NULL );
+	libnk2_notify_set_verbose(
+	 verbose );
+
+	if( carve_handle_initialize(
+	     &nk2carve_carve_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize carve handle.\n" );
+
+		goto on_error;
+	}
+	if( option_block_size != NULL )
+	{
+		result = carve_handle_set_block_size(
+		          nk2carve_carve_handle,
+		          option_block_size,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set block size.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported block size defaulting to: %" PRIzd ".\n",
+			 nk2carve_carve_handle->block_size );
+		}
+	}
+	if( option_threads != NULL )
+	{
+		result = carve_handle_set_number_of_threads(
+		          nk2carve_carve_handle,
+		          option_threads,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of threads.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads defaulting to: %d.\n",
+			 nk2carve_carve_handle->number_of_threads );
+		}
+	}
+	nk2carve_carve_handle->carve_items = carve_items;
+
+	if( option_target != NULL )
+	{
+		if( carve_handle_set_target_path(
+		     nk2carve_carve_handle,
+		     option_target,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set target path.\n" );
+
+			goto on_error;
+		}
+	}
+	if( carve_handle_open_input(
+	     nk2carve_carve_handle,
+	     source,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open: %" PRIs_SYSTEM ".\n",
+		 source );
+
+		goto on_error;
+	}
+	if( nk2tools_signal_attach(
+	     nk2carve_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( nk2carve_carve_handle->carve_items != 0 )
+	{
+		result = carve_handle_carve_input_items(
+		          nk2carve_carve_handle,
+		          &error );
+	}
+	else
+	{
+		result = carve_handle_carve_input(
+		          nk2carve_carve_handle,
+		          &error );
+	}
+
+	if( nk2tools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( result != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to carve: %" PRIs_SYSTEM ".\n",
+		 source );
+
+		carve_handle_close_input(
+		 nk2carve_carve_handle,
+		 NULL );
+
+		goto on_error;
+	}
+	if( carve_handle_close_input(
+	     nk2carve_carve_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close carve handle.\n" );
+
+		goto on_error;
+	}
+	if( carve_handle_free(
+	     &nk2carve_carve_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free carve handle.\n" );
+
+		goto on_error;
+	}
+	if( nk2carve_abort != 0 )
+	{
+		fprintf(
+		 stdout,
+		 "Carve aborted.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( nk2carve_carve_handle != NULL )
+	{
+		carve_handle_free(
+		 &nk2carve_carve_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,351 @@
+/*
+ * Shows the differences between two Nickfiles (NK2)
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "diff_handle.h"
+#include "nk2tools_getopt.h"
+#include "nk2tools_libcerror.h"
+#include "nk2tools_libclocale.h"
+#include "nk2tools_libcnotify.h"
+#include "nk2tools_libnk2.h"
+#include "nk2tools_output.h"
+#include "nk2tools_signal.h"
+#include "nk2tools_unused.h"
+
+diff_handle_t *nk2diff_diff_handle = NULL;
+int nk2diff_abort                  = 0;
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use nk2diff to show the differences between two Nickfiles (NK2).\n\n" );
+
+	fprintf( stream, "Usage: nk2diff [ -c codepage ] [ -hvV ] source other_source\n\n" );
+
+	fprintf( stream, "\tsource:       the source file\n" );
+	fprintf( stream, "\tother_source: the source file to compare with\n\n" );
+
+	fprintf( stream, "\t-c:     codepage of ASCII strings, options: ascii, windows-874,\n"
+	                 "\t        windows-932, windows-936, windows-949, windows-950,\n"
+	                 "\t        windows-1250, windows-1251, windows-1252 (default),\n"
+	                 "\t        windows-1253, windows-1254, windows-1255, windows-1256\n"
+	                 "\t        windows-1257 or windows-1258\n" );
+	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-v:     verbose output to stderr\n" );
+	fprintf( stream, "\t-V:     print version\n" );
+}
+
+/* Signal handler for nk2diff
+ */
+void nk2diff_signal_handler(
+      nk2tools_signal_t signal NK2TOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function   = "nk2diff_signal_handler";
+
+	NK2TOOLS_UNREFERENCED_PARAMETER( signal )
+
+	nk2diff_abort = 1;
+
+	if( nk2diff_diff_handle != NULL )
+	{
+		if( diff_handle_signal_abort(
+		     nk2diff_diff_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal diff handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcerror_error_t *error                  = NULL;
+	system_character_t *option_ascii_codepage = NULL;
+	system_character_t *other_source          = NULL;
+	system_character_t *source                = NULL;
+	char *program                             = "nk2diff";
+	system_integer_t option                   = 0;
+	int result                                = 0;
+	int verbose                               = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+	     "nk2tools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( nk2tools_output_initialize(
+	     _IONBF,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	nk2tools_output_version_fprint(
+	 stdout,
+	 program );
+
+	while( ( option = nk2tools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "c:hvV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'c':
+				option_ascii_codepage = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				nk2tools_output_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( ( optind + 1 ) >= argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file(s).\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	source       = argv[ optind ];
+	other_source = argv[ optind + 1 ];
+
+	libcnotify_verbose_set(
+	 verbose );
+	libnk2_notify_set_stream(
+	 stderr,
+	 NULL );
+	libnk2_notify_set_verbose(
+	 verbose );
+
+	if( diff_handle_initialize(
+	     &nk2diff_diff_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize diff handle.\n" );
+
+		goto on_error;
+	}
+	if( option_ascii_codepage != NULL )
+	{
+		result = diff_handle_set_ascii_codepage(
+		          nk2diff_diff_handle,
+		          option_ascii_codepage,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set ASCII codepage in diff handle.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported ASCII codepage defaulting to: windows-1252.\n" );
+		}
+	}
+	if( diff_handle_open(
+	     nk2diff_diff_handle,
+	     source,
+	     other_source,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open: %" PRIs_SYSTEM " or: %" PRIs_SYSTEM ".\n",
+		 source,
+		 other_source );
+
+		goto on_error;
+	}
+	if( nk2tools_signal_attach(
+	     nk2diff_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	result = diff_handle_diff_fprint(
+	          nk2diff_diff_handle,
+	          &error );
+
+	if( nk2tools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( result != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to print differences.\n" );
+
+		goto on_error;
+	}
+	if( diff_handle_close(
+	     nk2diff_diff_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close diff handle.\n" );
+
+		goto on_error;
+	}
+	if( diff_handle_free(
+	     &nk2diff_diff_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free diff handle.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( nk2diff_diff_handle != NULL )
+	{
+		diff_handle_free(
+		 &nk2diff_diff_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
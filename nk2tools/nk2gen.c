@@ -0,0 +1,478 @@
+/*
+ * Generates a synthetic Nickfile (NK2) for testing and benchmarking
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "generate_handle.h"
+#include "nk2tools_getopt.h"
+#include "nk2tools_libcerror.h"
+#include "nk2tools_libcfile.h"
+#include "nk2tools_libclocale.h"
+#include "nk2tools_libcnotify.h"
+#include "nk2tools_libnk2.h"
+#include "nk2tools_output.h"
+#include "nk2tools_signal.h"
+#include "nk2tools_unused.h"
+
+generate_handle_t *nk2gen_generate_handle = NULL;
+int nk2gen_abort                          = 0;
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use nk2gen to generate a synthetic Nickfile (NK2) with a\n"
+	                 "deterministic content for testing and benchmarking.\n\n" );
+
+	fprintf( stream, "Usage: nk2gen [ -e number_of_entries ] [ -i number_of_items ]\n"
+	                 "              [ -m malformed_type ] [ -S maximum_value_size ]\n"
+	                 "              [ -s seed ] [ -hvV ] target\n\n" );
+
+	fprintf( stream, "\ttarget: the target file\n\n" );
+
+	fprintf( stream, "\t-e:     number of record entries per item (default is 16)\n" );
+	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-i:     number of items (default is 100)\n" );
+	fprintf( stream, "\t-m:     malformed type, options: none (default), number_of_entries,\n"
+	                 "\t        number_of_items, signature, truncated, value_size, value_type\n" );
+	fprintf( stream, "\t-S:     maximum size of variable size values in bytes (default is 64)\n" );
+	fprintf( stream, "\t-s:     seed of the pseudo random generator (default is 0)\n" );
+	fprintf( stream, "\t-v:     verbose output to stderr\n" );
+	fprintf( stream, "\t-V:     print version\n" );
+}
+
+/* Signal handler for nk2gen
+ */
+void nk2gen_signal_handler(
+      nk2tools_signal_t signal NK2TOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function   = "nk2gen_signal_handler";
+
+	NK2TOOLS_UNREFERENCED_PARAMETER( signal )
+
+	nk2gen_abort = 1;
+
+	if( nk2gen_generate_handle != NULL )
+	{
+		if( generate_handle_signal_abort(
+		     nk2gen_generate_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal generate handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcerror_error_t *error                            = NULL;
+	system_character_t *option_malformed_type           = NULL;
+	system_character_t *option_maximum_value_size       = NULL;
+	system_character_t *option_number_of_entries        = NULL;
+	system_character_t *option_number_of_items          = NULL;
+	system_character_t *option_seed                     = NULL;
+	system_character_t *target                          = NULL;
+	char *program                                       = "nk2gen";
+	system_integer_t option                             = 0;
+	int result                                          = 0;
+	int verbose                                         = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+	     "nk2tools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( nk2tools_output_initialize(
+	     _IONBF,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	nk2tools_output_version_fprint(
+	 stdout,
+	 program );
+
+	while( ( option = nk2tools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "e:hi:m:S:s:vV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'e':
+				option_number_of_entries = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'i':
+				option_number_of_items = optarg;
+
+				break;
+
+			case (system_integer_t) 'm':
+				option_malformed_type = optarg;
+
+				break;
+
+			case (system_integer_t) 'S':
+				option_maximum_value_size = optarg;
+
+				break;
+
+			case (system_integer_t) 's':
+				option_seed = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				nk2tools_output_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing target file.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	target = argv[ optind ];
+
+	libcnotify_verbose_set(
+	 verbose );
+	libnk2_notify_set_stream(
+	 stderr,
+	 NULL );
+	libnk2_notify_set_verbose(
+	 verbose );
+
+	if( generate_handle_initialize(
+	     &nk2gen_generate_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize generate handle.\n" );
+
+		goto on_error;
+	}
+	if( option_number_of_entries != NULL )
+	{
+		result = generate_handle_set_number_of_entries_per_item(
+		          nk2gen_generate_handle,
+		          option_number_of_entries,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of entries per item.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of entries per item defaulting to: %" PRIu32 ".\n",
+			 nk2gen_generate_handle->number_of_entries_per_item );
+		}
+	}
+	if( option_number_of_items != NULL )
+	{
+		result = generate_handle_set_number_of_items(
+		          nk2gen_generate_handle,
+		          option_number_of_items,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of items.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of items defaulting to: %" PRIu32 ".\n",
+			 nk2gen_generate_handle->number_of_items );
+		}
+	}
+	if( option_malformed_type != NULL )
+	{
+		result = generate_handle_set_malformed_type(
+		          nk2gen_generate_handle,
+		          option_malformed_type,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set malformed type.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported malformed type defaulting to: none.\n" );
+		}
+	}
+	if( option_maximum_value_size != NULL )
+	{
+		result = generate_handle_set_maximum_value_size(
+		          nk2gen_generate_handle,
+		          option_maximum_value_size,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set maximum value size.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported maximum value size defaulting to: %" PRIu32 ".\n",
+			 nk2gen_generate_handle->maximum_value_size );
+		}
+	}
+	if( option_seed != NULL )
+	{
+		result = generate_handle_set_seed(
+		          nk2gen_generate_handle,
+		          option_seed,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set seed.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported seed defaulting to: %" PRIu64 ".\n",
+			 nk2gen_generate_handle->seed );
+		}
+	}
+	if( generate_handle_open(
+	     nk2gen_generate_handle,
+	     target,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open: %" PRIs_SYSTEM ".\n",
+		 target );
+
+		goto on_error;
+	}
+	if( nk2tools_signal_attach(
+	     nk2gen_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	result = generate_handle_generate(
+	          nk2gen_generate_handle,
+	          &error );
+
+	if( nk2tools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( result != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to generate: %" PRIs_SYSTEM ".\n",
+		 target );
+
+		generate_handle_close(
+		 nk2gen_generate_handle,
+		 NULL );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "Generated: %" PRIs_SYSTEM " (%" PRIu64 " bytes).\n",
+	 target,
+	 nk2gen_generate_handle->number_of_bytes_written );
+
+	if( generate_handle_close(
+	     nk2gen_generate_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close generate handle.\n" );
+
+		goto on_error;
+	}
+	if( generate_handle_free(
+	     &nk2gen_generate_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free generate handle.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( nk2gen_generate_handle != NULL )
+	{
+		generate_handle_free(
+		 &nk2gen_generate_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
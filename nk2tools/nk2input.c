@@ -340,3 +340,72 @@ int nk2input_determine_ascii_codepage(
 	return( result );
 }
 
+/* Determines a decimal value from a string
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int nk2input_determine_decimal_value(
+     const system_character_t *string,
+     uint64_t *value_64bit,
+     libcerror_error_t **error )
+{
+	static char *function = "nk2input_determine_decimal_value";
+	size_t string_index   = 0;
+	size_t string_length  = 0;
+	uint64_t safe_value   = 0;
+	uint8_t digit         = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 64-bit.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	/* The maximum 64-bit value in decimal consists of 20 digits
+	 */
+	if( ( string_length == 0 )
+	 || ( string_length > 20 ) )
+	{
+		return( 0 );
+	}
+	for( string_index = 0;
+	     string_index < string_length;
+	     string_index++ )
+	{
+		if( ( string[ string_index ] < (system_character_t) '0' )
+		 || ( string[ string_index ] > (system_character_t) '9' ) )
+		{
+			return( 0 );
+		}
+		digit = (uint8_t) ( string[ string_index ] - (system_character_t) '0' );
+
+		if( safe_value > ( ( (uint64_t) UINT64_MAX - digit ) / 10 ) )
+		{
+			return( 0 );
+		}
+		safe_value *= 10;
+		safe_value += digit;
+	}
+	*value_64bit = safe_value;
+
+	return( 1 );
+}
+
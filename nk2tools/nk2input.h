@@ -36,6 +36,11 @@ int nk2input_determine_ascii_codepage(
      int *ascii_codepage,
      libcerror_error_t **error );
 
+int nk2input_determine_decimal_value(
+     const system_character_t *string,
+     uint64_t *value_64bit,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -20,6 +20,7 @@
  */
 
 #include <common.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <types.h>
 
@@ -34,6 +35,7 @@
 #include "pynk2_item.h"
 #include "pynk2_items.h"
 #include "pynk2_libcerror.h"
+#include "pynk2_libcthreads.h"
 #include "pynk2_libnk2.h"
 #include "pynk2_python.h"
 #include "pynk2_record_entry.h"
@@ -83,10 +85,18 @@ PyMethodDef pynk2_module_methods[] = {
 	{ "open_file_object",
 	  (PyCFunction) pynk2_open_new_file_with_file_object,
 	  METH_VARARGS | METH_KEYWORDS,
-	  "open_file_object(file_object, mode='r') -> Object\n"
+	  "open_file_object(file_object, mode='r', read_ahead_size=65536) -> Object\n"
 	  "\n"
 	  "Opens a file using a file-like object." },
 
+	{ "open_many",
+	  (PyCFunction) pynk2_open_many,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "open_many(paths, mode='r', workers=4) -> List\n"
+	  "\n"
+	  "Opens multiple files using a pool of native threads and returns a list\n"
+	  "of file objects in the order of the paths." },
+
 	/* Sentinel */
 	{ NULL, NULL, 0, NULL }
 };
@@ -359,6 +369,7 @@ PyObject *pynk2_check_file_signature_file_object(
 	if( pynk2_file_object_initialize(
 	     &file_io_handle,
 	     file_object,
+	     0,
 	     &error ) != 1 )
 	{
 		pynk2_error_raise(
@@ -532,6 +543,605 @@ on_error:
 	return( NULL );
 }
 
+/* Opens the file of an open many value
+ * Callback function for the open many thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int pynk2_open_many_value_open(
+     pynk2_open_many_value_t *open_many_value,
+     void *arguments PYNK2_ATTRIBUTE_UNUSED )
+{
+	PYNK2_UNREFERENCED_PARAMETER( arguments )
+
+	if( open_many_value == NULL )
+	{
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( open_many_value->filename_wide != NULL )
+	{
+		open_many_value->result = libnk2_file_open_wide(
+		                           open_many_value->file,
+		                           open_many_value->filename_wide,
+		                           LIBNK2_OPEN_READ,
+		                           &( open_many_value->error ) );
+	}
+	else
+#endif
+	{
+		open_many_value->result = libnk2_file_open(
+		                           open_many_value->file,
+		                           open_many_value->filename_narrow,
+		                           LIBNK2_OPEN_READ,
+		                           &( open_many_value->error ) );
+	}
+	return( 1 );
+}
+
+/* Opens the files of the open many values
+ * This function is called without holding the GIL
+ * Returns 1 if successful or -1 on error
+ */
+int pynk2_open_many_values_open(
+     pynk2_open_many_value_t *open_many_values,
+     int number_of_values,
+     int number_of_workers,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_PYNK2_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_pool_t *thread_pool = NULL;
+	int number_of_threads                  = 0;
+	int result                             = 1;
+#endif
+
+	static char *function                  = "pynk2_open_many_values_open";
+	int value_index                        = 0;
+
+	if( open_many_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid open many values.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_values < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of values value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_workers < 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of workers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_PYNK2_MULTI_THREAD_SUPPORT )
+	if( ( number_of_workers > 1 )
+	 && ( number_of_values > 1 ) )
+	{
+		number_of_threads = number_of_workers;
+
+		if( number_of_threads > number_of_values )
+		{
+			number_of_threads = number_of_values;
+		}
+		if( libcthreads_thread_pool_create(
+		     &thread_pool,
+		     NULL,
+		     number_of_threads,
+		     number_of_values,
+		     (int (*)(intptr_t *, void *)) &pynk2_open_many_value_open,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
+
+			return( -1 );
+		}
+		for( value_index = 0;
+		     value_index < number_of_values;
+		     value_index++ )
+		{
+			if( libcthreads_thread_pool_push(
+			     thread_pool,
+			     (intptr_t *) &( open_many_values[ value_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to push value: %d onto thread pool.",
+				 function,
+				 value_index );
+
+				result = -1;
+
+				break;
+			}
+		}
+		/* The thread pool is joined after all values have been processed
+		 * and also when a value could not be pushed
+		 */
+		if( libcthreads_thread_pool_join(
+		     &thread_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			result = -1;
+		}
+		return( result );
+	}
+#endif /* defined( HAVE_PYNK2_MULTI_THREAD_SUPPORT ) */
+
+	for( value_index = 0;
+	     value_index < number_of_values;
+	     value_index++ )
+	{
+		if( pynk2_open_many_value_open(
+		     &( open_many_values[ value_index ] ),
+		     NULL ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open value: %d.",
+			 function,
+			 value_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Creates new file objects and opens them using a pool of native threads
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pynk2_open_many(
+           PyObject *self PYNK2_ATTRIBUTE_UNUSED,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	PyObject *list_object                     = NULL;
+	PyObject *paths_object                    = NULL;
+	PyObject *sequence_object                 = NULL;
+	PyObject *string_object                   = NULL;
+	libcerror_error_t *error                  = NULL;
+	pynk2_file_t *pynk2_file                  = NULL;
+	pynk2_open_many_value_t *open_many_value  = NULL;
+	pynk2_open_many_value_t *open_many_values = NULL;
+	static char *function                     = "pynk2_open_many";
+	static char *keyword_list[]               = { "paths", "mode", "workers", NULL };
+	char *mode                                = NULL;
+	Py_ssize_t sequence_size                  = 0;
+	int number_of_values                      = 0;
+	int number_of_workers                     = 4;
+	int result                                = 0;
+	int value_index                           = 0;
+
+	PYNK2_UNREFERENCED_PARAMETER( self )
+
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "O|si",
+	     keyword_list,
+	     &paths_object,
+	     &mode,
+	     &number_of_workers ) == 0 )
+	{
+		return( NULL );
+	}
+	if( ( mode != NULL )
+	 && ( mode[ 0 ] != 'r' ) )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: unsupported mode: %s.",
+		 function,
+		 mode );
+
+		return( NULL );
+	}
+	if( number_of_workers < 1 )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid number of workers value out of bounds.",
+		 function );
+
+		return( NULL );
+	}
+	/* A single string is a sequence of characters and not of paths
+	 */
+#if PY_MAJOR_VERSION >= 3
+	if( PyUnicode_Check(
+	     paths_object )
+	 || PyBytes_Check(
+	     paths_object ) )
+#else
+	if( PyUnicode_Check(
+	     paths_object )
+	 || PyString_Check(
+	     paths_object ) )
+#endif
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: unsupported paths object type.",
+		 function );
+
+		return( NULL );
+	}
+	sequence_object = PySequence_Fast(
+	                   paths_object,
+	                   "paths must be a sequence of strings" );
+
+	if( sequence_object == NULL )
+	{
+		goto on_error;
+	}
+	sequence_size = PySequence_Fast_GET_SIZE(
+	                 sequence_object );
+
+	if( ( sequence_size < 0 )
+	 || ( sequence_size > (Py_ssize_t) INT_MAX ) )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid number of paths value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	number_of_values = (int) sequence_size;
+
+	list_object = PyList_New(
+	               sequence_size );
+
+	if( list_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create list object.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_values == 0 )
+	{
+		Py_DecRef(
+		 sequence_object );
+
+		return( list_object );
+	}
+	open_many_values = (pynk2_open_many_value_t *) PyMem_Malloc(
+	                                                sizeof( pynk2_open_many_value_t ) * number_of_values );
+
+	if( open_many_values == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create open many values.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     open_many_values,
+	     0,
+	     sizeof( pynk2_open_many_value_t ) * number_of_values ) == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to clear open many values.",
+		 function );
+
+		PyMem_Free(
+		 open_many_values );
+
+		open_many_values = NULL;
+
+		goto on_error;
+	}
+
+	/* The file objects and filenames are created while holding the GIL
+	 */
+	for( value_index = 0;
+	     value_index < number_of_values;
+	     value_index++ )
+	{
+		open_many_value = &( open_many_values[ value_index ] );
+
+		/* PyObject_New does not invoke tp_init
+		 */
+		pynk2_file = PyObject_New(
+		              struct pynk2_file,
+		              &pynk2_file_type_object );
+
+		if( pynk2_file == NULL )
+		{
+			PyErr_Format(
+			 PyExc_MemoryError,
+			 "%s: unable to create file: %d.",
+			 function,
+			 value_index );
+
+			goto on_error;
+		}
+		if( pynk2_file_init(
+		     pynk2_file ) != 0 )
+		{
+			Py_DecRef(
+			 (PyObject *) pynk2_file );
+
+			goto on_error;
+		}
+		/* PyList_SET_ITEM steals the reference to the file object
+		 */
+		PyList_SET_ITEM(
+		 list_object,
+		 (Py_ssize_t) value_index,
+		 (PyObject *) pynk2_file );
+
+		open_many_value->file = pynk2_file->file;
+
+		string_object = PySequence_Fast_GET_ITEM(
+		                 sequence_object,
+		                 (Py_ssize_t) value_index );
+
+		result = PyObject_IsInstance(
+		          string_object,
+		          (PyObject *) &PyUnicode_Type );
+
+		if( result == -1 )
+		{
+			pynk2_error_fetch_and_raise(
+			 PyExc_RuntimeError,
+			 "%s: unable to determine if string object: %d is of type Unicode.",
+			 function,
+			 value_index );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			PyErr_Clear();
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#if PY_MAJOR_VERSION >= 3 && PY_MINOR_VERSION >= 3
+			open_many_value->filename_wide = (wchar_t *) PyUnicode_AsWideCharString(
+			                                              string_object,
+			                                              NULL );
+#else
+			open_many_value->filename_wide = (wchar_t *) PyUnicode_AsUnicode(
+			                                              string_object );
+#endif
+			if( open_many_value->filename_wide == NULL )
+			{
+				pynk2_error_fetch_and_raise(
+				 PyExc_RuntimeError,
+				 "%s: unable to convert Unicode string: %d to wide character string.",
+				 function,
+				 value_index );
+
+				goto on_error;
+			}
+#else
+			open_many_value->utf8_string_object = PyUnicode_AsUTF8String(
+			                                       string_object );
+
+			if( open_many_value->utf8_string_object == NULL )
+			{
+				pynk2_error_fetch_and_raise(
+				 PyExc_RuntimeError,
+				 "%s: unable to convert Unicode string: %d to UTF-8.",
+				 function,
+				 value_index );
+
+				goto on_error;
+			}
+#if PY_MAJOR_VERSION >= 3
+			open_many_value->filename_narrow = PyBytes_AsString(
+			                                    open_many_value->utf8_string_object );
+#else
+			open_many_value->filename_narrow = PyString_AsString(
+			                                    open_many_value->utf8_string_object );
+#endif
+#endif /* defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+			continue;
+		}
+		PyErr_Clear();
+
+#if PY_MAJOR_VERSION >= 3
+		result = PyObject_IsInstance(
+		          string_object,
+		          (PyObject *) &PyBytes_Type );
+#else
+		result = PyObject_IsInstance(
+		          string_object,
+		          (PyObject *) &PyString_Type );
+#endif
+		if( result == -1 )
+		{
+			pynk2_error_fetch_and_raise(
+			 PyExc_RuntimeError,
+			 "%s: unable to determine if string object: %d is of type string.",
+			 function,
+			 value_index );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			PyErr_Format(
+			 PyExc_TypeError,
+			 "%s: unsupported string object type: %d.",
+			 function,
+			 value_index );
+
+			goto on_error;
+		}
+		PyErr_Clear();
+
+		/* The string object is kept alive by the sequence object
+		 */
+#if PY_MAJOR_VERSION >= 3
+		open_many_value->filename_narrow = PyBytes_AsString(
+		                                    string_object );
+#else
+		open_many_value->filename_narrow = PyString_AsString(
+		                                    string_object );
+#endif
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = pynk2_open_many_values_open(
+	          open_many_values,
+	          number_of_values,
+	          number_of_workers,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pynk2_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to open files.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		goto on_error;
+	}
+	for( value_index = 0;
+	     value_index < number_of_values;
+	     value_index++ )
+	{
+		open_many_value = &( open_many_values[ value_index ] );
+
+		if( open_many_value->result != 1 )
+		{
+			pynk2_error_raise(
+			 open_many_value->error,
+			 PyExc_IOError,
+			 "%s: unable to open file: %d.",
+			 function,
+			 value_index );
+
+			goto on_error;
+		}
+	}
+	for( value_index = 0;
+	     value_index < number_of_values;
+	     value_index++ )
+	{
+		open_many_value = &( open_many_values[ value_index ] );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#if PY_MAJOR_VERSION >= 3 && PY_MINOR_VERSION >= 3
+		if( open_many_value->filename_wide != NULL )
+		{
+			PyMem_Free(
+			 open_many_value->filename_wide );
+		}
+#endif
+#else
+		if( open_many_value->utf8_string_object != NULL )
+		{
+			Py_DecRef(
+			 open_many_value->utf8_string_object );
+		}
+#endif
+	}
+	PyMem_Free(
+	 open_many_values );
+
+	Py_DecRef(
+	 sequence_object );
+
+	return( list_object );
+
+on_error:
+	if( open_many_values != NULL )
+	{
+		for( value_index = 0;
+		     value_index < number_of_values;
+		     value_index++ )
+		{
+			open_many_value = &( open_many_values[ value_index ] );
+
+			if( open_many_value->error != NULL )
+			{
+				libcerror_error_free(
+				 &( open_many_value->error ) );
+			}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#if PY_MAJOR_VERSION >= 3 && PY_MINOR_VERSION >= 3
+			if( open_many_value->filename_wide != NULL )
+			{
+				PyMem_Free(
+				 open_many_value->filename_wide );
+			}
+#endif
+#else
+			if( open_many_value->utf8_string_object != NULL )
+			{
+				Py_DecRef(
+				 open_many_value->utf8_string_object );
+			}
+#endif
+		}
+		PyMem_Free(
+		 open_many_values );
+	}
+	/* Freeing the list also closes and frees the file objects
+	 */
+	if( list_object != NULL )
+	{
+		Py_DecRef(
+		 list_object );
+	}
+	if( sequence_object != NULL )
+	{
+		Py_DecRef(
+		 sequence_object );
+	}
+	return( NULL );
+}
+
 #if PY_MAJOR_VERSION >= 3
 
 /* The pynk2 module definition
@@ -25,12 +25,45 @@
 #include <common.h>
 #include <types.h>
 
+#include "pynk2_libcerror.h"
+#include "pynk2_libnk2.h"
 #include "pynk2_python.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+typedef struct pynk2_open_many_value pynk2_open_many_value_t;
+
+struct pynk2_open_many_value
+{
+	/* The libnk2 file
+	 */
+	libnk2_file_t *file;
+
+	/* The narrow character filename
+	 */
+	const char *filename_narrow;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	/* The wide character filename
+	 */
+	wchar_t *filename_wide;
+#else
+	/* The UTF-8 string object that contains the narrow character filename
+	 */
+	PyObject *utf8_string_object;
+#endif
+
+	/* The result of opening the file
+	 */
+	int result;
+
+	/* The error of opening the file
+	 */
+	libcerror_error_t *error;
+};
+
 PyObject *pynk2_get_version(
            PyObject *self,
            PyObject *arguments );
@@ -55,6 +88,21 @@ PyObject *pynk2_open_new_file_with_file_object(
            PyObject *arguments,
            PyObject *keywords );
 
+int pynk2_open_many_value_open(
+     pynk2_open_many_value_t *open_many_value,
+     void *arguments );
+
+int pynk2_open_many_values_open(
+     pynk2_open_many_value_t *open_many_values,
+     int number_of_values,
+     int number_of_workers,
+     libcerror_error_t **error );
+
+PyObject *pynk2_open_many(
+           PyObject *self,
+           PyObject *arguments,
+           PyObject *keywords );
+
 #if PY_MAJOR_VERSION >= 3
 PyMODINIT_FUNC PyInit_pynk2(
                 void );
@@ -27,6 +27,14 @@
 #include <stdlib.h>
 #endif
 
+#if defined( HAVE_SYS_MMAN_H ) && !defined( WINAPI )
+#include <sys/mman.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H ) && !defined( WINAPI )
+#include <sys/stat.h>
+#endif
+
 #include "pynk2_codepage.h"
 #include "pynk2_datetime.h"
 #include "pynk2_error.h"
@@ -42,6 +50,12 @@
 #include "pynk2_python.h"
 #include "pynk2_unused.h"
 
+/* The data of a file object of a regular file is memory mapped when supported
+ */
+#if defined( HAVE_SYS_MMAN_H ) && defined( HAVE_SYS_STAT_H ) && defined( HAVE_MMAP ) && defined( HAVE_MUNMAP ) && !defined( WINAPI )
+#define PYNK2_FILE_HAVE_MMAP
+#endif
+
 #if !defined( LIBNK2_HAVE_BFIO )
 
 LIBNK2_EXTERN \
@@ -72,9 +86,13 @@ PyMethodDef pynk2_file_object_methods[] = {
 	{ "open_file_object",
 	  (PyCFunction) pynk2_file_open_file_object,
 	  METH_VARARGS | METH_KEYWORDS,
-	  "open_file_object(file_object, mode='r') -> None\n"
+	  "open_file_object(file_object, mode='r', read_ahead_size=65536) -> None\n"
 	  "\n"
-	  "Opens a file using a file-like object." },
+	  "Opens a file using a file-like object.\n"
+	  "The data of a file object of a regular file that provides fileno() is\n"
+	  "memory mapped when supported. For other file objects small reads are\n"
+	  "served from a read-ahead buffer of read_ahead_size bytes, a read_ahead_size\n"
+	  "of 0 disables the read-ahead buffer." },
 
 	{ "close",
 	  (PyCFunction) pynk2_file_close,
@@ -126,6 +144,15 @@ PyMethodDef pynk2_file_object_methods[] = {
 	  "\n"
 	  "Retrieves the item specified by the index." },
 
+	{ "to_records",
+	  (PyCFunction) pynk2_file_to_records,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "to_records(entry_types=None) -> List of dictionaries\n"
+	  "\n"
+	  "Retrieves the decoded entry values of all items as a list of dictionaries\n"
+	  "keyed by entry type. If entry_types is set only the entries of those types\n"
+	  "are included." },
+
 	/* Sentinel */
 	{ NULL, NULL, 0, NULL }
 };
@@ -275,8 +302,11 @@ int pynk2_file_init(
 	}
 	/* Make sure libnk2 file is set to NULL
 	 */
-	pynk2_file->file           = NULL;
-	pynk2_file->file_io_handle = NULL;
+	pynk2_file->file              = NULL;
+	pynk2_file->file_io_handle    = NULL;
+	pynk2_file->mapped_data       = NULL;
+	pynk2_file->mapped_data_size  = 0;
+	pynk2_file->number_of_exports = 0;
 
 	if( libnk2_file_initialize(
 	     &( pynk2_file->file ),
@@ -336,13 +366,16 @@ void pynk2_file_free(
 
 		return;
 	}
+	/* The object is freed even if the file cannot be closed, since otherwise
+	 * the libnk2 file and the file IO handle are leaked
+	 */
 	if( pynk2_file->file_io_handle != NULL )
 	{
 		if( pynk2_file_close(
 		     pynk2_file,
 		     NULL ) == NULL )
 		{
-			return;
+			PyErr_Clear();
 		}
 	}
 	if( pynk2_file->file != NULL )
@@ -367,6 +400,33 @@ void pynk2_file_free(
 			 &error );
 		}
 	}
+	if( pynk2_file->file_io_handle != NULL )
+	{
+		Py_BEGIN_ALLOW_THREADS
+
+		result = libbfio_handle_free(
+		          &( pynk2_file->file_io_handle ),
+		          &error );
+
+		Py_END_ALLOW_THREADS
+
+		if( result != 1 )
+		{
+			pynk2_error_raise(
+			 error,
+			 PyExc_MemoryError,
+			 "%s: unable to free libbfio file IO handle.",
+			 function );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* The mapped data is only unmapped after the file IO handle that references it was freed
+	 */
+	pynk2_file_unmap_file_object(
+	 pynk2_file );
+
 	ob_type->tp_free(
 	 (PyObject*) pynk2_file );
 }
@@ -648,8 +708,9 @@ PyObject *pynk2_file_open_file_object(
 	PyObject *file_object       = NULL;
 	libcerror_error_t *error    = NULL;
 	static char *function       = "pynk2_file_open_file_object";
-	static char *keyword_list[] = { "file_object", "mode", NULL };
+	static char *keyword_list[] = { "file_object", "mode", "read_ahead_size", NULL };
 	char *mode                  = NULL;
+	Py_ssize_t read_ahead_size  = (Py_ssize_t) PYNK2_FILE_OBJECT_IO_HANDLE_DEFAULT_READ_AHEAD_SIZE;
 	int result                  = 0;
 
 	if( pynk2_file == NULL )
@@ -664,10 +725,11 @@ PyObject *pynk2_file_open_file_object(
 	if( PyArg_ParseTupleAndKeywords(
 	     arguments,
 	     keywords,
-	     "O|s",
+	     "O|sn",
 	     keyword_list,
 	     &file_object,
-	     &mode ) == 0 )
+	     &mode,
+	     &read_ahead_size ) == 0 )
 	{
 		return( NULL );
 	}
@@ -682,6 +744,15 @@ PyObject *pynk2_file_open_file_object(
 
 		return( NULL );
 	}
+	if( read_ahead_size < 0 )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid read-ahead size value out of bounds.",
+		 function );
+
+		return( NULL );
+	}
 	PyErr_Clear();
 
 	result = PyObject_HasAttrString(
@@ -722,10 +793,57 @@ PyObject *pynk2_file_open_file_object(
 
 		goto on_error;
 	}
-	if( pynk2_file_object_initialize(
-	     &( pynk2_file->file_io_handle ),
-	     file_object,
-	     &error ) != 1 )
+	/* A file object of a regular file is read directly from memory instead of
+	 * calling its read and seek methods
+	 */
+	result = pynk2_file_map_file_object(
+	          pynk2_file,
+	          file_object );
+
+	if( result == -1 )
+	{
+		goto on_error;
+	}
+	else if( result == 1 )
+	{
+		if( libbfio_memory_range_initialize(
+		     &( pynk2_file->file_io_handle ),
+		     &error ) != 1 )
+		{
+			pynk2_error_raise(
+			 error,
+			 PyExc_MemoryError,
+			 "%s: unable to initialize file IO handle.",
+			 function );
+
+			libcerror_error_free(
+			 &error );
+
+			goto on_error;
+		}
+		if( libbfio_memory_range_set(
+		     pynk2_file->file_io_handle,
+		     pynk2_file->mapped_data,
+		     pynk2_file->mapped_data_size,
+		     &error ) != 1 )
+		{
+			pynk2_error_raise(
+			 error,
+			 PyExc_IOError,
+			 "%s: unable to set memory range of file IO handle.",
+			 function );
+
+			libcerror_error_free(
+			 &error );
+
+			goto on_error;
+		}
+	}
+	else if( pynk2_file_object_initialize(
+	          &( pynk2_file->file_io_handle ),
+	          file_object,
+	          (size_t) read_ahead_size,
+	          &error ) != 1 )
 	{
 		pynk2_error_raise(
 		 error,
@@ -773,9 +891,167 @@ on_error:
 		 &( pynk2_file->file_io_handle ),
 		 NULL );
 	}
+	pynk2_file_unmap_file_object(
+	 pynk2_file );
+
 	return( NULL );
 }
 
+/* Memory maps the data of a file object
+ * Only a file object of a regular file that provides a file descriptor is mapped
+ * Returns 1 if successful, 0 if the file object was not mapped or -1 on error
+ */
+int pynk2_file_map_file_object(
+     pynk2_file_t *pynk2_file,
+     PyObject *file_object )
+{
+#if defined( PYNK2_FILE_HAVE_MMAP )
+	struct stat file_statistics;
+
+	PyObject *method_name    = NULL;
+	PyObject *method_result  = NULL;
+	libcerror_error_t *error = NULL;
+	void *mapped_data        = NULL;
+	int64_t file_descriptor  = 0;
+	int result               = 0;
+#endif
+
+	static char *function    = "pynk2_file_map_file_object";
+
+	if( pynk2_file == NULL )
+	{
+		return( 0 );
+	}
+	/* The mapped data cannot be replaced while a buffer exports data of the file
+	 */
+	if( pynk2_file->number_of_exports > 0 )
+	{
+		PyErr_Format(
+		 PyExc_BufferError,
+		 "%s: unable to map file object while data of the file is exported.",
+		 function );
+
+		return( -1 );
+	}
+	if( pynk2_file->mapped_data != NULL )
+	{
+		return( 0 );
+	}
+#if defined( PYNK2_FILE_HAVE_MMAP )
+	PyErr_Clear();
+
+	result = PyObject_HasAttrString(
+	          file_object,
+	          "fileno" );
+
+	if( result != 1 )
+	{
+		return( 0 );
+	}
+#if PY_MAJOR_VERSION >= 3
+	method_name = PyUnicode_FromString(
+	               "fileno" );
+#else
+	method_name = PyString_FromString(
+	               "fileno" );
+#endif
+	method_result = PyObject_CallMethodObjArgs(
+	                 file_object,
+	                 method_name,
+	                 NULL );
+
+	Py_DecRef(
+	 method_name );
+
+	/* File-like objects without a file descriptor, such as io.BytesIO,
+	 * raise io.UnsupportedOperation
+	 */
+	if( method_result == NULL )
+	{
+		PyErr_Clear();
+
+		return( 0 );
+	}
+	result = pynk2_integer_signed_copy_to_64bit(
+	          method_result,
+	          &file_descriptor,
+	          &error );
+
+	Py_DecRef(
+	 method_result );
+
+	if( result != 1 )
+	{
+		libcerror_error_free(
+		 &error );
+
+		PyErr_Clear();
+
+		return( 0 );
+	}
+	if( ( file_descriptor < 0 )
+	 || ( file_descriptor > (int64_t) INT_MAX ) )
+	{
+		return( 0 );
+	}
+	if( fstat(
+	     (int) file_descriptor,
+	     &file_statistics ) != 0 )
+	{
+		return( 0 );
+	}
+	/* Pipes, sockets and character devices are not mapped and empty files cannot be mapped
+	 */
+	if( ( S_ISREG( file_statistics.st_mode ) == 0 )
+	 || ( file_statistics.st_size <= 0 )
+	 || ( (uint64_t) file_statistics.st_size > (uint64_t) SSIZE_MAX ) )
+	{
+		return( 0 );
+	}
+	mapped_data = mmap(
+	               NULL,
+	               (size_t) file_statistics.st_size,
+	               PROT_READ,
+	               MAP_PRIVATE,
+	               (int) file_descriptor,
+	               0 );
+
+	if( mapped_data == MAP_FAILED )
+	{
+		return( 0 );
+	}
+	pynk2_file->mapped_data      = (uint8_t *) mapped_data;
+	pynk2_file->mapped_data_size = (size_t) file_statistics.st_size;
+
+	return( 1 );
+#else
+	PYNK2_UNREFERENCED_PARAMETER( file_object )
+
+	return( 0 );
+#endif /* defined( PYNK2_FILE_HAVE_MMAP ) */
+}
+
+/* Unmaps the memory mapped data of a file object
+ */
+void pynk2_file_unmap_file_object(
+      pynk2_file_t *pynk2_file )
+{
+	if( pynk2_file == NULL )
+	{
+		return;
+	}
+	if( pynk2_file->mapped_data != NULL )
+	{
+#if defined( PYNK2_FILE_HAVE_MMAP )
+		munmap(
+		 (void *) pynk2_file->mapped_data,
+		 pynk2_file->mapped_data_size );
+#endif
+		pynk2_file->mapped_data      = NULL;
+		pynk2_file->mapped_data_size = 0;
+	}
+}
+
 /* Closes a file
  * Returns a Python object if successful or NULL on error
  */
@@ -798,6 +1074,17 @@ PyObject *pynk2_file_close(
 
 		return( NULL );
 	}
+	/* Closing the file frees the data that is referenced by the exported buffers
+	 */
+	if( pynk2_file->number_of_exports > 0 )
+	{
+		PyErr_Format(
+		 PyExc_BufferError,
+		 "%s: unable to close file while data of the file is exported.",
+		 function );
+
+		return( NULL );
+	}
 	Py_BEGIN_ALLOW_THREADS
 
 	result = libnk2_file_close(
@@ -843,6 +1130,11 @@ PyObject *pynk2_file_close(
 			return( NULL );
 		}
 	}
+	/* The mapped data is only unmapped after the file IO handle that references it was freed
+	 */
+	pynk2_file_unmap_file_object(
+	 pynk2_file );
+
 	Py_IncRef(
 	 Py_None );
 
@@ -1498,3 +1790,257 @@ PyObject *pynk2_file_get_items(
 	return( sequence_object );
 }
 
+/* Retrieves the decoded entry values of all items
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pynk2_file_to_records(
+           pynk2_file_t *pynk2_file,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	PyObject *entry_types_object = NULL;
+	PyObject *list_object        = NULL;
+	PyObject *record_object      = NULL;
+	PyObject *sequence_object    = NULL;
+	libcerror_error_t *error     = NULL;
+	libnk2_item_t *item          = NULL;
+	static char *function        = "pynk2_file_to_records";
+	static char *keyword_list[]  = { "entry_types", NULL };
+	uint64_t value_64bit         = 0;
+	uint32_t *entry_types        = NULL;
+	Py_ssize_t entry_type_index  = 0;
+	Py_ssize_t sequence_size     = 0;
+	int item_index               = 0;
+	int number_of_entry_types    = 0;
+	int number_of_items          = 0;
+	int result                   = 0;
+
+	if( pynk2_file == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid file.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "|O",
+	     keyword_list,
+	     &entry_types_object ) == 0 )
+	{
+		return( NULL );
+	}
+	if( ( entry_types_object != NULL )
+	 && ( entry_types_object != Py_None ) )
+	{
+		sequence_object = PySequence_Fast(
+		                   entry_types_object,
+		                   "entry_types must be a sequence of integers" );
+
+		if( sequence_object == NULL )
+		{
+			goto on_error;
+		}
+		sequence_size = PySequence_Fast_GET_SIZE(
+		                 sequence_object );
+
+		if( ( sequence_size < 0 )
+		 || ( sequence_size > (Py_ssize_t) INT_MAX ) )
+		{
+			PyErr_Format(
+			 PyExc_ValueError,
+			 "%s: invalid number of entry types value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		number_of_entry_types = (int) sequence_size;
+
+		/* Allocate at least 1 entry type so that an empty sequence filters all entries
+		 */
+		entry_types = (uint32_t *) PyMem_Malloc(
+		                            sizeof( uint32_t ) * ( number_of_entry_types + 1 ) );
+
+		if( entry_types == NULL )
+		{
+			PyErr_Format(
+			 PyExc_MemoryError,
+			 "%s: unable to create entry types.",
+			 function );
+
+			goto on_error;
+		}
+		for( entry_type_index = 0;
+		     entry_type_index < sequence_size;
+		     entry_type_index++ )
+		{
+			result = pynk2_integer_unsigned_copy_to_64bit(
+			          PySequence_Fast_GET_ITEM(
+			           sequence_object,
+			           entry_type_index ),
+			          &value_64bit,
+			          &error );
+
+			if( result != 1 )
+			{
+				pynk2_error_raise(
+				 error,
+				 PyExc_ValueError,
+				 "%s: unable to convert entry type: %d into an integer.",
+				 function,
+				 (int) entry_type_index );
+
+				libcerror_error_free(
+				 &error );
+
+				goto on_error;
+			}
+			if( value_64bit > (uint64_t) UINT32_MAX )
+			{
+				PyErr_Format(
+				 PyExc_ValueError,
+				 "%s: invalid entry type: %d value out of bounds.",
+				 function,
+				 (int) entry_type_index );
+
+				goto on_error;
+			}
+			entry_types[ entry_type_index ] = (uint32_t) value_64bit;
+		}
+		Py_DecRef(
+		 sequence_object );
+
+		sequence_object = NULL;
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libnk2_file_get_number_of_items(
+	          pynk2_file->file,
+	          &number_of_items,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pynk2_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve number of items.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		goto on_error;
+	}
+	list_object = PyList_New(
+	               (Py_ssize_t) number_of_items );
+
+	if( list_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create list object.",
+		 function );
+
+		goto on_error;
+	}
+	for( item_index = 0;
+	     item_index < number_of_items;
+	     item_index++ )
+	{
+		/* The GIL is released since retrieving the item grabs the read/write lock
+		 * of the file, that can be held by another thread that needs the GIL
+		 */
+		Py_BEGIN_ALLOW_THREADS
+
+		result = libnk2_file_get_item(
+		          pynk2_file->file,
+		          item_index,
+		          &item,
+		          &error );
+
+		Py_END_ALLOW_THREADS
+
+		if( result != 1 )
+		{
+			pynk2_error_raise(
+			 error,
+			 PyExc_IOError,
+			 "%s: unable to retrieve item: %d.",
+			 function,
+			 item_index );
+
+			libcerror_error_free(
+			 &error );
+
+			goto on_error;
+		}
+		record_object = pynk2_item_dict_new(
+		                 item,
+		                 entry_types,
+		                 number_of_entry_types );
+
+		if( record_object == NULL )
+		{
+			goto on_error;
+		}
+		/* PyList_SET_ITEM steals the reference to the record object
+		 */
+		PyList_SET_ITEM(
+		 list_object,
+		 (Py_ssize_t) item_index,
+		 record_object );
+
+		if( libnk2_item_free(
+		     &item,
+		     &error ) != 1 )
+		{
+			pynk2_error_raise(
+			 error,
+			 PyExc_IOError,
+			 "%s: unable to free item: %d.",
+			 function,
+			 item_index );
+
+			libcerror_error_free(
+			 &error );
+
+			goto on_error;
+		}
+	}
+	if( entry_types != NULL )
+	{
+		PyMem_Free(
+		 entry_types );
+	}
+	return( list_object );
+
+on_error:
+	if( item != NULL )
+	{
+		libnk2_item_free(
+		 &item,
+		 NULL );
+	}
+	if( list_object != NULL )
+	{
+		Py_DecRef(
+		 list_object );
+	}
+	if( entry_types != NULL )
+	{
+		PyMem_Free(
+		 entry_types );
+	}
+	if( sequence_object != NULL )
+	{
+		Py_DecRef(
+		 sequence_object );
+	}
+	return( NULL );
+}
@@ -48,6 +48,18 @@ struct pynk2_file
 	/* The libbfio file IO handle
 	 */
 	libbfio_handle_t *file_io_handle;
+
+	/* The memory mapped file data
+	 */
+	uint8_t *mapped_data;
+
+	/* The memory mapped file data size
+	 */
+	size_t mapped_data_size;
+
+	/* The number of buffers that export data of the file
+	 */
+	Py_ssize_t number_of_exports;
 };
 
 extern PyMethodDef pynk2_file_object_methods[];
@@ -73,6 +85,13 @@ PyObject *pynk2_file_open_file_object(
            PyObject *arguments,
            PyObject *keywords );
 
+int pynk2_file_map_file_object(
+     pynk2_file_t *pynk2_file,
+     PyObject *file_object );
+
+void pynk2_file_unmap_file_object(
+      pynk2_file_t *pynk2_file );
+
 PyObject *pynk2_file_close(
            pynk2_file_t *pynk2_file,
            PyObject *arguments );
@@ -120,6 +139,11 @@ PyObject *pynk2_file_get_items(
            pynk2_file_t *pynk2_file,
            PyObject *arguments );
 
+PyObject *pynk2_file_to_records(
+           pynk2_file_t *pynk2_file,
+           PyObject *arguments,
+           PyObject *keywords );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -121,11 +121,13 @@ on_error:
 }
 
 /* Initializes the file object IO handle
+ * A read_ahead_size of 0 disables the read-ahead buffer
  * Returns 1 if successful or -1 on error
  */
 int pynk2_file_object_initialize(
      libbfio_handle_t **handle,
      PyObject *file_object,
+     size_t read_ahead_size,
      libcerror_error_t **error )
 {
 	pynk2_file_object_io_handle_t *file_object_io_handle = NULL;
@@ -153,6 +155,17 @@ int pynk2_file_object_initialize(
 
 		return( -1 );
 	}
+	if( read_ahead_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid read-ahead size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
 	if( pynk2_file_object_io_handle_initialize(
 	     &file_object_io_handle,
 	     file_object,
@@ -167,6 +180,8 @@ int pynk2_file_object_initialize(
 
 		goto on_error;
 	}
+	file_object_io_handle->read_ahead_size = read_ahead_size;
+
 	if( libbfio_handle_initialize(
 	     handle,
 	     (intptr_t *) file_object_io_handle,
@@ -229,6 +244,11 @@ int pynk2_file_object_io_handle_free(
 	{
 		gil_state = PyGILState_Ensure();
 
+		if( ( *file_object_io_handle )->read_ahead_buffer != NULL )
+		{
+			PyMem_Free(
+			 ( *file_object_io_handle )->read_ahead_buffer );
+		}
 		Py_DecRef(
 		 ( *file_object_io_handle )->file_object );
 
@@ -306,6 +326,8 @@ int pynk2_file_object_io_handle_clone(
 
 		return( -1 );
 	}
+	( *destination_file_object_io_handle )->read_ahead_size = source_file_object_io_handle->read_ahead_size;
+
 	return( 1 );
 }
 
@@ -317,7 +339,9 @@ int pynk2_file_object_io_handle_open(
      int access_flags,
      libcerror_error_t **error )
 {
-	static char *function = "pynk2_file_object_io_handle_open";
+	static char *function      = "pynk2_file_object_io_handle_open";
+	PyGILState_STATE gil_state = 0;
+	off64_t current_offset     = 0;
 
 	if( file_object_io_handle == NULL )
 	{
@@ -364,9 +388,34 @@ int pynk2_file_object_io_handle_open(
 
 		return( -1 );
 	}
-	/* No need to do anything here, because the file object is already open
+	/* No need to open the file object, because it is already open, but the
+	 * current offset is tracked by the IO handle
 	 */
-	file_object_io_handle->access_flags = access_flags;
+	gil_state = PyGILState_Ensure();
+
+	if( pynk2_file_object_get_offset(
+	     file_object_io_handle->file_object,
+	     &current_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to retrieve current offset in file object.",
+		 function );
+
+		PyGILState_Release(
+		 gil_state );
+
+		return( -1 );
+	}
+	PyGILState_Release(
+	 gil_state );
+
+	file_object_io_handle->access_flags         = access_flags;
+	file_object_io_handle->current_offset       = current_offset;
+	file_object_io_handle->read_ahead_data_size = 0;
 
 	return( 1 );
 }
@@ -404,7 +453,8 @@ int pynk2_file_object_io_handle_close(
 	}
 	/* Do not close the file object, have Python deal with it
 	 */
-	file_object_io_handle->access_flags = 0;
+	file_object_io_handle->access_flags         = 0;
+	file_object_io_handle->read_ahead_data_size = 0;
 
 	return( 0 );
 }
@@ -614,6 +664,8 @@ on_error:
 }
 
 /* Reads a buffer from the file object IO handle
+ * Small reads are served from the read-ahead buffer, so that the file object
+ * read method is not called for every read
  * Returns the number of bytes read if successful, or -1 on error
  */
 ssize_t pynk2_file_object_io_handle_read(
@@ -624,6 +676,8 @@ ssize_t pynk2_file_object_io_handle_read(
 {
 	static char *function      = "pynk2_file_object_io_handle_read";
 	PyGILState_STATE gil_state = 0;
+	size_t buffer_offset       = 0;
+	size_t read_size           = 0;
 	ssize_t read_count         = 0;
 
 	if( file_object_io_handle == NULL )
@@ -637,29 +691,154 @@ ssize_t pynk2_file_object_io_handle_read(
 
 		return( -1 );
 	}
-	gil_state = PyGILState_Ensure();
-
-	read_count = pynk2_file_object_read_buffer(
-	              file_object_io_handle->file_object,
-	              buffer,
-	              size,
-	              error );
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
 
-	if( read_count == -1 )
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read from file object.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
 		 function );
 
-		goto on_error;
+		return( -1 );
+	}
+	gil_state = PyGILState_Ensure();
+
+	while( buffer_offset < size )
+	{
+		if( ( file_object_io_handle->current_offset >= file_object_io_handle->read_ahead_offset )
+		 && ( file_object_io_handle->current_offset < (off64_t) ( file_object_io_handle->read_ahead_offset + file_object_io_handle->read_ahead_data_size ) ) )
+		{
+			read_size = file_object_io_handle->read_ahead_data_size
+			          - (size_t) ( file_object_io_handle->current_offset - file_object_io_handle->read_ahead_offset );
+
+			if( read_size > ( size - buffer_offset ) )
+			{
+				read_size = size - buffer_offset;
+			}
+			if( memory_copy(
+			     &( buffer[ buffer_offset ] ),
+			     &( file_object_io_handle->read_ahead_buffer[ file_object_io_handle->current_offset - file_object_io_handle->read_ahead_offset ] ),
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy read-ahead data to buffer.",
+				 function );
+
+				goto on_error;
+			}
+			buffer_offset                         += read_size;
+			file_object_io_handle->current_offset += (off64_t) read_size;
+
+			continue;
+		}
+		/* The file object is shared with clones of the IO handle, hence
+		 * its offset is set before every read
+		 */
+		if( pynk2_file_object_seek_offset(
+		     file_object_io_handle->file_object,
+		     file_object_io_handle->current_offset,
+		     SEEK_SET,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek in file object.",
+			 function );
+
+			goto on_error;
+		}
+		/* Reads that are larger than the read-ahead buffer are not buffered
+		 */
+		if( ( size - buffer_offset ) >= file_object_io_handle->read_ahead_size )
+		{
+			read_count = pynk2_file_object_read_buffer(
+			              file_object_io_handle->file_object,
+			              &( buffer[ buffer_offset ] ),
+			              size - buffer_offset,
+			              error );
+
+			if( read_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read from file object.",
+				 function );
+
+				goto on_error;
+			}
+			buffer_offset                         += (size_t) read_count;
+			file_object_io_handle->current_offset += (off64_t) read_count;
+
+			break;
+		}
+		if( file_object_io_handle->read_ahead_buffer == NULL )
+		{
+			file_object_io_handle->read_ahead_buffer = (uint8_t *) PyMem_Malloc(
+			                                                        sizeof( uint8_t ) * file_object_io_handle->read_ahead_size );
+
+			if( file_object_io_handle->read_ahead_buffer == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create read-ahead buffer.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		file_object_io_handle->read_ahead_offset    = file_object_io_handle->current_offset;
+		file_object_io_handle->read_ahead_data_size = 0;
+
+		read_count = pynk2_file_object_read_buffer(
+		              file_object_io_handle->file_object,
+		              file_object_io_handle->read_ahead_buffer,
+		              file_object_io_handle->read_ahead_size,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from file object.",
+			 function );
+
+			goto on_error;
+		}
+		/* Stop at the end of the file object
+		 */
+		if( read_count == 0 )
+		{
+			break;
+		}
+		file_object_io_handle->read_ahead_data_size = (size_t) read_count;
 	}
 	PyGILState_Release(
 	 gil_state );
 
-	return( read_count );
+	return( (ssize_t) buffer_offset );
 
 on_error:
 	PyGILState_Release(
@@ -1130,6 +1309,8 @@ on_error:
 }
 
 /* Seeks a certain offset within the file object IO handle
+ * The file object is only accessed when seeking relative to the end,
+ * otherwise the offset is set when reading
  * Returns the offset if the seek is successful or -1 on error
  */
 off64_t pynk2_file_object_io_handle_seek_offset(
@@ -1152,39 +1333,71 @@ off64_t pynk2_file_object_io_handle_seek_offset(
 
 		return( -1 );
 	}
-	gil_state = PyGILState_Ensure();
-
-	if( pynk2_file_object_seek_offset(
-	     file_object_io_handle->file_object,
-	     offset,
-	     whence,
-	     error ) != 1 )
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek in file object.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( pynk2_file_object_get_offset(
-	     file_object_io_handle->file_object,
-	     &offset,
-	     error ) != 1 )
+	if( whence == SEEK_END )
+	{
+		gil_state = PyGILState_Ensure();
+
+		if( pynk2_file_object_seek_offset(
+		     file_object_io_handle->file_object,
+		     offset,
+		     whence,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek in file object.",
+			 function );
+
+			goto on_error;
+		}
+		if( pynk2_file_object_get_offset(
+		     file_object_io_handle->file_object,
+		     &offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to retrieve current offset in file object.",
+			 function );
+
+			goto on_error;
+		}
+		PyGILState_Release(
+		 gil_state );
+	}
+	else if( whence == SEEK_CUR )
+	{
+		offset += file_object_io_handle->current_offset;
+	}
+	if( offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to retrieve current offset in file object.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	PyGILState_Release(
-	 gil_state );
+	file_object_io_handle->current_offset = offset;
 
 	return( offset );
 
@@ -33,6 +33,10 @@
 extern "C" {
 #endif
 
+/* The default size of the read-ahead buffer
+ */
+#define PYNK2_FILE_OBJECT_IO_HANDLE_DEFAULT_READ_AHEAD_SIZE	65536
+
 typedef struct pynk2_file_object_io_handle pynk2_file_object_io_handle_t;
 
 struct pynk2_file_object_io_handle
@@ -44,6 +48,26 @@ struct pynk2_file_object_io_handle
 	/* The access flags
 	 */
 	int access_flags;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+	/* The read-ahead buffer
+	 */
+	uint8_t *read_ahead_buffer;
+
+	/* The read-ahead size
+	 */
+	size_t read_ahead_size;
+
+	/* The offset of the data in the read-ahead buffer
+	 */
+	off64_t read_ahead_offset;
+
+	/* The size of the data in the read-ahead buffer
+	 */
+	size_t read_ahead_data_size;
 };
 
 int pynk2_file_object_io_handle_initialize(
@@ -54,6 +78,7 @@ int pynk2_file_object_io_handle_initialize(
 int pynk2_file_object_initialize(
      libbfio_handle_t **handle,
      PyObject *file_object,
+     size_t read_ahead_size,
      libcerror_error_t **error );
 
 int pynk2_file_object_io_handle_free(
@@ -27,6 +27,7 @@
 #endif
 
 #include "pynk2_error.h"
+#include "pynk2_integer.h"
 #include "pynk2_item.h"
 #include "pynk2_libcerror.h"
 #include "pynk2_libnk2.h"
@@ -37,6 +38,13 @@
 
 PyMethodDef pynk2_item_object_methods[] = {
 
+	{ "get_content_hash",
+	  (PyCFunction) pynk2_item_get_content_hash,
+	  METH_NOARGS,
+	  "get_content_hash() -> Integer\n"
+	  "\n"
+	  "Retrieves the content hash." },
+
 	{ "get_number_of_entries",
 	  (PyCFunction) pynk2_item_get_number_of_entries,
 	  METH_NOARGS,
@@ -58,12 +66,25 @@ PyMethodDef pynk2_item_object_methods[] = {
 	  "\n"
 	  "Retrieves the entry." },
 
+	{ "to_dict",
+	  (PyCFunction) pynk2_item_to_dict,
+	  METH_NOARGS,
+	  "to_dict() -> Dictionary\n"
+	  "\n"
+	  "Retrieves the decoded values of all entries as a dictionary keyed by entry type." },
+
 	/* Sentinel */
 	{ NULL, NULL, 0, NULL }
 };
 
 PyGetSetDef pynk2_item_object_get_set_definitions[] = {
 
+	{ "content_hash",
+	  (getter) pynk2_item_get_content_hash,
+	  (setter) 0,
+	  "The content hash.",
+	  NULL },
+
 	{ "number_of_entries",
 	  (getter) pynk2_item_get_number_of_entries,
 	  (setter) 0,
@@ -335,6 +356,58 @@ void pynk2_item_free(
 	 (PyObject*) pynk2_item );
 }
 
+/* Retrieves the content hash
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pynk2_item_get_content_hash(
+           pynk2_item_t *pynk2_item,
+           PyObject *arguments PYNK2_ATTRIBUTE_UNUSED )
+{
+	PyObject *integer_object = NULL;
+	libcerror_error_t *error = NULL;
+	static char *function    = "pynk2_item_get_content_hash";
+	uint64_t content_hash    = 0;
+	int result               = 0;
+
+	PYNK2_UNREFERENCED_PARAMETER( arguments )
+
+	if( pynk2_item == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid item.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libnk2_item_get_content_hash(
+	          pynk2_item->item,
+	          &content_hash,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pynk2_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve content hash.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	integer_object = pynk2_integer_unsigned_new_from_64bit(
+	                  content_hash );
+
+	return( integer_object );
+}
+
 /* Retrieves the number of entries
  * Returns a Python object if successful or NULL on error
  */
@@ -713,3 +786,205 @@ on_error:
 	return( NULL );
 }
 
+/* Creates a new dictionary of the decoded entry values of an item
+ * The dictionary is keyed by entry type, if entry_types is set only the entries
+ * of the types in entry_types are included
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pynk2_item_dict_new(
+           libnk2_item_t *item,
+           const uint32_t *entry_types,
+           int number_of_entry_types )
+{
+	PyObject *dict_object               = NULL;
+	PyObject *key_object                = NULL;
+	PyObject *value_object              = NULL;
+	libcerror_error_t *error            = NULL;
+	libnk2_record_entry_t *record_entry = NULL;
+	static char *function               = "pynk2_item_dict_new";
+	uint32_t entry_type                 = 0;
+	int entry_index                     = 0;
+	int entry_type_index                = 0;
+	int number_of_entries               = 0;
+
+	if( libnk2_item_get_number_of_entries(
+	     item,
+	     &number_of_entries,
+	     &error ) != 1 )
+	{
+		pynk2_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		goto on_error;
+	}
+	dict_object = PyDict_New();
+
+	if( dict_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create dict object.",
+		 function );
+
+		goto on_error;
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libnk2_item_get_entry_by_index(
+		     item,
+		     entry_index,
+		     &record_entry,
+		     &error ) != 1 )
+		{
+			pynk2_error_raise(
+			 error,
+			 PyExc_IOError,
+			 "%s: unable to retrieve entry: %d.",
+			 function,
+			 entry_index );
+
+			libcerror_error_free(
+			 &error );
+
+			goto on_error;
+		}
+		if( libnk2_record_entry_get_entry_type(
+		     record_entry,
+		     &entry_type,
+		     &error ) != 1 )
+		{
+			pynk2_error_raise(
+			 error,
+			 PyExc_IOError,
+			 "%s: unable to retrieve entry: %d type.",
+			 function,
+			 entry_index );
+
+			libcerror_error_free(
+			 &error );
+
+			goto on_error;
+		}
+		if( entry_types != NULL )
+		{
+			for( entry_type_index = 0;
+			     entry_type_index < number_of_entry_types;
+			     entry_type_index++ )
+			{
+				if( entry_types[ entry_type_index ] == entry_type )
+				{
+					break;
+				}
+			}
+		}
+		if( ( entry_types == NULL )
+		 || ( entry_type_index < number_of_entry_types ) )
+		{
+			value_object = pynk2_record_entry_value_new(
+			                record_entry );
+
+			if( value_object == NULL )
+			{
+				goto on_error;
+			}
+			key_object = PyLong_FromUnsignedLong(
+			              (unsigned long) entry_type );
+
+			if( key_object == NULL )
+			{
+				goto on_error;
+			}
+			if( PyDict_SetItem(
+			     dict_object,
+			     key_object,
+			     value_object ) != 0 )
+			{
+				goto on_error;
+			}
+			Py_DecRef(
+			 key_object );
+
+			key_object = NULL;
+
+			Py_DecRef(
+			 value_object );
+
+			value_object = NULL;
+		}
+		if( libnk2_record_entry_free(
+		     &record_entry,
+		     &error ) != 1 )
+		{
+			pynk2_error_raise(
+			 error,
+			 PyExc_IOError,
+			 "%s: unable to free entry: %d.",
+			 function,
+			 entry_index );
+
+			libcerror_error_free(
+			 &error );
+
+			goto on_error;
+		}
+	}
+	return( dict_object );
+
+on_error:
+	if( record_entry != NULL )
+	{
+		libnk2_record_entry_free(
+		 &record_entry,
+		 NULL );
+	}
+	if( key_object != NULL )
+	{
+		Py_DecRef(
+		 key_object );
+	}
+	if( value_object != NULL )
+	{
+		Py_DecRef(
+		 value_object );
+	}
+	if( dict_object != NULL )
+	{
+		Py_DecRef(
+		 dict_object );
+	}
+	return( NULL );
+}
+
+/* Retrieves the decoded entry values as a dictionary keyed by entry type
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pynk2_item_to_dict(
+           pynk2_item_t *pynk2_item,
+           PyObject *arguments PYNK2_ATTRIBUTE_UNUSED )
+{
+	static char *function = "pynk2_item_to_dict";
+
+	PYNK2_UNREFERENCED_PARAMETER( arguments )
+
+	if( pynk2_item == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid item.",
+		 function );
+
+		return( NULL );
+	}
+	return( pynk2_item_dict_new(
+	         pynk2_item->item,
+	         NULL,
+	         0 ) );
+}
@@ -62,6 +62,10 @@ int pynk2_item_init(
 void pynk2_item_free(
       pynk2_item_t *pynk2_item );
 
+PyObject *pynk2_item_get_content_hash(
+           pynk2_item_t *pynk2_item,
+           PyObject *arguments );
+
 PyObject *pynk2_item_get_number_of_entries(
            pynk2_item_t *pynk2_item,
            PyObject *arguments );
@@ -84,6 +88,15 @@ PyObject *pynk2_item_get_entry_by_type(
            PyObject *arguments,
            PyObject *keywords );
 
+PyObject *pynk2_item_dict_new(
+           libnk2_item_t *item,
+           const uint32_t *entry_types,
+           int number_of_entry_types );
+
+PyObject *pynk2_item_to_dict(
+           pynk2_item_t *pynk2_item,
+           PyObject *arguments );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -28,8 +28,10 @@
 
 #include "pynk2_datetime.h"
 #include "pynk2_error.h"
+#include "pynk2_file.h"
 #include "pynk2_guid.h"
 #include "pynk2_integer.h"
+#include "pynk2_item.h"
 #include "pynk2_libcerror.h"
 #include "pynk2_libnk2.h"
 #include "pynk2_python.h"
@@ -59,6 +61,16 @@ PyMethodDef pynk2_record_entry_object_methods[] = {
 	  "\n"
 	  "Retrieves the data." },
 
+#if PY_MAJOR_VERSION >= 3
+	{ "get_data_as_memoryview",
+	  (PyCFunction) pynk2_record_entry_get_data_as_memoryview,
+	  METH_NOARGS,
+	  "get_data_as_memoryview() -> Memoryview or None\n"
+	  "\n"
+	  "Retrieves the data as a read-only memoryview without copying it.\n"
+	  "The memoryview is only valid while the file is open." },
+#endif
+
 	{ "get_data_as_boolean",
 	  (PyCFunction) pynk2_record_entry_get_data_as_boolean,
 	  METH_NOARGS,
@@ -132,6 +144,14 @@ PyGetSetDef pynk2_record_entry_object_get_set_definitions[] = {
 	  "The data.",
 	  NULL },
 
+#if PY_MAJOR_VERSION >= 3
+	{ "data_as_memoryview",
+	  (getter) pynk2_record_entry_get_data_as_memoryview,
+	  (setter) 0,
+	  "The data as a read-only memoryview.",
+	  NULL },
+#endif
+
 	{ "data_as_boolean",
 	  (getter) pynk2_record_entry_get_data_as_boolean,
 	  (setter) 0,
@@ -178,6 +198,15 @@ PyGetSetDef pynk2_record_entry_object_get_set_definitions[] = {
 	{ NULL, NULL, NULL, NULL, NULL }
 };
 
+#if PY_MAJOR_VERSION >= 3
+PyBufferProcs pynk2_record_entry_buffer_procedures = {
+	/* bf_getbuffer */
+	(getbufferproc) pynk2_record_entry_get_buffer,
+	/* bf_releasebuffer */
+	(releasebufferproc) pynk2_record_entry_release_buffer
+};
+#endif
+
 PyTypeObject pynk2_record_entry_type_object = {
 	PyVarObject_HEAD_INIT( NULL, 0 )
 
@@ -216,7 +245,11 @@ PyTypeObject pynk2_record_entry_type_object = {
 	/* tp_setattro */
 	0,
 	/* tp_as_buffer */
+#if PY_MAJOR_VERSION >= 3
+	&pynk2_record_entry_buffer_procedures,
+#else
 	0,
+#endif
 	/* tp_flags */
 	Py_TPFLAGS_DEFAULT,
 	/* tp_doc */
@@ -561,7 +594,7 @@ PyObject *pynk2_record_entry_get_data(
 {
 	PyObject *bytes_object   = NULL;
 	libcerror_error_t *error = NULL;
-	char *data               = NULL;
+	const uint8_t *data      = NULL;
 	static char *function    = "pynk2_record_entry_get_data";
 	size_t data_size         = 0;
 	int result               = 0;
@@ -597,7 +630,7 @@ PyObject *pynk2_record_entry_get_data(
 		libcerror_error_free(
 		 &error );
 
-		goto on_error;
+		return( NULL );
 	}
 	else if( ( result == 0 )
 	      || ( data_size == 0 ) )
@@ -607,24 +640,14 @@ PyObject *pynk2_record_entry_get_data(
 
 		return( Py_None );
 	}
-	data = (char *) PyMem_Malloc(
-	                 sizeof( char ) * data_size );
-
-	if( data == NULL )
-	{
-		PyErr_Format(
-		 PyExc_MemoryError,
-		 "%s: unable to create data.",
-		 function );
-
-		goto on_error;
-	}
+	/* The data is referenced directly so that it is only copied once into the Bytes object
+	 */
 	Py_BEGIN_ALLOW_THREADS
 
-	result = libnk2_record_entry_get_data(
+	result = libnk2_record_entry_get_data_pointer(
 	          pynk2_record_entry->record_entry,
-	          (uint8_t *) data,
-	          data_size,
+	          &data,
+	          &data_size,
 	          &error );
 
 	Py_END_ALLOW_THREADS
@@ -640,17 +663,17 @@ PyObject *pynk2_record_entry_get_data(
 		libcerror_error_free(
 		 &error );
 
-		goto on_error;
+		return( NULL );
 	}
 	/* This is a binary string so include the full size
 	 */
 #if PY_MAJOR_VERSION >= 3
 	bytes_object = PyBytes_FromStringAndSize(
-	                data,
+	                (char *) data,
 	                (Py_ssize_t) data_size );
 #else
 	bytes_object = PyString_FromStringAndSize(
-	                data,
+	                (char *) data,
 	                (Py_ssize_t) data_size );
 #endif
 	if( bytes_object == NULL )
@@ -660,22 +683,240 @@ PyObject *pynk2_record_entry_get_data(
 		 "%s: unable to convert data into Bytes object.",
 		 function );
 
-		goto on_error;
+		return( NULL );
 	}
-	PyMem_Free(
-	 data );
-
 	return( bytes_object );
+}
 
-on_error:
-	if( data != NULL )
+/* Retrieves the file object that owns the data of the record entry
+ * Returns the file object if successful or NULL if not available
+ */
+pynk2_file_t *pynk2_record_entry_get_file_object(
+               pynk2_record_entry_t *pynk2_record_entry )
+{
+	PyObject *parent_object = NULL;
+
+	if( pynk2_record_entry == NULL )
 	{
-		PyMem_Free(
-		 data );
+		return( NULL );
 	}
-	return( NULL );
+	parent_object = pynk2_record_entry->parent_object;
+
+	if( ( parent_object == NULL )
+	 || ( PyObject_TypeCheck(
+	       parent_object,
+	       &pynk2_item_type_object ) == 0 ) )
+	{
+		return( NULL );
+	}
+	parent_object = ( (pynk2_item_t *) parent_object )->parent_object;
+
+	if( ( parent_object == NULL )
+	 || ( PyObject_TypeCheck(
+	       parent_object,
+	       &pynk2_file_type_object ) == 0 ) )
+	{
+		return( NULL );
+	}
+	return( (pynk2_file_t *) parent_object );
 }
 
+#if PY_MAJOR_VERSION >= 3
+
+/* Retrieves a read-only buffer of the data
+ * The buffer references the data of the record entry and is not a copy
+ * Returns 0 if successful or -1 on error
+ */
+int pynk2_record_entry_get_buffer(
+     pynk2_record_entry_t *pynk2_record_entry,
+     Py_buffer *buffer,
+     int flags )
+{
+	static uint8_t empty_data[ 1 ] = { 0 };
+
+	libcerror_error_t *error       = NULL;
+	pynk2_file_t *pynk2_file       = NULL;
+	const uint8_t *data            = NULL;
+	static char *function          = "pynk2_record_entry_get_buffer";
+	size_t data_size               = 0;
+	int result                     = 0;
+
+	if( buffer == NULL )
+	{
+		PyErr_Format(
+		 PyExc_BufferError,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	buffer->obj = NULL;
+
+	if( pynk2_record_entry == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid record entry.",
+		 function );
+
+		return( -1 );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libnk2_record_entry_get_data_size(
+	          pynk2_record_entry->record_entry,
+	          &data_size,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pynk2_error_raise(
+		 error,
+		 PyExc_BufferError,
+		 "%s: unable to retrieve data size.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( -1 );
+	}
+	if( data_size == 0 )
+	{
+		data = empty_data;
+	}
+	else
+	{
+		Py_BEGIN_ALLOW_THREADS
+
+		result = libnk2_record_entry_get_data_pointer(
+		          pynk2_record_entry->record_entry,
+		          &data,
+		          &data_size,
+		          &error );
+
+		Py_END_ALLOW_THREADS
+
+		if( result != 1 )
+		{
+			pynk2_error_raise(
+			 error,
+			 PyExc_BufferError,
+			 "%s: unable to retrieve data.",
+			 function );
+
+			libcerror_error_free(
+			 &error );
+
+			return( -1 );
+		}
+	}
+	/* The buffer holds a reference to the record entry object, which in turn
+	 * keeps its parent objects alive
+	 */
+	if( PyBuffer_FillInfo(
+	     buffer,
+	     (PyObject *) pynk2_record_entry,
+	     (void *) data,
+	     (Py_ssize_t) data_size,
+	     1,
+	     flags ) != 0 )
+	{
+		return( -1 );
+	}
+	/* The file cannot be closed while the buffer references its data
+	 */
+	pynk2_file = pynk2_record_entry_get_file_object(
+	              pynk2_record_entry );
+
+	if( pynk2_file != NULL )
+	{
+		pynk2_file->number_of_exports += 1;
+	}
+	return( 0 );
+}
+
+/* Releases a buffer of the data
+ */
+void pynk2_record_entry_release_buffer(
+      pynk2_record_entry_t *pynk2_record_entry,
+      Py_buffer *buffer PYNK2_ATTRIBUTE_UNUSED )
+{
+	pynk2_file_t *pynk2_file = NULL;
+
+	PYNK2_UNREFERENCED_PARAMETER( buffer )
+
+	pynk2_file = pynk2_record_entry_get_file_object(
+	              pynk2_record_entry );
+
+	if( ( pynk2_file != NULL )
+	 && ( pynk2_file->number_of_exports > 0 ) )
+	{
+		pynk2_file->number_of_exports -= 1;
+	}
+}
+
+/* Retrieves the data as a read-only memoryview
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pynk2_record_entry_get_data_as_memoryview(
+           pynk2_record_entry_t *pynk2_record_entry,
+           PyObject *arguments PYNK2_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "pynk2_record_entry_get_data_as_memoryview";
+	size_t data_size         = 0;
+	int result               = 0;
+
+	PYNK2_UNREFERENCED_PARAMETER( arguments )
+
+	if( pynk2_record_entry == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid record entry.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libnk2_record_entry_get_data_size(
+	          pynk2_record_entry->record_entry,
+	          &data_size,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result == -1 )
+	{
+		pynk2_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve data size.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	else if( ( result == 0 )
+	      || ( data_size == 0 ) )
+	{
+		Py_IncRef(
+		 Py_None );
+
+		return( Py_None );
+	}
+	return( PyMemoryView_FromObject(
+	         (PyObject *) pynk2_record_entry ) );
+}
+
+#endif /* PY_MAJOR_VERSION >= 3 */
+
 /* Retrieves the data as a boolean value
  * Returns a Python object if successful or NULL on error
  */
@@ -1278,3 +1519,278 @@ PyObject *pynk2_record_entry_get_data_as_guid(
 	return( string_object );
 }
 
+/* Creates a new object of the decoded data of a record entry
+ * This function is used by the bulk conversion functions, the record entry
+ * data is held in memory hence the GIL is not released for every value
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pynk2_record_entry_value_new(
+           libnk2_record_entry_t *record_entry )
+{
+	uint8_t guid_data[ 16 ];
+	uint8_t utf8_string_data[ 256 ];
+
+	PyObject *value_object   = NULL;
+	libcerror_error_t *error = NULL;
+	const uint8_t *data      = NULL;
+	uint8_t *utf8_string     = NULL;
+	static char *function    = "pynk2_record_entry_value_new";
+	size_t data_size         = 0;
+	size_t utf8_string_size  = 0;
+	double value_double      = 0.0;
+	uint64_t value_64bit     = 0;
+	uint32_t value_32bit     = 0;
+	uint32_t value_type      = 0;
+	uint16_t value_16bit     = 0;
+	uint8_t value_boolean    = 0;
+	int result               = 0;
+
+	if( libnk2_record_entry_get_value_type(
+	     record_entry,
+	     &value_type,
+	     &error ) != 1 )
+	{
+		pynk2_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve value type.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	switch( value_type )
+	{
+		case LIBNK2_VALUE_TYPE_BOOLEAN:
+			result = libnk2_record_entry_get_data_as_boolean(
+			          record_entry,
+			          &value_boolean,
+			          &error );
+
+			if( result == 1 )
+			{
+				value_object = PyBool_FromLong(
+				                (long) ( value_boolean != 0 ) );
+			}
+			break;
+
+		case LIBNK2_VALUE_TYPE_INTEGER_16BIT_SIGNED:
+			result = libnk2_record_entry_get_data_as_16bit_integer(
+			          record_entry,
+			          &value_16bit,
+			          &error );
+
+			if( result == 1 )
+			{
+#if PY_MAJOR_VERSION >= 3
+				value_object = PyLong_FromLong(
+				                (long) ( (int16_t) value_16bit ) );
+#else
+				value_object = PyInt_FromLong(
+				                (long) ( (int16_t) value_16bit ) );
+#endif
+			}
+			break;
+
+		case LIBNK2_VALUE_TYPE_INTEGER_32BIT_SIGNED:
+			result = libnk2_record_entry_get_data_as_32bit_integer(
+			          record_entry,
+			          &value_32bit,
+			          &error );
+
+			if( result == 1 )
+			{
+#if PY_MAJOR_VERSION >= 3
+				value_object = PyLong_FromLong(
+				                (long) ( (int32_t) value_32bit ) );
+#else
+				value_object = PyInt_FromLong(
+				                (long) ( (int32_t) value_32bit ) );
+#endif
+			}
+			break;
+
+		case LIBNK2_VALUE_TYPE_INTEGER_64BIT_SIGNED:
+			result = libnk2_record_entry_get_data_as_64bit_integer(
+			          record_entry,
+			          &value_64bit,
+			          &error );
+
+			if( result == 1 )
+			{
+				value_object = pynk2_integer_signed_new_from_64bit(
+				                (int64_t) value_64bit );
+			}
+			break;
+
+		case LIBNK2_VALUE_TYPE_FLOAT_32BIT:
+		case LIBNK2_VALUE_TYPE_DOUBLE_64BIT:
+			result = libnk2_record_entry_get_data_as_floating_point(
+			          record_entry,
+			          &value_double,
+			          &error );
+
+			if( result == 1 )
+			{
+				value_object = PyFloat_FromDouble(
+				                value_double );
+			}
+			break;
+
+		case LIBNK2_VALUE_TYPE_FILETIME:
+			result = libnk2_record_entry_get_data_as_filetime(
+			          record_entry,
+			          &value_64bit,
+			          &error );
+
+			if( result == 1 )
+			{
+				value_object = pynk2_datetime_new_from_filetime(
+				                value_64bit );
+			}
+			break;
+
+		case LIBNK2_VALUE_TYPE_FLOATINGTIME:
+			result = libnk2_record_entry_get_data_as_floatingtime(
+			          record_entry,
+			          &value_64bit,
+			          &error );
+
+			if( result == 1 )
+			{
+				value_object = pynk2_datetime_new_from_floatingtime(
+				                value_64bit );
+			}
+			break;
+
+		case LIBNK2_VALUE_TYPE_GUID:
+			result = libnk2_record_entry_get_data_as_guid(
+			          record_entry,
+			          guid_data,
+			          16,
+			          &error );
+
+			if( result == 1 )
+			{
+				value_object = pynk2_string_new_from_guid(
+				                guid_data,
+				                16 );
+			}
+			break;
+
+		case LIBNK2_VALUE_TYPE_STRING_ASCII:
+		case LIBNK2_VALUE_TYPE_STRING_UNICODE:
+			result = libnk2_record_entry_get_data_as_utf8_string_size(
+			          record_entry,
+			          &utf8_string_size,
+			          &error );
+
+			if( ( result != 1 )
+			 || ( utf8_string_size == 0 ) )
+			{
+				break;
+			}
+			/* Most strings fit in the buffer on the stack which saves an allocation per value
+			 */
+			if( utf8_string_size <= 256 )
+			{
+				utf8_string = utf8_string_data;
+			}
+			else
+			{
+				utf8_string = (uint8_t *) PyMem_Malloc(
+				                           sizeof( uint8_t ) * utf8_string_size );
+
+				if( utf8_string == NULL )
+				{
+					PyErr_Format(
+					 PyExc_MemoryError,
+					 "%s: unable to create UTF-8 string.",
+					 function );
+
+					return( NULL );
+				}
+			}
+			result = libnk2_record_entry_get_data_as_utf8_string(
+			          record_entry,
+			          utf8_string,
+			          utf8_string_size,
+			          &error );
+
+			if( result == 1 )
+			{
+				/* Pass the string length to PyUnicode_DecodeUTF8 otherwise it makes
+				 * the end of string character is part of the string
+				 */
+				value_object = PyUnicode_DecodeUTF8(
+				                (char *) utf8_string,
+				                (Py_ssize_t) utf8_string_size - 1,
+				                NULL );
+			}
+			if( utf8_string != utf8_string_data )
+			{
+				PyMem_Free(
+				 utf8_string );
+			}
+			break;
+
+		default:
+			result = libnk2_record_entry_get_data_size(
+			          record_entry,
+			          &data_size,
+			          &error );
+
+			if( ( result != 1 )
+			 || ( data_size == 0 ) )
+			{
+				break;
+			}
+			result = libnk2_record_entry_get_data_pointer(
+			          record_entry,
+			          &data,
+			          &data_size,
+			          &error );
+
+			if( result == 1 )
+			{
+#if PY_MAJOR_VERSION >= 3
+				value_object = PyBytes_FromStringAndSize(
+				                (char *) data,
+				                (Py_ssize_t) data_size );
+#else
+				value_object = PyString_FromStringAndSize(
+				                (char *) data,
+				                (Py_ssize_t) data_size );
+#endif
+			}
+			break;
+	}
+	if( result == -1 )
+	{
+		pynk2_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve value of type: 0x%04" PRIx32 ".",
+		 function,
+		 value_type );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	else if( value_object == NULL )
+	{
+		if( PyErr_Occurred() != NULL )
+		{
+			return( NULL );
+		}
+		Py_IncRef(
+		 Py_None );
+
+		return( Py_None );
+	}
+	return( value_object );
+}
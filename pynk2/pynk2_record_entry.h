@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "pynk2_file.h"
 #include "pynk2_libnk2.h"
 #include "pynk2_python.h"
 
@@ -52,6 +53,10 @@ struct pynk2_record_entry
 extern PyMethodDef pynk2_record_entry_object_methods[];
 extern PyTypeObject pynk2_record_entry_type_object;
 
+#if PY_MAJOR_VERSION >= 3
+extern PyBufferProcs pynk2_record_entry_buffer_procedures;
+#endif
+
 PyObject *pynk2_record_entry_new(
            PyTypeObject *type_object,
            libnk2_record_entry_t *record_entry,
@@ -75,6 +80,26 @@ PyObject *pynk2_record_entry_get_data(
            pynk2_record_entry_t *pynk2_record_entry,
            PyObject *arguments );
 
+pynk2_file_t *pynk2_record_entry_get_file_object(
+               pynk2_record_entry_t *pynk2_record_entry );
+
+#if PY_MAJOR_VERSION >= 3
+
+int pynk2_record_entry_get_buffer(
+     pynk2_record_entry_t *pynk2_record_entry,
+     Py_buffer *buffer,
+     int flags );
+
+void pynk2_record_entry_release_buffer(
+      pynk2_record_entry_t *pynk2_record_entry,
+      Py_buffer *buffer );
+
+PyObject *pynk2_record_entry_get_data_as_memoryview(
+           pynk2_record_entry_t *pynk2_record_entry,
+           PyObject *arguments );
+
+#endif /* PY_MAJOR_VERSION >= 3 */
+
 PyObject *pynk2_record_entry_get_data_as_boolean(
            pynk2_record_entry_t *pynk2_record_entry,
            PyObject *arguments );
@@ -103,6 +128,9 @@ PyObject *pynk2_record_entry_get_data_as_guid(
            pynk2_record_entry_t *pynk2_record_entry,
            PyObject *arguments );
 
+PyObject *pynk2_record_entry_value_new(
+           libnk2_record_entry_t *record_entry );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,1005 @@
+/*
+ * Library benchmark program
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "nk2_test_functions.h"
+#include "nk2_test_getopt.h"
+#include "nk2_test_libbfio.h"
+#include "nk2_test_libcerror.h"
+#include "nk2_test_libnk2.h"
+#include "nk2_test_unused.h"
+
+#include "../libnk2/libnk2_statistics.h"
+
+#if !defined( LIBNK2_HAVE_BFIO )
+
+LIBNK2_EXTERN \
+int libnk2_file_open_file_io_handle(
+     libnk2_file_t *file,
+     libbfio_handle_t *file_io_handle,
+     int access_flags,
+     libnk2_error_t **error );
+
+#endif /* !defined( LIBNK2_HAVE_BFIO ) */
+
+/* The entry types used in the synthetic corpus
+ */
+#define NK2_BENCH_ENTRY_TYPE_DISPLAY_NAME	0x3001
+#define NK2_BENCH_ENTRY_TYPE_EMAIL_ADDRESS	0x3003
+#define NK2_BENCH_ENTRY_TYPE_FIRST_INTEGER	0x6000
+
+/* The size of a record entry in the synthetic corpus
+ */
+#define NK2_BENCH_RECORD_ENTRY_SIZE		16
+
+/* Prints usage information
+ */
+void nk2_bench_usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use nk2_bench to benchmark libnk2 against a synthetic corpus.\n\n" );
+
+	fprintf( stream, "Usage: nk2_bench [ -c codepage ] [ -e entries ] [ -i items ]\n"
+	                 "                 [ -r iterations ] [ -s size ] [ -h ]\n\n" );
+
+	fprintf( stream, "\t-c: codepage of the extended ASCII strings, for example 1252\n"
+	                 "\t    (default is 1252), 20127 generates 7-bit ASCII only\n" );
+	fprintf( stream, "\t-e: number of entries per item (default is 8, minimum is 2)\n" );
+	fprintf( stream, "\t-h: shows this help\n" );
+	fprintf( stream, "\t-i: number of items (default is 1000)\n" );
+	fprintf( stream, "\t-r: number of iterations (default is 10)\n" );
+	fprintf( stream, "\t-s: number of characters per string value (default is 32)\n" );
+}
+
+/* Copies a decimal value from a system string
+ * Returns 1 if successful or -1 on error
+ */
+int nk2_bench_copy_from_system_string(
+     const system_character_t *string,
+     uint32_t *value_32bit )
+{
+	uint64_t value_64bit = 0;
+	size_t string_index  = 0;
+
+	if( ( string == NULL )
+	 || ( string[ 0 ] == 0 )
+	 || ( value_32bit == NULL ) )
+	{
+		return( -1 );
+	}
+	for( string_index = 0;
+	     string[ string_index ] != 0;
+	     string_index++ )
+	{
+		if( ( string[ string_index ] < (system_character_t) '0' )
+		 || ( string[ string_index ] > (system_character_t) '9' ) )
+		{
+			return( -1 );
+		}
+		value_64bit *= 10;
+		value_64bit += (uint64_t) ( string[ string_index ] - (system_character_t) '0' );
+
+		if( value_64bit > (uint64_t) 0xffffffffUL )
+		{
+			return( -1 );
+		}
+	}
+	*value_32bit = (uint32_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Writes a record entry header into the corpus data
+ */
+void nk2_bench_write_record_entry(
+      uint8_t *data,
+      uint16_t value_type,
+      uint16_t entry_type,
+      uint32_t value_32bit )
+{
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 0 ] ),
+	 value_type );
+
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 2 ] ),
+	 entry_type );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 4 ] ),
+	 0 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 8 ] ),
+	 value_32bit );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 12 ] ),
+	 0 );
+}
+
+/* Generates a synthetic NK2 corpus
+ * Every item consists of (number of entries per item - 2) 32-bit integer entries
+ * followed by an extended ASCII e-mail address and an UTF-16 display name
+ * Returns 1 if successful or -1 on error
+ */
+int nk2_bench_generate_corpus(
+     uint8_t **data,
+     size_t *data_size,
+     uint32_t number_of_items,
+     uint32_t number_of_entries_per_item,
+     uint32_t string_size,
+     int ascii_codepage,
+     libcerror_error_t **error )
+{
+	uint8_t *corpus_data        = NULL;
+	static char *function       = "nk2_bench_generate_corpus";
+	size_t ascii_string_size    = 0;
+	size_t data_offset          = 0;
+	size_t item_size            = 0;
+	size_t unicode_string_size  = 0;
+	uint64_t corpus_size        = 0;
+	uint32_t character_index    = 0;
+	uint32_t entry_index        = 0;
+	uint32_t item_index         = 0;
+	uint16_t unicode_character  = 0;
+	uint8_t ascii_character     = 0;
+
+	if( ( data == NULL )
+	 || ( data_size == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_entries_per_item < 2 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid number of entries per item value too small.",
+		 function );
+
+		return( -1 );
+	}
+	ascii_string_size   = (size_t) string_size + 1;
+	unicode_string_size = ( (size_t) string_size + 1 ) * 2;
+
+	item_size = 4
+	          + ( (size_t) number_of_entries_per_item * NK2_BENCH_RECORD_ENTRY_SIZE )
+	          + 4 + ascii_string_size
+	          + 4 + unicode_string_size;
+
+	corpus_size = 16 + ( (uint64_t) number_of_items * item_size ) + 12;
+
+	if( corpus_size > (uint64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid corpus size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	corpus_data = (uint8_t *) memory_allocate(
+	                           (size_t) corpus_size );
+
+	if( corpus_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create corpus data.",
+		 function );
+
+		return( -1 );
+	}
+	/* The file header
+	 */
+	corpus_data[ 0 ] = 0x0d;
+	corpus_data[ 1 ] = 0xf0;
+	corpus_data[ 2 ] = 0xad;
+	corpus_data[ 3 ] = 0xba;
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( corpus_data[ 4 ] ),
+	 0x0000000aUL );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( corpus_data[ 8 ] ),
+	 0x00000001UL );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( corpus_data[ 12 ] ),
+	 number_of_items );
+
+	data_offset = 16;
+
+	for( item_index = 0;
+	     item_index < number_of_items;
+	     item_index++ )
+	{
+		byte_stream_copy_from_uint32_little_endian(
+		 &( corpus_data[ data_offset ] ),
+		 number_of_entries_per_item );
+
+		data_offset += 4;
+
+		for( entry_index = 0;
+		     entry_index < ( number_of_entries_per_item - 2 );
+		     entry_index++ )
+		{
+			nk2_bench_write_record_entry(
+			 &( corpus_data[ data_offset ] ),
+			 LIBNK2_VALUE_TYPE_INTEGER_32BIT_SIGNED,
+			 (uint16_t) ( NK2_BENCH_ENTRY_TYPE_FIRST_INTEGER + entry_index ),
+			 item_index );
+
+			data_offset += NK2_BENCH_RECORD_ENTRY_SIZE;
+		}
+		nk2_bench_write_record_entry(
+		 &( corpus_data[ data_offset ] ),
+		 LIBNK2_VALUE_TYPE_STRING_ASCII,
+		 NK2_BENCH_ENTRY_TYPE_EMAIL_ADDRESS,
+		 0 );
+
+		data_offset += NK2_BENCH_RECORD_ENTRY_SIZE;
+
+		byte_stream_copy_from_uint32_little_endian(
+		 &( corpus_data[ data_offset ] ),
+		 (uint32_t) ascii_string_size );
+
+		data_offset += 4;
+
+		for( character_index = 0;
+		     character_index < string_size;
+		     character_index++ )
+		{
+			if( ( ascii_codepage != LIBNK2_CODEPAGE_ASCII )
+			 && ( ( character_index % 4 ) == 3 ) )
+			{
+				ascii_character = 0xe9;
+			}
+			else
+			{
+				ascii_character = (uint8_t) ( 'a' + ( ( item_index + character_index ) % 26 ) );
+			}
+			corpus_data[ data_offset++ ] = ascii_character;
+		}
+		corpus_data[ data_offset++ ] = 0;
+
+		nk2_bench_write_record_entry(
+		 &( corpus_data[ data_offset ] ),
+		 LIBNK2_VALUE_TYPE_STRING_UNICODE,
+		 NK2_BENCH_ENTRY_TYPE_DISPLAY_NAME,
+		 0 );
+
+		data_offset += NK2_BENCH_RECORD_ENTRY_SIZE;
+
+		byte_stream_copy_from_uint32_little_endian(
+		 &( corpus_data[ data_offset ] ),
+		 (uint32_t) unicode_string_size );
+
+		data_offset += 4;
+
+		for( character_index = 0;
+		     character_index < string_size;
+		     character_index++ )
+		{
+			if( ( character_index % 4 ) == 3 )
+			{
+				unicode_character = 0x00e9;
+			}
+			else
+			{
+				unicode_character = (uint16_t) ( 'A' + ( ( item_index + character_index ) % 26 ) );
+			}
+			byte_stream_copy_from_uint16_little_endian(
+			 &( corpus_data[ data_offset ] ),
+			 unicode_character );
+
+			data_offset += 2;
+		}
+		corpus_data[ data_offset++ ] = 0;
+		corpus_data[ data_offset++ ] = 0;
+	}
+	/* The file footer
+	 */
+	byte_stream_copy_from_uint32_little_endian(
+	 &( corpus_data[ data_offset ] ),
+	 0 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( corpus_data[ data_offset + 4 ] ),
+	 0x01d0000000000000ULL );
+
+	data_offset += 12;
+
+	*data      = corpus_data;
+	*data_size = data_offset;
+
+	return( 1 );
+}
+
+/* Times the retrieval of an entry by type and its conversion to an UTF-8 string
+ * The elapsed times in nanoseconds are added to the corresponding values
+ * Returns 1 if successful or -1 on error
+ */
+int nk2_bench_time_entry(
+     libnk2_item_t *item,
+     uint32_t entry_type,
+     uint32_t value_type,
+     uint64_t *get_entry_time,
+     uint64_t *utf8_string_size_time,
+     uint64_t *utf8_string_time,
+     libcerror_error_t **error )
+{
+	uint8_t utf8_string[ 4096 ];
+
+	libnk2_record_entry_t *record_entry = NULL;
+	static char *function               = "nk2_bench_time_entry";
+	size_t utf8_string_size             = 0;
+	uint64_t end_time                   = 0;
+	uint64_t start_time                 = 0;
+
+	libnk2_statistics_get_current_time(
+	 &start_time,
+	 NULL );
+
+	if( libnk2_item_get_entry_by_type(
+	     item,
+	     entry_type,
+	     value_type,
+	     &record_entry,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry: 0x%04" PRIx32 ".",
+		 function,
+		 entry_type );
+
+		goto on_error;
+	}
+	libnk2_statistics_get_current_time(
+	 &end_time,
+	 NULL );
+
+	*get_entry_time += end_time - start_time;
+	start_time       = end_time;
+
+	if( libnk2_record_entry_get_data_as_utf8_string_size(
+	     record_entry,
+	     &utf8_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 string size.",
+		 function );
+
+		goto on_error;
+	}
+	libnk2_statistics_get_current_time(
+	 &end_time,
+	 NULL );
+
+	*utf8_string_size_time += end_time - start_time;
+	start_time              = end_time;
+
+	if( utf8_string_size > sizeof( utf8_string ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: UTF-8 string size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( libnk2_record_entry_get_data_as_utf8_string(
+	     record_entry,
+	     utf8_string,
+	     utf8_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 string.",
+		 function );
+
+		goto on_error;
+	}
+	libnk2_statistics_get_current_time(
+	 &end_time,
+	 NULL );
+
+	*utf8_string_time += end_time - start_time;
+
+	if( libnk2_record_entry_free(
+	     &record_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free record entry.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( record_entry != NULL )
+	{
+		libnk2_record_entry_free(
+		 &record_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Runs the benchmark on a corpus and prints the results as a single line of JSON
+ * Returns 1 if successful or -1 on error
+ */
+int nk2_bench_run(
+     uint8_t *data,
+     size_t data_size,
+     uint32_t number_of_items,
+     uint32_t number_of_entries_per_item,
+     uint32_t string_size,
+     int ascii_codepage,
+     uint32_t number_of_iterations,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle            = NULL;
+	libnk2_file_t *file                         = NULL;
+	libnk2_item_t *item                         = NULL;
+	static char *function                       = "nk2_bench_run";
+	libnk2_statistics_t statistics;
+	uint64_t codepage_to_utf8_string_size_time  = 0;
+	uint64_t codepage_to_utf8_string_time       = 0;
+	uint64_t end_time                           = 0;
+	uint64_t get_entry_time                     = 0;
+	uint64_t minimum_open_time                  = 0;
+	uint64_t number_of_lookups                  = 0;
+	uint64_t open_time                          = 0;
+	uint64_t start_time                         = 0;
+	uint64_t total_open_time                    = 0;
+	uint64_t utf16_to_utf8_string_size_time     = 0;
+	uint64_t utf16_to_utf8_string_time          = 0;
+	uint32_t iteration                          = 0;
+	int item_index                              = 0;
+	int number_of_file_items                    = 0;
+
+	if( number_of_iterations == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of iterations value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( nk2_test_open_file_io_handle(
+	     &file_io_handle,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	for( iteration = 0;
+	     iteration < number_of_iterations;
+	     iteration++ )
+	{
+		if( libnk2_file_initialize(
+		     &file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file.",
+			 function );
+
+			goto on_error;
+		}
+		if( libnk2_file_set_ascii_codepage(
+		     file,
+		     ascii_codepage,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set ASCII codepage.",
+			 function );
+
+			goto on_error;
+		}
+		libnk2_statistics_get_current_time(
+		 &start_time,
+		 NULL );
+
+		if( libnk2_file_open_file_io_handle(
+		     file,
+		     file_io_handle,
+		     LIBNK2_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file.",
+			 function );
+
+			goto on_error;
+		}
+		libnk2_statistics_get_current_time(
+		 &end_time,
+		 NULL );
+
+		open_time        = end_time - start_time;
+		total_open_time += open_time;
+
+		if( ( iteration == 0 )
+		 || ( open_time < minimum_open_time ) )
+		{
+			minimum_open_time = open_time;
+		}
+		if( iteration == 0 )
+		{
+			if( libnk2_file_get_statistics(
+			     file,
+			     &statistics,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve statistics.",
+				 function );
+
+				goto on_error;
+			}
+			if( libnk2_file_get_number_of_items(
+			     file,
+			     &number_of_file_items,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of items.",
+				 function );
+
+				goto on_error;
+			}
+			for( item_index = 0;
+			     item_index < number_of_file_items;
+			     item_index++ )
+			{
+				if( libnk2_file_get_item(
+				     file,
+				     item_index,
+				     &item,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve item: %d.",
+					 function,
+					 item_index );
+
+					goto on_error;
+				}
+				/* The display name is the last entry of the item
+				 */
+				if( nk2_bench_time_entry(
+				     item,
+				     NK2_BENCH_ENTRY_TYPE_DISPLAY_NAME,
+				     LIBNK2_VALUE_TYPE_STRING_UNICODE,
+				     &get_entry_time,
+				     &utf16_to_utf8_string_size_time,
+				     &utf16_to_utf8_string_time,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to time display name of item: %d.",
+					 function,
+					 item_index );
+
+					goto on_error;
+				}
+				if( nk2_bench_time_entry(
+				     item,
+				     NK2_BENCH_ENTRY_TYPE_EMAIL_ADDRESS,
+				     LIBNK2_VALUE_TYPE_STRING_ASCII,
+				     &get_entry_time,
+				     &codepage_to_utf8_string_size_time,
+				     &codepage_to_utf8_string_time,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to time e-mail address of item: %d.",
+					 function,
+					 item_index );
+
+					goto on_error;
+				}
+				if( libnk2_item_free(
+				     &item,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free item.",
+					 function );
+
+					goto on_error;
+				}
+				number_of_lookups += 1;
+			}
+		}
+		if( libnk2_file_close(
+		     file,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file.",
+			 function );
+
+			goto on_error;
+		}
+		if( libnk2_file_free(
+		     &file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( nk2_test_close_file_io_handle(
+	     &file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	total_open_time /= number_of_iterations;
+
+	if( total_open_time == 0 )
+	{
+		total_open_time = 1;
+	}
+	if( number_of_lookups == 0 )
+	{
+		number_of_lookups = 1;
+	}
+	fprintf(
+	 stdout,
+	 "{\"items\": %" PRIu32 ", \"entries_per_item\": %" PRIu32 ", \"string_size\": %" PRIu32 ", \"codepage\": %d, \"iterations\": %" PRIu32 ", \"file_size\": %" PRIzd ", ",
+	 number_of_items,
+	 number_of_entries_per_item,
+	 string_size,
+	 ascii_codepage,
+	 number_of_iterations,
+	 data_size );
+
+	fprintf(
+	 stdout,
+	 "\"open_ns_mean\": %" PRIu64 ", \"open_ns_min\": %" PRIu64 ", \"items_per_second\": %" PRIu64 ", ",
+	 total_open_time,
+	 minimum_open_time,
+	 ( (uint64_t) number_of_items * 1000000000UL ) / total_open_time );
+
+	fprintf(
+	 stdout,
+	 "\"read_calls\": %" PRIu64 ", \"bytes_read\": %" PRIu64 ", \"allocations\": %" PRIu64 ", \"bytes_allocated\": %" PRIu64 ", ",
+	 statistics.number_of_read_calls,
+	 statistics.number_of_bytes_read,
+	 statistics.number_of_allocations,
+	 statistics.number_of_bytes_allocated );
+
+	/* Every lookup consists of a display name and an e-mail address entry
+	 */
+	fprintf(
+	 stdout,
+	 "\"get_entry_by_type_ns\": %" PRIu64 ", ",
+	 get_entry_time / ( number_of_lookups * 2 ) );
+
+	fprintf(
+	 stdout,
+	 "\"utf16_utf8_string_size_ns\": %" PRIu64 ", \"utf16_utf8_string_ns\": %" PRIu64 ", ",
+	 utf16_to_utf8_string_size_time / number_of_lookups,
+	 utf16_to_utf8_string_time / number_of_lookups );
+
+	fprintf(
+	 stdout,
+	 "\"codepage_utf8_string_size_ns\": %" PRIu64 ", \"codepage_utf8_string_ns\": %" PRIu64 "}\n",
+	 codepage_to_utf8_string_size_time / number_of_lookups,
+	 codepage_to_utf8_string_time / number_of_lookups );
+
+	return( 1 );
+
+on_error:
+	if( file != NULL )
+	{
+		libnk2_file_free(
+		 &file,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc,
+     wchar_t * const argv[] )
+#else
+int main(
+     int argc,
+     char * const argv[] )
+#endif
+{
+	libcerror_error_t *error            = NULL;
+	uint8_t *data                       = NULL;
+	size_t data_size                    = 0;
+	system_integer_t option             = 0;
+	uint32_t ascii_codepage             = LIBNK2_CODEPAGE_WINDOWS_1252;
+	uint32_t number_of_entries_per_item = 8;
+	uint32_t number_of_items            = 1000;
+	uint32_t number_of_iterations       = 10;
+	uint32_t string_size                = 32;
+
+	while( ( option = nk2_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "c:e:hi:r:s:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				nk2_bench_usage_fprint(
+				 stderr );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'c':
+				if( nk2_bench_copy_from_system_string(
+				     optarg,
+				     &ascii_codepage ) != 1 )
+				{
+					fprintf(
+					 stderr,
+					 "Unsupported codepage: %" PRIs_SYSTEM ".\n",
+					 optarg );
+
+					return( EXIT_FAILURE );
+				}
+				break;
+
+			case (system_integer_t) 'e':
+				if( ( nk2_bench_copy_from_system_string(
+				       optarg,
+				       &number_of_entries_per_item ) != 1 )
+				 || ( number_of_entries_per_item < 2 ) )
+				{
+					fprintf(
+					 stderr,
+					 "Unsupported number of entries per item: %" PRIs_SYSTEM ".\n",
+					 optarg );
+
+					return( EXIT_FAILURE );
+				}
+				break;
+
+			case (system_integer_t) 'h':
+				nk2_bench_usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'i':
+				if( nk2_bench_copy_from_system_string(
+				     optarg,
+				     &number_of_items ) != 1 )
+				{
+					fprintf(
+					 stderr,
+					 "Unsupported number of items: %" PRIs_SYSTEM ".\n",
+					 optarg );
+
+					return( EXIT_FAILURE );
+				}
+				break;
+
+			case (system_integer_t) 'r':
+				if( ( nk2_bench_copy_from_system_string(
+				       optarg,
+				       &number_of_iterations ) != 1 )
+				 || ( number_of_iterations == 0 ) )
+				{
+					fprintf(
+					 stderr,
+					 "Unsupported number of iterations: %" PRIs_SYSTEM ".\n",
+					 optarg );
+
+					return( EXIT_FAILURE );
+				}
+				break;
+
+			case (system_integer_t) 's':
+				if( ( nk2_bench_copy_from_system_string(
+				       optarg,
+				       &string_size ) != 1 )
+				 || ( string_size > 1024 ) )
+				{
+					fprintf(
+					 stderr,
+					 "Unsupported string size: %" PRIs_SYSTEM ".\n",
+					 optarg );
+
+					return( EXIT_FAILURE );
+				}
+				break;
+		}
+	}
+	if( nk2_bench_generate_corpus(
+	     &data,
+	     &data_size,
+	     number_of_items,
+	     number_of_entries_per_item,
+	     string_size,
+	     (int) ascii_codepage,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to generate corpus.\n" );
+
+		goto on_error;
+	}
+	if( nk2_bench_run(
+	     data,
+	     data_size,
+	     number_of_items,
+	     number_of_entries_per_item,
+	     string_size,
+	     (int) ascii_codepage,
+	     number_of_iterations,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to run benchmark.\n" );
+
+		goto on_error;
+	}
+	memory_free(
+	 data );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( EXIT_FAILURE );
+}
+
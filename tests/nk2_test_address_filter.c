@@ -0,0 +1,1318 @@
+/*
+ * Library address filter functions test program
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "nk2_test_file_data.h"
+#include "nk2_test_functions.h"
+#include "nk2_test_libbfio.h"
+#include "nk2_test_libcerror.h"
+#include "nk2_test_libnk2.h"
+#include "nk2_test_macros.h"
+#include "nk2_test_memory.h"
+#include "nk2_test_unused.h"
+
+/* Tests the libnk2_address_filter_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_address_filter_initialize(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libnk2_address_filter_t *address_filter = NULL;
+	int result                              = 0;
+
+	/* Test regular cases
+	 */
+	result = libnk2_address_filter_initialize(
+	          &address_filter,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "address_filter",
+	 address_filter );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_address_filter_free(
+	          &address_filter,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "address_filter",
+	 address_filter );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libnk2_address_filter_initialize(
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	address_filter = (libnk2_address_filter_t *) 0x12345678UL;
+
+	result = libnk2_address_filter_initialize(
+	          &address_filter,
+	          &error );
+
+	address_filter = NULL;
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( address_filter != NULL )
+	{
+		libnk2_address_filter_free(
+		 &address_filter,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_address_filter_free function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_address_filter_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libnk2_address_filter_free(
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_address_filter_build_from_file function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_address_filter_build_from_file(
+     libnk2_file_t *file )
+{
+	libcerror_error_t *error                = NULL;
+	libnk2_address_filter_t *address_filter = NULL;
+	size_t data_size                        = 0;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libnk2_address_filter_initialize(
+	          &address_filter,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test an address filter without addresses
+	 */
+	result = libnk2_address_filter_get_data_size(
+	          address_filter,
+	          &data_size,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test regular cases
+	 */
+	result = libnk2_address_filter_build_from_file(
+	          address_filter,
+	          file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The address filter contains a 40-byte header and a 64-bit bitmap
+	 */
+	result = libnk2_address_filter_get_data_size(
+	          address_filter,
+	          &data_size,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_EQUAL_SIZE(
+	 "data_size",
+	 data_size,
+	 (size_t) 48 );
+
+	/* Test error cases
+	 */
+	result = libnk2_address_filter_build_from_file(
+	          NULL,
+	          file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_address_filter_build_from_file(
+	          address_filter,
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_address_filter_get_data_size(
+	          NULL,
+	          &data_size,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_address_filter_get_data_size(
+	          address_filter,
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libnk2_address_filter_free(
+	          &address_filter,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( address_filter != NULL )
+	{
+		libnk2_address_filter_free(
+		 &address_filter,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_address_filter_write_data function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_address_filter_write_data(
+     libnk2_address_filter_t *address_filter )
+{
+	uint8_t expected_data[ 48 ] = {
+		0x4e, 0x4b, 0x32, 0x42, 0x4c, 0x4f, 0x4f, 0x4d, 0x01, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,
+		0x40, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x80, 0xa7, 0xc3, 0xd2, 0xb2, 0xc5, 0xd0, 0x01,
+		0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x08, 0xc2, 0x08, 0x00, 0x61, 0x10, 0x84 };
+
+	uint8_t data[ 48 ];
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libnk2_address_filter_write_data(
+	          address_filter,
+	          data,
+	          48,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          expected_data,
+	          48 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libnk2_address_filter_write_data(
+	          NULL,
+	          data,
+	          48,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_address_filter_write_data(
+	          address_filter,
+	          NULL,
+	          48,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_address_filter_write_data(
+	          address_filter,
+	          data,
+	          47,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_address_filter_write_data(
+	          address_filter,
+	          data,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_address_filter_read_data function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_address_filter_read_data(
+     libnk2_address_filter_t *address_filter )
+{
+	uint8_t data[ 48 ];
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libnk2_address_filter_write_data(
+	          address_filter,
+	          data,
+	          48,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libnk2_address_filter_read_data(
+	          address_filter,
+	          data,
+	          48,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libnk2_address_filter_read_data(
+	          NULL,
+	          data,
+	          48,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_address_filter_read_data(
+	          address_filter,
+	          NULL,
+	          48,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_address_filter_read_data(
+	          address_filter,
+	          data,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* A truncated bitmap is not supported
+	 */
+	result = libnk2_address_filter_read_data(
+	          address_filter,
+	          data,
+	          47,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test read with an invalid signature
+	 */
+	data[ 0 ] = 0xff;
+
+	result = libnk2_address_filter_read_data(
+	          address_filter,
+	          data,
+	          48,
+	          &error );
+
+	data[ 0 ] = 0x4e;
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test read with an unsupported number of bits
+	 */
+	data[ 16 ] = 0x41;
+
+	result = libnk2_address_filter_read_data(
+	          address_filter,
+	          data,
+	          48,
+	          &error );
+
+	data[ 16 ] = 0x40;
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test read with an unsupported number of hash functions
+	 */
+	data[ 12 ] = 0x00;
+
+	result = libnk2_address_filter_read_data(
+	          address_filter,
+	          data,
+	          48,
+	          &error );
+
+	data[ 12 ] = 0x07;
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_address_filter_get_modification_time function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_address_filter_get_modification_time(
+     libnk2_address_filter_t *address_filter )
+{
+	libcerror_error_t *error = NULL;
+	uint64_t filetime        = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libnk2_address_filter_get_modification_time(
+	          address_filter,
+	          &filetime,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_EQUAL_UINT64(
+	 "filetime",
+	 filetime,
+	 (uint64_t) 0x01d0c5b2d2c3a780UL );
+
+	/* Test error cases
+	 */
+	result = libnk2_address_filter_get_modification_time(
+	          NULL,
+	          &filetime,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_address_filter_get_modification_time(
+	          address_filter,
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_address_filter_get_number_of_items function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_address_filter_get_number_of_items(
+     libnk2_address_filter_t *address_filter )
+{
+	libcerror_error_t *error = NULL;
+	uint32_t number_of_items = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libnk2_address_filter_get_number_of_items(
+	          address_filter,
+	          &number_of_items,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_items",
+	 number_of_items,
+	 (uint32_t) 2 );
+
+	/* Test error cases
+	 */
+	result = libnk2_address_filter_get_number_of_items(
+	          NULL,
+	          &number_of_items,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_address_filter_get_number_of_items(
+	          address_filter,
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_address_filter_get_number_of_addresses function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_address_filter_get_number_of_addresses(
+     libnk2_address_filter_t *address_filter )
+{
+	libcerror_error_t *error     = NULL;
+	uint32_t number_of_addresses = 0;
+	int result                   = 0;
+
+	/* Test regular cases
+	 */
+	result = libnk2_address_filter_get_number_of_addresses(
+	          address_filter,
+	          &number_of_addresses,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_addresses",
+	 number_of_addresses,
+	 (uint32_t) 2 );
+
+	/* Test error cases
+	 */
+	result = libnk2_address_filter_get_number_of_addresses(
+	          NULL,
+	          &number_of_addresses,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_address_filter_get_number_of_addresses(
+	          address_filter,
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_address_filter_contains_utf8_address function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_address_filter_contains_utf8_address(
+     libnk2_address_filter_t *address_filter )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libnk2_address_filter_contains_utf8_address(
+	          address_filter,
+	          (uint8_t *) "test@example.com",
+	          16,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The address is matched case insensitive and without leading and trailing white space
+	 */
+	result = libnk2_address_filter_contains_utf8_address(
+	          address_filter,
+	          (uint8_t *) " USER@Example.com ",
+	          18,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_address_filter_contains_utf8_address(
+	          address_filter,
+	          (uint8_t *) "nobody@example.com",
+	          18,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Display names are not contained
+	 */
+	result = libnk2_address_filter_contains_utf8_address(
+	          address_filter,
+	          (uint8_t *) "Test",
+	          4,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_address_filter_contains_utf8_address(
+	          address_filter,
+	          (uint8_t *) "  ",
+	          2,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libnk2_address_filter_contains_utf8_address(
+	          NULL,
+	          (uint8_t *) "test@example.com",
+	          16,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_address_filter_contains_utf8_address(
+	          address_filter,
+	          NULL,
+	          16,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_address_filter_contains_utf8_address(
+	          address_filter,
+	          (uint8_t *) "test@example.com",
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc NK2_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] NK2_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc NK2_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] NK2_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	libbfio_handle_t *file_io_handle        = NULL;
+	libcerror_error_t *error                = NULL;
+	libnk2_address_filter_t *address_filter = NULL;
+	libnk2_file_t *file                     = NULL;
+	int result                              = 0;
+
+	NK2_TEST_UNREFERENCED_PARAMETER( argc )
+	NK2_TEST_UNREFERENCED_PARAMETER( argv )
+
+	NK2_TEST_RUN(
+	 "libnk2_address_filter_initialize",
+	 nk2_test_address_filter_initialize );
+
+	NK2_TEST_RUN(
+	 "libnk2_address_filter_free",
+	 nk2_test_address_filter_free );
+
+#if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
+
+	/* Initialize test
+	 */
+	result = libnk2_file_initialize(
+	          &file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "file",
+	 file );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = nk2_test_open_file_io_handle(
+	          &file_io_handle,
+	          nk2_test_file_data1,
+	          202,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_file_open_file_io_handle(
+	          file,
+	          file_io_handle,
+	          LIBNK2_OPEN_READ,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_RUN_WITH_ARGS(
+	 "libnk2_address_filter_build_from_file",
+	 nk2_test_address_filter_build_from_file,
+	 file );
+
+	result = libnk2_address_filter_initialize(
+	          &address_filter,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "address_filter",
+	 address_filter );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_address_filter_build_from_file(
+	          address_filter,
+	          file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The address filter does not reference the file
+	 */
+	result = libnk2_file_close(
+	          file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_RUN_WITH_ARGS(
+	 "libnk2_address_filter_write_data",
+	 nk2_test_address_filter_write_data,
+	 address_filter );
+
+	NK2_TEST_RUN_WITH_ARGS(
+	 "libnk2_address_filter_read_data",
+	 nk2_test_address_filter_read_data,
+	 address_filter );
+
+	NK2_TEST_RUN_WITH_ARGS(
+	 "libnk2_address_filter_get_modification_time",
+	 nk2_test_address_filter_get_modification_time,
+	 address_filter );
+
+	NK2_TEST_RUN_WITH_ARGS(
+	 "libnk2_address_filter_get_number_of_items",
+	 nk2_test_address_filter_get_number_of_items,
+	 address_filter );
+
+	NK2_TEST_RUN_WITH_ARGS(
+	 "libnk2_address_filter_get_number_of_addresses",
+	 nk2_test_address_filter_get_number_of_addresses,
+	 address_filter );
+
+	NK2_TEST_RUN_WITH_ARGS(
+	 "libnk2_address_filter_contains_utf8_address",
+	 nk2_test_address_filter_contains_utf8_address,
+	 address_filter );
+
+	/* Clean up
+	 */
+	result = libnk2_address_filter_free(
+	          &address_filter,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = nk2_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_file_free(
+	          &file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#endif /* !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( address_filter != NULL )
+	{
+		libnk2_address_filter_free(
+		 &address_filter,
+		 NULL );
+	}
+	if( file != NULL )
+	{
+		libnk2_file_free(
+		 &file,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,1651 @@
+/*
+ * Library alias index functions test program
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "nk2_test_file_data.h"
+#include "nk2_test_functions.h"
+#include "nk2_test_libbfio.h"
+#include "nk2_test_libcerror.h"
+#include "nk2_test_libnk2.h"
+#include "nk2_test_macros.h"
+#include "nk2_test_memory.h"
+#include "nk2_test_unused.h"
+
+/* Tests the libnk2_alias_index_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_alias_index_initialize(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libnk2_alias_index_t *alias_index = NULL;
+	int result                        = 0;
+
+	/* Test regular cases
+	 */
+	result = libnk2_alias_index_initialize(
+	          &alias_index,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "alias_index",
+	 alias_index );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_alias_index_free(
+	          &alias_index,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "alias_index",
+	 alias_index );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libnk2_alias_index_initialize(
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	alias_index = (libnk2_alias_index_t *) 0x12345678UL;
+
+	result = libnk2_alias_index_initialize(
+	          &alias_index,
+	          &error );
+
+	alias_index = NULL;
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( alias_index != NULL )
+	{
+		libnk2_alias_index_free(
+		 &alias_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_alias_index_free function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_alias_index_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libnk2_alias_index_free(
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_alias_index_writer_add_file function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_alias_index_writer_add_file(
+     libnk2_file_t *file )
+{
+	libcerror_error_t *error                        = NULL;
+	libnk2_alias_index_writer_t *alias_index_writer = NULL;
+	size_t segment_size                             = 0;
+	uint32_t number_of_files                        = 0;
+	int result                                      = 0;
+
+	/* Initialize test
+	 */
+	result = libnk2_alias_index_writer_initialize(
+	          &alias_index_writer,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libnk2_alias_index_writer_add_file(
+	          alias_index_writer,
+	          file,
+	          (uint8_t *) "first.nk2",
+	          9,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_alias_index_writer_get_number_of_files(
+	          alias_index_writer,
+	          &number_of_files,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_files",
+	 number_of_files,
+	 1 );
+
+	/* The segment contains 1 file, 2 keys and 2 postings
+	 */
+	result = libnk2_alias_index_writer_get_segment_size(
+	          alias_index_writer,
+	          &segment_size,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_EQUAL_SIZE(
+	 "segment_size",
+	 segment_size,
+	 (size_t) 160 );
+
+	/* Test error cases
+	 */
+	result = libnk2_alias_index_writer_add_file(
+	          NULL,
+	          file,
+	          (uint8_t *) "first.nk2",
+	          9,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_alias_index_writer_add_file(
+	          alias_index_writer,
+	          NULL,
+	          (uint8_t *) "first.nk2",
+	          9,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_alias_index_writer_add_file(
+	          alias_index_writer,
+	          file,
+	          NULL,
+	          9,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* A failed add does not change the writer
+	 */
+	result = libnk2_alias_index_writer_get_number_of_files(
+	          alias_index_writer,
+	          &number_of_files,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_files",
+	 number_of_files,
+	 1 );
+
+	result = libnk2_alias_index_writer_get_segment_size(
+	          NULL,
+	          &segment_size,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_alias_index_writer_get_segment_size(
+	          alias_index_writer,
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libnk2_alias_index_writer_free(
+	          &alias_index_writer,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( alias_index_writer != NULL )
+	{
+		libnk2_alias_index_writer_free(
+		 &alias_index_writer,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_alias_index_open_data function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_alias_index_open_data(
+     const uint8_t *data,
+     size_t data_size )
+{
+	libcerror_error_t *error          = NULL;
+	libnk2_alias_index_t *alias_index = NULL;
+	uint32_t number_of_files          = 0;
+	int number_of_segments            = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libnk2_alias_index_initialize(
+	          &alias_index,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libnk2_alias_index_open_data(
+	          alias_index,
+	          data,
+	          data_size,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_alias_index_get_number_of_segments(
+	          alias_index,
+	          &number_of_segments,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "number_of_segments",
+	 number_of_segments,
+	 2 );
+
+	result = libnk2_alias_index_get_number_of_files(
+	          alias_index,
+	          &number_of_files,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_files",
+	 number_of_files,
+	 3 );
+
+	/* Test error cases
+	 */
+	result = libnk2_alias_index_open_data(
+	          alias_index,
+	          data,
+	          data_size,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_alias_index_close(
+	          alias_index,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_alias_index_close(
+	          alias_index,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_alias_index_open_data(
+	          NULL,
+	          data,
+	          data_size,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_alias_index_open_data(
+	          alias_index,
+	          NULL,
+	          data_size,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_alias_index_open_data(
+	          alias_index,
+	          data,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* A truncated alias index has no segment footer at the end of the data
+	 */
+	result = libnk2_alias_index_open_data(
+	          alias_index,
+	          data,
+	          data_size - 1,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* The last segment of an alias index cannot be opened without the preceding segments
+	 */
+	result = libnk2_alias_index_open_data(
+	          alias_index,
+	          &( data[ 200 ] ),
+	          data_size - 200,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libnk2_alias_index_free(
+	          &alias_index,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( alias_index != NULL )
+	{
+		libnk2_alias_index_free(
+		 &alias_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_alias_index_get_file_modification_time function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_alias_index_get_file_modification_time(
+     libnk2_alias_index_t *alias_index )
+{
+	libcerror_error_t *error = NULL;
+	uint64_t filetime        = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libnk2_alias_index_get_file_modification_time(
+	          alias_index,
+	          2,
+	          &filetime,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_EQUAL_UINT64(
+	 "filetime",
+	 filetime,
+	 (uint64_t) 0x01d0c5b2d2c3a780UL );
+
+	/* Test error cases
+	 */
+	result = libnk2_alias_index_get_file_modification_time(
+	          NULL,
+	          0,
+	          &filetime,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_alias_index_get_file_modification_time(
+	          alias_index,
+	          3,
+	          &filetime,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_alias_index_get_file_modification_time(
+	          alias_index,
+	          0,
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_alias_index_get_utf8_file_name_size and libnk2_alias_index_get_utf8_file_name functions
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_alias_index_get_utf8_file_name(
+     libnk2_alias_index_t *alias_index )
+{
+	uint8_t utf8_string[ 16 ];
+
+	libcerror_error_t *error = NULL;
+	size_t utf8_string_size  = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libnk2_alias_index_get_utf8_file_name_size(
+	          alias_index,
+	          1,
+	          &utf8_string_size,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_EQUAL_SIZE(
+	 "utf8_string_size",
+	 utf8_string_size,
+	 (size_t) 11 );
+
+	result = libnk2_alias_index_get_utf8_file_name(
+	          alias_index,
+	          1,
+	          utf8_string,
+	          16,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          utf8_string,
+	          "second.nk2",
+	          11 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libnk2_alias_index_get_utf8_file_name_size(
+	          NULL,
+	          1,
+	          &utf8_string_size,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_alias_index_get_utf8_file_name_size(
+	          alias_index,
+	          3,
+	          &utf8_string_size,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_alias_index_get_utf8_file_name_size(
+	          alias_index,
+	          1,
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_alias_index_get_utf8_file_name(
+	          alias_index,
+	          1,
+	          NULL,
+	          16,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_alias_index_get_utf8_file_name(
+	          alias_index,
+	          1,
+	          utf8_string,
+	          10,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_alias_index_search_utf8_address function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_alias_index_search_utf8_address(
+     libnk2_alias_index_t *alias_index )
+{
+	uint32_t file_identifiers[ 4 ];
+	uint32_t item_indexes[ 4 ];
+
+	libcerror_error_t *error = NULL;
+	int number_of_postings   = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	/* The address is matched case insensitive and without leading and trailing white space
+	 */
+	result = libnk2_alias_index_search_utf8_address(
+	          alias_index,
+	          (uint8_t *) " USER@example.com ",
+	          18,
+	          file_identifiers,
+	          item_indexes,
+	          4,
+	          &number_of_postings,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "number_of_postings",
+	 number_of_postings,
+	 3 );
+
+	NK2_TEST_ASSERT_EQUAL_UINT32(
+	 "file_identifiers[ 0 ]",
+	 file_identifiers[ 0 ],
+	 (uint32_t) 0 );
+
+	NK2_TEST_ASSERT_EQUAL_UINT32(
+	 "item_indexes[ 0 ]",
+	 item_indexes[ 0 ],
+	 (uint32_t) 1 );
+
+	NK2_TEST_ASSERT_EQUAL_UINT32(
+	 "file_identifiers[ 1 ]",
+	 file_identifiers[ 1 ],
+	 (uint32_t) 1 );
+
+	NK2_TEST_ASSERT_EQUAL_UINT32(
+	 "item_indexes[ 1 ]",
+	 item_indexes[ 1 ],
+	 (uint32_t) 1 );
+
+	NK2_TEST_ASSERT_EQUAL_UINT32(
+	 "file_identifiers[ 2 ]",
+	 file_identifiers[ 2 ],
+	 (uint32_t) 2 );
+
+	NK2_TEST_ASSERT_EQUAL_UINT32(
+	 "item_indexes[ 2 ]",
+	 item_indexes[ 2 ],
+	 (uint32_t) 1 );
+
+	/* The postings are limited to the maximum number of postings
+	 */
+	result = libnk2_alias_index_search_utf8_address(
+	          alias_index,
+	          (uint8_t *) "test@example.com",
+	          16,
+	          file_identifiers,
+	          item_indexes,
+	          1,
+	          &number_of_postings,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "number_of_postings",
+	 number_of_postings,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_UINT32(
+	 "file_identifiers[ 0 ]",
+	 file_identifiers[ 0 ],
+	 (uint32_t) 0 );
+
+	/* Only complete addresses match
+	 */
+	result = libnk2_alias_index_search_utf8_address(
+	          alias_index,
+	          (uint8_t *) "test@example",
+	          12,
+	          file_identifiers,
+	          item_indexes,
+	          4,
+	          &number_of_postings,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "number_of_postings",
+	 number_of_postings,
+	 0 );
+
+	result = libnk2_alias_index_search_utf8_address(
+	          alias_index,
+	          (uint8_t *) "Test",
+	          4,
+	          file_identifiers,
+	          item_indexes,
+	          4,
+	          &number_of_postings,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libnk2_alias_index_search_utf8_address(
+	          NULL,
+	          (uint8_t *) "test@example.com",
+	          16,
+	          file_identifiers,
+	          item_indexes,
+	          4,
+	          &number_of_postings,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_alias_index_search_utf8_address(
+	          alias_index,
+	          NULL,
+	          16,
+	          file_identifiers,
+	          item_indexes,
+	          4,
+	          &number_of_postings,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_alias_index_search_utf8_address(
+	          alias_index,
+	          (uint8_t *) "test@example.com",
+	          (size_t) SSIZE_MAX + 1,
+	          file_identifiers,
+	          item_indexes,
+	          4,
+	          &number_of_postings,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_alias_index_search_utf8_address(
+	          alias_index,
+	          (uint8_t *) "test@example.com",
+	          16,
+	          NULL,
+	          item_indexes,
+	          4,
+	          &number_of_postings,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_alias_index_search_utf8_address(
+	          alias_index,
+	          (uint8_t *) "test@example.com",
+	          16,
+	          file_identifiers,
+	          NULL,
+	          4,
+	          &number_of_postings,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_alias_index_search_utf8_address(
+	          alias_index,
+	          (uint8_t *) "test@example.com",
+	          16,
+	          file_identifiers,
+	          item_indexes,
+	          -1,
+	          &number_of_postings,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_alias_index_search_utf8_address(
+	          alias_index,
+	          (uint8_t *) "test@example.com",
+	          16,
+	          file_identifiers,
+	          item_indexes,
+	          4,
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc NK2_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] NK2_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc NK2_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] NK2_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	uint8_t alias_index_data[ 512 ];
+
+	libbfio_handle_t *file_io_handle                = NULL;
+	libcerror_error_t *error                        = NULL;
+	libnk2_alias_index_t *alias_index               = NULL;
+	libnk2_alias_index_writer_t *alias_index_writer = NULL;
+	libnk2_file_t *file                             = NULL;
+	size_t alias_index_data_size                    = 0;
+	size_t segment_size                             = 0;
+	int result                                      = 0;
+
+	NK2_TEST_UNREFERENCED_PARAMETER( argc )
+	NK2_TEST_UNREFERENCED_PARAMETER( argv )
+
+	NK2_TEST_RUN(
+	 "libnk2_alias_index_initialize",
+	 nk2_test_alias_index_initialize );
+
+	NK2_TEST_RUN(
+	 "libnk2_alias_index_free",
+	 nk2_test_alias_index_free );
+
+#if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
+
+	/* Initialize test
+	 */
+	result = libnk2_file_initialize(
+	          &file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "file",
+	 file );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = nk2_test_open_file_io_handle(
+	          &file_io_handle,
+	          nk2_test_file_data1,
+	          202,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_file_open_file_io_handle(
+	          file,
+	          file_io_handle,
+	          LIBNK2_OPEN_READ,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_RUN_WITH_ARGS(
+	 "libnk2_alias_index_writer_add_file",
+	 nk2_test_alias_index_writer_add_file,
+	 file );
+
+	/* Write an alias index with 2 segments, the first segment contains 2 files
+	 * and the second segment 1 file, all with the same content
+	 */
+	result = libnk2_alias_index_writer_initialize(
+	          &alias_index_writer,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_alias_index_writer_add_file(
+	          alias_index_writer,
+	          file,
+	          (uint8_t *) "first.nk2",
+	          9,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_alias_index_writer_add_file(
+	          alias_index_writer,
+	          file,
+	          (uint8_t *) "second.nk2",
+	          10,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_alias_index_writer_get_segment_size(
+	          alias_index_writer,
+	          &segment_size,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_EQUAL_SIZE(
+	 "segment_size",
+	 segment_size,
+	 (size_t) 200 );
+
+	result = libnk2_alias_index_writer_write_segment(
+	          alias_index_writer,
+	          0,
+	          alias_index_data,
+	          segment_size,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	alias_index_data_size = segment_size;
+
+	result = libnk2_alias_index_writer_clear(
+	          alias_index_writer,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_alias_index_writer_add_file(
+	          alias_index_writer,
+	          file,
+	          (uint8_t *) "third.nk2",
+	          9,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_alias_index_writer_get_segment_size(
+	          alias_index_writer,
+	          &segment_size,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_EQUAL_SIZE(
+	 "segment_size",
+	 segment_size,
+	 (size_t) 160 );
+
+	/* Test write segment with a buffer that is too small
+	 */
+	result = libnk2_alias_index_writer_write_segment(
+	          alias_index_writer,
+	          2,
+	          &( alias_index_data[ alias_index_data_size ] ),
+	          segment_size - 1,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_alias_index_writer_write_segment(
+	          alias_index_writer,
+	          2,
+	          &( alias_index_data[ alias_index_data_size ] ),
+	          segment_size,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	alias_index_data_size += segment_size;
+
+	result = libnk2_alias_index_writer_free(
+	          &alias_index_writer,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_RUN_WITH_ARGS(
+	 "libnk2_alias_index_open_data",
+	 nk2_test_alias_index_open_data,
+	 alias_index_data,
+	 alias_index_data_size );
+
+	result = libnk2_alias_index_initialize(
+	          &alias_index,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "alias_index",
+	 alias_index );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_alias_index_open_data(
+	          alias_index,
+	          alias_index_data,
+	          alias_index_data_size,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_RUN_WITH_ARGS(
+	 "libnk2_alias_index_get_file_modification_time",
+	 nk2_test_alias_index_get_file_modification_time,
+	 alias_index );
+
+	NK2_TEST_RUN_WITH_ARGS(
+	 "libnk2_alias_index_get_utf8_file_name",
+	 nk2_test_alias_index_get_utf8_file_name,
+	 alias_index );
+
+	NK2_TEST_RUN_WITH_ARGS(
+	 "libnk2_alias_index_search_utf8_address",
+	 nk2_test_alias_index_search_utf8_address,
+	 alias_index );
+
+	/* Clean up
+	 */
+	result = libnk2_alias_index_free(
+	          &alias_index,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = nk2_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_file_free(
+	          &file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#endif /* !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( alias_index != NULL )
+	{
+		libnk2_alias_index_free(
+		 &alias_index,
+		 NULL );
+	}
+	if( alias_index_writer != NULL )
+	{
+		libnk2_alias_index_writer_free(
+		 &alias_index_writer,
+		 NULL );
+	}
+	if( file != NULL )
+	{
+		libnk2_file_free(
+		 &file,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
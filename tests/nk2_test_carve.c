@@ -0,0 +1,976 @@
+/*
+ * Library carving functions test program
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "nk2_test_functions.h"
+#include "nk2_test_libbfio.h"
+#include "nk2_test_libcerror.h"
+#include "nk2_test_libnk2.h"
+#include "nk2_test_macros.h"
+#include "nk2_test_memory.h"
+#include "nk2_test_unused.h"
+
+/* Garbage that contains a partial signature, a NK2 file of 202 bytes at offset 8
+ * and a truncated NK2 file at offset 210, the items of the NK2 file are at offset 24 and 111
+ */
+uint8_t nk2_test_carve_data1[ 216 ] = {
+	0x0d, 0xf0, 0xad, 0x00, 0x41, 0x42, 0x0d, 0x0d, 0x0d, 0xf0, 0xad, 0xba, 0x0a, 0x00, 0x00, 0x00,
+	0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x1f, 0x00, 0x01, 0x30,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00,
+	0x54, 0x00, 0x65, 0x00, 0x73, 0x00, 0x74, 0x00, 0x00, 0x00, 0x1e, 0x00, 0x03, 0x30, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x00, 0x00, 0x00, 0x74, 0x65,
+	0x73, 0x74, 0x40, 0x65, 0x78, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x2e, 0x63, 0x6f, 0x6d, 0x00, 0x03,
+	0x00, 0x00, 0x39, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03,
+	0x00, 0x00, 0x00, 0x1f, 0x00, 0x01, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x55, 0x00, 0x73, 0x00, 0x65, 0x00, 0x72, 0x00, 0x00,
+	0x00, 0x1e, 0x00, 0x03, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x11, 0x00, 0x00, 0x00, 0x75, 0x73, 0x65, 0x72, 0x40, 0x65, 0x78, 0x61, 0x6d, 0x70, 0x6c,
+	0x65, 0x2e, 0x63, 0x6f, 0x6d, 0x00, 0x03, 0x00, 0x00, 0x39, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xa7, 0xc3, 0xd2, 0xb2, 0xc5,
+	0xd0, 0x01, 0x0d, 0xf0, 0xad, 0xba, 0xff, 0xff };
+
+/* Tests the libnk2_carve_scan_buffer_for_signature function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_carve_scan_buffer_for_signature(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	size_t signature_offset  = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libnk2_carve_scan_buffer_for_signature(
+	          nk2_test_carve_data1,
+	          216,
+	          &signature_offset,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_SIZE(
+	 "signature_offset",
+	 signature_offset,
+	 (size_t) 8 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_carve_scan_buffer_for_signature(
+	          &( nk2_test_carve_data1[ 9 ] ),
+	          207,
+	          &signature_offset,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_SIZE(
+	 "signature_offset",
+	 signature_offset,
+	 (size_t) 201 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a signature that is not fully contained in the buffer
+	 */
+	result = libnk2_carve_scan_buffer_for_signature(
+	          nk2_test_carve_data1,
+	          11,
+	          &signature_offset,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_carve_scan_buffer_for_signature(
+	          nk2_test_carve_data1,
+	          0,
+	          &signature_offset,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libnk2_carve_scan_buffer_for_signature(
+	          NULL,
+	          216,
+	          &signature_offset,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_carve_scan_buffer_for_signature(
+	          nk2_test_carve_data1,
+	          (size_t) SSIZE_MAX + 1,
+	          &signature_offset,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_carve_scan_buffer_for_signature(
+	          nk2_test_carve_data1,
+	          216,
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_carve_validate_file_io_handle function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_carve_validate_file_io_handle(
+     void )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	size64_t carved_size             = 0;
+	uint32_t number_of_items         = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = nk2_test_open_file_io_handle(
+	          &file_io_handle,
+	          nk2_test_carve_data1,
+	          216,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libnk2_carve_validate_file_io_handle(
+	          file_io_handle,
+	          8,
+	          &carved_size,
+	          &number_of_items,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_UINT64(
+	 "carved_size",
+	 (uint64_t) carved_size,
+	 (uint64_t) 202 );
+
+	NK2_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_items",
+	 number_of_items,
+	 (uint32_t) 2 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test candidates that are not valid
+	 */
+	result = libnk2_carve_validate_file_io_handle(
+	          file_io_handle,
+	          0,
+	          &carved_size,
+	          &number_of_items,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_carve_validate_file_io_handle(
+	          file_io_handle,
+	          210,
+	          &carved_size,
+	          &number_of_items,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_carve_validate_file_io_handle(
+	          file_io_handle,
+	          216,
+	          &carved_size,
+	          &number_of_items,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libnk2_carve_validate_file_io_handle(
+	          NULL,
+	          8,
+	          &carved_size,
+	          &number_of_items,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_carve_validate_file_io_handle(
+	          file_io_handle,
+	          -1,
+	          &carved_size,
+	          &number_of_items,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_carve_validate_file_io_handle(
+	          file_io_handle,
+	          8,
+	          NULL,
+	          &number_of_items,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_carve_validate_file_io_handle(
+	          file_io_handle,
+	          8,
+	          &carved_size,
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = nk2_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_carve_validate_item_data function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_carve_validate_item_data(
+     void )
+{
+	libcerror_error_t *error   = NULL;
+	size_t item_data_size      = 0;
+	uint32_t number_of_entries = 0;
+	int result                 = 0;
+
+	/* Test regular cases
+	 */
+	result = libnk2_carve_validate_item_data(
+	          &( nk2_test_carve_data1[ 24 ] ),
+	          192,
+	          &item_data_size,
+	          &number_of_entries,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_SIZE(
+	 "item_data_size",
+	 item_data_size,
+	 (size_t) 87 );
+
+	NK2_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_entries",
+	 number_of_entries,
+	 (uint32_t) 3 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test data that is not a valid item
+	 */
+	result = libnk2_carve_validate_item_data(
+	          &( nk2_test_carve_data1[ 24 ] ),
+	          86,
+	          &item_data_size,
+	          &number_of_entries,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_carve_validate_item_data(
+	          &( nk2_test_carve_data1[ 8 ] ),
+	          208,
+	          &item_data_size,
+	          &number_of_entries,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libnk2_carve_validate_item_data(
+	          NULL,
+	          192,
+	          &item_data_size,
+	          &number_of_entries,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_carve_validate_item_data(
+	          &( nk2_test_carve_data1[ 24 ] ),
+	          (size_t) SSIZE_MAX + 1,
+	          &item_data_size,
+	          &number_of_entries,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_carve_validate_item_data(
+	          &( nk2_test_carve_data1[ 24 ] ),
+	          192,
+	          NULL,
+	          &number_of_entries,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_carve_validate_item_data(
+	          &( nk2_test_carve_data1[ 24 ] ),
+	          192,
+	          &item_data_size,
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_carve_scan_buffer_for_item function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_carve_scan_buffer_for_item(
+     void )
+{
+	libcerror_error_t *error   = NULL;
+	size_t item_data_size      = 0;
+	size_t item_offset         = 0;
+	uint32_t number_of_entries = 0;
+	int result                 = 0;
+
+	/* Test regular cases
+	 */
+	result = libnk2_carve_scan_buffer_for_item(
+	          nk2_test_carve_data1,
+	          216,
+	          &item_offset,
+	          &item_data_size,
+	          &number_of_entries,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_SIZE(
+	 "item_offset",
+	 item_offset,
+	 (size_t) 24 );
+
+	NK2_TEST_ASSERT_EQUAL_SIZE(
+	 "item_data_size",
+	 item_data_size,
+	 (size_t) 87 );
+
+	NK2_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_entries",
+	 number_of_entries,
+	 (uint32_t) 3 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_carve_scan_buffer_for_item(
+	          &( nk2_test_carve_data1[ 25 ] ),
+	          191,
+	          &item_offset,
+	          &item_data_size,
+	          &number_of_entries,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_SIZE(
+	 "item_offset",
+	 item_offset,
+	 (size_t) 86 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_carve_scan_buffer_for_item(
+	          &( nk2_test_carve_data1[ 112 ] ),
+	          104,
+	          &item_offset,
+	          &item_data_size,
+	          &number_of_entries,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libnk2_carve_scan_buffer_for_item(
+	          NULL,
+	          216,
+	          &item_offset,
+	          &item_data_size,
+	          &number_of_entries,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_carve_scan_buffer_for_item(
+	          nk2_test_carve_data1,
+	          216,
+	          NULL,
+	          &item_data_size,
+	          &number_of_entries,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_carve_read_item_file_io_handle function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_carve_read_item_file_io_handle(
+     void )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libnk2_item_t *item              = NULL;
+	int number_of_entries            = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = nk2_test_open_file_io_handle(
+	          &file_io_handle,
+	          nk2_test_carve_data1,
+	          216,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libnk2_carve_read_item_file_io_handle(
+	          file_io_handle,
+	          111,
+	          LIBNK2_CODEPAGE_WINDOWS_1252,
+	          &item,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "item",
+	 item );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_item_get_number_of_entries(
+	          item,
+	          &number_of_entries,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 3 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_item_free(
+	          &item,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libnk2_carve_read_item_file_io_handle(
+	          file_io_handle,
+	          8,
+	          LIBNK2_CODEPAGE_WINDOWS_1252,
+	          &item,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "item",
+	 item );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_carve_read_item_file_io_handle(
+	          NULL,
+	          111,
+	          LIBNK2_CODEPAGE_WINDOWS_1252,
+	          &item,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_carve_read_item_file_io_handle(
+	          file_io_handle,
+	          -1,
+	          LIBNK2_CODEPAGE_WINDOWS_1252,
+	          &item,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_carve_read_item_file_io_handle(
+	          file_io_handle,
+	          111,
+	          LIBNK2_CODEPAGE_WINDOWS_1252,
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = nk2_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( item != NULL )
+	{
+		libnk2_item_free(
+		 &item,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc NK2_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] NK2_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc NK2_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] NK2_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	NK2_TEST_UNREFERENCED_PARAMETER( argc )
+	NK2_TEST_UNREFERENCED_PARAMETER( argv )
+
+	NK2_TEST_RUN(
+	 "libnk2_carve_scan_buffer_for_signature",
+	 nk2_test_carve_scan_buffer_for_signature );
+
+	NK2_TEST_RUN(
+	 "libnk2_carve_validate_file_io_handle",
+	 nk2_test_carve_validate_file_io_handle );
+
+	NK2_TEST_RUN(
+	 "libnk2_carve_validate_item_data",
+	 nk2_test_carve_validate_item_data );
+
+	NK2_TEST_RUN(
+	 "libnk2_carve_scan_buffer_for_item",
+	 nk2_test_carve_scan_buffer_for_item );
+
+	NK2_TEST_RUN(
+	 "libnk2_carve_read_item_file_io_handle",
+	 nk2_test_carve_read_item_file_io_handle );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
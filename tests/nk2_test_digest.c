@@ -0,0 +1,1129 @@
+/*
+ * Library digest functions test program
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "nk2_test_libcerror.h"
+#include "nk2_test_libnk2.h"
+#include "nk2_test_macros.h"
+#include "nk2_test_memory.h"
+#include "nk2_test_unused.h"
+
+#include "../libnk2/libnk2_digest.h"
+
+#if defined( __GNUC__ ) && !defined( LIBNK2_DLL_IMPORT )
+
+/* The MD5, SHA1 and SHA256 hashes of "abc"
+ */
+uint8_t nk2_test_digest_md5_hash1[ 16 ] = {
+	0x90, 0x01, 0x50, 0x98, 0x3c, 0xd2, 0x4f, 0xb0, 0xd6, 0x96, 0x3f, 0x7d, 0x28, 0xe1, 0x7f, 0x72 };
+
+uint8_t nk2_test_digest_sha1_hash1[ 20 ] = {
+	0xa9, 0x99, 0x3e, 0x36, 0x47, 0x06, 0x81, 0x6a, 0xba, 0x3e, 0x25, 0x71, 0x78, 0x50, 0xc2, 0x6c,
+	0x9c, 0xd0, 0xd8, 0x9d };
+
+uint8_t nk2_test_digest_sha256_hash1[ 32 ] = {
+	0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+	0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad };
+
+/* The sizes of the test vectors, which consist of the character 'a'
+ * The sizes are chosen around the 64-byte block size and the 8-byte length field
+ */
+size_t nk2_test_digest_vector_sizes[ 5 ] = {
+	0, 55, 56, 64, 1000000 };
+
+/* The MD5, SHA1 and SHA256 hashes of the test vectors
+ */
+uint8_t nk2_test_digest_md5_vector_hashes[ 5 ][ 16 ] = {
+	{ 0xd4, 0x1d, 0x8c, 0xd9, 0x8f, 0x00, 0xb2, 0x04, 0xe9, 0x80, 0x09, 0x98, 0xec, 0xf8, 0x42, 0x7e },
+	{ 0xef, 0x17, 0x72, 0xb6, 0xdf, 0xf9, 0xa1, 0x22, 0x35, 0x85, 0x52, 0x95, 0x4a, 0xd0, 0xdf, 0x65 },
+	{ 0x3b, 0x0c, 0x8a, 0xc7, 0x03, 0xf8, 0x28, 0xb0, 0x4c, 0x6c, 0x19, 0x70, 0x06, 0xd1, 0x72, 0x18 },
+	{ 0x01, 0x48, 0x42, 0xd4, 0x80, 0xb5, 0x71, 0x49, 0x5a, 0x4a, 0x03, 0x63, 0x79, 0x3f, 0x73, 0x67 },
+	{ 0x77, 0x07, 0xd6, 0xae, 0x4e, 0x02, 0x7c, 0x70, 0xee, 0xa2, 0xa9, 0x35, 0xc2, 0x29, 0x6f, 0x21 } };
+
+uint8_t nk2_test_digest_sha1_vector_hashes[ 5 ][ 20 ] = {
+	{ 0xda, 0x39, 0xa3, 0xee, 0x5e, 0x6b, 0x4b, 0x0d, 0x32, 0x55, 0xbf, 0xef, 0x95, 0x60, 0x18, 0x90,
+	  0xaf, 0xd8, 0x07, 0x09 },
+	{ 0xc1, 0xc8, 0xbb, 0xdc, 0x22, 0x79, 0x6e, 0x28, 0xc0, 0xe1, 0x51, 0x63, 0xd2, 0x08, 0x99, 0xb6,
+	  0x56, 0x21, 0xd6, 0x5a },
+	{ 0xc2, 0xdb, 0x33, 0x0f, 0x60, 0x83, 0x85, 0x4c, 0x99, 0xd4, 0xb5, 0xbf, 0xb6, 0xe8, 0xf2, 0x9f,
+	  0x20, 0x1b, 0xe6, 0x99 },
+	{ 0x00, 0x98, 0xba, 0x82, 0x4b, 0x5c, 0x16, 0x42, 0x7b, 0xd7, 0xa1, 0x12, 0x2a, 0x5a, 0x44, 0x2a,
+	  0x25, 0xec, 0x64, 0x4d },
+	{ 0x34, 0xaa, 0x97, 0x3c, 0xd4, 0xc4, 0xda, 0xa4, 0xf6, 0x1e, 0xeb, 0x2b, 0xdb, 0xad, 0x27, 0x31,
+	  0x65, 0x34, 0x01, 0x6f } };
+
+uint8_t nk2_test_digest_sha256_vector_hashes[ 5 ][ 32 ] = {
+	{ 0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14, 0x9a, 0xfb, 0xf4, 0xc8, 0x99, 0x6f, 0xb9, 0x24,
+	  0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b, 0x93, 0x4c, 0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55 },
+	{ 0x9f, 0x43, 0x90, 0xf8, 0xd3, 0x0c, 0x2d, 0xd9, 0x2e, 0xc9, 0xf0, 0x95, 0xb6, 0x5e, 0x2b, 0x9a,
+	  0xe9, 0xb0, 0xa9, 0x25, 0xa5, 0x25, 0x8e, 0x24, 0x1c, 0x9f, 0x1e, 0x91, 0x0f, 0x73, 0x43, 0x18 },
+	{ 0xb3, 0x54, 0x39, 0xa4, 0xac, 0x6f, 0x09, 0x48, 0xb6, 0xd6, 0xf9, 0xe3, 0xc6, 0xaf, 0x0f, 0x5f,
+	  0x59, 0x0c, 0xe2, 0x0f, 0x1b, 0xde, 0x70, 0x90, 0xef, 0x79, 0x70, 0x68, 0x6e, 0xc6, 0x73, 0x8a },
+	{ 0xff, 0xe0, 0x54, 0xfe, 0x7a, 0xe0, 0xcb, 0x6d, 0xc6, 0x5c, 0x3a, 0xf9, 0xb6, 0x1d, 0x52, 0x09,
+	  0xf4, 0x39, 0x85, 0x1d, 0xb4, 0x3d, 0x0b, 0xa5, 0x99, 0x73, 0x37, 0xdf, 0x15, 0x46, 0x68, 0xeb },
+	{ 0xcd, 0xc7, 0x6e, 0x5c, 0x99, 0x14, 0xfb, 0x92, 0x81, 0xa1, 0xc7, 0xe2, 0x84, 0xd7, 0x3e, 0x67,
+	  0xf1, 0x80, 0x9a, 0x48, 0xa4, 0x97, 0x20, 0x0e, 0x04, 0x6d, 0x39, 0xcc, 0xc7, 0x11, 0x2c, 0xd0 } };
+
+/* Tests the libnk2_digest_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_digest_initialize(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libnk2_digest_t *digest         = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_NK2_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 1;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libnk2_digest_initialize(
+	          &digest,
+	          LIBNK2_DIGEST_TYPE_MD5 | LIBNK2_DIGEST_TYPE_SHA1 | LIBNK2_DIGEST_TYPE_SHA256,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "digest",
+	 digest );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_digest_free(
+	          &digest,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "digest",
+	 digest );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libnk2_digest_initialize(
+	          NULL,
+	          LIBNK2_DIGEST_TYPE_MD5 | LIBNK2_DIGEST_TYPE_SHA1 | LIBNK2_DIGEST_TYPE_SHA256,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	digest = (libnk2_digest_t *) 0x12345678UL;
+
+	result = libnk2_digest_initialize(
+	          &digest,
+	          LIBNK2_DIGEST_TYPE_MD5 | LIBNK2_DIGEST_TYPE_SHA1 | LIBNK2_DIGEST_TYPE_SHA256,
+	          &error );
+
+	digest = NULL;
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_digest_initialize(
+	          &digest,
+	          0x08,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_NK2_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libnk2_digest_initialize with malloc failing
+		 */
+		nk2_test_malloc_attempts_before_fail = test_number;
+
+		result = libnk2_digest_initialize(
+		          &digest,
+		          LIBNK2_DIGEST_TYPE_MD5 | LIBNK2_DIGEST_TYPE_SHA1 | LIBNK2_DIGEST_TYPE_SHA256,
+		          &error );
+
+		if( nk2_test_malloc_attempts_before_fail != -1 )
+		{
+			nk2_test_malloc_attempts_before_fail = -1;
+
+			if( digest != NULL )
+			{
+				libnk2_digest_free(
+				 &digest,
+				 NULL );
+			}
+		}
+		else
+		{
+			NK2_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			NK2_TEST_ASSERT_IS_NULL(
+			 "digest",
+			 digest );
+
+			NK2_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libnk2_digest_initialize with memset failing
+		 */
+		nk2_test_memset_attempts_before_fail = test_number;
+
+		result = libnk2_digest_initialize(
+		          &digest,
+		          LIBNK2_DIGEST_TYPE_MD5 | LIBNK2_DIGEST_TYPE_SHA1 | LIBNK2_DIGEST_TYPE_SHA256,
+		          &error );
+
+		if( nk2_test_memset_attempts_before_fail != -1 )
+		{
+			nk2_test_memset_attempts_before_fail = -1;
+
+			if( digest != NULL )
+			{
+				libnk2_digest_free(
+				 &digest,
+				 NULL );
+			}
+		}
+		else
+		{
+			NK2_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			NK2_TEST_ASSERT_IS_NULL(
+			 "digest",
+			 digest );
+
+			NK2_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_NK2_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( digest != NULL )
+	{
+		libnk2_digest_free(
+		 &digest,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_digest_free function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_digest_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libnk2_digest_free(
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_digest_update function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_digest_update(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	libnk2_digest_t *digest  = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libnk2_digest_initialize(
+	          &digest,
+	          LIBNK2_DIGEST_TYPE_SHA256,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "digest",
+	 digest );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libnk2_digest_update(
+	          digest,
+	          (uint8_t *) "abc",
+	          3,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_digest_update(
+	          digest,
+	          (uint8_t *) "abc",
+	          0,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libnk2_digest_update(
+	          NULL,
+	          (uint8_t *) "abc",
+	          3,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_digest_update(
+	          digest,
+	          NULL,
+	          3,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_digest_update(
+	          digest,
+	          (uint8_t *) "abc",
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libnk2_digest_update after finalize
+	 */
+	result = libnk2_digest_finalize(
+	          digest,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_digest_update(
+	          digest,
+	          (uint8_t *) "abc",
+	          3,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libnk2_digest_free(
+	          &digest,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "digest",
+	 digest );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( digest != NULL )
+	{
+		libnk2_digest_free(
+		 &digest,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_digest_get_hash function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_digest_get_hash(
+     void )
+{
+	uint8_t hash[ 32 ];
+
+	libcerror_error_t *error = NULL;
+	libnk2_digest_t *digest  = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libnk2_digest_initialize(
+	          &digest,
+	          LIBNK2_DIGEST_TYPE_MD5 | LIBNK2_DIGEST_TYPE_SHA1 | LIBNK2_DIGEST_TYPE_SHA256,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "digest",
+	 digest );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_digest_update(
+	          digest,
+	          (uint8_t *) "abc",
+	          3,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test libnk2_digest_get_hash before finalize
+	 */
+	result = libnk2_digest_get_hash(
+	          digest,
+	          LIBNK2_DIGEST_TYPE_SHA256,
+	          hash,
+	          32,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_digest_finalize(
+	          digest,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libnk2_digest_get_hash(
+	          digest,
+	          LIBNK2_DIGEST_TYPE_MD5,
+	          hash,
+	          16,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          hash,
+	          nk2_test_digest_md5_hash1,
+	          16 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libnk2_digest_get_hash(
+	          digest,
+	          LIBNK2_DIGEST_TYPE_SHA1,
+	          hash,
+	          20,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          hash,
+	          nk2_test_digest_sha1_hash1,
+	          20 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libnk2_digest_get_hash(
+	          digest,
+	          LIBNK2_DIGEST_TYPE_SHA256,
+	          hash,
+	          32,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          hash,
+	          nk2_test_digest_sha256_hash1,
+	          32 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libnk2_digest_get_hash(
+	          NULL,
+	          LIBNK2_DIGEST_TYPE_SHA256,
+	          hash,
+	          32,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_digest_get_hash(
+	          digest,
+	          0x08,
+	          hash,
+	          32,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_digest_get_hash(
+	          digest,
+	          LIBNK2_DIGEST_TYPE_SHA256,
+	          NULL,
+	          32,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_digest_get_hash(
+	          digest,
+	          LIBNK2_DIGEST_TYPE_SHA256,
+	          hash,
+	          16,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libnk2_digest_free(
+	          &digest,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "digest",
+	 digest );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a digest type that was not calculated
+	 */
+	result = libnk2_digest_initialize(
+	          &digest,
+	          LIBNK2_DIGEST_TYPE_MD5,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "digest",
+	 digest );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_digest_finalize(
+	          digest,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_digest_get_hash(
+	          digest,
+	          LIBNK2_DIGEST_TYPE_SHA1,
+	          hash,
+	          20,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libnk2_digest_free(
+	          &digest,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "digest",
+	 digest );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( digest != NULL )
+	{
+		libnk2_digest_free(
+		 &digest,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_digest functions with the test vectors
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_digest_vectors(
+     void )
+{
+	uint8_t data[ 1000 ];
+	uint8_t hash[ 32 ];
+
+	libcerror_error_t *error = NULL;
+	libnk2_digest_t *digest  = NULL;
+	void *memset_result      = NULL;
+	size_t data_offset       = 0;
+	size_t data_size         = 0;
+	int result               = 0;
+	int vector_index         = 0;
+
+	/* Initialize test
+	 */
+	memset_result = memory_set(
+	                 data,
+	                 'a',
+	                 1000 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "memset_result",
+	 memset_result );
+
+	/* Test regular cases
+	 */
+
+	for( vector_index = 0;
+	     vector_index < 5;
+	     vector_index++ )
+	{
+		result = libnk2_digest_initialize(
+		          &digest,
+		          LIBNK2_DIGEST_TYPE_MD5 | LIBNK2_DIGEST_TYPE_SHA1 | LIBNK2_DIGEST_TYPE_SHA256,
+		          &error );
+
+		NK2_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		NK2_TEST_ASSERT_IS_NOT_NULL(
+		 "digest",
+		 digest );
+
+		NK2_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* The data is passed in parts that do not align with the block size
+		 */
+		for( data_offset = 0;
+		     data_offset < nk2_test_digest_vector_sizes[ vector_index ];
+		     data_offset += data_size )
+		{
+			data_size = nk2_test_digest_vector_sizes[ vector_index ] - data_offset;
+
+			if( data_size > 1000 )
+			{
+				data_size = 1000;
+			}
+			result = libnk2_digest_update(
+			          digest,
+			          data,
+			          data_size,
+			          &error );
+
+			NK2_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			NK2_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		result = libnk2_digest_finalize(
+		          digest,
+		          &error );
+
+		NK2_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		NK2_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libnk2_digest_get_hash(
+		          digest,
+		          LIBNK2_DIGEST_TYPE_MD5,
+		          hash,
+		          16,
+		          &error );
+
+		NK2_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		NK2_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          hash,
+		          nk2_test_digest_md5_vector_hashes[ vector_index ],
+		          16 );
+
+		NK2_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		result = libnk2_digest_get_hash(
+		          digest,
+		          LIBNK2_DIGEST_TYPE_SHA1,
+		          hash,
+		          20,
+		          &error );
+
+		NK2_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		NK2_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          hash,
+		          nk2_test_digest_sha1_vector_hashes[ vector_index ],
+		          20 );
+
+		NK2_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		result = libnk2_digest_get_hash(
+		          digest,
+		          LIBNK2_DIGEST_TYPE_SHA256,
+		          hash,
+		          32,
+		          &error );
+
+		NK2_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		NK2_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          hash,
+		          nk2_test_digest_sha256_vector_hashes[ vector_index ],
+		          32 );
+
+		NK2_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		result = libnk2_digest_free(
+		          &digest,
+		          &error );
+
+		NK2_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		NK2_TEST_ASSERT_IS_NULL(
+		 "digest",
+		 digest );
+
+		NK2_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( digest != NULL )
+	{
+		libnk2_digest_free(
+		 &digest,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBNK2_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc NK2_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] NK2_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc NK2_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] NK2_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	NK2_TEST_UNREFERENCED_PARAMETER( argc )
+	NK2_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBNK2_DLL_IMPORT )
+
+	NK2_TEST_RUN(
+	 "libnk2_digest_initialize",
+	 nk2_test_digest_initialize );
+
+	NK2_TEST_RUN(
+	 "libnk2_digest_free",
+	 nk2_test_digest_free );
+
+	NK2_TEST_RUN(
+	 "libnk2_digest_update",
+	 nk2_test_digest_update );
+
+	NK2_TEST_RUN(
+	 "libnk2_digest_get_hash",
+	 nk2_test_digest_get_hash );
+
+	NK2_TEST_RUN(
+	 "libnk2_digest_vectors",
+	 nk2_test_digest_vectors );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBNK2_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
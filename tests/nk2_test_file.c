@@ -20,7 +20,9 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
@@ -30,6 +32,7 @@
 #include <stdlib.h>
 #endif
 
+#include "nk2_test_file_data.h"
 #include "nk2_test_functions.h"
 #include "nk2_test_getopt.h"
 #include "nk2_test_libbfio.h"
@@ -61,6 +64,36 @@ int libnk2_file_open_file_io_handle(
 #error Unsupported size of wchar_t
 #endif
 
+#if defined( HAVE_NK2_TEST_MEMORY )
+
+/* The upper bounds of the number of allocations and the peak allocated size
+ * when opening nk2_test_file_data1, which contains 2 items with 3 record entries each
+ */
+#define NK2_TEST_FILE_DATA1_MAXIMUM_NUMBER_OF_ALLOCATIONS		84
+#define NK2_TEST_FILE_DATA1_MAXIMUM_PEAK_ALLOCATED_SIZE			67018
+
+/* The upper bounds of the number of allocations when opening a file
+ * without caching: a fixed overhead and the allocations per item and per record entry
+ */
+#define NK2_TEST_FILE_MAXIMUM_NUMBER_OF_ALLOCATIONS			64
+#define NK2_TEST_FILE_MAXIMUM_NUMBER_OF_ALLOCATIONS_PER_ITEM		4
+#define NK2_TEST_FILE_MAXIMUM_NUMBER_OF_ALLOCATIONS_PER_ENTRY		2
+
+/* The upper bounds of the peak allocated size when opening a file
+ * in addition to the size of the file
+ */
+#define NK2_TEST_FILE_MAXIMUM_PEAK_ALLOCATED_SIZE			65536
+#define NK2_TEST_FILE_MAXIMUM_PEAK_ALLOCATED_SIZE_PER_ITEM		256
+#define NK2_TEST_FILE_MAXIMUM_PEAK_ALLOCATED_SIZE_PER_ENTRY		128
+
+/* The minimum size of an item and of a record entry in a file, which bound
+ * the number of items and record entries of a file of a specific size
+ */
+#define NK2_TEST_FILE_MINIMUM_ITEM_SIZE					20
+#define NK2_TEST_FILE_MINIMUM_RECORD_ENTRY_SIZE				16
+
+#endif /* defined( HAVE_NK2_TEST_MEMORY ) */
+
 /* Define to make nk2_test_file generate verbose output
 #define NK2_TEST_FILE_VERBOSE
  */
@@ -1729,193 +1762,3115 @@ on_error:
 	return( 0 );
 }
 
-/* The main program
+/* Tests the libnk2_file_get_statistics function
+ * Returns 1 if successful or 0 if not
  */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-int wmain(
-     int argc,
-     wchar_t * const argv[] )
-#else
-int main(
-     int argc,
-     char * const argv[] )
-#endif
+int nk2_test_file_get_statistics(
+     libnk2_file_t *file )
 {
-	libbfio_handle_t *file_io_handle = NULL;
-	libcerror_error_t *error         = NULL;
-	libnk2_file_t *file              = NULL;
-	system_character_t *source       = NULL;
-	system_integer_t option          = 0;
-	size_t string_length             = 0;
-	int result                       = 0;
+	libcerror_error_t *error       = NULL;
+	libnk2_statistics_t statistics;
+	int result                     = 0;
 
-	while( ( option = nk2_test_getopt(
-	                   argc,
-	                   argv,
-	                   _SYSTEM_STRING( "" ) ) ) != (system_integer_t) -1 )
-	{
-		switch( option )
-		{
-			case (system_integer_t) '?':
-			default:
-				fprintf(
-				 stderr,
-				 "Invalid argument: %" PRIs_SYSTEM ".\n",
-				 argv[ optind - 1 ] );
+	/* Test regular cases
+	 */
+	result = libnk2_file_get_statistics(
+	          file,
+	          &statistics,
+	          &error );
 
-				return( EXIT_FAILURE );
-		}
-	}
-	if( optind < argc )
-	{
-		source = argv[ optind ];
-	}
-#if defined( HAVE_DEBUG_OUTPUT ) && defined( NK2_TEST_FILE_VERBOSE )
-	libnk2_notify_set_verbose(
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
 	 1 );
-	libnk2_notify_set_stream(
-	 stderr,
-	 NULL );
-#endif
 
-	NK2_TEST_RUN(
-	 "libnk2_file_initialize",
-	 nk2_test_file_initialize );
-
-	NK2_TEST_RUN(
-	 "libnk2_file_free",
-	 nk2_test_file_free );
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-#if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
-	if( source != NULL )
-	{
-		result = libbfio_file_initialize(
-		          &file_io_handle,
-		          &error );
+	/* The file header and footer are read with a single read call each
+	 */
+	NK2_TEST_ASSERT_GREATER_THAN_UINT64(
+	 "statistics.number_of_read_calls",
+	 statistics.number_of_read_calls,
+	 (uint64_t) 1 );
 
-		NK2_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 1 );
+	NK2_TEST_ASSERT_GREATER_THAN_UINT64(
+	 "statistics.number_of_bytes_read",
+	 statistics.number_of_bytes_read,
+	 (uint64_t) 27 );
 
-	        NK2_TEST_ASSERT_IS_NOT_NULL(
-	         "file_io_handle",
-	         file_io_handle );
+	NK2_TEST_ASSERT_GREATER_THAN_UINT64(
+	 "statistics.number_of_allocations",
+	 statistics.number_of_allocations,
+	 (uint64_t) 1 );
 
-	        NK2_TEST_ASSERT_IS_NULL(
-	         "error",
-	         error );
+	/* Test error cases
+	 */
+	result = libnk2_file_get_statistics(
+	          NULL,
+	          &statistics,
+	          &error );
 
-		string_length = system_string_length(
-		                 source );
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		result = libbfio_file_set_name_wide(
-		          file_io_handle,
-		          source,
-		          string_length,
-		          &error );
-#else
-		result = libbfio_file_set_name(
-		          file_io_handle,
-		          source,
-		          string_length,
-		          &error );
-#endif
-		NK2_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 1 );
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-	        NK2_TEST_ASSERT_IS_NULL(
-	         "error",
-	         error );
+	libcerror_error_free(
+	 &error );
 
-		result = libnk2_check_file_signature_file_io_handle(
-		          file_io_handle,
-		          &error );
+	result = libnk2_file_get_statistics(
+	          file,
+	          NULL,
+	          &error );
 
-		NK2_TEST_ASSERT_NOT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		NK2_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
-	}
-	if( result != 0 )
-	{
-		NK2_TEST_RUN_WITH_ARGS(
-		 "libnk2_file_open",
-		 nk2_test_file_open,
-		 source );
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-#if defined( HAVE_WIDE_CHARACTER_TYPE )
+	libcerror_error_free(
+	 &error );
 
-		NK2_TEST_RUN_WITH_ARGS(
-		 "libnk2_file_open_wide",
-		 nk2_test_file_open_wide,
-		 source );
+	return( 1 );
 
-#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
 
-		NK2_TEST_RUN_WITH_ARGS(
-		 "libnk2_file_open_file_io_handle",
-		 nk2_test_file_open_file_io_handle,
-		 source );
+/* Tests the libnk2_file_get_number_of_entries_by_value_type function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_file_get_number_of_entries_by_value_type(
+     libnk2_file_t *file )
+{
+	libcerror_error_t *error   = NULL;
+	uint64_t number_of_entries = 0;
+	int result                 = 0;
 
-		NK2_TEST_RUN(
-		 "libnk2_file_close",
-		 nk2_test_file_close );
+	/* Test regular cases
+	 */
+	result = libnk2_file_get_number_of_entries_by_value_type(
+	          file,
+	          LIBNK2_VALUE_TYPE_STRING_UNICODE,
+	          &number_of_entries,
+	          &error );
 
-		NK2_TEST_RUN_WITH_ARGS(
-		 "libnk2_file_open_close",
-		 nk2_test_file_open_close,
-		 source );
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		/* Initialize file for tests
-		 */
-		result = nk2_test_file_open_source(
-		          &file,
-		          file_io_handle,
-		          &error );
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		NK2_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 1 );
+	/* Test error cases
+	 */
+	result = libnk2_file_get_number_of_entries_by_value_type(
+	          NULL,
+	          LIBNK2_VALUE_TYPE_STRING_UNICODE,
+	          &number_of_entries,
+	          &error );
 
-		NK2_TEST_ASSERT_IS_NOT_NULL(
-		 "file",
-		 file );
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		NK2_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-		NK2_TEST_RUN_WITH_ARGS(
-		 "libnk2_file_signal_abort",
-		 nk2_test_file_signal_abort,
-		 file );
+	libcerror_error_free(
+	 &error );
 
-#if defined( __GNUC__ ) && !defined( LIBNK2_DLL_IMPORT )
+	result = libnk2_file_get_number_of_entries_by_value_type(
+	          file,
+	          LIBNK2_VALUE_TYPE_STRING_UNICODE,
+	          NULL,
+	          &error );
 
-		/* TODO: add tests for libnk2_file_open_read */
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-#endif /* defined( __GNUC__ ) && !defined( LIBNK2_DLL_IMPORT ) */
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-		NK2_TEST_RUN_WITH_ARGS(
-		 "libnk2_file_get_ascii_codepage",
-		 nk2_test_file_get_ascii_codepage,
-		 file );
+	libcerror_error_free(
+	 &error );
 
-		NK2_TEST_RUN_WITH_ARGS(
-		 "libnk2_file_set_ascii_codepage",
-		 nk2_test_file_set_ascii_codepage,
-		 file );
+	return( 1 );
 
-		NK2_TEST_RUN_WITH_ARGS(
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_file_open_file_io_handle function in lightweight error mode
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_file_open_lightweight_error_mode(
+     void )
+{
+	uint8_t data[ 202 ];
+
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libnk2_file_t *file              = NULL;
+	off64_t error_offset             = 0;
+	int error_code                   = 0;
+	int error_domain                 = 0;
+	int error_mode                   = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libnk2_file_initialize(
+	          &file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "file",
+	 file );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_file_set_error_mode(
+	          file,
+	          LIBNK2_ERROR_MODE_LIGHTWEIGHT,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_file_get_error_mode(
+	          file,
+	          &error_mode,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "error_mode",
+	 error_mode,
+	 LIBNK2_ERROR_MODE_LIGHTWEIGHT );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open with an invalid signature
+	 */
+	memory_copy(
+	 data,
+	 nk2_test_file_data1,
+	 202 );
+
+	data[ 0 ] = 0xff;
+
+	result = nk2_test_open_file_io_handle(
+	          &file_io_handle,
+	          data,
+	          202,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_file_open_file_io_handle(
+	          file,
+	          file_io_handle,
+	          LIBNK2_OPEN_READ,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_file_get_last_error(
+	          file,
+	          &error_domain,
+	          &error_code,
+	          &error_offset,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "error_domain",
+	 error_domain,
+	 LIBNK2_ERROR_DOMAIN_RUNTIME );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "error_code",
+	 error_code,
+	 LIBNK2_RUNTIME_ERROR_UNSUPPORTED_VALUE );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = nk2_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open with truncated data
+	 */
+	result = nk2_test_open_file_io_handle(
+	          &file_io_handle,
+	          nk2_test_file_data1,
+	          100,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_file_open_file_io_handle(
+	          file,
+	          file_io_handle,
+	          LIBNK2_OPEN_READ,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_file_get_last_error(
+	          file,
+	          &error_domain,
+	          &error_code,
+	          &error_offset,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "error_domain",
+	 error_domain,
+	 LIBNK2_ERROR_DOMAIN_IO );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "error_code",
+	 error_code,
+	 LIBNK2_IO_ERROR_READ_FAILED );
+
+	NK2_TEST_ASSERT_EQUAL_INT64(
+	 "error_offset",
+	 (int64_t) error_offset,
+	 (int64_t) 100 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = nk2_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open of a file that does not exist
+	 */
+	result = libnk2_file_open(
+	          file,
+	          "nk2_test_file_does_not_exist.nk2",
+	          LIBNK2_OPEN_READ,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_file_get_last_error(
+	          file,
+	          &error_domain,
+	          &error_code,
+	          &error_offset,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "error_domain",
+	 error_domain,
+	 LIBNK2_ERROR_DOMAIN_IO );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "error_code",
+	 error_code,
+	 LIBNK2_IO_ERROR_OPEN_FAILED );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libnk2_file_set_error_mode(
+	          file,
+	          -1,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_file_get_error_mode(
+	          NULL,
+	          &error_mode,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_file_get_last_error(
+	          file,
+	          NULL,
+	          &error_code,
+	          &error_offset,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libnk2_file_free(
+	          &file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "file",
+	 file );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( file != NULL )
+	{
+		libnk2_file_free(
+		 &file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_file_set_value_table function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_file_set_value_table(
+     void )
+{
+	libbfio_handle_t *file_io_handles[ 2 ] = { NULL, NULL };
+	libcerror_error_t *error               = NULL;
+	libnk2_file_t *files[ 2 ]              = { NULL, NULL };
+	libnk2_value_table_t *value_table      = NULL;
+	uint64_t number_of_references          = 0;
+	int file_index                         = 0;
+	int number_of_values                   = 0;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	result = libnk2_value_table_initialize(
+	          &value_table,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "value_table",
+	 value_table );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( file_index = 0;
+	     file_index < 2;
+	     file_index++ )
+	{
+		result = libnk2_file_initialize(
+		          &( files[ file_index ] ),
+		          &error );
+
+		NK2_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		NK2_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libnk2_file_set_value_table(
+		          files[ file_index ],
+		          value_table,
+		          &error );
+
+		NK2_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		NK2_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = nk2_test_open_file_io_handle(
+		          &( file_io_handles[ file_index ] ),
+		          nk2_test_file_data1,
+		          202,
+		          &error );
+
+		NK2_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		NK2_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libnk2_file_open_file_io_handle(
+		          files[ file_index ],
+		          file_io_handles[ file_index ],
+		          LIBNK2_OPEN_READ,
+		          &error );
+
+		NK2_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		NK2_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Both files contain the same 4 strings
+	 */
+	result = libnk2_value_table_get_number_of_values(
+	          value_table,
+	          &number_of_values,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "number_of_values",
+	 number_of_values,
+	 4 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_value_table_get_number_of_references(
+	          value_table,
+	          &number_of_references,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_references",
+	 number_of_references,
+	 (uint64_t) 8 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libnk2_file_set_value_table(
+	          NULL,
+	          value_table,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* The value table cannot be set while the file is open
+	 */
+	result = libnk2_file_set_value_table(
+	          files[ 0 ],
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* The value table cannot be freed while the files are open
+	 */
+	result = libnk2_value_table_free(
+	          &value_table,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	for( file_index = 0;
+	     file_index < 2;
+	     file_index++ )
+	{
+		result = libnk2_file_close(
+		          files[ file_index ],
+		          &error );
+
+		NK2_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		NK2_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = nk2_test_close_file_io_handle(
+		          &( file_io_handles[ file_index ] ),
+		          &error );
+
+		NK2_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		NK2_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libnk2_file_free(
+		          &( files[ file_index ] ),
+		          &error );
+
+		NK2_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		NK2_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libnk2_value_table_free(
+	          &value_table,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "value_table",
+	 value_table );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	for( file_index = 0;
+	     file_index < 2;
+	     file_index++ )
+	{
+		if( files[ file_index ] != NULL )
+		{
+			libnk2_file_free(
+			 &( files[ file_index ] ),
+			 NULL );
+		}
+		if( file_io_handles[ file_index ] != NULL )
+		{
+			libbfio_handle_free(
+			 &( file_io_handles[ file_index ] ),
+			 NULL );
+		}
+	}
+	if( value_table != NULL )
+	{
+		libnk2_value_table_free(
+		 &value_table,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_file_set_digest_types and libnk2_file_get_digest functions
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_file_get_digest(
+     void )
+{
+	uint8_t md5_hash[ 16 ] = {
+		0x0a, 0xdb, 0x74, 0xdb, 0xcd, 0xbf, 0x60, 0xc9, 0x27, 0x9e, 0x85, 0x7c, 0x37, 0x13, 0xa1, 0x90 };
+
+	uint8_t sha256_hash[ 32 ] = {
+		0x68, 0x22, 0x9c, 0x33, 0x77, 0x2c, 0xc9, 0x3c, 0x98, 0xac, 0x28, 0xd9, 0xa8, 0xf5, 0x5c, 0x2a,
+		0x3f, 0x38, 0xcb, 0xab, 0x85, 0x27, 0xaa, 0xa7, 0xaa, 0xab, 0x2f, 0xa4, 0x2f, 0xe1, 0x13, 0xd7 };
+
+	uint8_t digest_hash[ 32 ];
+
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libnk2_file_t *file              = NULL;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libnk2_file_initialize(
+	          &file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a file without digest types
+	 */
+	result = libnk2_file_get_digest(
+	          file,
+	          LIBNK2_DIGEST_TYPE_SHA256,
+	          digest_hash,
+	          32,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_file_set_digest_types(
+	          file,
+	          LIBNK2_DIGEST_TYPE_MD5 | LIBNK2_DIGEST_TYPE_SHA256,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = nk2_test_open_file_io_handle(
+	          &file_io_handle,
+	          nk2_test_file_data1,
+	          202,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	result = libnk2_file_open_file_io_handle(
+	          file,
+	          file_io_handle,
+	          LIBNK2_OPEN_READ,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libnk2_file_get_digest(
+	          file,
+	          LIBNK2_DIGEST_TYPE_MD5,
+	          digest_hash,
+	          16,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          digest_hash,
+	          md5_hash,
+	          16 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libnk2_file_get_digest(
+	          file,
+	          LIBNK2_DIGEST_TYPE_SHA256,
+	          digest_hash,
+	          32,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          digest_hash,
+	          sha256_hash,
+	          32 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libnk2_file_get_digest(
+	          file,
+	          LIBNK2_DIGEST_TYPE_SHA1,
+	          digest_hash,
+	          32,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libnk2_file_set_digest_types(
+	          NULL,
+	          LIBNK2_DIGEST_TYPE_SHA256,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_file_set_digest_types(
+	          file,
+	          LIBNK2_DIGEST_TYPE_SHA256,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_file_get_digest(
+	          NULL,
+	          LIBNK2_DIGEST_TYPE_SHA256,
+	          digest_hash,
+	          32,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_file_get_digest(
+	          file,
+	          LIBNK2_DIGEST_TYPE_SHA256,
+	          NULL,
+	          32,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_file_get_digest(
+	          file,
+	          LIBNK2_DIGEST_TYPE_SHA256,
+	          digest_hash,
+	          16,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libnk2_file_close(
+	          file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_file_set_digest_types(
+	          file,
+	          0x08,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = nk2_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_file_free(
+	          &file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file != NULL )
+	{
+		libnk2_file_free(
+		 &file,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_file_export_arrow function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_file_export_arrow(
+     void )
+{
+	struct ArrowArray array;
+	struct ArrowSchema schema;
+
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libnk2_file_t *file              = NULL;
+	const int32_t *string_offsets    = NULL;
+	const uint32_t *item_indexes     = NULL;
+	const char *string_data          = NULL;
+	int result                       = 0;
+
+	array.release  = NULL;
+	schema.release = NULL;
+
+	/* Initialize test
+	 */
+	result = libnk2_file_initialize(
+	          &file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = nk2_test_open_file_io_handle(
+	          &file_io_handle,
+	          nk2_test_file_data1,
+	          202,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_file_open_file_io_handle(
+	          file,
+	          file_io_handle,
+	          LIBNK2_OPEN_READ,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libnk2_file_export_arrow(
+	          file,
+	          &schema,
+	          &array,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "schema.release",
+	 schema.release );
+
+	NK2_TEST_ASSERT_EQUAL_INT64(
+	 "schema.n_children",
+	 schema.n_children,
+	 (int64_t) LIBNK2_ARROW_NUMBER_OF_COLUMNS );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "array.release",
+	 array.release );
+
+	/* The file contains 2 items with 3 record entries each
+	 */
+	NK2_TEST_ASSERT_EQUAL_INT64(
+	 "array.length",
+	 array.length,
+	 (int64_t) 6 );
+
+	NK2_TEST_ASSERT_EQUAL_INT64(
+	 "array.n_children",
+	 array.n_children,
+	 (int64_t) LIBNK2_ARROW_NUMBER_OF_COLUMNS );
+
+	item_indexes = (const uint32_t *) array.children[ LIBNK2_ARROW_COLUMN_ITEM_INDEX ]->buffers[ 1 ];
+
+	NK2_TEST_ASSERT_EQUAL_UINT32(
+	 "item_indexes[ 2 ]",
+	 item_indexes[ 2 ],
+	 (uint32_t) 0 );
+
+	NK2_TEST_ASSERT_EQUAL_UINT32(
+	 "item_indexes[ 3 ]",
+	 item_indexes[ 3 ],
+	 (uint32_t) 1 );
+
+	/* The third record entry of each item is a 32-bit integer
+	 */
+	NK2_TEST_ASSERT_EQUAL_INT64(
+	 "string null_count",
+	 array.children[ LIBNK2_ARROW_COLUMN_STRING ]->null_count,
+	 (int64_t) 2 );
+
+	string_offsets = (const int32_t *) array.children[ LIBNK2_ARROW_COLUMN_STRING ]->buffers[ 1 ];
+	string_data    = (const char *) array.children[ LIBNK2_ARROW_COLUMN_STRING ]->buffers[ 2 ];
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "string_offsets[ 1 ]",
+	 (int) string_offsets[ 1 ],
+	 4 );
+
+	result = memory_compare(
+	          string_data,
+	          "Testtest@example.com",
+	          20 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	array.release(
+	 &array );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "array.release",
+	 array.release );
+
+	schema.release(
+	 &schema );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "schema.release",
+	 schema.release );
+
+	/* Test error cases
+	 */
+	result = libnk2_file_export_arrow(
+	          NULL,
+	          &schema,
+	          &array,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_file_export_arrow(
+	          file,
+	          NULL,
+	          &array,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_file_export_arrow(
+	          file,
+	          &schema,
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libnk2_file_close(
+	          file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = nk2_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_file_free(
+	          &file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( array.release != NULL )
+	{
+		array.release(
+		 &array );
+	}
+	if( schema.release != NULL )
+	{
+		schema.release(
+		 &schema );
+	}
+	if( file != NULL )
+	{
+		libnk2_file_free(
+		 &file,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_file_get_item_by_utf8_email_address and libnk2_file_get_item_by_utf8_display_name functions
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_file_get_item_by_utf8_key(
+     void )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libnk2_file_t *file              = NULL;
+	libnk2_item_t *expected_item     = NULL;
+	libnk2_item_t *item              = NULL;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libnk2_file_initialize(
+	          &file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = nk2_test_open_file_io_handle(
+	          &file_io_handle,
+	          nk2_test_file_data1,
+	          202,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases before the file is opened
+	 */
+	result = libnk2_file_get_item_by_utf8_email_address(
+	          file,
+	          (uint8_t *) "test@example.com",
+	          16,
+	          &item,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_file_open_file_io_handle(
+	          file,
+	          file_io_handle,
+	          LIBNK2_OPEN_READ,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libnk2_file_get_item(
+	          file,
+	          0,
+	          &expected_item,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Email addresses are matched case insensitive
+	 */
+	result = libnk2_file_get_item_by_utf8_email_address(
+	          file,
+	          (uint8_t *) "test@EXAMPLE.com",
+	          16,
+	          &item,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "item",
+	 (int) ( item == expected_item ),
+	 1 );
+
+	item          = NULL;
+	expected_item = NULL;
+
+	result = libnk2_file_get_item(
+	          file,
+	          1,
+	          &expected_item,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_file_get_item_by_utf8_display_name(
+	          file,
+	          (uint8_t *) "User",
+	          4,
+	          &item,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "item",
+	 (int) ( item == expected_item ),
+	 1 );
+
+	item          = NULL;
+	expected_item = NULL;
+
+	/* Display names are matched exactly
+	 */
+	result = libnk2_file_get_item_by_utf8_display_name(
+	          file,
+	          (uint8_t *) "user",
+	          4,
+	          &item,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "item",
+	 item );
+
+	/* An email address does not match a display name
+	 */
+	result = libnk2_file_get_item_by_utf8_email_address(
+	          file,
+	          (uint8_t *) "User",
+	          4,
+	          &item,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_file_get_item_by_utf8_email_address(
+	          file,
+	          (uint8_t *) "nobody@example.com",
+	          18,
+	          &item,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libnk2_file_get_item_by_utf8_email_address(
+	          NULL,
+	          (uint8_t *) "test@example.com",
+	          16,
+	          &item,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_file_get_item_by_utf8_display_name(
+	          NULL,
+	          (uint8_t *) "Test",
+	          4,
+	          &item,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_file_get_item_by_utf8_email_address(
+	          file,
+	          NULL,
+	          16,
+	          &item,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_file_get_item_by_utf8_display_name(
+	          file,
+	          (uint8_t *) "Test",
+	          (size_t) SSIZE_MAX + 1,
+	          &item,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_file_get_item_by_utf8_display_name(
+	          file,
+	          (uint8_t *) "Test",
+	          4,
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libnk2_file_close(
+	          file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = nk2_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_file_free(
+	          &file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file != NULL )
+	{
+		libnk2_file_free(
+		 &file,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The callback data of the libnk2_file_diff tests
+ */
+typedef struct nk2_test_file_diff_counts nk2_test_file_diff_counts_t;
+
+struct nk2_test_file_diff_counts
+{
+	/* The number of added items
+	 */
+	int number_of_added_items;
+
+	/* The number of removed items
+	 */
+	int number_of_removed_items;
+
+	/* The number of modified items
+	 */
+	int number_of_modified_items;
+
+	/* The number of changed record entries
+	 */
+	int number_of_changed_entries;
+
+	/* The entry type of the last changed record entry
+	 */
+	uint32_t changed_entry_type;
+};
+
+/* Counts an added item
+ * Returns 1 if successful or -1 on error
+ */
+int nk2_test_file_diff_item_added(
+     libnk2_item_t *item NK2_TEST_ATTRIBUTE_UNUSED,
+     int item_index NK2_TEST_ATTRIBUTE_UNUSED,
+     void *callback_data )
+{
+	NK2_TEST_UNREFERENCED_PARAMETER( item )
+	NK2_TEST_UNREFERENCED_PARAMETER( item_index )
+
+	( (nk2_test_file_diff_counts_t *) callback_data )->number_of_added_items += 1;
+
+	return( 1 );
+}
+
+/* Counts a removed item
+ * Returns 1 if successful or -1 on error
+ */
+int nk2_test_file_diff_item_removed(
+     libnk2_item_t *item NK2_TEST_ATTRIBUTE_UNUSED,
+     int item_index NK2_TEST_ATTRIBUTE_UNUSED,
+     void *callback_data )
+{
+	NK2_TEST_UNREFERENCED_PARAMETER( item )
+	NK2_TEST_UNREFERENCED_PARAMETER( item_index )
+
+	( (nk2_test_file_diff_counts_t *) callback_data )->number_of_removed_items += 1;
+
+	return( 1 );
+}
+
+/* Counts a modified item
+ * Returns 1 if successful or -1 on error
+ */
+int nk2_test_file_diff_item_modified(
+     libnk2_item_t *item NK2_TEST_ATTRIBUTE_UNUSED,
+     int item_index,
+     libnk2_item_t *other_item NK2_TEST_ATTRIBUTE_UNUSED,
+     int other_item_index,
+     void *callback_data )
+{
+	NK2_TEST_UNREFERENCED_PARAMETER( item )
+	NK2_TEST_UNREFERENCED_PARAMETER( other_item )
+
+	if( item_index != other_item_index )
+	{
+		return( -1 );
+	}
+	( (nk2_test_file_diff_counts_t *) callback_data )->number_of_modified_items += 1;
+
+	return( 1 );
+}
+
+/* Counts a changed record entry
+ * Returns 1 if successful or -1 on error
+ */
+int nk2_test_file_diff_entry_changed(
+     libnk2_record_entry_t *record_entry,
+     libnk2_record_entry_t *other_record_entry,
+     void *callback_data )
+{
+	uint32_t entry_type = 0;
+
+	if( ( record_entry == NULL )
+	 || ( other_record_entry == NULL ) )
+	{
+		return( -1 );
+	}
+	if( libnk2_record_entry_get_entry_type(
+	     record_entry,
+	     &entry_type,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	( (nk2_test_file_diff_counts_t *) callback_data )->number_of_changed_entries += 1;
+	( (nk2_test_file_diff_counts_t *) callback_data )->changed_entry_type         = entry_type;
+
+	return( 1 );
+}
+
+/* Fails on a changed record entry
+ * Returns -1
+ */
+int nk2_test_file_diff_entry_changed_failure(
+     libnk2_record_entry_t *record_entry NK2_TEST_ATTRIBUTE_UNUSED,
+     libnk2_record_entry_t *other_record_entry NK2_TEST_ATTRIBUTE_UNUSED,
+     void *callback_data NK2_TEST_ATTRIBUTE_UNUSED )
+{
+	NK2_TEST_UNREFERENCED_PARAMETER( record_entry )
+	NK2_TEST_UNREFERENCED_PARAMETER( other_record_entry )
+	NK2_TEST_UNREFERENCED_PARAMETER( callback_data )
+
+	return( -1 );
+}
+
+/* Tests the libnk2_file_diff function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_file_diff(
+     void )
+{
+	uint8_t other_data[ 202 ];
+
+	libbfio_handle_t *file_io_handle       = NULL;
+	libbfio_handle_t *other_file_io_handle = NULL;
+	libcerror_error_t *error               = NULL;
+	libnk2_diff_callbacks_t callbacks;
+	libnk2_file_t *file                    = NULL;
+	libnk2_file_t *other_file              = NULL;
+	nk2_test_file_diff_counts_t counts;
+	void *memset_result                    = NULL;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	memset_result = memory_set(
+	                 &callbacks,
+	                 0,
+	                 sizeof( libnk2_diff_callbacks_t ) );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "memset_result",
+	 memset_result );
+
+	callbacks.item_added    = &nk2_test_file_diff_item_added;
+	callbacks.item_removed  = &nk2_test_file_diff_item_removed;
+	callbacks.item_modified = &nk2_test_file_diff_item_modified;
+	callbacks.entry_changed = &nk2_test_file_diff_entry_changed;
+
+	/* The other file has the display name of the second item changed from "User" into "Uses"
+	 */
+	memset_result = memory_copy(
+	                 other_data,
+	                 nk2_test_file_data1,
+	                 202 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "memset_result",
+	 memset_result );
+
+	other_data[ 133 ] = 0x73;
+
+	result = libnk2_file_initialize(
+	          &file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = nk2_test_open_file_io_handle(
+	          &file_io_handle,
+	          nk2_test_file_data1,
+	          202,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_file_initialize(
+	          &other_file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = nk2_test_open_file_io_handle(
+	          &other_file_io_handle,
+	          other_data,
+	          202,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases before the files are opened
+	 */
+	result = libnk2_file_diff(
+	          file,
+	          other_file,
+	          &callbacks,
+	          &counts,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_file_open_file_io_handle(
+	          file,
+	          file_io_handle,
+	          LIBNK2_OPEN_READ,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_file_open_file_io_handle(
+	          other_file,
+	          other_file_io_handle,
+	          LIBNK2_OPEN_READ,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	memset_result = memory_set(
+	                 &counts,
+	                 0,
+	                 sizeof( nk2_test_file_diff_counts_t ) );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "memset_result",
+	 memset_result );
+
+	result = libnk2_file_diff(
+	          file,
+	          file,
+	          &callbacks,
+	          &counts,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "counts.number_of_added_items",
+	 counts.number_of_added_items,
+	 0 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "counts.number_of_removed_items",
+	 counts.number_of_removed_items,
+	 0 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "counts.number_of_modified_items",
+	 counts.number_of_modified_items,
+	 0 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "counts.number_of_changed_entries",
+	 counts.number_of_changed_entries,
+	 0 );
+
+	memset_result = memory_set(
+	                 &counts,
+	                 0,
+	                 sizeof( nk2_test_file_diff_counts_t ) );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "memset_result",
+	 memset_result );
+
+	result = libnk2_file_diff(
+	          file,
+	          other_file,
+	          &callbacks,
+	          &counts,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "counts.number_of_added_items",
+	 counts.number_of_added_items,
+	 0 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "counts.number_of_removed_items",
+	 counts.number_of_removed_items,
+	 0 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "counts.number_of_modified_items",
+	 counts.number_of_modified_items,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "counts.number_of_changed_entries",
+	 counts.number_of_changed_entries,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_UINT32(
+	 "counts.changed_entry_type",
+	 counts.changed_entry_type,
+	 0x3001 );
+
+	/* The modified item is reported the same way when the files are swapped
+	 */
+	memset_result = memory_set(
+	                 &counts,
+	                 0,
+	                 sizeof( nk2_test_file_diff_counts_t ) );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "memset_result",
+	 memset_result );
+
+	result = libnk2_file_diff(
+	          other_file,
+	          file,
+	          &callbacks,
+	          &counts,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "counts.number_of_added_items",
+	 counts.number_of_added_items,
+	 0 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "counts.number_of_removed_items",
+	 counts.number_of_removed_items,
+	 0 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "counts.number_of_modified_items",
+	 counts.number_of_modified_items,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "counts.number_of_changed_entries",
+	 counts.number_of_changed_entries,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libnk2_file_diff(
+	          NULL,
+	          other_file,
+	          &callbacks,
+	          &counts,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_file_diff(
+	          file,
+	          NULL,
+	          &callbacks,
+	          &counts,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_file_diff(
+	          file,
+	          other_file,
+	          NULL,
+	          &counts,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	callbacks.entry_changed = &nk2_test_file_diff_entry_changed_failure;
+
+	result = libnk2_file_diff(
+	          file,
+	          other_file,
+	          &callbacks,
+	          &counts,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libnk2_file_close(
+	          other_file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = nk2_test_close_file_io_handle(
+	          &other_file_io_handle,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_file_free(
+	          &other_file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_file_close(
+	          file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = nk2_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_file_free(
+	          &file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( other_file != NULL )
+	{
+		libnk2_file_free(
+		 &other_file,
+		 NULL );
+	}
+	if( other_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &other_file_io_handle,
+		 NULL );
+	}
+	if( file != NULL )
+	{
+		libnk2_file_free(
+		 &file,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_file_open_file_io_handle function with sizes that exceed the file size
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_file_open_size_validation(
+     void )
+{
+	uint8_t data[ 202 ];
+
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libnk2_file_t *file              = NULL;
+	off64_t error_offset             = 0;
+	int error_code                   = 0;
+	int error_domain                 = 0;
+	int result                       = 0;
+	int test_number                  = 0;
+
+	/* The number of items, the number of record entries of the first item
+	 * and the value data size of the first record entry
+	 */
+	size_t test_offsets[ 3 ] = { 12, 16, 36 };
+
+	for( test_number = 0;
+	     test_number < 3;
+	     test_number++ )
+	{
+		/* Initialize test
+		 */
+		memory_copy(
+		 data,
+		 nk2_test_file_data1,
+		 202 );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 &( data[ test_offsets[ test_number ] ] ),
+		 0x7fffffffUL );
+
+		result = libnk2_file_initialize(
+		          &file,
+		          &error );
+
+		NK2_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		NK2_TEST_ASSERT_IS_NOT_NULL(
+		 "file",
+		 file );
+
+		NK2_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = nk2_test_open_file_io_handle(
+		          &file_io_handle,
+		          data,
+		          202,
+		          &error );
+
+		NK2_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		NK2_TEST_ASSERT_IS_NOT_NULL(
+		 "file_io_handle",
+		 file_io_handle );
+
+		NK2_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Test open
+		 */
+		result = libnk2_file_open_file_io_handle(
+		          file,
+		          file_io_handle,
+		          LIBNK2_OPEN_READ,
+		          &error );
+
+		NK2_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		NK2_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libnk2_file_get_last_error(
+		          file,
+		          &error_domain,
+		          &error_code,
+		          &error_offset,
+		          &error );
+
+		NK2_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		NK2_TEST_ASSERT_EQUAL_INT(
+		 "error_code",
+		 error_code,
+		 LIBNK2_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM );
+
+		NK2_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Clean up
+		 */
+		result = nk2_test_close_file_io_handle(
+		          &file_io_handle,
+		          &error );
+
+		NK2_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		NK2_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libnk2_file_free(
+		          &file,
+		          &error );
+
+		NK2_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		NK2_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( file != NULL )
+	{
+		libnk2_file_free(
+		 &file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_NK2_TEST_MEMORY )
+
+/* Tests the number of allocations and peak allocated size of libnk2_file_open_file_io_handle
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_file_open_allocations(
+     libbfio_handle_t *file_io_handle,
+     uint64_t maximum_number_of_allocations,
+     int64_t maximum_peak_allocated_size )
+{
+	libcerror_error_t *error = NULL;
+	libnk2_file_t *file      = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libnk2_file_initialize(
+	          &file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "file",
+	 file );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open
+	 */
+	nk2_test_memory_start_tracking();
+
+	result = libnk2_file_open_file_io_handle(
+	          file,
+	          file_io_handle,
+	          LIBNK2_OPEN_READ,
+	          &error );
+
+	nk2_test_memory_stop_tracking();
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_LESS_THAN_UINT64(
+	 "nk2_test_memory_number_of_allocations",
+	 nk2_test_memory_number_of_allocations,
+	 maximum_number_of_allocations + 1 );
+
+	NK2_TEST_ASSERT_LESS_THAN_INT64(
+	 "nk2_test_memory_peak_allocated_size",
+	 nk2_test_memory_peak_allocated_size,
+	 maximum_peak_allocated_size + 1 );
+
+	/* Clean up
+	 */
+	result = libnk2_file_close(
+	          file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_file_free(
+	          &file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "file",
+	 file );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	nk2_test_memory_stop_tracking();
+
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file != NULL )
+	{
+		libnk2_file_free(
+		 &file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the number of allocations and peak allocated size of libnk2_file_open_file_io_handle on a source file
+ * The upper bounds are derived from the size of the file
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_file_open_allocations_with_source(
+     libbfio_handle_t *file_io_handle )
+{
+	libcerror_error_t *error               = NULL;
+	size64_t file_size                     = 0;
+	uint64_t maximum_number_of_allocations = 0;
+	uint64_t maximum_number_of_entries     = 0;
+	uint64_t maximum_number_of_items       = 0;
+	int64_t maximum_peak_allocated_size    = 0;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	result = libbfio_handle_get_size(
+	          file_io_handle,
+	          &file_size,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	maximum_number_of_items   = (uint64_t) file_size / NK2_TEST_FILE_MINIMUM_ITEM_SIZE;
+	maximum_number_of_entries = (uint64_t) file_size / NK2_TEST_FILE_MINIMUM_RECORD_ENTRY_SIZE;
+
+	maximum_number_of_allocations = NK2_TEST_FILE_MAXIMUM_NUMBER_OF_ALLOCATIONS
+	                              + ( maximum_number_of_items * NK2_TEST_FILE_MAXIMUM_NUMBER_OF_ALLOCATIONS_PER_ITEM )
+	                              + ( maximum_number_of_entries * NK2_TEST_FILE_MAXIMUM_NUMBER_OF_ALLOCATIONS_PER_ENTRY );
+
+	maximum_peak_allocated_size = (int64_t) file_size
+	                            + NK2_TEST_FILE_MAXIMUM_PEAK_ALLOCATED_SIZE
+	                            + (int64_t) ( maximum_number_of_items * NK2_TEST_FILE_MAXIMUM_PEAK_ALLOCATED_SIZE_PER_ITEM )
+	                            + (int64_t) ( maximum_number_of_entries * NK2_TEST_FILE_MAXIMUM_PEAK_ALLOCATED_SIZE_PER_ENTRY );
+
+	/* Test open
+	 */
+	result = nk2_test_file_open_allocations(
+	          file_io_handle,
+	          maximum_number_of_allocations,
+	          maximum_peak_allocated_size );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the number of allocations and peak allocated size of libnk2_file_open_file_io_handle on test data
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_file_open_allocations_with_data(
+     void )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = nk2_test_open_file_io_handle(
+	          &file_io_handle,
+	          nk2_test_file_data1,
+	          202,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open
+	 */
+	result = nk2_test_file_open_allocations(
+	          file_io_handle,
+	          NK2_TEST_FILE_DATA1_MAXIMUM_NUMBER_OF_ALLOCATIONS,
+	          NK2_TEST_FILE_DATA1_MAXIMUM_PEAK_ALLOCATED_SIZE );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Clean up
+	 */
+	result = nk2_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_NK2_TEST_MEMORY ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc,
+     wchar_t * const argv[] )
+#else
+int main(
+     int argc,
+     char * const argv[] )
+#endif
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libnk2_file_t *file              = NULL;
+	system_character_t *source       = NULL;
+	system_integer_t option          = 0;
+	size_t string_length             = 0;
+	int result                       = 0;
+
+	while( ( option = nk2_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				return( EXIT_FAILURE );
+		}
+	}
+	if( optind < argc )
+	{
+		source = argv[ optind ];
+	}
+#if defined( HAVE_DEBUG_OUTPUT ) && defined( NK2_TEST_FILE_VERBOSE )
+	libnk2_notify_set_verbose(
+	 1 );
+	libnk2_notify_set_stream(
+	 stderr,
+	 NULL );
+#endif
+
+	NK2_TEST_RUN(
+	 "libnk2_file_initialize",
+	 nk2_test_file_initialize );
+
+	NK2_TEST_RUN(
+	 "libnk2_file_free",
+	 nk2_test_file_free );
+
+	NK2_TEST_RUN(
+	 "libnk2_file_open_file_io_handle lightweight error mode",
+	 nk2_test_file_open_lightweight_error_mode );
+
+	NK2_TEST_RUN(
+	 "libnk2_file_open_file_io_handle size validation",
+	 nk2_test_file_open_size_validation );
+
+	NK2_TEST_RUN(
+	 "libnk2_file_set_value_table",
+	 nk2_test_file_set_value_table );
+
+	NK2_TEST_RUN(
+	 "libnk2_file_get_digest",
+	 nk2_test_file_get_digest );
+
+	NK2_TEST_RUN(
+	 "libnk2_file_export_arrow",
+	 nk2_test_file_export_arrow );
+
+	NK2_TEST_RUN(
+	 "libnk2_file_get_item_by_utf8_key",
+	 nk2_test_file_get_item_by_utf8_key );
+
+	NK2_TEST_RUN(
+	 "libnk2_file_diff",
+	 nk2_test_file_diff );
+
+#if defined( HAVE_NK2_TEST_MEMORY )
+
+	NK2_TEST_RUN(
+	 "libnk2_file_open_file_io_handle allocations",
+	 nk2_test_file_open_allocations_with_data );
+
+#endif /* defined( HAVE_NK2_TEST_MEMORY ) */
+
+#if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
+	if( source != NULL )
+	{
+		result = libbfio_file_initialize(
+		          &file_io_handle,
+		          &error );
+
+		NK2_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+	        NK2_TEST_ASSERT_IS_NOT_NULL(
+	         "file_io_handle",
+	         file_io_handle );
+
+	        NK2_TEST_ASSERT_IS_NULL(
+	         "error",
+	         error );
+
+		string_length = system_string_length(
+		                 source );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libbfio_file_set_name_wide(
+		          file_io_handle,
+		          source,
+		          string_length,
+		          &error );
+#else
+		result = libbfio_file_set_name(
+		          file_io_handle,
+		          source,
+		          string_length,
+		          &error );
+#endif
+		NK2_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+	        NK2_TEST_ASSERT_IS_NULL(
+	         "error",
+	         error );
+
+		result = libnk2_check_file_signature_file_io_handle(
+		          file_io_handle,
+		          &error );
+
+		NK2_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		NK2_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	if( result != 0 )
+	{
+		NK2_TEST_RUN_WITH_ARGS(
+		 "libnk2_file_open",
+		 nk2_test_file_open,
+		 source );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+		NK2_TEST_RUN_WITH_ARGS(
+		 "libnk2_file_open_wide",
+		 nk2_test_file_open_wide,
+		 source );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+		NK2_TEST_RUN_WITH_ARGS(
+		 "libnk2_file_open_file_io_handle",
+		 nk2_test_file_open_file_io_handle,
+		 source );
+
+		NK2_TEST_RUN(
+		 "libnk2_file_close",
+		 nk2_test_file_close );
+
+		NK2_TEST_RUN_WITH_ARGS(
+		 "libnk2_file_open_close",
+		 nk2_test_file_open_close,
+		 source );
+
+#if defined( HAVE_NK2_TEST_MEMORY )
+
+		NK2_TEST_RUN_WITH_ARGS(
+		 "libnk2_file_open_file_io_handle allocations",
+		 nk2_test_file_open_allocations_with_source,
+		 file_io_handle );
+
+#endif /* defined( HAVE_NK2_TEST_MEMORY ) */
+
+		/* Initialize file for tests
+		 */
+		result = nk2_test_file_open_source(
+		          &file,
+		          file_io_handle,
+		          &error );
+
+		NK2_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		NK2_TEST_ASSERT_IS_NOT_NULL(
+		 "file",
+		 file );
+
+		NK2_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		NK2_TEST_RUN_WITH_ARGS(
+		 "libnk2_file_signal_abort",
+		 nk2_test_file_signal_abort,
+		 file );
+
+#if defined( __GNUC__ ) && !defined( LIBNK2_DLL_IMPORT )
+
+		/* TODO: add tests for libnk2_file_open_read */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBNK2_DLL_IMPORT ) */
+
+		NK2_TEST_RUN_WITH_ARGS(
+		 "libnk2_file_get_ascii_codepage",
+		 nk2_test_file_get_ascii_codepage,
+		 file );
+
+		NK2_TEST_RUN_WITH_ARGS(
+		 "libnk2_file_set_ascii_codepage",
+		 nk2_test_file_set_ascii_codepage,
+		 file );
+
+		NK2_TEST_RUN_WITH_ARGS(
 		 "libnk2_file_get_modification_time",
 		 nk2_test_file_get_modification_time,
 		 file );
@@ -1930,6 +4885,16 @@ int main(
 		 nk2_test_file_get_item,
 		 file );
 
+		NK2_TEST_RUN_WITH_ARGS(
+		 "libnk2_file_get_statistics",
+		 nk2_test_file_get_statistics,
+		 file );
+
+		NK2_TEST_RUN_WITH_ARGS(
+		 "libnk2_file_get_number_of_entries_by_value_type",
+		 nk2_test_file_get_number_of_entries_by_value_type,
+		 file );
+
 		/* Clean up
 		 */
 		result = nk2_test_file_close_source(
@@ -0,0 +1,743 @@
+/*
+ * Library index functions test program
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "nk2_test_file_data.h"
+#include "nk2_test_functions.h"
+#include "nk2_test_libbfio.h"
+#include "nk2_test_libcerror.h"
+#include "nk2_test_libnk2.h"
+#include "nk2_test_macros.h"
+#include "nk2_test_memory.h"
+#include "nk2_test_unused.h"
+
+/* Tests the libnk2_index_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_index_initialize(
+     libnk2_file_t *file )
+{
+	libcerror_error_t *error = NULL;
+	libnk2_index_t *index    = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libnk2_index_initialize(
+	          &index,
+	          file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "index",
+	 index );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_index_free(
+	          &index,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "index",
+	 index );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libnk2_index_initialize(
+	          NULL,
+	          file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	index = (libnk2_index_t *) 0x12345678UL;
+
+	result = libnk2_index_initialize(
+	          &index,
+	          file,
+	          &error );
+
+	index = NULL;
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_index_initialize(
+	          &index,
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( index != NULL )
+	{
+		libnk2_index_free(
+		 &index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_index_free function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_index_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libnk2_index_free(
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_index_get_number_of_keys function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_index_get_number_of_keys(
+     libnk2_index_t *index )
+{
+	libcerror_error_t *error = NULL;
+	int number_of_keys       = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libnk2_index_get_number_of_keys(
+	          index,
+	          &number_of_keys,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "number_of_keys",
+	 number_of_keys,
+	 4 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libnk2_index_get_number_of_keys(
+	          NULL,
+	          &number_of_keys,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_index_get_number_of_keys(
+	          index,
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_index_prefix_search function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_index_prefix_search(
+     libnk2_index_t *index )
+{
+	uint32_t item_indexes[ 4 ];
+
+	libcerror_error_t *error   = NULL;
+	int number_of_item_indexes = 0;
+	int result                 = 0;
+
+	/* Test regular cases
+	 */
+	result = libnk2_index_prefix_search(
+	          index,
+	          (uint8_t *) "TE",
+	          2,
+	          item_indexes,
+	          4,
+	          &number_of_item_indexes,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "number_of_item_indexes",
+	 number_of_item_indexes,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_UINT32(
+	 "item_indexes[ 0 ]",
+	 item_indexes[ 0 ],
+	 (uint32_t) 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_index_prefix_search(
+	          index,
+	          (uint8_t *) "user@",
+	          5,
+	          item_indexes,
+	          4,
+	          &number_of_item_indexes,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "number_of_item_indexes",
+	 number_of_item_indexes,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_UINT32(
+	 "item_indexes[ 0 ]",
+	 item_indexes[ 0 ],
+	 (uint32_t) 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* An empty prefix matches all items
+	 */
+	result = libnk2_index_prefix_search(
+	          index,
+	          (uint8_t *) "",
+	          0,
+	          item_indexes,
+	          4,
+	          &number_of_item_indexes,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "number_of_item_indexes",
+	 number_of_item_indexes,
+	 2 );
+
+	NK2_TEST_ASSERT_EQUAL_UINT32(
+	 "item_indexes[ 0 ]",
+	 item_indexes[ 0 ],
+	 (uint32_t) 0 );
+
+	NK2_TEST_ASSERT_EQUAL_UINT32(
+	 "item_indexes[ 1 ]",
+	 item_indexes[ 1 ],
+	 (uint32_t) 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The number of item indexes is limited to the maximum
+	 */
+	result = libnk2_index_prefix_search(
+	          index,
+	          (uint8_t *) "",
+	          0,
+	          item_indexes,
+	          1,
+	          &number_of_item_indexes,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "number_of_item_indexes",
+	 number_of_item_indexes,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_index_prefix_search(
+	          index,
+	          (uint8_t *) "testx",
+	          5,
+	          item_indexes,
+	          4,
+	          &number_of_item_indexes,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "number_of_item_indexes",
+	 number_of_item_indexes,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libnk2_index_prefix_search(
+	          NULL,
+	          (uint8_t *) "te",
+	          2,
+	          item_indexes,
+	          4,
+	          &number_of_item_indexes,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_index_prefix_search(
+	          index,
+	          NULL,
+	          2,
+	          item_indexes,
+	          4,
+	          &number_of_item_indexes,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_index_prefix_search(
+	          index,
+	          (uint8_t *) "te",
+	          2,
+	          NULL,
+	          4,
+	          &number_of_item_indexes,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_index_prefix_search(
+	          index,
+	          (uint8_t *) "te",
+	          2,
+	          item_indexes,
+	          -1,
+	          &number_of_item_indexes,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_index_prefix_search(
+	          index,
+	          (uint8_t *) "te",
+	          2,
+	          item_indexes,
+	          4,
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc NK2_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] NK2_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc NK2_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] NK2_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libnk2_file_t *file              = NULL;
+	libnk2_index_t *index            = NULL;
+	int result                       = 0;
+
+	NK2_TEST_UNREFERENCED_PARAMETER( argc )
+	NK2_TEST_UNREFERENCED_PARAMETER( argv )
+
+	NK2_TEST_RUN(
+	 "libnk2_index_free",
+	 nk2_test_index_free );
+
+#if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
+
+	/* Initialize test
+	 */
+	result = libnk2_file_initialize(
+	          &file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "file",
+	 file );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = nk2_test_open_file_io_handle(
+	          &file_io_handle,
+	          nk2_test_file_data1,
+	          202,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_file_open_file_io_handle(
+	          file,
+	          file_io_handle,
+	          LIBNK2_OPEN_READ,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_RUN_WITH_ARGS(
+	 "libnk2_index_initialize",
+	 nk2_test_index_initialize,
+	 file );
+
+	result = libnk2_index_initialize(
+	          &index,
+	          file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "index",
+	 index );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The index does not reference the file
+	 */
+	result = libnk2_file_close(
+	          file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_RUN_WITH_ARGS(
+	 "libnk2_index_get_number_of_keys",
+	 nk2_test_index_get_number_of_keys,
+	 index );
+
+	NK2_TEST_RUN_WITH_ARGS(
+	 "libnk2_index_prefix_search",
+	 nk2_test_index_prefix_search,
+	 index );
+
+	/* Clean up
+	 */
+	result = libnk2_index_free(
+	          &index,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = nk2_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_file_free(
+	          &file,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#endif /* !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( index != NULL )
+	{
+		libnk2_index_free(
+		 &index,
+		 NULL );
+	}
+	if( file != NULL )
+	{
+		libnk2_file_free(
+		 &file,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -580,6 +580,206 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libnk2_item_update_content_hash function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_item_update_content_hash(
+     void )
+{
+	uint8_t data[ 64 ];
+
+	uint64_t content_hash = 0;
+	size_t data_offset    = 0;
+
+	for( data_offset = 0;
+	     data_offset < 64;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) data_offset;
+	}
+	/* Test regular cases
+	 */
+	content_hash = libnk2_item_update_content_hash(
+	                0,
+	                (uint8_t *) "",
+	                0 );
+
+	NK2_TEST_ASSERT_EQUAL_UINT64(
+	 "content_hash",
+	 content_hash,
+	 (uint64_t) 0xef46db3751d8e999ULL );
+
+	content_hash = libnk2_item_update_content_hash(
+	                0,
+	                (uint8_t *) "abc",
+	                3 );
+
+	NK2_TEST_ASSERT_EQUAL_UINT64(
+	 "content_hash",
+	 content_hash,
+	 (uint64_t) 0x44bc2cf5ad770999ULL );
+
+	content_hash = libnk2_item_update_content_hash(
+	                0,
+	                (uint8_t *) "Nobody inspects the spammish repetition",
+	                39 );
+
+	NK2_TEST_ASSERT_EQUAL_UINT64(
+	 "content_hash",
+	 content_hash,
+	 (uint64_t) 0xfbcea83c8a378bf1ULL );
+
+	content_hash = libnk2_item_update_content_hash(
+	                12345,
+	                data,
+	                37 );
+
+	NK2_TEST_ASSERT_EQUAL_UINT64(
+	 "content_hash",
+	 content_hash,
+	 (uint64_t) 0xc608f760078d40d2ULL );
+
+	/* Test error cases
+	 */
+	content_hash = libnk2_item_update_content_hash(
+	                12345,
+	                NULL,
+	                37 );
+
+	NK2_TEST_ASSERT_EQUAL_UINT64(
+	 "content_hash",
+	 content_hash,
+	 (uint64_t) 12345 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libnk2_item_get_content_hash function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_item_get_content_hash(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	libnk2_item_t *item      = NULL;
+	uint64_t content_hash    = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libnk2_item_initialize(
+	          &item,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "item",
+	 item );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libnk2_item_get_content_hash(
+	          item,
+	          &content_hash,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_EQUAL_UINT64(
+	 "content_hash",
+	 content_hash,
+	 (uint64_t) LIBNK2_ITEM_CONTENT_HASH_INITIAL_VALUE );
+
+	/* Test error cases
+	 */
+	result = libnk2_item_get_content_hash(
+	          NULL,
+	          &content_hash,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_item_get_content_hash(
+	          item,
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libnk2_internal_item_free(
+	          (libnk2_internal_item_t **) &item,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "item",
+	 item );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( item != NULL )
+	{
+		libnk2_internal_item_free(
+		 (libnk2_internal_item_t **) &item,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBNK2_DLL_IMPORT ) */
 
 /* The main program
@@ -623,6 +823,14 @@ int main(
 	 "libnk2_item_get_number_of_entries",
 	 nk2_test_item_get_number_of_entries );
 
+	NK2_TEST_RUN(
+	 "libnk2_item_update_content_hash",
+	 nk2_test_item_update_content_hash );
+
+	NK2_TEST_RUN(
+	 "libnk2_item_get_content_hash",
+	 nk2_test_item_get_content_hash );
+
 	/* TODO: add tests for libnk2_item_get_entry_by_index */
 
 	/* TODO: add tests for libnk2_item_get_entry_by_type */
@@ -29,12 +29,14 @@
 #define __USE_GNU
 #include <dlfcn.h>
 #undef __USE_GNU
+#include <malloc.h>
 #endif
 
 #include "nk2_test_memory.h"
 
 #if defined( HAVE_NK2_TEST_MEMORY )
 
+static void (*nk2_test_real_free)(void *)                           = NULL;
 static void *(*nk2_test_real_malloc)(size_t)                       = NULL;
 static void *(*nk2_test_real_memcpy)(void *, const void *, size_t) = NULL;
 static void *(*nk2_test_real_memset)(void *, int, size_t)          = NULL;
@@ -45,7 +47,107 @@ int nk2_test_memcpy_attempts_before_fail                           = -1;
 int nk2_test_memset_attempts_before_fail                           = -1;
 int nk2_test_realloc_attempts_before_fail                          = -1;
 
-/* Custom malloc for testing memory error cases
+int nk2_test_memory_tracking                                       = 0;
+uint64_t nk2_test_memory_number_of_allocations                     = 0;
+int64_t nk2_test_memory_allocated_size                             = 0;
+int64_t nk2_test_memory_peak_allocated_size                        = 0;
+
+/* The blocks that were allocated while tracking, only these blocks
+ * are subtracted from the allocated size when they are freed
+ */
+static void *nk2_test_memory_tracked_blocks[ NK2_TEST_MEMORY_MAXIMUM_NUMBER_OF_TRACKED_BLOCKS ];
+static int nk2_test_memory_number_of_tracked_blocks                = 0;
+
+/* Adds a block to the tracked blocks
+ * Returns 1 if successful or 0 if there is no space to track the block
+ */
+static int nk2_test_memory_add_tracked_block(
+            void *ptr )
+{
+	if( nk2_test_memory_number_of_tracked_blocks >= NK2_TEST_MEMORY_MAXIMUM_NUMBER_OF_TRACKED_BLOCKS )
+	{
+		return( 0 );
+	}
+	nk2_test_memory_tracked_blocks[ nk2_test_memory_number_of_tracked_blocks++ ] = ptr;
+
+	return( 1 );
+}
+
+/* Removes a block from the tracked blocks
+ * Returns 1 if the block was tracked or 0 if not
+ */
+static int nk2_test_memory_remove_tracked_block(
+            void *ptr )
+{
+	int block_index = 0;
+
+	for( block_index = nk2_test_memory_number_of_tracked_blocks - 1;
+	     block_index >= 0;
+	     block_index-- )
+	{
+		if( nk2_test_memory_tracked_blocks[ block_index ] == ptr )
+		{
+			nk2_test_memory_number_of_tracked_blocks--;
+
+			nk2_test_memory_tracked_blocks[ block_index ] = nk2_test_memory_tracked_blocks[ nk2_test_memory_number_of_tracked_blocks ];
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Starts tracking allocations
+ * This resets the allocation counters
+ */
+void nk2_test_memory_start_tracking(
+      void )
+{
+	nk2_test_memory_number_of_allocations    = 0;
+	nk2_test_memory_allocated_size           = 0;
+	nk2_test_memory_peak_allocated_size      = 0;
+	nk2_test_memory_number_of_tracked_blocks = 0;
+	nk2_test_memory_tracking                 = 1;
+}
+
+/* Stops tracking allocations
+ * The allocation counters retain their values
+ */
+void nk2_test_memory_stop_tracking(
+      void )
+{
+	nk2_test_memory_tracking = 0;
+}
+
+/* Custom free for tracking the allocated size
+ */
+void free(
+      void *ptr )
+{
+	if( nk2_test_real_free == NULL )
+	{
+		nk2_test_real_free = dlsym(
+		                      RTLD_NEXT,
+		                      "free" );
+	}
+	/* A block that was allocated before tracking started is not subtracted
+	 * so that the allocated size cannot drop below zero
+	 */
+	if( ptr != NULL )
+	{
+		if( ( nk2_test_memory_remove_tracked_block(
+		       ptr ) != 0 )
+		 && ( nk2_test_memory_tracking != 0 ) )
+		{
+			nk2_test_memory_allocated_size -= (int64_t) malloc_usable_size(
+			                                             ptr );
+		}
+	}
+	nk2_test_real_free(
+	 ptr );
+}
+
+/* Custom malloc for testing memory error cases and tracking allocations
  * Note this function might fail if compiled with optimation
  * Returns a pointer to newly allocated data or NULL
  */
@@ -73,6 +175,23 @@ void *malloc(
 	ptr = nk2_test_real_malloc(
 	       size );
 
+	if( ( nk2_test_memory_tracking != 0 )
+	 && ( ptr != NULL ) )
+	{
+		nk2_test_memory_number_of_allocations += 1;
+
+		if( nk2_test_memory_add_tracked_block(
+		     ptr ) != 0 )
+		{
+			nk2_test_memory_allocated_size += (int64_t) malloc_usable_size(
+			                                             ptr );
+
+			if( nk2_test_memory_allocated_size > nk2_test_memory_peak_allocated_size )
+			{
+				nk2_test_memory_peak_allocated_size = nk2_test_memory_allocated_size;
+			}
+		}
+	}
 	return( ptr );
 }
 
@@ -142,7 +261,7 @@ void *memset(
 	return( ptr );
 }
 
-/* Custom realloc for testing memory error cases
+/* Custom realloc for testing memory error cases and tracking allocations
  * Note this function might fail if compiled with optimation
  * Returns a pointer to reallocated data or NULL
  */
@@ -150,6 +269,9 @@ void *realloc(
        void *ptr,
        size_t size )
 {
+	void *reallocated_ptr = NULL;
+	size_t previous_size  = 0;
+
 	if( nk2_test_real_realloc == NULL )
 	{
 		nk2_test_real_realloc = dlsym(
@@ -166,11 +288,45 @@ void *realloc(
 	{
 		nk2_test_realloc_attempts_before_fail--;
 	}
-	ptr = nk2_test_real_realloc(
-	       ptr,
-	       size );
+	if( ptr != NULL )
+	{
+		previous_size = malloc_usable_size(
+		                 ptr );
+	}
+	reallocated_ptr = nk2_test_real_realloc(
+	                   ptr,
+	                   size );
 
-	return( ptr );
+	if( reallocated_ptr == NULL )
+	{
+		return( NULL );
+	}
+	/* The previous size is only subtracted if the block was tracked
+	 */
+	if( ( ptr != NULL )
+	 && ( nk2_test_memory_remove_tracked_block(
+	       ptr ) != 0 )
+	 && ( nk2_test_memory_tracking != 0 ) )
+	{
+		nk2_test_memory_allocated_size -= (int64_t) previous_size;
+	}
+	if( nk2_test_memory_tracking != 0 )
+	{
+		nk2_test_memory_number_of_allocations += 1;
+
+		if( nk2_test_memory_add_tracked_block(
+		     reallocated_ptr ) != 0 )
+		{
+			nk2_test_memory_allocated_size += (int64_t) malloc_usable_size(
+			                                             reallocated_ptr );
+
+			if( nk2_test_memory_allocated_size > nk2_test_memory_peak_allocated_size )
+			{
+				nk2_test_memory_peak_allocated_size = nk2_test_memory_allocated_size;
+			}
+		}
+	}
+	return( reallocated_ptr );
 }
 
 #endif /* defined( HAVE_NK2_TEST_MEMORY ) */
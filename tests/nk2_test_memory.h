@@ -23,6 +23,7 @@
 #define _NK2_TEST_MEMORY_H
 
 #include <common.h>
+#include <types.h>
 
 #if defined( __cplusplus )
 extern "C" {
@@ -34,6 +35,11 @@ extern "C" {
 
 #if defined( HAVE_NK2_TEST_MEMORY )
 
+/* The maximum number of blocks that are tracked, blocks beyond this number
+ * are counted as allocations but not in the allocated size
+ */
+#define NK2_TEST_MEMORY_MAXIMUM_NUMBER_OF_TRACKED_BLOCKS	65536
+
 extern int nk2_test_malloc_attempts_before_fail;
 
 extern int nk2_test_memcpy_attempts_before_fail;
@@ -42,6 +48,20 @@ extern int nk2_test_memset_attempts_before_fail;
 
 extern int nk2_test_realloc_attempts_before_fail;
 
+extern int nk2_test_memory_tracking;
+
+extern uint64_t nk2_test_memory_number_of_allocations;
+
+extern int64_t nk2_test_memory_allocated_size;
+
+extern int64_t nk2_test_memory_peak_allocated_size;
+
+void nk2_test_memory_start_tracking(
+      void );
+
+void nk2_test_memory_stop_tracking(
+      void );
+
 #endif /* defined( HAVE_NK2_TEST_MEMORY ) */
 
 #if defined( __cplusplus )
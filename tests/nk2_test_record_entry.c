@@ -36,6 +36,7 @@
 #include "nk2_test_memory.h"
 #include "nk2_test_unused.h"
 
+#include "../libnk2/libnk2_io_handle.h"
 #include "../libnk2/libnk2_record_entry.h"
 
 uint8_t nk2_test_record_entry_16bit_integer_data1[ 16 ] = {
@@ -621,11 +622,29 @@ int nk2_test_record_entry_read_file_io_handle(
 {
 	libbfio_handle_t *file_io_handle    = NULL;
 	libcerror_error_t *error            = NULL;
+	libnk2_io_handle_t *io_handle       = NULL;
 	libnk2_record_entry_t *record_entry = NULL;
 	int result                          = 0;
 
 	/* Initialize test
 	 */
+	result = libnk2_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	result = libnk2_record_entry_initialize(
 	          &record_entry,
 	          LIBNK2_CODEPAGE_WINDOWS_1252,
@@ -669,6 +688,7 @@ int nk2_test_record_entry_read_file_io_handle(
 	 */
 	result = libnk2_record_entry_read_file_io_handle(
 	          record_entry,
+	          io_handle,
 	          file_io_handle,
 	          &error );
 
@@ -681,10 +701,26 @@ int nk2_test_record_entry_read_file_io_handle(
 	 "error",
 	 error );
 
+	NK2_TEST_ASSERT_EQUAL_UINT64(
+	 "io_handle->statistics.number_of_read_calls",
+	 io_handle->statistics.number_of_read_calls,
+	 (uint64_t) 3 );
+
+	NK2_TEST_ASSERT_EQUAL_UINT64(
+	 "io_handle->statistics.number_of_bytes_read",
+	 io_handle->statistics.number_of_bytes_read,
+	 (uint64_t) 46 );
+
+	NK2_TEST_ASSERT_EQUAL_UINT64(
+	 "io_handle->statistics.number_of_allocations",
+	 io_handle->statistics.number_of_allocations,
+	 (uint64_t) 1 );
+
 	/* Test error cases
 	 */
 	result = libnk2_record_entry_read_file_io_handle(
 	          NULL,
+	          io_handle,
 	          file_io_handle,
 	          &error );
 
@@ -702,6 +738,7 @@ int nk2_test_record_entry_read_file_io_handle(
 
 	result = libnk2_record_entry_read_file_io_handle(
 	          record_entry,
+	          io_handle,
 	          NULL,
 	          &error );
 
@@ -717,6 +754,24 @@ int nk2_test_record_entry_read_file_io_handle(
 	libcerror_error_free(
 	 &error );
 
+	result = libnk2_record_entry_read_file_io_handle(
+	          record_entry,
+	          NULL,
+	          file_io_handle,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
 #if defined( TODO )
 /* TODO fix failing test */
 
@@ -728,6 +783,7 @@ int nk2_test_record_entry_read_file_io_handle(
 
 	result = libnk2_record_entry_read_file_io_handle(
 	          record_entry,
+	          io_handle,
 	          file_io_handle,
 	          &error );
 
@@ -767,6 +823,81 @@ int nk2_test_record_entry_read_file_io_handle(
 	 "error",
 	 error );
 
+	/* Test value data size that exceeds the remaining items size
+	 */
+	result = nk2_test_open_file_io_handle(
+	          &file_io_handle,
+	          nk2_test_record_entry_string_unicode_data1,
+	          46,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_io_handle_clear_last_error(
+	          io_handle,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->current_offset   = 0;
+	io_handle->items_end_offset = 40;
+
+	result = libnk2_record_entry_read_file_io_handle(
+	          record_entry,
+	          io_handle,
+	          file_io_handle,
+	          &error );
+
+	io_handle->items_end_offset = 0;
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "io_handle->last_error_code",
+	 io_handle->last_error_code,
+	 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM );
+
+	result = nk2_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	/* Test data too small for record entry
 	 */
 	result = nk2_test_open_file_io_handle(
@@ -790,6 +921,7 @@ int nk2_test_record_entry_read_file_io_handle(
 
 	result = libnk2_record_entry_read_file_io_handle(
 	          record_entry,
+	          io_handle,
 	          file_io_handle,
 	          &error );
 
@@ -841,6 +973,7 @@ int nk2_test_record_entry_read_file_io_handle(
 
 	result = libnk2_record_entry_read_file_io_handle(
 	          record_entry,
+	          io_handle,
 	          file_io_handle,
 	          &error );
 
@@ -892,6 +1025,7 @@ int nk2_test_record_entry_read_file_io_handle(
 
 	result = libnk2_record_entry_read_file_io_handle(
 	          record_entry,
+	          io_handle,
 	          file_io_handle,
 	          &error );
 
@@ -941,6 +1075,23 @@ int nk2_test_record_entry_read_file_io_handle(
 	 "error",
 	 error );
 
+	result = libnk2_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	return( 1 );
 
 on_error:
@@ -961,6 +1112,12 @@ on_error:
 		 (libnk2_internal_record_entry_t **) &record_entry,
 		 NULL );
 	}
+	if( io_handle != NULL )
+	{
+		libnk2_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
 	return( 0 );
 }
 
@@ -1598,6 +1755,203 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libnk2_record_entry_get_data_pointer function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_record_entry_get_data_pointer(
+     void )
+{
+	libcerror_error_t *error            = NULL;
+	libnk2_record_entry_t *record_entry = NULL;
+	const uint8_t *data                 = NULL;
+	size_t data_size                    = 0;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libnk2_record_entry_initialize(
+	          &record_entry,
+	          LIBNK2_CODEPAGE_WINDOWS_1252,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "record_entry",
+	 record_entry );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_record_entry_read_data(
+	          record_entry,
+	          nk2_test_record_entry_32bit_integer_data1,
+	          16,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libnk2_record_entry_get_data_pointer(
+	          record_entry,
+	          &data,
+	          &data_size,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	NK2_TEST_ASSERT_EQUAL_SIZE(
+	 "data_size",
+	 data_size,
+	 (size_t) 4 );
+
+	result = memory_compare(
+	          data,
+	          &( nk2_test_record_entry_32bit_integer_data1[ 8 ] ),
+	          4 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libnk2_record_entry_get_data_pointer(
+	          NULL,
+	          &data,
+	          &data_size,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_record_entry_get_data_pointer(
+	          record_entry,
+	          NULL,
+	          &data_size,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_record_entry_get_data_pointer(
+	          record_entry,
+	          &data,
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	( (libnk2_internal_record_entry_t *) record_entry )->value_data = NULL;
+
+	result = libnk2_record_entry_get_data_pointer(
+	          record_entry,
+	          &data,
+	          &data_size,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	( (libnk2_internal_record_entry_t *) record_entry )->value_data = ( (libnk2_internal_record_entry_t *) record_entry )->value_data_array;
+
+	/* Clean up
+	 */
+	result = libnk2_internal_record_entry_free(
+	          (libnk2_internal_record_entry_t **) &record_entry,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "record_entry",
+	 record_entry );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( record_entry != NULL )
+	{
+		libnk2_internal_record_entry_free(
+		 (libnk2_internal_record_entry_t **) &record_entry,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* Tests the libnk2_record_entry_get_data_as_boolean function
  * Returns 1 if successful or 0 if not
  */
@@ -4086,6 +4440,10 @@ int main(
 	 "libnk2_record_entry_get_data",
 	 nk2_test_record_entry_get_data );
 
+	NK2_TEST_RUN(
+	 "libnk2_record_entry_get_data_pointer",
+	 nk2_test_record_entry_get_data_pointer );
+
 	NK2_TEST_RUN(
 	 "libnk2_record_entry_get_data_as_boolean",
 	 nk2_test_record_entry_get_data_as_boolean );
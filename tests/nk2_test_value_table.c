@@ -0,0 +1,839 @@
+/*
+ * Library value table functions test program
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "nk2_test_libcerror.h"
+#include "nk2_test_libnk2.h"
+#include "nk2_test_macros.h"
+#include "nk2_test_memory.h"
+#include "nk2_test_unused.h"
+
+#include "../libnk2/libnk2_value_table.h"
+
+/* Tests the libnk2_value_table_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_value_table_initialize(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libnk2_value_table_t *value_table = NULL;
+	int result                        = 0;
+
+	/* Test regular cases
+	 */
+	result = libnk2_value_table_initialize(
+	          &value_table,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "value_table",
+	 value_table );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_value_table_free(
+	          &value_table,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "value_table",
+	 value_table );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libnk2_value_table_initialize(
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	value_table = (libnk2_value_table_t *) 0x12345678UL;
+
+	result = libnk2_value_table_initialize(
+	          &value_table,
+	          &error );
+
+	value_table = NULL;
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( value_table != NULL )
+	{
+		libnk2_value_table_free(
+		 &value_table,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_value_table_free function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_value_table_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libnk2_value_table_free(
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBNK2_DLL_IMPORT )
+
+/* Tests the libnk2_value_table_insert_value and libnk2_value_table_release_value functions
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_value_table_insert_and_release_value(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libnk2_value_table_t *value_table = NULL;
+	uint8_t *data1                    = NULL;
+	uint8_t *data2                    = NULL;
+	uint8_t *data3                    = NULL;
+	uint64_t number_of_references     = 0;
+	int number_of_values              = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libnk2_value_table_initialize(
+	          &value_table,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "value_table",
+	 value_table );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data1 = (uint8_t *) memory_allocate(
+	                     sizeof( uint8_t ) * 8 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "data1",
+	 data1 );
+
+	data2 = (uint8_t *) memory_allocate(
+	                     sizeof( uint8_t ) * 8 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "data2",
+	 data2 );
+
+	data3 = (uint8_t *) memory_allocate(
+	                     sizeof( uint8_t ) * 8 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "data3",
+	 data3 );
+
+	memory_copy(
+	 data1,
+	 "value 1",
+	 8 );
+
+	memory_copy(
+	 data2,
+	 "value 1",
+	 8 );
+
+	memory_copy(
+	 data3,
+	 "value 2",
+	 8 );
+
+	/* Test regular cases
+	 */
+	result = libnk2_value_table_insert_value(
+	          value_table,
+	          &data1,
+	          8,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The identical data is freed and replaced by the stored data
+	 */
+	result = libnk2_value_table_insert_value(
+	          value_table,
+	          &data2,
+	          8,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "data2",
+	 (int) ( data2 == data1 ),
+	 1 );
+
+	result = libnk2_value_table_insert_value(
+	          value_table,
+	          &data3,
+	          8,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "data3",
+	 (int) ( data3 == data1 ),
+	 0 );
+
+	result = libnk2_value_table_get_number_of_values(
+	          value_table,
+	          &number_of_values,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "number_of_values",
+	 number_of_values,
+	 2 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_value_table_get_number_of_references(
+	          value_table,
+	          &number_of_references,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_references",
+	 number_of_references,
+	 (uint64_t) 3 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The value table cannot be freed while values are referenced
+	 */
+	result = libnk2_value_table_free(
+	          &value_table,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "value_table",
+	 value_table );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_value_table_release_value(
+	          value_table,
+	          data2,
+	          8,
+	          &error );
+
+	data2 = NULL;
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_value_table_get_number_of_values(
+	          value_table,
+	          &number_of_values,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "number_of_values",
+	 number_of_values,
+	 2 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_value_table_release_value(
+	          value_table,
+	          data1,
+	          8,
+	          &error );
+
+	data1 = NULL;
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_value_table_release_value(
+	          value_table,
+	          data3,
+	          8,
+	          &error );
+
+	data3 = NULL;
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libnk2_value_table_get_number_of_values(
+	          value_table,
+	          &number_of_values,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "number_of_values",
+	 number_of_values,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libnk2_value_table_insert_value(
+	          NULL,
+	          &data1,
+	          8,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_value_table_insert_value(
+	          value_table,
+	          NULL,
+	          8,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_value_table_release_value(
+	          NULL,
+	          (uint8_t *) "value 1",
+	          8,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_value_table_release_value(
+	          value_table,
+	          (uint8_t *) "value 1",
+	          8,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libnk2_value_table_free(
+	          &value_table,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "value_table",
+	 value_table );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data3 != NULL )
+	{
+		memory_free(
+		 data3 );
+	}
+	if( ( data2 != NULL )
+	 && ( data2 != data1 ) )
+	{
+		memory_free(
+		 data2 );
+	}
+	if( data1 != NULL )
+	{
+		memory_free(
+		 data1 );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBNK2_DLL_IMPORT ) */
+
+/* Tests the libnk2_value_table_get_number_of_values function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_value_table_get_number_of_values(
+     libnk2_value_table_t *value_table )
+{
+	libcerror_error_t *error = NULL;
+	int number_of_values     = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libnk2_value_table_get_number_of_values(
+	          value_table,
+	          &number_of_values,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "number_of_values",
+	 number_of_values,
+	 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libnk2_value_table_get_number_of_values(
+	          NULL,
+	          &number_of_values,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_value_table_get_number_of_values(
+	          value_table,
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libnk2_value_table_get_number_of_references function
+ * Returns 1 if successful or 0 if not
+ */
+int nk2_test_value_table_get_number_of_references(
+     libnk2_value_table_t *value_table )
+{
+	libcerror_error_t *error      = NULL;
+	uint64_t number_of_references = 0;
+	int result                    = 0;
+
+	/* Test regular cases
+	 */
+	result = libnk2_value_table_get_number_of_references(
+	          value_table,
+	          &number_of_references,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_references",
+	 number_of_references,
+	 (uint64_t) 0 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libnk2_value_table_get_number_of_references(
+	          NULL,
+	          &number_of_references,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libnk2_value_table_get_number_of_references(
+	          value_table,
+	          NULL,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc NK2_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] NK2_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc NK2_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] NK2_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	libcerror_error_t *error          = NULL;
+	libnk2_value_table_t *value_table = NULL;
+	int result                        = 0;
+
+	NK2_TEST_UNREFERENCED_PARAMETER( argc )
+	NK2_TEST_UNREFERENCED_PARAMETER( argv )
+
+	NK2_TEST_RUN(
+	 "libnk2_value_table_initialize",
+	 nk2_test_value_table_initialize );
+
+	NK2_TEST_RUN(
+	 "libnk2_value_table_free",
+	 nk2_test_value_table_free );
+
+#if defined( __GNUC__ ) && !defined( LIBNK2_DLL_IMPORT )
+
+	NK2_TEST_RUN(
+	 "libnk2_value_table_insert_value",
+	 nk2_test_value_table_insert_and_release_value );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBNK2_DLL_IMPORT ) */
+
+#if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
+
+	/* Initialize test
+	 */
+	result = libnk2_value_table_initialize(
+	          &value_table,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NOT_NULL(
+	 "value_table",
+	 value_table );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	NK2_TEST_RUN_WITH_ARGS(
+	 "libnk2_value_table_get_number_of_values",
+	 nk2_test_value_table_get_number_of_values,
+	 value_table );
+
+	NK2_TEST_RUN_WITH_ARGS(
+	 "libnk2_value_table_get_number_of_references",
+	 nk2_test_value_table_get_number_of_references,
+	 value_table );
+
+	/* Clean up
+	 */
+	result = libnk2_value_table_free(
+	          &value_table,
+	          &error );
+
+	NK2_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "value_table",
+	 value_table );
+
+	NK2_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#endif /* !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( value_table != NULL )
+	{
+		libnk2_value_table_free(
+		 &value_table,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -20,8 +20,10 @@
 # along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 import argparse
+import io
 import os
 import sys
+import threading
 import unittest
 
 import pynk2
@@ -83,6 +85,88 @@ class FileTypeTests(unittest.TestCase):
       with self.assertRaises(ValueError):
         nk2_file.open_file_object(file_object, mode="w")
 
+  def test_open_file_object_read_ahead_size(self):
+    """Tests the open_file_object function with a read-ahead size."""
+    test_source = getattr(unittest, "source", None)
+    if not test_source:
+      raise unittest.SkipTest("missing source")
+
+    if not os.path.isfile(test_source):
+      raise unittest.SkipTest("source not a regular file")
+
+    nk2_file = pynk2.file()
+
+    with open(test_source, "rb") as file_object:
+      nk2_file.open_file_object(file_object, read_ahead_size=0)
+      expected_records = nk2_file.to_records()
+      nk2_file.close()
+
+      for read_ahead_size in (16, 4096, 65536):
+        file_object.seek(0, os.SEEK_SET)
+        nk2_file.open_file_object(file_object, read_ahead_size=read_ahead_size)
+        self.assertEqual(nk2_file.to_records(), expected_records)
+        nk2_file.close()
+
+      with self.assertRaises(ValueError):
+        nk2_file.open_file_object(file_object, read_ahead_size=-1)
+
+  def test_open_file_object_without_file_descriptor(self):
+    """Tests the open_file_object function with a file object without fileno."""
+    test_source = getattr(unittest, "source", None)
+    if not test_source:
+      raise unittest.SkipTest("missing source")
+
+    if not os.path.isfile(test_source):
+      raise unittest.SkipTest("source not a regular file")
+
+    nk2_file = pynk2.file()
+
+    with open(test_source, "rb") as file_object:
+      nk2_file.open_file_object(file_object)
+      expected_records = nk2_file.to_records()
+      nk2_file.close()
+
+      file_object.seek(0, os.SEEK_SET)
+      bytes_io_object = io.BytesIO(file_object.read())
+
+    nk2_file.open_file_object(bytes_io_object)
+    self.assertEqual(nk2_file.to_records(), expected_records)
+    nk2_file.close()
+
+  def test_open_many(self):
+    """Tests the open_many function."""
+    test_source = getattr(unittest, "source", None)
+    if not test_source:
+      raise unittest.SkipTest("missing source")
+
+    nk2_file = pynk2.open(test_source)
+    expected_number_of_items = nk2_file.number_of_items
+    nk2_file.close()
+
+    nk2_files = pynk2.open_many([test_source] * 8, workers=4)
+    self.assertEqual(len(nk2_files), 8)
+
+    for nk2_file in nk2_files:
+      self.assertEqual(nk2_file.number_of_items, expected_number_of_items)
+      nk2_file.close()
+
+    self.assertEqual(pynk2.open_many([]), [])
+
+    with self.assertRaises(IOError):
+      pynk2.open_many([test_source, ""])
+
+    with self.assertRaises(TypeError):
+      pynk2.open_many(test_source)
+
+    with self.assertRaises(TypeError):
+      pynk2.open_many([None])
+
+    with self.assertRaises(ValueError):
+      pynk2.open_many([test_source], workers=0)
+
+    with self.assertRaises(ValueError):
+      pynk2.open_many([test_source], mode="w")
+
   def test_close(self):
     """Tests the close function."""
     test_source = getattr(unittest, "source", None)
@@ -233,6 +317,123 @@ class FileTypeTests(unittest.TestCase):
 
     nk2_file.close()
 
+  def test_record_entry_data_buffer(self):
+    """Tests the buffer protocol and memoryview of the record entry data."""
+    test_source = getattr(unittest, "source", None)
+    if not test_source:
+      raise unittest.SkipTest("missing source")
+
+    nk2_file = pynk2.file()
+
+    nk2_file.open(test_source)
+
+    if nk2_file.number_of_items > 0:
+      item = nk2_file.get_item(0)
+      for entry_index in range(item.number_of_entries):
+        record_entry = item.get_entry(entry_index)
+        data = record_entry.data
+
+        memoryview_object = record_entry.get_data_as_memoryview()
+        if data is None:
+          self.assertIsNone(memoryview_object)
+        else:
+          self.assertTrue(memoryview_object.readonly)
+          self.assertEqual(memoryview_object.tobytes(), data)
+          self.assertEqual(bytes(memoryview(record_entry)), data)
+          memoryview_object.release()
+
+    nk2_file.close()
+
+  def test_record_entry_data_buffer_close(self):
+    """Tests that close is refused while record entry data is exported."""
+    test_source = getattr(unittest, "source", None)
+    if not test_source:
+      raise unittest.SkipTest("missing source")
+
+    nk2_file = pynk2.file()
+
+    nk2_file.open(test_source)
+
+    memoryview_object = None
+    for item in nk2_file.items:
+      for record_entry in item.entries:
+        memoryview_object = record_entry.get_data_as_memoryview()
+        if memoryview_object is not None:
+          break
+      if memoryview_object is not None:
+        break
+
+    if memoryview_object is None:
+      nk2_file.close()
+      raise unittest.SkipTest("missing record entry data")
+
+    with self.assertRaises(BufferError):
+      nk2_file.close()
+
+    memoryview_object.release()
+
+    nk2_file.close()
+
+  def test_to_records(self):
+    """Tests the to_records function and the item to_dict function."""
+    test_source = getattr(unittest, "source", None)
+    if not test_source:
+      raise unittest.SkipTest("missing source")
+
+    nk2_file = pynk2.file()
+
+    nk2_file.open(test_source)
+
+    records = nk2_file.to_records()
+    self.assertIsNotNone(records)
+    self.assertEqual(len(records), nk2_file.number_of_items)
+
+    if nk2_file.number_of_items > 0:
+      item = nk2_file.get_item(0)
+      record = item.to_dict()
+      self.assertEqual(records[0], record)
+      self.assertEqual(len(record), item.number_of_entries)
+
+      entry_types = list(record.keys())[:1]
+      records = nk2_file.to_records(entry_types=entry_types)
+      self.assertEqual(list(records[0].keys()), entry_types)
+
+    records = nk2_file.to_records(entry_types=[])
+    self.assertEqual(records, [{}] * nk2_file.number_of_items)
+
+    with self.assertRaises(TypeError):
+      nk2_file.to_records(entry_types=1)
+
+    nk2_file.close()
+
+  def test_open_threads(self):
+    """Tests the open function from multiple threads."""
+    test_source = getattr(unittest, "source", None)
+    if not test_source:
+      raise unittest.SkipTest("missing source")
+
+    nk2_file = pynk2.file()
+
+    nk2_file.open(test_source)
+    expected_number_of_items = nk2_file.number_of_items
+    nk2_file.close()
+
+    results = []
+
+    def _OpenFile():
+      thread_nk2_file = pynk2.file()
+      thread_nk2_file.open(test_source)
+      results.append(thread_nk2_file.number_of_items)
+      thread_nk2_file.close()
+
+    threads = [threading.Thread(target=_OpenFile) for _ in range(4)]
+    for thread in threads:
+      thread.start()
+    for thread in threads:
+      thread.join()
+
+    self.assertEqual(results, [expected_number_of_items] * 4)
+
 
 if __name__ == "__main__":
   argument_parser = argparse.ArgumentParser()
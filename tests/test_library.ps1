@@ -6,7 +6,7 @@ $ExitSuccess = 0
 $ExitFailure = 1
 $ExitIgnore = 77
 
-$LibraryTests = "error file_footer file_header io_handle item mapi_value notify record_entry"
+$LibraryTests = "address_filter alias_index carve digest error file_footer file_header index io_handle item mapi_value notify record_entry value_table writer"
 $LibraryTestsWithInput = "file support"
 $OptionSets = ""
 